@@ -0,0 +1,125 @@
+#include "bb3d/core/Log.hpp"
+#include "bb3d/render/TextureCooker.hpp"
+#include <stb_image.h>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace bb3d;
+namespace fs = std::filesystem;
+
+/**
+ * @brief Outil hors-ligne : convertit les images sources (JPG/PNG/TGA) en `.ktx2` BCn avec mips.
+ *
+ * Usage : bb3d_texture_cooker [--fast] [--no-mips] [--box] [--force] [fichiers ou dossiers...]
+ * Sans argument, cuisine `assets/PBR`. Le `.ktx2` est écrit à côté de la source ; `Texture`
+ * le charge à sa place. Le rôle (albedo, normal, niveaux de gris) est déduit du nom du fichier.
+ * Les mips utilisent le filtre de Kaiser (`--box` : moyenne 2x2, plus rapide).
+ */
+
+static bool isSourceImage(const fs::path& path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext == ".jpg" || ext == ".jpeg" || ext == ".png" || ext == ".tga";
+}
+
+static const char* usageName(TextureUsage usage) {
+    switch (usage) {
+        case TextureUsage::Albedo: return "albedo";
+        case TextureUsage::Normal: return "normal";
+        case TextureUsage::Single: return "single";
+        default: return "data";
+    }
+}
+
+int main(int argc, char** argv) {
+    Log::Init();
+
+    TextureCookSettings settings;
+    bool force = false;
+    std::vector<fs::path> inputs;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--fast") settings.fast = true;
+        else if (arg == "--no-mips") settings.generateMips = false;
+        else if (arg == "--box") settings.mipFilter = MipFilter::Box;
+        else if (arg == "--force") force = true;
+        else inputs.emplace_back(arg);
+    }
+    if (inputs.empty()) inputs.emplace_back("assets/PBR");
+
+    // Sources whose .ktx2 is missing or older
+    std::vector<fs::path> jobs;
+    auto consider = [&](const fs::path& source) {
+        if (!isSourceImage(source)) return;
+        fs::path cooked = source;
+        cooked.replace_extension(".ktx2");
+        if (!force && fs::exists(cooked) && fs::last_write_time(cooked) >= fs::last_write_time(source)) return;
+        jobs.push_back(source);
+    };
+    for (const auto& input : inputs) {
+        if (fs::is_directory(input)) {
+            for (const auto& entry : fs::recursive_directory_iterator(input)) {
+                if (entry.is_regular_file()) consider(entry.path());
+            }
+        } else if (fs::exists(input)) {
+            consider(input);
+        } else {
+            BB_CORE_WARN("Cooker: '{0}' not found.", input.string());
+        }
+    }
+    BB_CORE_INFO("Cooker: {0} texture(s) to cook.", jobs.size());
+
+    // One file per worker: the encoders are single-threaded and files are independent
+    std::atomic<size_t> next{ 0 };
+    std::atomic<int> failures{ 0 };
+    std::atomic<uint64_t> sourceBytes{ 0 }, cookedBytes{ 0 };
+    auto worker = [&]() {
+        for (size_t index = next++; index < jobs.size(); index = next++) {
+            const fs::path& source = jobs[index];
+            int width = 0, height = 0, channels = 0;
+            stbi_uc* pixels = stbi_load(source.string().c_str(), &width, &height, &channels, STBI_rgb_alpha);
+            if (!pixels) {
+                BB_CORE_ERROR("Cooker: Failed to decode '{0}'.", source.string());
+                failures++;
+                continue;
+            }
+
+            const TextureUsage usage = TextureCooker::detectUsage(source.filename().string());
+            KTX2Texture texture = TextureCooker::cook(pixels, static_cast<uint32_t>(width), static_cast<uint32_t>(height), usage, settings);
+            stbi_image_free(pixels);
+
+            const auto bytes = KTX2::write(texture);
+            fs::path cooked = source;
+            cooked.replace_extension(".ktx2");
+            std::ofstream file(cooked, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            if (!file) {
+                BB_CORE_ERROR("Cooker: Failed to write '{0}'.", cooked.string());
+                failures++;
+                continue;
+            }
+
+            // VRAM of the runtime path: RGBA8 + full mip chain (4/3)
+            sourceBytes += static_cast<uint64_t>(width) * height * 4 * 4 / 3;
+            cookedBytes += bytes.size();
+            BB_CORE_INFO("Cooker: {0} ({1}, {2}x{3}, {4} levels) -> {5} KB", cooked.filename().string(), usageName(usage), width, height, texture.levels.size(), bytes.size() / 1024);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    const unsigned threadCount = std::max(1u, std::min<unsigned>(std::thread::hardware_concurrency(), static_cast<unsigned>(jobs.size())));
+    for (unsigned i = 0; i < threadCount; ++i) threads.emplace_back(worker);
+    for (auto& thread : threads) thread.join();
+
+    if (cookedBytes > 0) {
+        BB_CORE_INFO("Cooker: {0} MB of RGBA8 VRAM -> {1} MB cooked ({2:.1f}x smaller).",
+            sourceBytes / (1024 * 1024), cookedBytes / (1024 * 1024), static_cast<double>(sourceBytes) / static_cast<double>(cookedBytes));
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,46 @@
+// Shared by cull_instances.comp and compact_draws.comp (layouts of InstanceCuller.hpp)
+
+#define INSTANCE_DATA_NO_BUFFER
+#include "instance_data.glsl"
+
+struct CullInstance {
+    vec3 boundsMin;
+    uint draw;
+    vec3 boundsMax;
+    uint instance;
+};
+
+struct DrawTemplate {
+    uint indexCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint firstInstance;
+    uint group;
+    uint groupFirstDraw;
+    uint pad0;
+    uint pad1;
+};
+
+struct DrawCommand {
+    uint indexCount;
+    uint instanceCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint firstInstance;
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer CullInstances { CullInstance items[]; } cullInstances;
+layout(std430, set = 0, binding = 1) readonly buffer DrawTemplates { DrawTemplate items[]; } drawTemplates;
+layout(std430, set = 0, binding = 2) buffer DrawCounts { uint counts[]; } drawCounts;
+layout(std430, set = 0, binding = 3) buffer InstanceBuffer { InstanceData items[]; } instances;
+layout(std430, set = 0, binding = 4) writeonly buffer DrawCommands { DrawCommand items[]; } drawCommands;
+// [0] = visible instances, [1 + group] = commands of the group (count buffer of vkCmdDrawIndexedIndirectCount)
+layout(std430, set = 0, binding = 5) buffer Counters { uint values[]; } counters;
+
+layout(push_constant) uniform CullConstants {
+    vec4 planes[6];
+    uint instanceCount;
+    uint drawCount;
+    uint outputBase;
+    uint pad;
+} pc;
@@ -0,0 +1,26 @@
+// Instance record shared by the mesh vertex shaders (layout of bb3d::InstanceData, 64 bytes).
+// The last row of the world matrix is always (0, 0, 0, 1): only the first three rows are
+// stored, translation in w, which frees 16 bytes for the per-instance attributes.
+
+struct InstanceData {
+    vec4 rows[3];
+    uint materialIndex; // Bindless material record (PBR with bindless materials)
+    uint color;         // Tint, packUnorm4x8
+    uint flags;         // Reserved, 0 today
+    uint pad;
+};
+
+mat4 instanceModel(InstanceData data) {
+    return transpose(mat4(data.rows[0], data.rows[1], data.rows[2], vec4(0.0, 0.0, 0.0, 1.0)));
+}
+
+vec4 instanceColor(InstanceData data) {
+    return unpackUnorm4x8(data.color);
+}
+
+// The culling passes bind the records elsewhere and only need the struct
+#ifndef INSTANCE_DATA_NO_BUFFER
+layout(std430, set = 0, binding = 1) readonly buffer InstanceBuffer {
+    InstanceData items[];
+} instances;
+#endif
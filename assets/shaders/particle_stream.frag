@@ -0,0 +1,21 @@
+#version 450
+
+layout(location = 0) in vec2 fragUV;
+layout(location = 1) in vec4 fragColor;
+
+layout(location = 0) out vec4 outColor;
+
+// Shared head of ParticleMaterial and PlasmaMaterial
+layout(set = 1, binding = 0) uniform MaterialUBO {
+    vec4 color;
+} material;
+layout(set = 1, binding = 1) uniform sampler2D texSampler;
+
+layout(push_constant) uniform Push {
+    float intensity;
+} push;
+
+void main() {
+    vec4 color = texture(texSampler, fragUV) * material.color * fragColor;
+    outColor = vec4(color.rgb * push.intensity, color.a);
+}
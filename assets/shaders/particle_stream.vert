@@ -0,0 +1,38 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "vertex_input.glsl"
+
+layout(location = 0) out vec2 fragUV;
+layout(location = 1) out vec4 fragColor;
+
+layout(set = 0, binding = 0) uniform GlobalUBO {
+    mat4 view;
+    mat4 proj;
+} ubo;
+
+// Mirror of bb3d::ParticleInstance (20 bytes)
+struct ParticleInstance {
+    float position[3];
+    float size;
+    uint color;
+};
+
+layout(std430, set = 0, binding = 5) readonly buffer ParticleStream {
+    ParticleInstance items[];
+} particles;
+
+void main() {
+    ParticleInstance p = particles.items[gl_InstanceIndex];
+    vec3 center = vec3(p.position[0], p.position[1], p.position[2]);
+
+    // Camera-facing: the mesh axes follow the rows of the view rotation
+    vec3 right = vec3(ubo.view[0][0], ubo.view[1][0], ubo.view[2][0]);
+    vec3 up = vec3(ubo.view[0][1], ubo.view[1][1], ubo.view[2][1]);
+    vec3 back = vec3(ubo.view[0][2], ubo.view[1][2], ubo.view[2][2]);
+    vec3 worldPos = center + (right * inPosition.x + up * inPosition.y + back * inPosition.z) * p.size;
+
+    fragUV = inUV;
+    fragColor = unpackUnorm4x8(p.color);
+    gl_Position = ubo.proj * ubo.view * vec4(worldPos, 1.0);
+}
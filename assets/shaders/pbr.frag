@@ -1,212 +1,4 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
 
-layout(location = 0) in vec3 fragPos;
-layout(location = 1) in vec3 fragNormal;
-layout(location = 2) in vec2 fragUV;
-layout(location = 3) in mat3 TBN;
-layout(location = 6) in vec3 fragColor; 
-
-layout(location = 0) out vec4 outColor;
-
-layout(set = 1, binding = 0) uniform MaterialUBO {
-    vec4 baseColorFactor;
-    float metallicFactor;
-    float roughnessFactor;
-    float normalScale;
-    float occlusionStrength;
-} mat;
-
-layout(set = 1, binding = 1) uniform sampler2D albedoMap;
-layout(set = 1, binding = 2) uniform sampler2D normalMap;
-layout(set = 1, binding = 3) uniform sampler2D ormMap; // R=Occlusion, G=Roughness, B=Metallic
-layout(set = 1, binding = 4) uniform sampler2D emissiveMap;
-
-struct Light {
-    vec4 position;  // xyz = pos, w = type (0=Dir, 1=Point)
-    vec4 color;     // rgb = color, a = intensity
-    vec4 direction; // xyz = dir
-    vec4 params;    // x = range
-};
-
-layout(set = 0, binding = 0) uniform GlobalUBO {
-    mat4 view;
-    mat4 proj;
-    mat4 shadowCascades[4];
-    vec4 shadowSplitDepths;
-    vec4 camPos;
-    vec4 globalParams; // .x = numLights
-    vec4 ambientColor; // .rgb = color, .a = intensity
-    vec4 shadowBiases; // .x = normalBias, .y = shaderDepthBias
-    vec4 fogColor;
-    vec4 fogParams;
-    mat4 skyProj;
-    Light lights[10];
-} ubo;
-
-layout(set = 0, binding = 2) uniform sampler2DArrayShadow shadowMap;
-
-const float PI = 3.14159265359;
-
-float ShadowCalculation(vec3 fragPosWorldSpace, vec3 N, vec3 lightDir) {
-    // Standard Normal Offset Bias for PCF smoothing (Dynamically Configured)
-    float NdotL = max(dot(N, lightDir), 0.0);
-    float normalBias = max(ubo.shadowBiases.x * (1.0 - NdotL), ubo.shadowBiases.x * 0.1);
-    vec3 offsetPos = fragPosWorldSpace + N * normalBias;
-
-    vec4 viewPos = ubo.view * vec4(offsetPos, 1.0);
-    float depth = abs(viewPos.z);
-    
-    int layer = -1;
-    for(int i = 0; i < 4; ++i) {
-        if(depth < ubo.shadowSplitDepths[i]) {
-            layer = i;
-            break;
-        }
-    }
-    if (layer == -1) layer = 3;
-
-    vec4 fragPosLightSpace = ubo.shadowCascades[layer] * vec4(offsetPos, 1.0);
-    vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w;
-    projCoords.xy = projCoords.xy * 0.5 + 0.5;
-    
-    if(projCoords.z > 1.0 || projCoords.z < 0.0 || projCoords.x < 0.0 || projCoords.x > 1.0 || projCoords.y < 0.0 || projCoords.y > 1.0)
-        return 1.0; 
-
-    // Standard Depth bias (Dynamically Configured)
-    float bias = max(ubo.shadowBiases.y * (1.0 - NdotL), ubo.shadowBiases.y * 0.2);
-    
-    float shadow = 0.0;
-    vec2 texelSize = 1.0 / textureSize(shadowMap, 0).xy;
-    for(int x = -1; x <= 1; ++x) {
-        for(int y = -1; y <= 1; ++y) {
-            shadow += texture(shadowMap, vec4(projCoords.xy + vec2(x,y)*texelSize, layer, projCoords.z - bias));
-        }
-    }
-    return shadow / 9.0;
-}
-
-float DistributionGGX(vec3 N, vec3 H, float roughness) {
-    float a = roughness * roughness;
-    float a2 = a * a;
-    float NdotH = max(dot(N, H), 0.0);
-    float NdotH2 = NdotH * NdotH;
-    float num = a2;
-    float denom = (NdotH2 * (a2 - 1.0) + 1.0);
-    denom = PI * denom * denom;
-    return num / denom;
-}
-
-float GeometrySchlickGGX(float NdotV, float roughness) {
-    float r = (roughness + 1.0);
-    float k = (r * r) / 8.0;
-    float num = NdotV;
-    float denom = NdotV * (1.0 - k) + k;
-    return num / denom;
-}
-
-float GeometrySmith(vec3 N, vec3 V, vec3 L, float roughness) {
-    float NdotV = max(dot(N, V), 0.0);
-    float NdotL = max(dot(N, L), 0.0);
-    float ggx2 = GeometrySchlickGGX(NdotV, roughness);
-    float ggx1 = GeometrySchlickGGX(NdotL, roughness);
-    return ggx1 * ggx2;
-}
-
-vec3 FresnelSchlick(float cosTheta, vec3 F0) {
-    return F0 + (1.0 - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
-}
-
-vec3 calculatePBR(vec3 L, vec3 V, vec3 N, vec3 radiance, vec3 albedo, float metallic, float roughness, vec3 F0) {
-    vec3 H = normalize(V + L);
-    float NDF = DistributionGGX(N, H, roughness);
-    float G = GeometrySmith(N, V, L, roughness);
-    vec3 F = FresnelSchlick(max(dot(H, V), 0.0), F0);
-
-    vec3 kS = F;
-    vec3 kD = vec3(1.0) - kS;
-    kD *= 1.0 - metallic;
-
-    vec3 numerator = NDF * G * F;
-    float denominator = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 0.0001;
-    vec3 specular = numerator / denominator;
-
-    float NdotL = max(dot(N, L), 0.0);
-    return (kD * albedo / PI + specular) * radiance * NdotL;
-}
-
-void main() {
-    vec3 fColor = (length(fragColor) < 0.01) ? vec3(1.0) : fragColor;
-    vec3 mColor = (length(mat.baseColorFactor.rgb) < 0.01) ? vec3(1.0) : mat.baseColorFactor.rgb;
-    vec3 albedo = texture(albedoMap, fragUV).rgb * mColor * fColor;
-    
-    vec3 orm = texture(ormMap, fragUV).rgb;
-    float ao = mix(1.0, orm.r, mat.occlusionStrength);
-    float roughness = mix(0.5, orm.g, mat.roughnessFactor); // Just in case, standard PBR usually multiplies, but if omitted, it defaults. Wait, roughness is usually multiplied or overridden. Let's keep it as is, just fix AO.
-    float metallic = orm.b * mat.metallicFactor;
-    
-    vec3 emissive = texture(emissiveMap, fragUV).rgb;
-
-    vec3 normalSample = texture(normalMap, fragUV).rgb;
-    vec3 n = normalSample * 2.0 - 1.0;
-    n.xy *= mat.normalScale;
-    vec3 N = normalize(TBN * n);
-    vec3 V = normalize(ubo.camPos.xyz - fragPos);
-
-    vec3 F0 = vec3(0.04);
-    F0 = mix(F0, albedo, metallic);
-
-    vec3 Lo = vec3(0.0);
-    int numLights = int(ubo.globalParams.x);
-    for(int i = 0; i < numLights; ++i) {
-        vec3 L;
-        vec3 radiance;
-        
-        if (ubo.lights[i].position.w < 0.5) { // Directional
-            L = normalize(-ubo.lights[i].direction.xyz);
-            radiance = ubo.lights[i].color.rgb * ubo.lights[i].color.a;
-            
-            // Appliquer l'ombre uniquement sur la lumiere principale directionnelle
-            if (i == 0) {
-                float shadow = ShadowCalculation(fragPos, N, L);
-                radiance *= shadow;
-            }
-        } else { // Point
-            vec3 lightDir = ubo.lights[i].position.xyz - fragPos;
-            float distance = length(lightDir);
-            L = normalize(lightDir);
-            float attenuation = 1.0 / (distance * distance);
-            radiance = ubo.lights[i].color.rgb * ubo.lights[i].color.a * attenuation;
-            
-            if (distance > ubo.lights[i].params.x) radiance *= 0.0;
-        }
-        
-        Lo += calculatePBR(L, V, N, radiance, albedo, metallic, roughness, F0);
-    }
-
-    vec3 ambient = ubo.ambientColor.rgb * ubo.ambientColor.a * albedo * ao; 
-    vec3 color = ambient + Lo + emissive;
-
-    // --- Fog ---
-    float fogType = ubo.fogColor.w;
-    if (fogType > 0.5) {
-        float dist = distance(ubo.camPos.xyz, fragPos);
-        float fogFactor = 0.0;
-        
-        if (fogType < 1.5) { // Linear
-            float fStart = ubo.fogParams.y;
-            float fEnd = ubo.fogParams.z;
-            fogFactor = clamp((dist - fStart) / (fEnd - fStart), 0.0, 1.0);
-        } else { // Exponential
-            float density = ubo.fogParams.x;
-            fogFactor = 1.0 - exp(-dist * density);
-            fogFactor = clamp(fogFactor, 0.0, 1.0);
-        }
-        
-        color = mix(color, ubo.fogColor.rgb, fogFactor);
-    }
-
-    color = color / (color + vec3(1.0));
-    color = pow(color, vec3(1.0/2.2));
-
-    outColor = vec4(color, 1.0);
-}
+#include "pbr_shading.glsl"
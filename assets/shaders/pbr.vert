@@ -1,16 +1,15 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
 
-layout(location = 0) in vec3 inPosition;
-layout(location = 1) in vec3 inNormal;
-layout(location = 2) in vec3 inColor;
-layout(location = 3) in vec2 inUV;
-layout(location = 4) in vec4 inTangent;
+#include "vertex_input.glsl"
+#include "instance_data.glsl"
 
 layout(location = 0) out vec3 fragPos;
 layout(location = 1) out vec3 fragNormal;
 layout(location = 2) out vec2 fragUV;
 layout(location = 3) out mat3 TBN;
 layout(location = 6) out vec3 fragColor;
+layout(location = 7) flat out uint fragMaterial;
 
 layout(set = 0, binding = 0) uniform GlobalUBO {
     mat4 view;
@@ -26,24 +25,24 @@ layout(set = 0, binding = 0) uniform GlobalUBO {
     mat4 skyProj;
 } ubo;
 
-// Nouveau : Buffer de stockage pour l'instancing
-layout(std430, set = 0, binding = 1) readonly buffer InstanceBuffer {
-    mat4 models[];
-} instances;
-
 void main() {
-    mat4 modelMatrix = instances.models[gl_InstanceIndex];
+    InstanceData instance = instances.items[gl_InstanceIndex];
+    mat4 modelMatrix = instanceModel(instance);
     
     vec4 worldPos = modelMatrix * vec4(inPosition, 1.0);
     fragPos = worldPos.xyz;
-    fragNormal = normalize(mat3(modelMatrix) * inNormal);
+    fragNormal = normalize(mat3(modelMatrix) * vertexNormal());
     fragUV = inUV;
-    fragColor = inColor;
+    // Tint of the instance over the vertex color (black = no vertex color, as in pbr_shading)
+    vec3 color = vertexColor();
+    fragColor = (length(color) < 0.01 ? vec3(1.0) : color) * instanceColor(instance).rgb;
+    fragMaterial = instance.materialIndex; // Bindless materials only (ignored by pbr.frag)
 
-    vec3 T = normalize(mat3(modelMatrix) * inTangent.xyz);
+    vec4 tangent = vertexTangent();
+    vec3 T = normalize(mat3(modelMatrix) * tangent.xyz);
     vec3 N = fragNormal;
     T = normalize(T - dot(T, N) * N);
-    vec3 B = cross(N, T) * inTangent.w;
+    vec3 B = cross(N, T) * tangent.w;
     TBN = mat3(T, B, N);
 
     gl_Position = ubo.proj * ubo.view * worldPos;
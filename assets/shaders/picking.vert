@@ -0,0 +1,16 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "instance_data.glsl"
+
+// Position only: the entity ID is pushed per draw and written by picking.frag
+layout(location = 0) in vec3 inPosition;
+
+layout(set = 0, binding = 0) uniform GlobalUBO {
+    mat4 view;
+    mat4 proj;
+} ubo;
+
+void main() {
+    gl_Position = ubo.proj * ubo.view * instanceModel(instances.items[gl_InstanceIndex]) * vec4(inPosition, 1.0);
+}
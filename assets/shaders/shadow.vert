@@ -0,0 +1,15 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "instance_data.glsl"
+
+// Depth only: the pipeline binds the position attribute alone
+layout(location = 0) in vec3 inPosition;
+
+layout(push_constant) uniform PushConstants {
+    mat4 lightVP;
+} pc;
+
+void main() {
+    gl_Position = pc.lightVP * instanceModel(instances.items[gl_InstanceIndex]) * vec4(inPosition, 1.0);
+}
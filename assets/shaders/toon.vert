@@ -0,0 +1,30 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "vertex_input.glsl"
+#include "instance_data.glsl"
+
+// Same output locations as pbr.vert (no tangent frame: toon shading has no normal map)
+layout(location = 0) out vec3 fragPos;
+layout(location = 1) out vec3 fragNormal;
+layout(location = 2) out vec2 fragUV;
+layout(location = 6) out vec3 fragColor;
+
+layout(set = 0, binding = 0) uniform GlobalUBO {
+    mat4 view;
+    mat4 proj;
+} ubo;
+
+void main() {
+    InstanceData instance = instances.items[gl_InstanceIndex];
+    mat4 modelMatrix = instanceModel(instance);
+    vec4 worldPos = modelMatrix * vec4(inPosition, 1.0);
+
+    fragPos = worldPos.xyz;
+    fragNormal = normalize(mat3(modelMatrix) * vertexNormal());
+    fragUV = inUV;
+    vec3 color = vertexColor();
+    fragColor = (length(color) < 0.01 ? vec3(1.0) : color) * instanceColor(instance).rgb;
+
+    gl_Position = ubo.proj * ubo.view * worldPos;
+}
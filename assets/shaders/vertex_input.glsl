@@ -0,0 +1,37 @@
+// Vertex inputs shared by the mesh shaders.
+// The layout of the vertex buffer is selected per mesh (see bb3d::VertexFormat) and the
+// pipeline variant sets VERTEX_FORMAT accordingly:
+//   0 = Full      : float3 normal, float3 color, float4 tangent
+//   1 = StaticLit : octahedral snorm16 normal/tangent, half2 uv, no color (white)
+//   2 = Colored   : StaticLit + unorm8 color
+//   3 = Skinned   : StaticLit + uint8 joints + unorm8 weights, no color (white)
+layout(constant_id = 0) const int VERTEX_FORMAT = 0;
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec4 inNormal;
+layout(location = 2) in vec4 inColor;
+layout(location = 3) in vec2 inUV;
+layout(location = 4) in vec4 inTangent;
+
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+vec3 vertexNormal() {
+    return VERTEX_FORMAT == 0 ? inNormal.xyz : octDecode(inNormal.xy);
+}
+
+// xyz = tangent, w = bitangent sign (stored in the sign of the 2nd octahedral coordinate)
+vec4 vertexTangent() {
+    if (VERTEX_FORMAT == 0) return inTangent;
+    vec2 e = vec2(inTangent.x, abs(inTangent.y) * 2.0 - 1.0);
+    return vec4(octDecode(e), inTangent.y < 0.0 ? -1.0 : 1.0);
+}
+
+vec3 vertexColor() {
+    return (VERTEX_FORMAT == 0 || VERTEX_FORMAT == 2) ? inColor.rgb : vec3(1.0);
+}
@@ -65,6 +65,25 @@ namespace bb3d {
         float shadowDepthBiasConstant = 1.25f;    ///< Constante de biais appliquée au Pipeline Vulkan.
         float shadowDepthBiasSlope = 1.75f;       ///< Pente de biais appliquée au Pipeline Vulkan.
         float shadowShaderDepthBias = 0.0005f;    ///< Biais de profondeur dans le shader.
+        uint32_t shadowCachedCascades = 0;        ///< Cascades lointaines mises en cache : re-rendues seulement si la lumière, leur emprise ou leurs projeteurs changent (0 = aucune).
+
+        bool enableLOD = true;            ///< Sélection automatique du niveau de détail selon la taille projetée à l'écran.
+        float lodBias = 0.0f;             ///< Biais LOD (> 0 : niveaux grossiers plus tôt, < 0 : plus de détails). Chaque unité divise la taille projetée par 2.
+        float lodHysteresis = 0.1f;       ///< Bande morte relative autour des seuils pour éviter le "popping".
+        bool enableClusterCulling = true; ///< Culling par meshlet (frustum + cône de normales) des meshes découpés en clusters.
+        bool enableGPUCulling = false;    ///< Culling des instances opaques par compute shader et draws `vkCmdDrawIndexedIndirectCount`. Ignoré si le GPU ne le supporte pas.
+        bool enableParallelRecording = true; ///< Cascades d'ombres et tranches de la passe principale enregistrées en parallèle (command buffers secondaires) sur le JobSystem.
+        uint32_t instanceBudget = 0;      ///< Budget dur d'instances par frame (0 = illimité) : au-delà, les dernières instances de l'ordre de dessin sont ignorées et un avertissement est loggé une fois.
+
+        bool enableTextureStreaming = false; ///< Textures 2D chargées avec leurs petits mips seulement ; les niveaux fins sont streamés selon la taille à l'écran. La chaîne complète reste en RAM (coût mémoire système ~ VRAM économisée).
+        uint32_t textureBudgetMB = 512;     ///< Budget VRAM des textures streamées : au-delà, les niveaux fins des textures les moins dégradées sont évincés.
+        float textureStreamingBias = 0.0f;  ///< Biais de mip du streaming (> 0 : textures plus floues, < 0 : plus nettes).
+
+        bool enableIBL = true;            ///< Éclairage ambiant par l'image du SkySphere (irradiance SH + spéculaire préfiltré), précalculé et mis en cache.
+        float iblIntensity = 1.0f;        ///< Multiplicateur de l'éclairage ambiant IBL.
+        uint32_t iblSpecularSize = 128;   ///< Taille d'une face du cubemap spéculaire préfiltré (niveau 0).
+
+        bool enableBindlessMaterials = true; ///< Matériaux PBR en bindless (descriptor indexing) : un seul set pour tous, instancing entre matériaux. Ignoré si le GPU ne le supporte pas.
 
         GraphicsConfig& setVsync(bool v) { vsync = v; return *this; }
         GraphicsConfig& setFpsMax(int fps) { fpsMax = fps; return *this; }
@@ -75,9 +94,18 @@ namespace bb3d {
         GraphicsConfig& setMipmapping(bool e) { enableMipmapping = e; return *this; }
         GraphicsConfig& setOffscreenRendering(bool e) { enableOffscreenRendering = e; return *this; }
         GraphicsConfig& setRenderScale(float s) { renderScale = s; return *this; }
+        GraphicsConfig& setLOD(bool e, float bias = 0.0f, float hysteresis = 0.1f) { enableLOD = e; lodBias = bias; lodHysteresis = hysteresis; return *this; }
+        GraphicsConfig& setClusterCulling(bool e) { enableClusterCulling = e; return *this; }
+        GraphicsConfig& setGPUCulling(bool e) { enableGPUCulling = e; return *this; }
+        GraphicsConfig& setParallelRecording(bool e) { enableParallelRecording = e; return *this; }
+        GraphicsConfig& setInstanceBudget(uint32_t maxInstances) { instanceBudget = maxInstances; return *this; }
+        GraphicsConfig& setTextureStreaming(bool e, uint32_t budgetMB = 512, float bias = 0.0f) { enableTextureStreaming = e; textureBudgetMB = budgetMB; textureStreamingBias = bias; return *this; }
+        GraphicsConfig& setIBL(bool e, float intensity = 1.0f, uint32_t specularSize = 128) { enableIBL = e; iblIntensity = intensity; iblSpecularSize = specularSize; return *this; }
+        GraphicsConfig& setBindlessMaterials(bool e) { enableBindlessMaterials = e; return *this; }
         GraphicsConfig& setShadows(bool e, uint32_t res = 2048, uint32_t c = 4, bool pcf = true) { shadowsEnabled = e; shadowMapResolution = res; shadowCascades = c; shadowPCF = pcf; return *this; }
+        GraphicsConfig& setShadowCache(uint32_t cachedCascades) { shadowCachedCascades = cachedCascades; return *this; }
 
-        NLOHMANN_DEFINE_TYPE_INTRUSIVE(GraphicsConfig, vsync, fpsMax, buffering, msaaSamples, anisotropy, shadowMapResolution, enableValidationLayers, enableFrustumCulling, enableMipmapping, enableOffscreenRendering, renderScale, shadowsEnabled, shadowCascades, shadowPCF)
+        NLOHMANN_DEFINE_TYPE_INTRUSIVE(GraphicsConfig, vsync, fpsMax, buffering, msaaSamples, anisotropy, shadowMapResolution, enableValidationLayers, enableFrustumCulling, enableMipmapping, enableOffscreenRendering, renderScale, shadowsEnabled, shadowCascades, shadowPCF, shadowCachedCascades, enableLOD, lodBias, lodHysteresis, enableClusterCulling, enableGPUCulling, enableParallelRecording, instanceBudget, enableTextureStreaming, textureBudgetMB, textureStreamingBias, enableIBL, iblIntensity, iblSpecularSize, enableBindlessMaterials)
     };
 
     /**
@@ -145,11 +173,13 @@ namespace bb3d {
         bool logFile = true;    ///< Active la sortie fichier.
         std::string logDirectory = "logs"; ///< Log storage directory (relative to executable CWD: build/bin/logs).
         std::string logFileName = "engine.log"; ///< Nom du fichier de log.
+        std::string cacheDirectory = "cache"; ///< Données dérivées recalculables (ex : IBL précalculé), relatif au CWD.
 
         SystemConfig& setMaxThreads(int t) { maxThreads = t; return *this; }
         SystemConfig& setAssetPath(std::string_view p) { assetPath = p; return *this; }
+        SystemConfig& setCacheDirectory(std::string_view p) { cacheDirectory = p; return *this; }
 
-        NLOHMANN_DEFINE_TYPE_INTRUSIVE(SystemConfig, maxThreads, assetPath, logLevel, logConsole, logFile, logDirectory, logFileName)
+        NLOHMANN_DEFINE_TYPE_INTRUSIVE(SystemConfig, maxThreads, assetPath, logLevel, logConsole, logFile, logDirectory, logFileName, cacheDirectory)
     };
 
     /**
@@ -177,6 +207,12 @@ namespace bb3d {
         EngineConfig& enableEditor(bool e) { modules.setEditor(e); return *this; }
         EngineConfig& enablePicking(PickingMode m) { modules.setPicking(m); return *this; }
         EngineConfig& renderScale(float s) { graphics.setRenderScale(s); return *this; }
+        EngineConfig& lodBias(float b) { graphics.lodBias = b; return *this; }
+        EngineConfig& clusterCulling(bool e) { graphics.setClusterCulling(e); return *this; }
+        EngineConfig& gpuCulling(bool e) { graphics.setGPUCulling(e); return *this; }
+        EngineConfig& parallelRecording(bool e) { graphics.setParallelRecording(e); return *this; }
+        EngineConfig& instanceBudget(uint32_t maxInstances) { graphics.setInstanceBudget(maxInstances); return *this; }
+        EngineConfig& textureStreaming(bool e, uint32_t budgetMB = 512) { graphics.setTextureStreaming(e, budgetMB); return *this; }
         EngineConfig& frontFace(std::string_view f) { rasterizer.frontFace = f; return *this; } // "CW" ou "CCW"
 
         /// @name Layout Locations par défaut pour les Shaders
@@ -0,0 +1,46 @@
+#pragma once
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BB_FLOAT4_SSE 1
+#endif
+
+namespace bb3d {
+
+/**
+ * @brief Four packed floats (one SSE register when available, plain floats otherwise).
+ *
+ * Used by the CPU image kernels (mip filters, IBL bake) to process a whole RGBA texel
+ * per operation. Only the operations these kernels need are provided.
+ */
+#ifdef BB_FLOAT4_SSE
+struct Float4 {
+    __m128 v;
+    static Float4 zero() { return { _mm_setzero_ps() }; }
+    static Float4 splat(float s) { return { _mm_set1_ps(s) }; }
+    static Float4 set(float x, float y, float z, float w) { return { _mm_setr_ps(x, y, z, w) }; }
+    static Float4 load(const float* p) { return { _mm_loadu_ps(p) }; }
+    void store(float* out) const { _mm_storeu_ps(out, v); }
+    Float4 operator+(Float4 o) const { return { _mm_add_ps(v, o.v) }; }
+    Float4 operator-(Float4 o) const { return { _mm_sub_ps(v, o.v) }; }
+    Float4 operator*(Float4 o) const { return { _mm_mul_ps(v, o.v) }; }
+    Float4 operator*(float s) const { return { _mm_mul_ps(v, _mm_set1_ps(s)) }; }
+    Float4& operator+=(Float4 o) { v = _mm_add_ps(v, o.v); return *this; }
+};
+#else
+struct alignas(16) Float4 {
+    float v[4];
+    static Float4 zero() { return { { 0.0f, 0.0f, 0.0f, 0.0f } }; }
+    static Float4 splat(float s) { return { { s, s, s, s } }; }
+    static Float4 set(float x, float y, float z, float w) { return { { x, y, z, w } }; }
+    static Float4 load(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+    void store(float* out) const { for (int i = 0; i < 4; ++i) out[i] = v[i]; }
+    Float4 operator+(Float4 o) const { return { { v[0] + o.v[0], v[1] + o.v[1], v[2] + o.v[2], v[3] + o.v[3] } }; }
+    Float4 operator-(Float4 o) const { return { { v[0] - o.v[0], v[1] - o.v[1], v[2] - o.v[2], v[3] - o.v[3] } }; }
+    Float4 operator*(Float4 o) const { return { { v[0] * o.v[0], v[1] * o.v[1], v[2] * o.v[2], v[3] * o.v[3] } }; }
+    Float4 operator*(float s) const { return { { v[0] * s, v[1] * s, v[2] * s, v[3] * s } }; }
+    Float4& operator+=(Float4 o) { *this = *this + o; return *this; }
+};
+#endif
+
+} // namespace bb3d
@@ -64,7 +64,7 @@ public:
             }
         };
 
-        pushInternal(std::move(wrappedJob));
+        pushInternal(std::move(wrappedJob), counter.get());
     }
 
     /**
@@ -97,13 +97,16 @@ public:
 
     /**
      * @brief Attend qu'un compteur atteigne 0.
-     * @note Le thread appelant aide à exécuter les jobs en attente durant le wait.
+     * @note Le thread appelant aide à exécuter les jobs en attente durant le wait, mais seulement ceux
+     * de ce compteur : un job étranger pourrait reprendre un verrou déjà tenu par l'appelant (ex: chargement
+     * d'une autre texture pendant la génération des mips d'une texture en cours de chargement).
      */
     void wait(const JobCounter& counter);
 
 private:
     struct Job {
         std::function<void(std::stop_token)> task;
+        const std::atomic<int>* counter = nullptr; ///< Identifie le groupe du job pour `wait()`.
     };
 
 #ifdef _MSC_VER
@@ -119,8 +122,10 @@ private:
 #endif
 
     void workerLoop(uint32_t threadIndex, std::stop_token st);
-    void pushInternal(std::function<void(std::stop_token)>&& job);
+    void pushInternal(std::function<void(std::stop_token)>&& job, const std::atomic<int>* counter);
     bool popJob(Job& outJob, uint32_t threadIndex);
+    /** @brief Retire un job en attente du groupe `counter`, depuis n'importe quelle queue. */
+    bool popJobOf(Job& outJob, const std::atomic<int>* counter);
 
     std::vector<std::jthread> m_workers;
     std::vector<std::unique_ptr<WorkerQueue>> m_queues; 
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <limits>
+
+namespace bb3d {
+
+/** @brief Axis-Aligned Bounding Box (AABB). */
+struct AABB {
+    glm::vec3 min{std::numeric_limits<float>::max()}; ///< Minimum corner (x, y, z).
+    glm::vec3 max{std::numeric_limits<float>::lowest()}; ///< Maximum corner (x, y, z).
+
+    /** @brief Extends the box to include a new point. */
+    void extend(const glm::vec3& point) {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+    
+    /** @brief Extends the box to include another AABB. */
+    void extend(const AABB& other) {
+        min = glm::min(min, other.min);
+        max = glm::max(max, other.max);
+    }
+
+    [[nodiscard]] inline glm::vec3 center() const { return (min + max) * 0.5f; }
+    [[nodiscard]] inline glm::vec3 size() const { return max - min; }
+
+    /** @brief Calculates a new AABB after transformation by a matrix. */
+    [[nodiscard]] inline AABB transform(const glm::mat4& m) const {
+        glm::vec3 newMin = m[3];
+        glm::vec3 newMax = m[3];
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                float a = m[j][i] * min[j];
+                float b = m[j][i] * max[j];
+                if (a < b) {
+                    newMin[i] += a; newMax[i] += b;
+                } else {
+                    newMin[i] += b; newMax[i] += a;
+                }
+            }
+        }
+        return {newMin, newMax};
+    }
+};
+
+} // namespace bb3d
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "bb3d/core/Base.hpp"
+#include "bb3d/render/Buffer.hpp"
+#include "bb3d/render/SlotAllocator.hpp"
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.hpp>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace bb3d {
+
+class VulkanContext; // Forward declaration
+class Texture;
+
+/** @brief Parameters of one material as read by the bindless PBR shader (std430, 48 bytes). */
+struct GPUMaterial {
+    glm::vec4 baseColorFactor = { 1.0f, 1.0f, 1.0f, 1.0f };
+    glm::vec4 factors = { 1.0f, 1.0f, 1.0f, 1.0f }; ///< metallic, roughness, normal scale, occlusion strength.
+    glm::uvec4 textures = { 0, 0, 0, 0 };           ///< Slots of the albedo, normal, ORM and emissive maps.
+};
+static_assert(sizeof(GPUMaterial) == 48, "GPUMaterial must match the std430 layout of MaterialRecord");
+
+/**
+ * @brief Descriptor set shared by every bindless material (set 1 of the bindless PBR pipeline).
+ *
+ * Binding 0 is a storage buffer of `GPUMaterial` records, indexed per instance;
+ * binding 1 is one large array of sampled textures, indexed by the records.
+ * Materials register their textures (one slot per texture, reference counted)
+ * and their parameters here instead of allocating their own sets, so draws of
+ * different materials on the same mesh end up in one instanced call.
+ *
+ * CPU changes are recorded immediately and pushed to the set and buffer of a
+ * frame by `update()`, once the fence of that frame has been waited for. Freed
+ * slots are recycled only after every frame in flight is done with them; the
+ * texture array is partially bound, so stale entries are never read.
+ */
+class BindlessMaterials {
+public:
+    static constexpr uint32_t MaxTextures = 4096;
+    static constexpr uint32_t MaxMaterials = 4096;
+
+    explicit BindlessMaterials(VulkanContext& context);
+    ~BindlessMaterials();
+
+    BindlessMaterials(const BindlessMaterials&) = delete;
+    BindlessMaterials& operator=(const BindlessMaterials&) = delete;
+
+    /**
+     * @brief Slot of `texture` in the array, registered on first use (the texture must be ready).
+     * @return Nothing if the array is full.
+     */
+    std::optional<uint32_t> acquireTexture(const Ref<Texture>& texture);
+    /** @brief Drops one reference taken by `acquireTexture`. */
+    void releaseTexture(uint32_t slot);
+
+    /** @brief Reserves a material record (nothing if the buffer is full). */
+    std::optional<uint32_t> allocateMaterial();
+    void releaseMaterial(uint32_t index);
+    void setMaterial(uint32_t index, const GPUMaterial& material);
+
+    /**
+     * @brief Writes the pending texture descriptors and material records of `frame`,
+     * and follows the streamed textures that replaced their image view.
+     * @note Call once per frame, after the fence of `frame`.
+     */
+    void update(uint32_t frame);
+
+    [[nodiscard]] vk::DescriptorSetLayout getLayout() const { return m_layout; }
+    [[nodiscard]] vk::DescriptorSet getDescriptorSet(uint32_t frame) const { return m_sets[frame]; }
+    [[nodiscard]] uint32_t getTextureCapacity() const { return m_textureAllocator.getCapacity(); }
+    [[nodiscard]] uint32_t getTextureCount() const { return m_textureAllocator.getUsed(); }
+    [[nodiscard]] uint32_t getMaterialCount() const { return m_materialAllocator.getUsed(); }
+
+private:
+    struct TextureSlot {
+        Ref<Texture> texture; ///< Kept until the slot is recycled (frames in flight may still sample it).
+        uint32_t references = 0;
+        uint32_t residencyVersion = 0;
+    };
+
+    void markTexture(uint32_t slot);
+
+    VulkanContext& m_context;
+    vk::DescriptorSetLayout m_layout;
+    vk::DescriptorPool m_pool;
+    // One entry per frame in flight (Renderer::MAX_FRAMES_IN_FLIGHT)
+    std::vector<vk::DescriptorSet> m_sets;
+    std::vector<Scope<Buffer>> m_materialBuffers;
+
+    std::mutex m_mutex; ///< Materials can be released from any thread.
+    SlotAllocator m_textureAllocator;
+    SlotAllocator m_materialAllocator;
+    std::vector<TextureSlot> m_textures;                       ///< By slot.
+    std::unordered_map<const Texture*, uint32_t> m_textureSlots;
+    std::vector<GPUMaterial> m_materials;                      ///< By record index.
+    std::vector<std::vector<uint32_t>> m_pendingTextures;  ///< By frame.
+    std::vector<std::vector<uint32_t>> m_pendingMaterials; ///< By frame.
+    std::vector<uint32_t> m_recycled;
+    bool m_warnedFull = false;
+};
+
+} // namespace bb3d
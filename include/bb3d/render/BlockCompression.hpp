@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace bb3d {
+
+/** @brief GPU block-compressed formats produced by the texture cooker (4x4 texel blocks). */
+enum class BlockFormat : uint8_t {
+    BC1, ///< RGB + 1-bit alpha, 8 bytes per block (opaque albedo).
+    BC3, ///< BC1 color + interpolated alpha, 16 bytes per block.
+    BC4, ///< Single channel (R), 8 bytes per block (roughness, AO, masks).
+    BC5, ///< Two channels (RG), 16 bytes per block (tangent-space normal maps).
+    BC7  ///< High quality RGBA, 16 bytes per block (albedo, packed maps).
+};
+
+/**
+ * @brief CPU encoders/decoders for the BCn formats, without any GPU or third-party dependency.
+ *
+ * The encoders favour predictable quality over speed: principal-axis endpoints refined by
+ * least squares (BC1/BC7), min/max ramps (BC4/BC5). BC7 only emits mode 6 (single subset,
+ * RGBA, 4-bit indices), which every BC7 decoder accepts; the decoder only reads mode 6 back.
+ * Blocks are 4x4 RGBA8 texels in row-major order (64 bytes).
+ */
+namespace BlockCompression {
+
+    /** @brief Size of one compressed 4x4 block in bytes (8 or 16). */
+    uint32_t blockBytes(BlockFormat format);
+
+    /** @brief Size of a compressed image of `width` x `height` texels (partial blocks are padded). */
+    size_t compressedSize(BlockFormat format, uint32_t width, uint32_t height);
+
+    /** @brief Encodes one 4x4 RGBA8 block. */
+    void encodeBlock(BlockFormat format, const uint8_t rgba[64], uint8_t* out);
+
+    /** @brief Decodes one block to RGBA8 (BC4: R,R,R,255; BC5: R,G,0,255). False for unsupported BC7 modes. */
+    bool decodeBlock(BlockFormat format, const uint8_t* block, uint8_t rgba[64]);
+
+    /** @brief Compresses a tightly packed RGBA8 image (edge texels are replicated into partial blocks). */
+    std::vector<uint8_t> compress(BlockFormat format, const uint8_t* rgba, uint32_t width, uint32_t height);
+
+} // namespace BlockCompression
+
+} // namespace bb3d
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "bb3d/render/Meshlet.hpp"
+#include <glm/glm.hpp>
+#include <array>
+#include <vector>
+#include <cstdint>
+
+namespace bb3d {
+
+/** @brief Counters filled by the cluster culler. */
+struct ClusterCullStats {
+    uint32_t tested = 0;          ///< Clusters tested.
+    uint32_t frustumCulled = 0;   ///< Clusters rejected by the frustum planes.
+    uint32_t backfaceCulled = 0;  ///< Clusters rejected by their normal cone.
+    uint32_t visible = 0;         ///< Clusters emitted as draw commands.
+    uint64_t trianglesVisible = 0;
+
+    void add(const ClusterCullStats& o) {
+        tested += o.tested; frustumCulled += o.frustumCulled; backfaceCulled += o.backfaceCulled;
+        visible += o.visible; trianglesVisible += o.trianglesVisible;
+    }
+};
+
+/**
+ * @brief CPU culling of meshlets (frustum + backface cone).
+ *
+ * Works entirely in the object space of the mesh: the caller provides the
+ * frustum planes and the camera position transformed by the inverse model
+ * matrix (see `toObjectSpace`). No Vulkan object is involved, so the culler can
+ * be benchmarked on machines without a GPU.
+ *
+ * Surviving clusters are appended as `IndexedDrawCommand` (layout of
+ * `VkDrawIndexedIndirectCommand`), ready to be copied into an `IndirectBuffer`.
+ */
+class ClusterCuller {
+public:
+    /** @brief Frustum planes and camera position expressed in the object space of one instance. */
+    struct View {
+        std::array<glm::vec4, 6> planes; ///< Normalized planes (xyz = normal, w = distance).
+        glm::vec3 cameraPosition{0.0f};
+        bool backfaceCulling = true;     ///< Disable for double-sided geometry or orthographic views.
+    };
+
+    /**
+     * @brief Transforms world-space frustum planes and camera into the object space of a model matrix.
+     * @param worldPlanes Normalized world-space planes (e.g. `Frustum::getPlanes()`).
+     * @param cameraPosition World-space camera position.
+     * @param model Model matrix of the instance.
+     */
+    static View toObjectSpace(const std::array<glm::vec4, 6>& worldPlanes, const glm::vec3& cameraPosition, const glm::mat4& model);
+
+    /**
+     * @brief Culls the meshlets of one instance and appends one draw per visible cluster.
+     * @param meshlets Meshlet decomposition of the mesh.
+     * @param view Object-space view (see `toObjectSpace`).
+     * @param firstInstance Instance index written in the draw commands.
+     * @param out Destination list (appended).
+     * @param stats Optional counters (accumulated).
+     * @return Number of draw commands appended.
+     */
+    static uint32_t cull(const MeshletData& meshlets, const View& view, uint32_t firstInstance,
+                         std::vector<IndexedDrawCommand>& out, ClusterCullStats* stats = nullptr);
+};
+
+} // namespace bb3d
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+namespace bb3d {
+
+/** @brief Draw positions `[begin, end)` recorded by one task. */
+struct DrawRange {
+    uint32_t begin = 0;
+    uint32_t end = 0;
+};
+
+/**
+ * @brief Splitting of the sorted draw list among parallel recording tasks.
+ *
+ * Each range goes to its own secondary command buffer, executed in order by the
+ * primary, so the ranges are contiguous and cover every position. A range holds at
+ * least `minDraws` positions (fewer ranges otherwise) and never cuts a span that
+ * must be recorded at once, such as a GPU-culled group drawn by a single
+ * indirect-count call: the cut moves to the end of the span.
+ */
+class DrawPartition {
+public:
+    /**
+     * @param drawCount Number of draw positions.
+     * @param minDraws Smallest range worth a command buffer.
+     * @param maxRanges Upper bound on the number of ranges (at least 1).
+     * @param spans Sorted, disjoint spans of positions that stay in one range.
+     * @param out Non-empty ranges, or a single (possibly empty) range when there is nothing to split.
+     */
+    static void split(uint32_t drawCount, uint32_t minDraws, uint32_t maxRanges, const std::vector<DrawRange>& spans, std::vector<DrawRange>& out);
+};
+
+} // namespace bb3d
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace bb3d {
+
+/** @brief Packed sort key of one draw and the index of its command in the unsorted list. */
+struct DrawKey {
+    uint64_t key = 0;
+    uint32_t index = 0;
+};
+
+/**
+ * @brief Draw ordering with 64-bit keys sorted by radix.
+ *
+ * The renderer sorts small (key, index) pairs instead of the commands themselves,
+ * then reads the commands through the sorted indices. Key layout, high bits first:
+ *
+ * - Opaque:      `0 | type:4 | format:3 | material:16 | mesh:16 | lod:3 | hidden:1 | depth:16`
+ * - Translucent: `1 | type:4 | ~depth:16 | format:3 | material:16 | mesh:16 | lod:3 | hidden:1`
+ *
+ * Opaque draws group by state and go front to back inside a batch (early depth
+ * rejection). Translucent draws come after every opaque draw and go back to front
+ * within their pipeline. Hidden (shadow-only) instances close their batch.
+ *
+ * Vulkan-free: the material and mesh fields are small per-frame IDs given by the caller.
+ */
+namespace DrawSort {
+
+    /** @brief Fields packed into a key; out-of-range values are truncated to their bit width. */
+    struct KeyFields {
+        uint32_t type = 0;      ///< Pipeline (material type).
+        uint32_t format = 0;    ///< Vertex format.
+        uint32_t material = 0;  ///< Material ID (0 when materials do not break batches).
+        uint32_t mesh = 0;      ///< Mesh ID.
+        uint32_t lod = 0;
+        bool hidden = false;      ///< Outside the camera frustum (shadow pass only).
+        bool translucent = false; ///< Alpha blended: ordered back to front.
+        float depth = 0.0f;       ///< Distance to the camera divided by the far plane, clamped to [0, 1].
+    };
+
+    /** @brief Depth in [0, 1] on 16 bits. */
+    [[nodiscard]] uint32_t quantizeDepth(float depth);
+
+    [[nodiscard]] uint64_t makeKey(const KeyFields& fields);
+
+    /** @brief True for keys built with `translucent` (their draws must keep the key order). */
+    [[nodiscard]] inline bool isTranslucent(uint64_t key) { return (key >> 63) != 0; }
+
+    /**
+     * @brief Stable LSD radix sort on the keys (8 bits per pass).
+     * Passes whose byte is the same in every key are skipped.
+     * @param scratch Reused between calls to avoid allocations.
+     */
+    void radixSort(std::vector<DrawKey>& keys, std::vector<DrawKey>& scratch);
+
+} // namespace DrawSort
+
+} // namespace bb3d
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "bb3d/core/Base.hpp"
+#include "bb3d/core/JobSystem.hpp"
+#include "bb3d/render/IBLBaker.hpp"
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace bb3d {
+
+class VulkanContext; // Forward declaration
+class Texture;
+struct EngineConfig;
+
+/**
+ * @brief Image-based ambient lighting of the scene, derived from its SkySphere.
+ *
+ * When the sky image changes, its HDR data is read again (`stbi_loadf`: float precision for
+ * `.hdr`, linearized for 8-bit files) and baked by `IBLBaker` on the JobSystem, off the render
+ * thread. Results are cached under `SystemConfig::cacheDirectory/ibl`, keyed by a hash of the
+ * file contents and of the bake settings: reloading the same sky only reads the cache file.
+ * Until a bake is installed the renderer keeps its flat ambient color.
+ *
+ * The split-sum BRDF table does not depend on the environment: it is baked (or read from the
+ * cache) once, at construction.
+ */
+class EnvironmentLighting {
+public:
+    EnvironmentLighting(VulkanContext& context, JobSystem& jobs, const EngineConfig& config);
+    ~EnvironmentLighting();
+
+    EnvironmentLighting(const EnvironmentLighting&) = delete;
+    EnvironmentLighting& operator=(const EnvironmentLighting&) = delete;
+
+    /**
+     * @brief Follows the sky image (empty path = no environment): starts a bake when it
+     * changes and installs finished ones. Render thread, once per frame.
+     */
+    void update(const std::string& assetPath, bool flipY);
+
+    /** @brief True once the environment of the current sky is installed. */
+    [[nodiscard]] bool isActive() const { return m_active; }
+    [[nodiscard]] const SHCoefficients& getIrradiance() const { return m_irradiance; }
+    /** @brief Prefiltered radiance cubemap (a black 1x1 cube while inactive). */
+    [[nodiscard]] const Ref<Texture>& getSpecular() const { return m_specular; }
+    [[nodiscard]] const Ref<Texture>& getBRDFTable() const { return m_brdfTable; }
+    /** @brief Level of the fully rough reflections (roughness 1). */
+    [[nodiscard]] float getSpecularMaxLod() const { return m_specularMaxLod; }
+    /** @brief Changes each time the textures are replaced (descriptors must be rewritten). */
+    [[nodiscard]] uint32_t getVersion() const { return m_version; }
+
+private:
+    struct Bake {
+        std::string source;
+        bool flipY = false;
+        std::atomic<bool> done{ false };
+        std::optional<BakedEnvironment> result;
+        bool fromCache = false;
+        double milliseconds = 0.0;
+    };
+
+    /** @brief Loads or bakes `bake.source` (JobSystem worker). */
+    static void run(Bake& bake, const IBLBakeSettings& settings, const std::filesystem::path& cacheDirectory, JobSystem& jobs);
+    void install(BakedEnvironment&& environment);
+    void clear();
+
+    VulkanContext& m_context;
+    JobSystem& m_jobs;
+    bool m_enabled = true;
+    IBLBakeSettings m_settings;
+    std::filesystem::path m_cacheDirectory;
+
+    std::string m_source; ///< Sky of the last `update()`.
+    bool m_flipY = false;
+    std::shared_ptr<Bake> m_pending;
+    JobCounter m_inFlight; ///< Bakes still running (including abandoned ones), waited for on destruction.
+
+    bool m_active = false;
+    SHCoefficients m_irradiance{};
+    Ref<Texture> m_specular;
+    Ref<Texture> m_blackCube;
+    Ref<Texture> m_brdfTable;
+    float m_specularMaxLod = 0.0f;
+    uint32_t m_version = 0;
+};
+
+} // namespace bb3d
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "bb3d/render/Buffer.hpp"
+#include "bb3d/render/RangeAllocator.hpp"
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace bb3d {
+
+class VulkanContext; // Forward declaration
+
+/**
+ * @brief Shared device-local vertex and index buffers, suballocated by every mesh.
+ *
+ * Instead of two dedicated VMA buffers per mesh, meshes own *handles* to ranges
+ * of two large buffers. The renderer binds the pool buffers once and draws with
+ * `vertexOffset` / `firstIndex`, which is also what multi-draw-indirect needs.
+ *
+ * - Vertex ranges are aligned on the vertex stride (exact `vertexOffset` for
+ *   every `VertexFormat`), index ranges on the index size.
+ * - A full pool grows (new buffer + GPU copy, rare); the old buffer is retired
+ *   like a released range.
+ * - Releases are deferred by `Renderer::MAX_FRAMES_IN_FLIGHT` calls to `nextFrame()`
+ *   so that recorded frames never read a recycled range. `update()` writes a new
+ *   range and retires the old one the same way.
+ * - `defragment()` packs all live ranges (offsets behind handles are updated).
+ */
+class GeometryPool {
+public:
+    using Handle = uint32_t;
+    static constexpr Handle InvalidHandle = 0xFFFFFFFFu;
+
+    /** @brief Occupation of the pool (bytes). */
+    struct Stats {
+        uint64_t vertexUsed = 0;
+        uint64_t vertexCapacity = 0;
+        uint64_t indexUsed = 0;
+        uint64_t indexCapacity = 0;
+        uint32_t allocations = 0;
+        float fragmentation = 0.0f; ///< Worst of the two buffers (see RangeAllocator::getFragmentation).
+    };
+
+    GeometryPool(VulkanContext& context, vk::DeviceSize vertexCapacity = 64ull * 1024 * 1024, vk::DeviceSize indexCapacity = 32ull * 1024 * 1024);
+    ~GeometryPool();
+
+    GeometryPool(const GeometryPool&) = delete;
+    GeometryPool& operator=(const GeometryPool&) = delete;
+
+    /** @brief Uploads vertices (`size` bytes, `stride` bytes per vertex) and returns their range. */
+    Handle allocateVertices(const void* data, vk::DeviceSize size, uint32_t stride);
+
+    /** @brief Uploads indices (`indexSize` = 2 or 4 bytes) and returns their range. */
+    Handle allocateIndices(const void* data, vk::DeviceSize size, uint32_t indexSize);
+
+    /**
+     * @brief Replaces the content of a range (same size or smaller).
+     * The data goes to a fresh range behind the same handle: frames in flight keep reading the old one until it is retired.
+     */
+    void update(Handle handle, const void* data, vk::DeviceSize size);
+
+    /** @brief Releases a range once the frames that may still read it are finished. */
+    void free(Handle handle);
+
+    /** @brief Advances the frame counter and recycles the ranges that are no longer in flight. */
+    void nextFrame();
+
+    /** @brief Packs every live range (waits for the device). Call between frames. */
+    void defragment();
+
+    /** @brief First vertex of a vertex range (`vertexOffset` of the draw, 0 for an invalid handle). */
+    [[nodiscard]] int32_t getVertexOffset(Handle handle) const;
+
+    /** @brief First index of an index range (`firstIndex` of the draw, 0 for an invalid handle). */
+    [[nodiscard]] uint32_t getFirstIndex(Handle handle) const;
+
+    /** @brief Size in bytes of a range. */
+    [[nodiscard]] vk::DeviceSize getSize(Handle handle) const;
+
+    [[nodiscard]] vk::Buffer getVertexBuffer() const { return m_vertexBuffer->getHandle(); }
+    [[nodiscard]] vk::Buffer getIndexBuffer() const { return m_indexBuffer->getHandle(); }
+
+    /** @brief Binds the shared vertex buffer and the index buffer with the given index type. */
+    void bind(vk::CommandBuffer commandBuffer, vk::IndexType indexType) const;
+
+    [[nodiscard]] Stats getStats() const;
+
+private:
+    enum class Region : uint8_t { Vertex, Index };
+
+    struct Slot {
+        Region region = Region::Vertex;
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        uint32_t elementSize = 1;
+        bool live = false;
+    };
+
+    /** @brief A released range, recycled `Renderer::MAX_FRAMES_IN_FLIGHT` frames after `frame`. */
+    struct PendingFree {
+        Region region = Region::Vertex;
+        uint64_t offset = 0;
+        Handle handle = InvalidHandle; ///< Slot released with the range (InvalidHandle for a range replaced by `update()`).
+        uint64_t frame = 0;
+    };
+
+    Handle allocate(Region region, const void* data, vk::DeviceSize size, uint32_t elementSize);
+    uint64_t allocateRangeLocked(Region region, vk::DeviceSize size, uint32_t elementSize);
+    void growLocked(Region region, vk::DeviceSize minFree);
+    void upload(vk::Buffer dst, vk::DeviceSize offset, const void* data, vk::DeviceSize size);
+    void releaseLocked(const PendingFree& pending);
+    Scope<Buffer> createBuffer(Region region, vk::DeviceSize size) const;
+
+    VulkanContext& m_context;
+    Scope<Buffer> m_vertexBuffer;
+    Scope<Buffer> m_indexBuffer;
+    RangeAllocator m_vertexRanges;
+    RangeAllocator m_indexRanges;
+
+    std::deque<Slot> m_slots;
+    std::vector<Handle> m_freeSlots;
+    std::vector<PendingFree> m_pendingFrees;
+    std::vector<std::pair<Scope<Buffer>, uint64_t>> m_retiredBuffers; ///< Buffers replaced by a growth + frame.
+    uint64_t m_frame = 0;
+    mutable std::mutex m_mutex;
+};
+
+} // namespace bb3d
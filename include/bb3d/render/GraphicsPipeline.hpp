@@ -3,6 +3,8 @@
 #include "bb3d/render/Shader.hpp"
 #include "bb3d/render/SwapChain.hpp"
 #include "bb3d/core/Config.hpp"
+#include "bb3d/render/VertexPacking.hpp"
+#include <array>
 
 namespace bb3d {
 enum class BlendMode { Opaque, Alpha, Additive };
@@ -42,7 +44,16 @@ public:
 
     void bind(vk::CommandBuffer commandBuffer);
 
+    /** @brief Binds the variant matching the vertex buffer layout of a mesh. */
+    void bind(vk::CommandBuffer commandBuffer, VertexFormat format);
+
     [[nodiscard]] inline vk::Pipeline getHandle() const { return m_pipeline; }
+    [[nodiscard]] vk::Pipeline getHandle(VertexFormat format) const;
+
+    /** @brief True if a variant exists for `format` (shaders decoding VERTEX_FORMAT, or reading only the position). */
+    [[nodiscard]] bool supportsVertexFormat(VertexFormat format) const {
+        return static_cast<uint32_t>(format) < VertexFormatCount && m_variants[static_cast<uint32_t>(format)];
+    }
     [[nodiscard]] inline vk::PipelineLayout getLayout() const { return m_pipelineLayout; }
 
 private:
@@ -60,7 +71,8 @@ private:
     vk::Format m_depthFormat;
 
     vk::PipelineLayout m_pipelineLayout;
-    vk::Pipeline m_pipeline;
+    vk::Pipeline m_pipeline; ///< Variant for VertexFormat::Full.
+    std::array<vk::Pipeline, VertexFormatCount> m_variants{};
 };
 
 } // namespace bb3d
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "bb3d/render/KTX2.hpp"
+#include <glm/glm.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace bb3d {
+
+class JobSystem; // Forward declaration
+
+/** @brief Linear HDR image in memory: RGBA float texels, top row first. */
+struct HDRImage {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<float> texels;
+};
+
+/** @brief Resolution and sample counts of an IBL bake (all of them are part of the cache key). */
+struct IBLBakeSettings {
+    uint32_t specularSize = 128;   ///< Face size of level 0 of the prefiltered cubemap.
+    uint32_t specularLevels = 6;   ///< Levels of the cubemap; roughness goes linearly from 0 (level 0) to 1 (last level).
+    uint32_t specularSamples = 64; ///< GGX samples per texel of the rough levels.
+    uint32_t brdfSize = 128;       ///< Size of the split-sum BRDF table (NdotV x roughness).
+    uint32_t brdfSamples = 256;    ///< Samples per texel of the BRDF table.
+};
+
+/** @brief Order-2 spherical harmonics (9 RGB coefficients, padded to vec4 for std140). */
+using SHCoefficients = std::array<glm::vec4, 9>;
+
+/** @brief Lighting precomputed from one environment. */
+struct BakedEnvironment {
+    SHCoefficients irradiance{}; ///< Already convolved with the cosine lobe and divided by pi (see `evaluateIrradiance`).
+    KTX2Texture specular;        ///< RGBA16F cubemap, one GGX roughness per level.
+};
+
+/**
+ * @brief CPU precomputation of image-based lighting from an equirectangular HDR environment.
+ *
+ * Produces what the PBR shader needs for its ambient term: diffuse irradiance as SH9, a
+ * GGX-prefiltered specular cubemap (filtered importance sampling from a float pyramid of the
+ * source) and the split-sum BRDF table, which does not depend on the environment. Texels are
+ * processed as `Float4` and spread over the JobSystem when one is given.
+ *
+ * Vulkan-free: `EnvironmentLighting` caches the results on disk and uploads them.
+ *
+ * Equirectangular convention: u = 0.5 + atan2(z, x) / 2pi, v = acos(y) / pi (+Y up, top row first).
+ * Cubemap faces follow the Vulkan layout (+X, -X, +Y, -Y, +Z, -Z).
+ */
+namespace IBLBaker {
+
+    /** @brief Changes whenever the baked data would differ (invalidates the disk cache). */
+    inline constexpr uint32_t Version = 1;
+
+    /** @brief World direction of the equirectangular coordinates (u, v) in [0, 1]. */
+    [[nodiscard]] glm::vec3 equirectDirection(float u, float v);
+
+    /** @brief World direction through the center of texel (x, y) of a cubemap face. */
+    [[nodiscard]] glm::vec3 cubeDirection(uint32_t face, uint32_t x, uint32_t y, uint32_t size);
+
+    /** @brief Projects the cosine-convolved radiance of the environment onto SH9. */
+    [[nodiscard]] SHCoefficients projectIrradiance(const HDRImage& environment, JobSystem* jobs = nullptr);
+
+    /** @brief Diffuse radiance for a white Lambertian surface of normal `normal` (irradiance / pi). */
+    [[nodiscard]] glm::vec3 evaluateIrradiance(const SHCoefficients& sh, const glm::vec3& normal);
+
+    /** @brief GGX-prefiltered RGBA16F cubemap of the environment. */
+    [[nodiscard]] KTX2Texture prefilterSpecular(const HDRImage& environment, const IBLBakeSettings& settings, JobSystem* jobs = nullptr);
+
+    /** @brief Split-sum BRDF table: RG16F, (scale, bias) of F0, u = NdotV, v = roughness. */
+    [[nodiscard]] KTX2Texture integrateBRDF(uint32_t size, uint32_t samples, JobSystem* jobs = nullptr);
+
+    /** @brief Irradiance and prefiltered specular of one environment. */
+    [[nodiscard]] BakedEnvironment bake(const HDRImage& environment, const IBLBakeSettings& settings, JobSystem* jobs = nullptr);
+
+    /** @brief FNV-1a of `data`, chained through `seed` (cache keys). */
+    [[nodiscard]] uint64_t hash(std::span<const std::byte> data, uint64_t seed = 0xcbf29ce484222325ull);
+
+    /** @brief Cache file of a baked environment: header, SH coefficients, then the cubemap as KTX2. */
+    [[nodiscard]] std::vector<std::byte> serialize(const BakedEnvironment& environment);
+    /** @brief Throws `std::runtime_error` if the data is not a cache file of this `Version`. */
+    [[nodiscard]] BakedEnvironment deserialize(std::span<const std::byte> data);
+
+    /** @brief IEEE half conversions (round to nearest even; magnitudes above 65504 are clamped, not infinite). */
+    [[nodiscard]] uint16_t toHalf(float value);
+    [[nodiscard]] float fromHalf(uint16_t value);
+
+} // namespace IBLBaker
+
+} // namespace bb3d
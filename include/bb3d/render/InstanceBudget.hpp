@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+namespace bb3d {
+
+/**
+ * @brief Sizing of the per-frame instance buffers.
+ *
+ * Buffers start at an initial capacity and grow geometrically (at least x2) when
+ * a frame needs more slots, so a scene that keeps growing reallocates a handful of
+ * times instead of every frame. An optional hard budget caps the growth: the
+ * instances past it are not drawn, and `admit()` reports the first frame that
+ * overflows so the renderer can log once instead of every frame.
+ */
+class InstanceBudget {
+public:
+    /** @param budget Maximum number of instances per frame (0 = unlimited). */
+    explicit InstanceBudget(uint32_t budget = 0) : m_budget(budget) {}
+
+    /**
+     * @brief Capacity to allocate for `required` instances.
+     * @return `current` if it is enough, otherwise max(2 x current, required), capped by the budget.
+     */
+    [[nodiscard]] uint32_t grow(uint32_t current, uint32_t required) const;
+
+    /**
+     * @brief Number of instances drawn this frame out of `requested`.
+     * @param firstOverflow Set to true on the first frame over the budget since it was last respected.
+     */
+    uint32_t admit(uint32_t requested, bool& firstOverflow);
+
+    [[nodiscard]] uint32_t getBudget() const { return m_budget; }
+
+private:
+    uint32_t m_budget = 0;
+    bool m_overflowing = false;
+};
+
+} // namespace bb3d
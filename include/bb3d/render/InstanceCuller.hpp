@@ -0,0 +1,92 @@
+#pragma once
+
+#include "bb3d/render/Meshlet.hpp"
+#include <glm/glm.hpp>
+#include <array>
+#include <vector>
+#include <cstdint>
+
+namespace bb3d {
+
+/** @brief World bounds of one instance, as read by `cull_instances.comp` (std430, 32 bytes). */
+struct GpuCullInstance {
+    glm::vec3 boundsMin{ 0.0f };
+    uint32_t draw = 0;      ///< Draw template of the instance.
+    glm::vec3 boundsMax{ 0.0f };
+    uint32_t instance = 0;  ///< Slot of the instance in the instance buffer (draw position).
+};
+
+/**
+ * @brief One batch of instances sharing a mesh and a LOD (std430, 32 bytes).
+ * @note `firstInstance` is the first slot of the batch: its visible instances are
+ *       compacted from `outputBase + firstInstance` on.
+ */
+struct GpuDrawTemplate {
+    uint32_t indexCount = 0;
+    uint32_t firstIndex = 0;
+    int32_t vertexOffset = 0;
+    uint32_t firstInstance = 0;
+    uint32_t group = 0;          ///< State group (pipeline, vertex format, material set, index type).
+    uint32_t groupFirstDraw = 0; ///< First command of the group in the output draw buffer.
+    uint32_t pad0 = 0;
+    uint32_t pad1 = 0;
+};
+
+/** @brief Push constants shared by the culling and compaction passes (112 bytes). */
+struct GpuCullPushConstants {
+    std::array<glm::vec4, 6> planes{}; ///< Normalized world-space frustum planes.
+    uint32_t instanceCount = 0;
+    uint32_t drawCount = 0;
+    uint32_t outputBase = 0;           ///< First slot of the compacted instances in the instance buffer.
+    uint32_t pad = 0;
+};
+
+/**
+ * @brief GPU-driven instance culling: data layout and CPU reference.
+ *
+ * The renderer uploads one `GpuCullInstance` per instance and one `GpuDrawTemplate`
+ * per batch, then runs two compute passes:
+ *
+ * 1. `cull_instances.comp`, one thread per instance: frustum test of the bounds;
+ *    a visible instance takes a slot in its batch (`atomicAdd` on the draw count)
+ *    and its `InstanceData` record is copied to the compacted range.
+ * 2. `compact_draws.comp`, one thread per template: a batch with visible instances
+ *    appends a `VkDrawIndexedIndirectCommand` to its state group (`atomicAdd` on
+ *    the group counter), consumed by `vkCmdDrawIndexedIndirectCount`.
+ *
+ * Counter 0 of the counter buffer holds the number of visible instances, counter
+ * `1 + g` the number of commands of group `g`.
+ *
+ * `cull()` runs the same passes serially. The GPU fills slots and commands in
+ * whatever order the atomics resolve, so results match as sets, not in order.
+ * The structs above must keep the layouts declared in `instance_culling.glsl`.
+ */
+class InstanceCuller {
+public:
+    /** @brief Outputs of the two passes. */
+    struct Result {
+        std::vector<uint32_t> drawCounts;        ///< Visible instances of each template.
+        std::vector<uint32_t> counters;          ///< [0] = visible instances, [1 + g] = commands of group g.
+        std::vector<uint32_t> compacted;         ///< Source slot of each compacted slot (UINT32_MAX = unused).
+        std::vector<IndexedDrawCommand> commands; ///< Output draw buffer, indexed by `groupFirstDraw + n`.
+    };
+
+    /** @brief Same test as `Frustum::intersects(const AABB&)` (positive vertex of each plane). */
+    [[nodiscard]] static bool isVisible(const std::array<glm::vec4, 6>& planes, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+
+    /**
+     * @brief CPU reference of the culling and compaction passes.
+     * @param constants Planes and counts, as pushed to the shaders.
+     * @param instances Instance bounds (`constants.instanceCount` entries).
+     * @param templates Draw templates (`constants.drawCount` entries).
+     * @param groupCount Number of state groups.
+     */
+    static void cull(const GpuCullPushConstants& constants, const std::vector<GpuCullInstance>& instances,
+                     const std::vector<GpuDrawTemplate>& templates, uint32_t groupCount, Result& result);
+};
+
+static_assert(sizeof(GpuCullInstance) == 32, "GpuCullInstance must match the std430 layout of cull_instances.comp");
+static_assert(sizeof(GpuDrawTemplate) == 32, "GpuDrawTemplate must match the std430 layout of cull_instances.comp");
+static_assert(sizeof(GpuCullPushConstants) == 112, "GpuCullPushConstants must match the push constant block of the culling shaders");
+
+} // namespace bb3d
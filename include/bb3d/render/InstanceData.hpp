@@ -0,0 +1,37 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+
+namespace bb3d {
+
+/**
+ * @brief Record of one instance in the instance buffer (std430, 64 bytes).
+ *
+ * The world matrix of a mesh is affine: its last row is always (0, 0, 0, 1), so
+ * only the first three rows are stored, translation in `w`. The 16 bytes saved
+ * carry the per-instance attributes, so instances that differ only by their tint
+ * or bindless material still share one batch, for the same bandwidth as a bare
+ * `mat4`. `instance_data.glsl` declares the same layout for the shaders.
+ */
+struct InstanceData {
+    glm::vec4 rows[3]{ glm::vec4(1.0f, 0.0f, 0.0f, 0.0f), glm::vec4(0.0f, 1.0f, 0.0f, 0.0f), glm::vec4(0.0f, 0.0f, 1.0f, 0.0f) };
+    uint32_t materialIndex = 0;  ///< Bindless material record (PBR with bindless materials, 0 otherwise).
+    uint32_t color = 0xFFFFFFFFu; ///< Tint multiplied with the vertex color, RGBA8 (`packColor`).
+    uint32_t flags = 0;          ///< Reserved for per-instance options, 0 today.
+    uint32_t pad = 0;
+
+    /** @brief Record of an instance. `world` must be affine (last row 0, 0, 0, 1). */
+    [[nodiscard]] static InstanceData pack(const glm::mat4& world, uint32_t materialIndex = 0, uint32_t color = 0xFFFFFFFFu, uint32_t flags = 0);
+
+    /** @brief World matrix of the record, as rebuilt by `instanceModel()` in the shaders. */
+    [[nodiscard]] static glm::mat4 unpackTransform(const InstanceData& data);
+
+    /** @brief Same packing as GLSL `packUnorm4x8` (red in the low byte, components clamped to [0, 1]). */
+    [[nodiscard]] static uint32_t packColor(const glm::vec4& color);
+    [[nodiscard]] static glm::vec4 unpackColor(uint32_t color);
+};
+
+static_assert(sizeof(InstanceData) == 64, "InstanceData must match the std430 layout of instance_data.glsl");
+
+} // namespace bb3d
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "bb3d/render/BlockCompression.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <vector>
+#include <optional>
+
+namespace bb3d {
+
+/** @brief Subset of VkFormat values stored in KTX2 files (same numeric values as Vulkan). */
+enum class KTX2Format : uint32_t {
+    Undefined = 0,
+    R8G8B8A8_UNORM = 37,
+    R8G8B8A8_SRGB = 43,
+    R16G16_SFLOAT = 83,
+    R16G16B16A16_SFLOAT = 97,
+    BC1_RGBA_UNORM = 133,
+    BC1_RGBA_SRGB = 134,
+    BC3_UNORM = 137,
+    BC3_SRGB = 138,
+    BC4_UNORM = 139,
+    BC5_UNORM = 141,
+    BC7_UNORM = 145,
+    BC7_SRGB = 146
+};
+
+/**
+ * @brief In-memory KTX2 texture: 2D or cubemap, full mip chain, no supercompression.
+ *
+ * `levels[0]` is the full-resolution level; each level holds its faces back to back
+ * (+X, -X, +Y, -Y, +Z, -Z for cubemaps), as laid out in the file.
+ */
+struct KTX2Texture {
+    KTX2Format format = KTX2Format::Undefined;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t faceCount = 1;
+    std::vector<std::vector<uint8_t>> levels;
+
+    [[nodiscard]] uint32_t getLevelWidth(uint32_t level) const { return width >> level ? width >> level : 1u; }
+    [[nodiscard]] uint32_t getLevelHeight(uint32_t level) const { return height >> level ? height >> level : 1u; }
+};
+
+/**
+ * @brief Minimal reader/writer of the Khronos KTX2 container.
+ *
+ * Only the layouts produced by the texture cooker are accepted on load (formats of
+ * `KTX2Format`, no array layers, no depth, no supercompression); anything else throws
+ * `std::runtime_error` so that callers can fall back to the source image.
+ */
+namespace KTX2 {
+
+    /** @brief True if the bytes start with the KTX2 identifier. */
+    bool isKTX2(std::span<const std::byte> data);
+
+    KTX2Texture read(std::span<const std::byte> data);
+
+    /** @brief Serializes with a Basic Data Format Descriptor and a `KTXwriter` key. */
+    std::vector<std::byte> write(const KTX2Texture& texture);
+
+    /** @brief Block format of a compressed KTX2 format (nullopt for uncompressed formats). */
+    std::optional<BlockFormat> getBlockFormat(KTX2Format format);
+
+    /** @brief True for the sRGB-encoded formats. */
+    bool isSRGB(KTX2Format format);
+
+    /** @brief True for the half-float formats (HDR data such as baked lighting). */
+    bool isFloat(KTX2Format format);
+
+    /** @brief Byte size of one face of a level. */
+    size_t getImageSize(KTX2Format format, uint32_t width, uint32_t height);
+
+} // namespace KTX2
+
+} // namespace bb3d
@@ -5,9 +5,12 @@
 #include "bb3d/render/UniformBuffer.hpp"
 #include "bb3d/render/VulkanContext.hpp"
 #include <glm/glm.hpp>
+#include <optional>
 
 namespace bb3d {
 
+class BindlessMaterials; // Forward declaration
+
 enum class MaterialType { PBR, Unlit, Toon, Skybox, SkySphere, Highlight, Plasma, Particle };
 
 enum class AlphaMode { Opaque = 0, Mask, Blend };
@@ -56,6 +59,15 @@ public:
      */
     virtual vk::DescriptorSet getDescriptorSet(vk::DescriptorPool pool, vk::DescriptorSetLayout layout) = 0;
 
+    /**
+     * @brief Forwards the on-screen size of an instance to the streamed textures of the material.
+     * @param screenPixels Approximate height of the instance on screen, in pixels.
+     */
+    virtual void requestTextureResolution(float screenPixels) { (void)screenPixels; }
+
+    /** @brief Blending of the surface; `AlphaMode::Blend` draws are ordered back to front. */
+    virtual AlphaMode getAlphaMode() const { return AlphaMode::Opaque; }
+
     /** @brief Releases static resources (default textures). */
     static void Cleanup(); 
 
@@ -72,6 +84,10 @@ protected:
     static Ref<Texture> s_defaultBlack;
     static Ref<Texture> s_defaultNormal;
     static void InitDefaults(VulkanContext& context);
+
+    /** @brief True once after one of the textures changed its resident mips (its image view was replaced). */
+    bool residencyChanged(std::initializer_list<const Texture*> textures);
+    uint64_t m_residencyStamp = 0;
 };
 
 /**
@@ -85,37 +101,54 @@ public:
     PBRMaterial(VulkanContext& context);
     ~PBRMaterial() override;
     MaterialType getType() const override { return MaterialType::PBR; }
+    AlphaMode getAlphaMode() const override { return m_parameters.alphaMode; }
 
     /** @brief Sets the color texture (Albedo). */
-    void setAlbedoMap(Ref<Texture> texture) { Ref<Texture> t = texture ? texture : s_defaultWhite; if (m_albedoMap != t) { m_albedoMap = t; m_dirty.fill(true); } }
+    void setAlbedoMap(Ref<Texture> texture) { Ref<Texture> t = texture ? texture : s_defaultWhite; if (m_albedoMap != t) { m_albedoMap = t; markDirty(); } }
     
     /** @brief Sets the normal texture. */
-    void setNormalMap(Ref<Texture> texture) { Ref<Texture> t = texture ? texture : s_defaultNormal; if (m_normalMap != t) { m_normalMap = t; m_dirty.fill(true); } }
+    void setNormalMap(Ref<Texture> texture) { Ref<Texture> t = texture ? texture : s_defaultNormal; if (m_normalMap != t) { m_normalMap = t; markDirty(); } }
     
     /** @brief Sets the ORM texture (R: Occlusion, G: Roughness, B: Metallic). */
-    void setORMMap(Ref<Texture> texture) { Ref<Texture> t = texture ? texture : s_defaultWhite; if (m_ormMap != t) { m_ormMap = t; m_dirty.fill(true); } }
+    void setORMMap(Ref<Texture> texture) { Ref<Texture> t = texture ? texture : s_defaultWhite; if (m_ormMap != t) { m_ormMap = t; markDirty(); } }
     
-    void setEmissiveMap(Ref<Texture> texture) { Ref<Texture> t = texture ? texture : s_defaultBlack; if (m_emissiveMap != t) { m_emissiveMap = t; m_dirty.fill(true); } }
+    void setEmissiveMap(Ref<Texture> texture) { Ref<Texture> t = texture ? texture : s_defaultBlack; if (m_emissiveMap != t) { m_emissiveMap = t; markDirty(); } }
     
     /** @brief Sets PBR scalar factors. */
-    void setParameters(const PBRParameters& params) { m_parameters = params; m_dirty.fill(true); }
+    void setParameters(const PBRParameters& params) { m_parameters = params; markDirty(); }
     [[nodiscard]] const PBRParameters& getParameters() const { return m_parameters; }
 
-    void setColor(const glm::vec3& color) { m_parameters.baseColorFactor = glm::vec4(color, 1.0f); m_dirty.fill(true); }
+    void setColor(const glm::vec3& color) { m_parameters.baseColorFactor = glm::vec4(color, 1.0f); markDirty(); }
     [[nodiscard]] glm::vec3 getColor() const { return glm::vec3(m_parameters.baseColorFactor); }
     
     vk::DescriptorSet getDescriptorSet(vk::DescriptorPool pool, vk::DescriptorSetLayout layout) override;
+    void requestTextureResolution(float screenPixels) override;
+
+    /**
+     * @brief Index of the material record in the bindless table, registered on first use.
+     * If parameters or textures have changed, the record is updated before being returned.
+     * @return 0 (the first record) if the table is full.
+     */
+    uint32_t getBindlessIndex(const Ref<BindlessMaterials>& table);
     
     /** @brief Creates the descriptor layout (Binding 0=Params, 1=Albedo, 2=Normal, 3=ORM, 4=Emissive). */
     static vk::DescriptorSetLayout CreateLayout(vk::Device device);
 
 private:
+    void markDirty() { m_dirty.fill(true); m_bindlessDirty = true; }
     void updateDescriptorSet(uint32_t frame);
+    void releaseBindless();
     Ref<Texture> m_albedoMap, m_normalMap, m_ormMap, m_emissiveMap;
     PBRParameters m_parameters;
     std::array<Scope<UniformBuffer>, MAX_FRAMES_IN_FLIGHT> m_paramBuffers;
     std::array<vk::DescriptorSet, MAX_FRAMES_IN_FLIGHT> m_sets = {nullptr, nullptr, nullptr};
     std::array<bool, MAX_FRAMES_IN_FLIGHT> m_dirty = {true, true, true};
+
+    // Bindless path: the table may be destroyed first (it belongs to the Renderer)
+    std::weak_ptr<BindlessMaterials> m_bindless;
+    std::optional<uint32_t> m_bindlessIndex;
+    std::array<std::optional<uint32_t>, 4> m_bindlessTextures; ///< Albedo, normal, ORM, emissive slots.
+    bool m_bindlessDirty = true;
 };
 
 class UnlitMaterial : public Material {
@@ -124,6 +157,7 @@ public:
     ~UnlitMaterial() override;
     MaterialType getType() const override { return MaterialType::Unlit; }
     void setBaseMap(Ref<Texture> texture) { if (m_baseMap != texture) { m_baseMap = texture; m_dirty.fill(true); } }
+    void requestTextureResolution(float screenPixels) override { if (m_baseMap) m_baseMap->requestResolution(screenPixels); }
     void setColor(const glm::vec3& color) { m_parameters.color = glm::vec4(color, 1.0f); m_dirty.fill(true); }
     vk::DescriptorSet getDescriptorSet(vk::DescriptorPool pool, vk::DescriptorSetLayout layout) override;
     static vk::DescriptorSetLayout CreateLayout(vk::Device device);
@@ -141,7 +175,9 @@ public:
     ToonMaterial(VulkanContext& context);
     ~ToonMaterial() override;
     MaterialType getType() const override { return MaterialType::Toon; }
+    AlphaMode getAlphaMode() const override { return m_parameters.alphaMode; }
     void setBaseMap(Ref<Texture> texture) { if (m_baseMap != texture) { m_baseMap = texture; m_dirty.fill(true); } }
+    void requestTextureResolution(float screenPixels) override { if (m_baseMap) m_baseMap->requestResolution(screenPixels); }
     vk::DescriptorSet getDescriptorSet(vk::DescriptorPool pool, vk::DescriptorSetLayout layout) override;
     static vk::DescriptorSetLayout CreateLayout(vk::Device device);
 private:
@@ -174,6 +210,7 @@ public:
     ~SkySphereMaterial() override;
     MaterialType getType() const override { return MaterialType::SkySphere; }
     void setTexture(Ref<Texture> texture) { if (m_texture != texture) { m_texture = texture; m_dirty.fill(true); } }
+    void requestTextureResolution(float screenPixels) override { if (m_texture) m_texture->requestResolution(screenPixels); }
     vk::DescriptorSet getDescriptorSet(vk::DescriptorPool pool, vk::DescriptorSetLayout layout) override;
     static vk::DescriptorSetLayout CreateLayout(vk::Device device);
 private:
@@ -196,8 +233,10 @@ public:
     ~PlasmaMaterial() override;
     MaterialType getType() const override { return MaterialType::Plasma; }
     void setBaseMap(Ref<Texture> texture) { if (m_baseMap != texture) { m_baseMap = texture; m_dirty.fill(true); } }
+    void requestTextureResolution(float screenPixels) override { if (m_baseMap) m_baseMap->requestResolution(screenPixels); }
     void setTime(float t) { m_parameters.time = t; m_dirty.fill(true); }
     void setIntensity(float i) { m_parameters.intensity = i; m_dirty.fill(true); }
+    float getIntensity() const { return m_parameters.intensity; }
     vk::DescriptorSet getDescriptorSet(vk::DescriptorPool pool, vk::DescriptorSetLayout layout) override;
     static vk::DescriptorSetLayout CreateLayout(vk::Device device);
 private:
@@ -215,6 +254,7 @@ public:
     ~ParticleMaterial() override;
     MaterialType getType() const override { return MaterialType::Particle; }
     void setBaseMap(Ref<Texture> texture) { if (m_baseMap != texture) { m_baseMap = texture; m_dirty.fill(true); } }
+    void requestTextureResolution(float screenPixels) override { if (m_baseMap) m_baseMap->requestResolution(screenPixels); }
     void setColor(const glm::vec3& color, float alpha = 1.0f) { m_parameters.color = glm::vec4(color, alpha); m_dirty.fill(true); }
     vk::DescriptorSet getDescriptorSet(vk::DescriptorPool pool, vk::DescriptorSetLayout layout) override;
     static vk::DescriptorSetLayout CreateLayout(vk::Device device);
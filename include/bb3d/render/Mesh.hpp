@@ -3,63 +3,37 @@
 #include "bb3d/core/Base.hpp"
 #include "bb3d/core/Log.hpp"
 #include "bb3d/render/Buffer.hpp"
+#include "bb3d/render/GeometryPool.hpp"
 #include "bb3d/render/Vertex.hpp"
 #include "bb3d/render/Texture.hpp"
 #include "bb3d/render/Material.hpp"
+#include "bb3d/render/MeshSimplifier.hpp"
+#include "bb3d/render/Meshlet.hpp"
+#include "bb3d/render/AABB.hpp"
 #include <vector>
-#include <limits>
+#include <span>
 #include <glm/glm.hpp>
 
 namespace bb3d {
 
 class VulkanContext;
 
-/** @brief Axis-Aligned Bounding Box (AABB). */
-struct AABB {
-    glm::vec3 min{std::numeric_limits<float>::max()}; ///< Minimum corner (x, y, z).
-    glm::vec3 max{std::numeric_limits<float>::lowest()}; ///< Maximum corner (x, y, z).
-
-    /** @brief Extends the box to include a new point. */
-    void extend(const glm::vec3& point) {
-        min = glm::min(min, point);
-        max = glm::max(max, point);
-    }
-    
-    /** @brief Extends the box to include another AABB. */
-    void extend(const AABB& other) {
-        min = glm::min(min, other.min);
-        max = glm::max(max, other.max);
-    }
-
-    [[nodiscard]] inline glm::vec3 center() const { return (min + max) * 0.5f; }
-    [[nodiscard]] inline glm::vec3 size() const { return max - min; }
-
-    /** @brief Calculates a new AABB after transformation by a matrix. */
-    [[nodiscard]] inline AABB transform(const glm::mat4& m) const {
-        glm::vec3 newMin = m[3];
-        glm::vec3 newMax = m[3];
-        for (int i = 0; i < 3; i++) {
-            for (int j = 0; j < 3; j++) {
-                float a = m[j][i] * min[j];
-                float b = m[j][i] * max[j];
-                if (a < b) {
-                    newMin[i] += a; newMax[i] += b;
-                } else {
-                    newMin[i] += b; newMax[i] += a;
-                }
-            }
-        }
-        return {newMin, newMax};
-    }
+/** @brief What a mesh keeps in RAM once its data has been handed to the GPU. */
+enum class MeshCPURetention {
+    Keep,            ///< Full vertices and indices (editing, normalize(), LOD/meshlet generation).
+    DropAfterUpload, ///< Nothing: the mesh only lives on the GPU.
+    PhysicsOnly      ///< Compact positions + indices, enough to build colliders.
 };
 
 /**
  * @brief Object containing geometric data ready for the GPU.
  * 
  * A Mesh consists of:
- * - A **Vertex Buffer** (Position, Normal, UV, etc.).
- * - An **Index Buffer** (Triangle indices for indexed drawing).
+ * - A **Vertex range** (Position, Normal, UV, etc.) in the shared GeometryPool vertex buffer.
+ * - An **Index range** (Triangle indices for indexed drawing) in the shared GeometryPool index buffer.
  * - A **Local AABB** for culling.
+ * - An optional chain of **LODs** stored as ranges of the index buffer (shared vertex buffer).
+ * - Optional **Meshlets** (clusters with bounds) for per-cluster culling of LOD 0.
  * - An optional link to a **Material**.
  */
 class Mesh {
@@ -67,27 +41,69 @@ public:
     /**
      * @brief Creates a mesh and transfers data to GPU memory.
      * @param context Vulkan context for buffer creation.
-     * @param vertices List of vertices.
+     * @param vertices List of vertices (streamed to the staging memory, only copied if retained).
      * @param indices List of triangle indices.
+     * @param format GPU vertex layout (`Auto` picks the smallest quantized format fitting the data).
+     * @param retention CPU data kept once the upload is recorded.
      */
     Mesh(VulkanContext& context, 
-         const std::vector<Vertex>& vertices, 
-         const std::vector<uint32_t>& indices)
-         : m_context(context), m_vertices(vertices), m_indices(indices), m_indexCount(static_cast<uint32_t>(indices.size())) {
+         std::span<const Vertex> vertices, 
+         std::span<const uint32_t> indices,
+         VertexFormat format = VertexFormat::Full,
+         MeshCPURetention retention = MeshCPURetention::Keep)
+         : m_context(context), m_indexCount(static_cast<uint32_t>(indices.size())), m_requestedFormat(format) {
         
-        m_vertexBuffer = Buffer::CreateVertexBuffer(context, m_vertices.data(), m_vertices.size() * sizeof(Vertex));
-        m_indexBuffer = Buffer::CreateIndexBuffer(context, m_indices.data(), m_indices.size() * sizeof(uint32_t));
-
-        for (const auto& v : vertices) {
-            m_bounds.extend(v.position);
+        upload(vertices, indices);
+        if (retention == MeshCPURetention::Keep) {
+            m_vertices.assign(vertices.begin(), vertices.end());
+            m_indices.assign(indices.begin(), indices.end());
+        } else if (retention == MeshCPURetention::PhysicsOnly) {
+            keepPhysicsCopy(vertices, indices);
         }
+        m_cpuRetention = retention;
+    }
+
+    /** @brief Same as above, taking ownership of the lists instead of copying them. */
+    Mesh(VulkanContext& context, 
+         std::vector<Vertex>&& vertices, 
+         std::vector<uint32_t>&& indices,
+         VertexFormat format = VertexFormat::Full,
+         MeshCPURetention retention = MeshCPURetention::Keep)
+         : m_context(context), m_vertices(std::move(vertices)), m_indices(std::move(indices)), m_indexCount(static_cast<uint32_t>(m_indices.size())), m_requestedFormat(format) {
+        
+        upload(m_vertices, m_indices);
+        setCPURetention(retention);
     }
 
     ~Mesh() {
-        m_vertexBuffer.reset();
-        m_indexBuffer.reset();
+        if (!m_context.hasGeometryPool()) return;
+        auto& pool = m_context.getGeometryPool();
+        pool.free(m_vertexRange);
+        pool.free(m_indexRange);
+        pool.free(m_clusterIndexRange);
     }
 
+    Mesh(const Mesh&) = delete;
+    Mesh& operator=(const Mesh&) = delete;
+
+    /** @brief Layout of the GPU vertex buffer (selects the pipeline variant). */
+    [[nodiscard]] inline VertexFormat getVertexFormat() const { return m_vertexFormat; }
+
+    /** @brief Index type of the GPU index buffers (16-bit when the vertex count allows it). */
+    [[nodiscard]] inline vk::IndexType getIndexType() const { return m_indexType; }
+
+    /** @brief First vertex of this mesh in the shared vertex buffer (`vertexOffset` of the draws). */
+    [[nodiscard]] inline int32_t getVertexOffset() const { return m_context.getGeometryPool().getVertexOffset(m_vertexRange); }
+
+    /** @brief First index of the LOD chain in the shared index buffer (added to `MeshLOD::firstIndex`). */
+    [[nodiscard]] inline uint32_t getFirstIndex() const { return m_context.getGeometryPool().getFirstIndex(m_indexRange); }
+
+    /** @brief First index of the meshlet-ordered indices in the shared index buffer. */
+    [[nodiscard]] inline uint32_t getClusterFirstIndex() const { return m_context.getGeometryPool().getFirstIndex(m_clusterIndexRange); }
+
+    /** @brief Size of the GPU vertex data in bytes. */
+    [[nodiscard]] inline size_t getVertexBufferSize() const { return m_vertexBufferSize; }
+
     /** @brief Retrieves the local spatial bounds of the mesh. */
     [[nodiscard]] inline const AABB& getBounds() const { return m_bounds; }
 
@@ -96,24 +112,122 @@ public:
      * @param commandBuffer Active command buffer.
      * @param instanceCount Number of instances to draw (Instancing).
      * @param firstInstance Index of the first instance in the instance SSBO.
+     * @param lod Level of detail to draw (clamped to the available levels).
      */
-    inline void draw(vk::CommandBuffer commandBuffer, uint32_t instanceCount = 1, uint32_t firstInstance = 0) const {
-        vk::Buffer vbs[] = {m_vertexBuffer->getHandle()};
-        vk::DeviceSize offsets[] = {0};
-        commandBuffer.bindVertexBuffers(0, 1, vbs, offsets);
-        commandBuffer.bindIndexBuffer(m_indexBuffer->getHandle(), 0, vk::IndexType::eUint32);
-        commandBuffer.drawIndexed(m_indexCount, instanceCount, 0, 0, firstInstance);
+    inline void draw(vk::CommandBuffer commandBuffer, uint32_t instanceCount = 1, uint32_t firstInstance = 0, uint32_t lod = 0) const {
+        bindBuffers(commandBuffer);
+        drawBound(commandBuffer, instanceCount, firstInstance, lod);
     }
 
+    /** @brief Binds the shared geometry buffers with the index type of this mesh. */
+    inline void bindBuffers(vk::CommandBuffer commandBuffer) const {
+        m_context.getGeometryPool().bind(commandBuffer, m_indexType);
+    }
+
+    /**
+     * @brief Same as draw() without rebinding: the geometry pool must already be bound with getIndexType().
+     * @note Lets the renderer bind the shared buffers once for every mesh using the same index type.
+     */
+    inline void drawBound(vk::CommandBuffer commandBuffer, uint32_t instanceCount = 1, uint32_t firstInstance = 0, uint32_t lod = 0) const {
+        const MeshLOD& level = m_lods[std::min<size_t>(lod, m_lods.size() - 1)];
+        const auto& pool = m_context.getGeometryPool();
+        commandBuffer.drawIndexed(level.indexCount, instanceCount, pool.getFirstIndex(m_indexRange) + level.firstIndex, pool.getVertexOffset(m_vertexRange), firstInstance);
+    }
+
+    /**
+     * @brief Generates the LOD chain from the CPU copy of the mesh (QEM simplification).
+     * @note Must be called before releaseCPUData(). LOD 0 is left untouched.
+     */
+    void generateLODs(const LODSettings& settings = LODSettings{}) {
+        if (isCPUDataReleased() || m_vertices.empty() || m_indices.empty()) {
+            BB_CORE_WARN("Mesh: Cannot generate LODs without CPU data.");
+            return;
+        }
+        setLODChain(MeshSimplifier::buildLODChain(&m_vertices[0].position.x, m_vertices.size(), sizeof(Vertex), m_indices, settings));
+    }
+
+    /**
+     * @brief Installs a precomputed LOD chain (e.g. generated on a worker thread) and uploads its index buffer.
+     * @param chain Concatenated indices, LOD 0 first (must match the current index list).
+     */
+    void setLODChain(const LODChain& chain) {
+        if (chain.levels.size() <= 1 || chain.levels[0].indexCount != m_indexCount) return;
+        replaceIndexRange(m_indexRange, chain.indices);
+        m_lods = chain.levels;
+        BB_CORE_TRACE("Mesh: {} LODs installed ({} -> {} triangles).", m_lods.size(), m_lods.front().indexCount / 3, m_lods.back().indexCount / 3);
+    }
+
+    /**
+     * @brief Draws a list of index ranges of the meshlet indices (visible clusters).
+     * @note The geometry pool must be bound with getIndexType(), and the commands rebased on
+     *       getClusterFirstIndex() / getVertexOffset().
+     * @param commandBuffer Active command buffer.
+     * @param indirectBuffer Buffer holding `VkDrawIndexedIndirectCommand` entries.
+     * @param offset Byte offset of the first command.
+     * @param drawCount Number of commands.
+     */
+    inline void drawClusters(vk::CommandBuffer commandBuffer, vk::Buffer indirectBuffer, vk::DeviceSize offset, uint32_t drawCount) const {
+        if (m_clusterIndexRange == GeometryPool::InvalidHandle || drawCount == 0) return;
+        constexpr uint32_t stride = sizeof(vk::DrawIndexedIndirectCommand);
+        if (m_context.supportsMultiDrawIndirect()) {
+            commandBuffer.drawIndexedIndirect(indirectBuffer, offset, drawCount, stride);
+        } else {
+            for (uint32_t i = 0; i < drawCount; ++i) commandBuffer.drawIndexedIndirect(indirectBuffer, offset + i * stride, 1, stride);
+        }
+    }
+
+    /**
+     * @brief Splits LOD 0 into meshlets and uploads the cluster-ordered indices.
+     * @note Must be called before releaseCPUData().
+     */
+    void buildMeshlets(uint32_t maxVertices = MeshletBuilder::DefaultMaxVertices, uint32_t maxTriangles = MeshletBuilder::DefaultMaxTriangles) {
+        if (isCPUDataReleased() || m_vertices.empty() || m_indices.empty()) {
+            BB_CORE_WARN("Mesh: Cannot build meshlets without CPU data.");
+            return;
+        }
+        setMeshlets(MeshletBuilder::build(&m_vertices[0].position.x, m_vertices.size(), sizeof(Vertex), m_indices, maxVertices, maxTriangles));
+    }
+
+    /** @brief Installs a precomputed meshlet decomposition (e.g. built on a worker thread). */
+    void setMeshlets(MeshletData meshlets) {
+        if (meshlets.empty() || meshlets.indices.size() != m_indexCount) return;
+        replaceIndexRange(m_clusterIndexRange, meshlets.indices);
+        // Only the bounds are needed on the CPU once the indices live on the GPU
+        meshlets.indices.clear();
+        meshlets.indices.shrink_to_fit();
+        m_meshlets = std::move(meshlets);
+    }
+
+    /** @brief Number of indices of LOD 0. */
+    [[nodiscard]] uint32_t getIndexCount() const { return m_indexCount; }
+
+    [[nodiscard]] bool hasMeshlets() const { return !m_meshlets.empty(); }
+    [[nodiscard]] const MeshletData& getMeshlets() const { return m_meshlets; }
+
+    /** @brief Number of levels of detail (1 if no LOD chain was generated). */
+    [[nodiscard]] uint32_t getLODCount() const { return static_cast<uint32_t>(m_lods.size()); }
+
+    /** @brief Level table (LOD 0 first). */
+    [[nodiscard]] const std::vector<MeshLOD>& getLODs() const { return m_lods; }
+
     /** @brief Updates GPU buffers after modifying the `getVertices()` list. */
     inline void updateVertices() {
 #if defined(BB3D_DEBUG)
-        if (m_cpuDataReleased) {
+        if (isCPUDataReleased()) {
             BB_CORE_ERROR("Mesh: Cannot update vertices, CPU data has been released!");
             return;
         }
 #endif
-        m_vertexBuffer = Buffer::CreateVertexBuffer(m_context, m_vertices.data(), m_vertices.size() * sizeof(Vertex));
+        uploadVertices(m_vertices);
+        if (m_indexType == vk::IndexType::eUint16 && m_vertices.size() > 65535) {
+            // The mesh outgrew 16-bit indices: back to LOD 0 with 32-bit indices
+            m_indexType = vk::IndexType::eUint32;
+            replaceIndexRange(m_indexRange, m_indices);
+            m_lods.resize(1);
+            m_context.getGeometryPool().free(m_clusterIndexRange);
+            m_clusterIndexRange = GeometryPool::InvalidHandle;
+            m_meshlets = {};
+        }
         m_bounds = AABB();
         for (const auto& v : m_vertices) {
             m_bounds.extend(v.position);
@@ -125,30 +239,65 @@ public:
      * @note After this call, data is no longer available for the CPU (e.g., for Physics).
      * @warning Ensure that physics colliders have been created BEFORE calling this method.
      */
-    void releaseCPUData() {
-        if (m_cpuDataReleased) return;
+    void releaseCPUData() { setCPURetention(MeshCPURetention::DropAfterUpload); }
+
+    /**
+     * @brief Reduces the CPU data kept by the mesh (call after generateLODs()/buildMeshlets()).
+     * @note Retention can only decrease: Keep -> PhysicsOnly -> DropAfterUpload.
+     */
+    void setCPURetention(MeshCPURetention retention) {
+        if (retention == m_cpuRetention || m_cpuRetention == MeshCPURetention::DropAfterUpload) return;
+        if (retention == MeshCPURetention::Keep) {
+            BB_CORE_WARN("Mesh: Released CPU data cannot be restored.");
+            return;
+        }
+        if (retention == MeshCPURetention::PhysicsOnly) {
+            keepPhysicsCopy(m_vertices, {});
+        } else {
+            m_indices.clear();
+            m_indices.shrink_to_fit();
+            m_physicsPositions.clear();
+            m_physicsPositions.shrink_to_fit();
+        }
         m_vertices.clear();
         m_vertices.shrink_to_fit();
-        m_indices.clear();
-        m_indices.shrink_to_fit();
-        m_cpuDataReleased = true;
-        BB_CORE_TRACE("Mesh: CPU data released to save RAM.");
+        m_cpuRetention = retention;
+        BB_CORE_TRACE("Mesh: CPU data reduced to save RAM ({}).", retention == MeshCPURetention::PhysicsOnly ? "physics only" : "dropped");
     }
 
-    [[nodiscard]] bool isCPUDataReleased() const { return m_cpuDataReleased; }
+    [[nodiscard]] MeshCPURetention getCPURetention() const { return m_cpuRetention; }
+
+    /** @brief True once the full vertex list is gone (PhysicsOnly or DropAfterUpload). */
+    [[nodiscard]] bool isCPUDataReleased() const { return m_cpuRetention != MeshCPURetention::Keep; }
+
+    /** @brief True while positions and indices are available on the CPU (collider creation). */
+    [[nodiscard]] bool hasCollisionData() const { return m_cpuRetention != MeshCPURetention::DropAfterUpload && !m_indices.empty(); }
+
+    /** @brief Number of CPU positions (full vertices or physics copy). */
+    [[nodiscard]] size_t getPositionCount() const { return m_cpuRetention == MeshCPURetention::PhysicsOnly ? m_physicsPositions.size() : m_vertices.size(); }
+
+    /** @brief Visits the CPU positions, whether the full vertices or only the physics copy are kept. */
+    template<typename Fn>
+    void forEachPosition(Fn&& fn) const {
+        if (m_cpuRetention == MeshCPURetention::PhysicsOnly) {
+            for (const auto& p : m_physicsPositions) fn(p);
+        } else {
+            for (const auto& v : m_vertices) fn(v.position);
+        }
+    }
 
     /** @brief Retrieves vertices (Read-only). Logs an error if data has been released (Debug only). */
     const std::vector<Vertex>& getVertices() const { 
 #if defined(BB3D_DEBUG)
-        if (m_cpuDataReleased) BB_CORE_ERROR("Mesh: Accessing vertices after releaseCPUData()! Results will be empty.");
+        if (isCPUDataReleased()) BB_CORE_ERROR("Mesh: Accessing vertices after releaseCPUData()! Results will be empty.");
 #endif
         return m_vertices; 
     }
 
-    /** @brief Retrieves indices (Read-only). Logs an error if data has been released (Debug only). */
+    /** @brief Retrieves indices (Read-only, kept by PhysicsOnly). Logs an error if data has been released (Debug only). */
     const std::vector<uint32_t>& getIndices() const { 
 #if defined(BB3D_DEBUG)
-        if (m_cpuDataReleased) BB_CORE_ERROR("Mesh: Accessing indices after releaseCPUData()! Results will be empty.");
+        if (m_cpuRetention == MeshCPURetention::DropAfterUpload) BB_CORE_ERROR("Mesh: Accessing indices after releaseCPUData()! Results will be empty.");
 #endif
         return m_indices; 
     }
@@ -156,7 +305,7 @@ public:
     /** @brief Retrieves vertices for modification. Logs an error if data has been released (Debug only). */
     std::vector<Vertex>& getVertices() { 
 #if defined(BB3D_DEBUG)
-        if (m_cpuDataReleased) BB_CORE_ERROR("Mesh: Accessing vertices for modification after releaseCPUData()!");
+        if (isCPUDataReleased()) BB_CORE_ERROR("Mesh: Accessing vertices for modification after releaseCPUData()!");
 #endif
         return m_vertices; 
     }
@@ -171,16 +320,80 @@ public:
     [[nodiscard]] bool isVisible() const { return m_visible; }
 
 private:
+    /** @brief Uploads LOD 0 and computes the bounds (the lists are not retained here). */
+    void upload(std::span<const Vertex> vertices, std::span<const uint32_t> indices) {
+        uploadVertices(vertices);
+        // 16-bit indices whenever every vertex is addressable with them (half the memory and bandwidth)
+        m_indexType = vertices.size() <= 65535 ? vk::IndexType::eUint16 : vk::IndexType::eUint32;
+        replaceIndexRange(m_indexRange, indices);
+
+        for (const auto& v : vertices) {
+            m_bounds.extend(v.position);
+        }
+        m_lods.push_back({ 0, m_indexCount, 1.0f, 0.0f });
+    }
+
+    /** @brief Keeps positions (12 bytes instead of a full Vertex) and indices for collider creation. */
+    void keepPhysicsCopy(std::span<const Vertex> vertices, std::span<const uint32_t> indices) {
+        m_physicsPositions.resize(vertices.size());
+        for (size_t i = 0; i < vertices.size(); ++i) m_physicsPositions[i] = vertices[i].position;
+        if (!indices.empty()) m_indices.assign(indices.begin(), indices.end());
+    }
+
+    /** @brief Uploads indices with the mesh index type into a new pool range (the previous one is released). */
+    void replaceIndexRange(GeometryPool::Handle& range, std::span<const uint32_t> indices) {
+        auto& pool = m_context.getGeometryPool();
+        pool.free(range);
+        if (m_indexType == vk::IndexType::eUint32) {
+            range = pool.allocateIndices(indices.data(), indices.size_bytes(), sizeof(uint32_t));
+            return;
+        }
+        std::vector<uint16_t> narrow(indices.begin(), indices.end());
+        range = pool.allocateIndices(narrow.data(), narrow.size() * sizeof(uint16_t), sizeof(uint16_t));
+    }
+
+    void uploadVertices(std::span<const Vertex> vertices) {
+        const VertexFormat previousFormat = m_vertexFormat;
+        m_vertexFormat = m_requestedFormat == VertexFormat::Auto ? Vertex::chooseFormat(vertices) : m_requestedFormat;
+
+        std::vector<std::byte> encoded;
+        const void* data = vertices.data();
+        size_t size = vertices.size_bytes();
+        if (m_vertexFormat != VertexFormat::Full) {
+            encoded = Vertex::encode(vertices, m_vertexFormat);
+            data = encoded.data();
+            size = encoded.size();
+        }
+
+        auto& pool = m_context.getGeometryPool();
+        if (m_vertexRange != GeometryPool::InvalidHandle && size == m_vertexBufferSize && m_vertexFormat == previousFormat) {
+            // Same layout and size: new content behind the same handle (the pool retires the old range)
+            pool.update(m_vertexRange, data, size);
+            return;
+        }
+        pool.free(m_vertexRange);
+        m_vertexRange = pool.allocateVertices(data, size, Vertex::getStride(m_vertexFormat));
+        m_vertexBufferSize = size;
+    }
+
     VulkanContext& m_context;
     std::vector<Vertex> m_vertices;
     std::vector<uint32_t> m_indices;
-    Scope<Buffer> m_vertexBuffer;
-    Scope<Buffer> m_indexBuffer;
+    std::vector<glm::vec3> m_physicsPositions; ///< PhysicsOnly retention: positions without the other attributes.
+    GeometryPool::Handle m_vertexRange = GeometryPool::InvalidHandle;
+    GeometryPool::Handle m_indexRange = GeometryPool::InvalidHandle;
+    GeometryPool::Handle m_clusterIndexRange = GeometryPool::InvalidHandle;
+    MeshletData m_meshlets;
     Ref<Texture> m_texture;
     Ref<Material> m_material;
     uint32_t m_indexCount;
+    VertexFormat m_requestedFormat = VertexFormat::Full;
+    vk::IndexType m_indexType = vk::IndexType::eUint32;
+    VertexFormat m_vertexFormat = VertexFormat::Full;
+    size_t m_vertexBufferSize = 0;
+    std::vector<MeshLOD> m_lods;
     AABB m_bounds;
-    bool m_cpuDataReleased = false;
+    MeshCPURetention m_cpuRetention = MeshCPURetention::Keep;
     bool m_visible = true;
 };
 
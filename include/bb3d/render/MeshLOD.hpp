@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <algorithm>
+#include <cmath>
+
+namespace bb3d {
+
+/**
+ * @brief One level of detail stored inside a Mesh index buffer.
+ *
+ * All levels share the vertex buffer of the mesh: a level is only a range
+ * of the (concatenated) index buffer.
+ */
+struct MeshLOD {
+    uint32_t firstIndex = 0;  ///< First index of this level in the index buffer.
+    uint32_t indexCount = 0;  ///< Number of indices of this level.
+    float screenSize = 1.0f;  ///< Level is used when the projected size (fraction of viewport height) drops below this value.
+    float error = 0.0f;       ///< Simplification error relative to the mesh extent (0 for LOD 0).
+};
+
+/** @brief Parameters for automatic LOD chain generation. */
+struct LODSettings {
+    uint32_t levels = 4;              ///< Total number of levels, LOD 0 included.
+    float reductionPerLevel = 0.5f;   ///< Target triangle ratio between two consecutive levels.
+    float maxError = 0.05f;           ///< Max geometric error allowed, relative to the mesh extent.
+    float firstScreenSize = 0.25f;    ///< Screen size below which LOD 1 is used. Halved for each following level.
+    uint32_t minTriangles = 256;      ///< Meshes below this triangle count keep a single level.
+};
+
+/** @brief Concatenated LOD index buffer (LOD 0 first) and its level table. */
+struct LODChain {
+    std::vector<uint32_t> indices;
+    std::vector<MeshLOD> levels;
+};
+
+namespace LOD {
+
+    /**
+     * @brief Approximates the fraction of the viewport height covered by a bounding sphere.
+     * @param radius World-space radius of the bounding sphere.
+     * @param distance Distance between the camera and the sphere center.
+     * @param projYScale Element [1][1] of the projection matrix (cot(fov/2)).
+     */
+    [[nodiscard]] inline float screenSize(float radius, float distance, float projYScale) {
+        if (distance <= radius) return 1.0f;
+        return std::abs(radius * projYScale) / distance;
+    }
+
+    /**
+     * @brief Chooses a level for the given screen size with hysteresis.
+     *
+     * A switch to a coarser level happens once the size drops below
+     * `threshold * (1 - hysteresis)`, and back to the finer level only once it
+     * exceeds `threshold * (1 + hysteresis)`. This avoids popping when an
+     * object stays near a threshold.
+     *
+     * @param levels Level table (LOD 0 first).
+     * @param size Projected screen size, already scaled by the LOD bias.
+     * @param previous Level selected during the previous frame.
+     * @param hysteresis Relative width of the dead band (0 = none).
+     */
+    [[nodiscard]] inline uint32_t selectLevel(std::span<const MeshLOD> levels, float size, uint32_t previous, float hysteresis) {
+        if (levels.size() <= 1) return 0;
+        const uint32_t last = static_cast<uint32_t>(levels.size()) - 1;
+        previous = std::min(previous, last);
+
+        uint32_t level = 0;
+        for (uint32_t i = 1; i <= last; ++i) {
+            // Thresholds around the previous level are widened to keep it stable.
+            float threshold = levels[i].screenSize;
+            if (i <= previous) threshold *= (1.0f + hysteresis);
+            else threshold *= (1.0f - hysteresis);
+            if (size < threshold) level = i;
+            else break;
+        }
+        return level;
+    }
+
+} // namespace LOD
+
+} // namespace bb3d
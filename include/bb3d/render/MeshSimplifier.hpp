@@ -0,0 +1,54 @@
+#pragma once
+
+#include "bb3d/render/MeshLOD.hpp"
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+
+namespace bb3d {
+
+/**
+ * @brief CPU mesh simplification based on Quadric Error Metrics (Garland & Heckbert).
+ *
+ * The simplifier performs half-edge collapses: vertices are only merged into
+ * existing vertices, so every simplified index buffer stays valid against the
+ * original vertex buffer. This lets all LODs of a Mesh share one vertex buffer.
+ *
+ * Border edges (open boundaries and attribute seams, which appear as borders
+ * since split vertices are not welded) are locked. This keeps UV seams intact
+ * and prevents cracks between meshes sharing an edge (e.g. planet faces).
+ *
+ * Positions are read through a stride so that `std::vector<Vertex>` can be
+ * passed directly without copying.
+ */
+class MeshSimplifier {
+public:
+    /**
+     * @brief Reduces a triangle list down to a target index count.
+     * @param positions Pointer to the first position (3 floats).
+     * @param vertexCount Number of vertices.
+     * @param stride Distance in bytes between two positions.
+     * @param indices Triangle list indices.
+     * @param targetIndexCount Desired number of indices (multiple of 3).
+     * @param targetError Maximum error allowed, relative to the mesh extent (e.g. 0.01 = 1%).
+     * @param outError Optional: receives the relative error reached.
+     * @return The simplified triangle list (may stay above the target if the error bound is hit first).
+     */
+    static std::vector<uint32_t> simplify(const float* positions, size_t vertexCount, size_t stride,
+                                          std::span<const uint32_t> indices,
+                                          size_t targetIndexCount, float targetError,
+                                          float* outError = nullptr);
+
+    /**
+     * @brief Builds a full LOD chain (LOD 0 = source indices) ready to be uploaded in one index buffer.
+     *
+     * Each level is simplified from the previous one. Generation stops early when a
+     * level no longer reduces the triangle count meaningfully.
+     */
+    static LODChain buildLODChain(const float* positions, size_t vertexCount, size_t stride,
+                                  std::span<const uint32_t> indices,
+                                  const LODSettings& settings = LODSettings{});
+};
+
+} // namespace bb3d
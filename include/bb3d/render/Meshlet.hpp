@@ -0,0 +1,74 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+
+namespace bb3d {
+
+/**
+ * @brief A cluster of triangles with bounded vertex/triangle counts.
+ *
+ * The triangles of a meshlet are contiguous in `MeshletData::indices`, so a
+ * meshlet can be drawn with a single indexed draw (`firstIndex`/`indexCount`).
+ */
+struct Meshlet {
+    uint32_t firstIndex = 0;     ///< First index in the cluster-ordered index buffer.
+    uint32_t indexCount = 0;     ///< Number of indices (3 x triangles).
+    uint32_t vertexCount = 0;    ///< Number of unique vertices referenced by the cluster.
+    glm::vec3 center{0.0f};      ///< Bounding sphere center (object space).
+    float radius = 0.0f;         ///< Bounding sphere radius.
+    glm::vec3 coneAxis{0.0f, 0.0f, 1.0f}; ///< Average facing direction of the triangles.
+    float coneCutoff = 1.0f;     ///< sin(half angle of the normal cone). >= 1 means the cone cannot be used for culling.
+};
+
+/** @brief Result of the meshlet decomposition of one mesh. */
+struct MeshletData {
+    std::vector<Meshlet> meshlets;
+    std::vector<uint32_t> indices; ///< Triangles reordered cluster by cluster (same vertex buffer as the mesh).
+
+    [[nodiscard]] bool empty() const { return meshlets.empty(); }
+};
+
+/**
+ * @brief Layout-compatible with `VkDrawIndexedIndirectCommand` (kept Vulkan-free for CPU tools and tests).
+ * @note `firstIndex` counts elements, so commands are valid for 16-bit and 32-bit index buffers alike:
+ *       the index type comes from the buffer bound by the mesh.
+ */
+struct IndexedDrawCommand {
+    uint32_t indexCount;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t vertexOffset;
+    uint32_t firstInstance;
+};
+
+/**
+ * @brief Splits a triangle list into meshlets.
+ *
+ * Clusters are grown greedily over triangle adjacency: the next triangle is the
+ * neighbour adding the fewest new vertices (ties broken by distance to the
+ * cluster center), which keeps clusters compact and their bounds tight.
+ */
+class MeshletBuilder {
+public:
+    static constexpr uint32_t DefaultMaxVertices = 64;
+    static constexpr uint32_t DefaultMaxTriangles = 124;
+
+    /**
+     * @param positions Pointer to the first position (3 floats).
+     * @param vertexCount Number of vertices.
+     * @param stride Distance in bytes between two positions.
+     * @param indices Triangle list indices.
+     * @param maxVertices Max unique vertices per meshlet.
+     * @param maxTriangles Max triangles per meshlet.
+     */
+    static MeshletData build(const float* positions, size_t vertexCount, size_t stride,
+                             std::span<const uint32_t> indices,
+                             uint32_t maxVertices = DefaultMaxVertices,
+                             uint32_t maxTriangles = DefaultMaxTriangles);
+};
+
+} // namespace bb3d
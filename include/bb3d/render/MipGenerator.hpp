@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace bb3d {
+
+class JobSystem; // Forward declaration
+
+/** @brief Role of a texture, which selects its mip filter space (and its block format when cooked). */
+enum class TextureUsage {
+    Albedo, ///< sRGB color: BC7 (or BC1/BC3 in fast mode), mips averaged in linear space.
+    Normal, ///< Tangent-space normal map: BC5 (X,Y), mips renormalized; Z is rebuilt in the shader.
+    Single, ///< Grayscale data (roughness, AO, metalness, height): BC4, sampled as R,R,R,1.
+    Data    ///< Linear multi-channel data (packed ORM...): BC7 unorm.
+};
+
+/** @brief Downsampling kernel of `MipGenerator`. */
+enum class MipFilter {
+    Box,   ///< 2x2 average: cheap, slightly blurry, aliases on fine patterns.
+    Kaiser ///< 8-tap windowed sinc (Kaiser window, alpha 4): sharper mips, what offline cookers use.
+};
+
+/**
+ * @brief CPU mip chain generation for RGBA8 images (runtime loads and the texture cooker).
+ *
+ * Filtering happens in float on whole RGBA texels (one `Float4` per texel):
+ * albedo is decoded from sRGB and re-encoded after filtering, normals are filtered as vectors
+ * and renormalized at every level, alpha and data maps stay linear. Each level is computed
+ * from the previous one, rows split across the JobSystem when one is given.
+ */
+namespace MipGenerator {
+
+    /** @brief Number of levels of a full chain down to 1x1. */
+    [[nodiscard]] uint32_t levelCount(uint32_t width, uint32_t height);
+
+    /** @brief Next level (half size, at least 1) of an RGBA8 image. */
+    std::vector<uint8_t> downsample(const uint8_t* rgba, uint32_t width, uint32_t height, TextureUsage usage,
+                                    MipFilter filter = MipFilter::Box, JobSystem* jobs = nullptr);
+
+    /** @brief RGBA8 mip chain (level 0 first, copied from `rgba`) down to 1x1. */
+    std::vector<std::vector<uint8_t>> buildMipChain(const uint8_t* rgba, uint32_t width, uint32_t height, TextureUsage usage,
+                                                    MipFilter filter = MipFilter::Box, JobSystem* jobs = nullptr);
+
+} // namespace MipGenerator
+
+} // namespace bb3d
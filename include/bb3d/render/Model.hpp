@@ -23,6 +23,11 @@ struct ModelLoadConfig {
     bool loadVertexColors = true;
     bool applyTransformations = true;
     bool recalculateNormals = false; ///< If true, computes flat normals and discards loaded ones (OBJ only)
+    bool generateLODs = false;       ///< If true, builds a QEM-simplified LOD chain for each mesh at import (synchronous, costly on large models).
+    LODSettings lodSettings{};       ///< Parameters of the generated LOD chain.
+    uint32_t meshletMinTriangles = 16384; ///< Meshes with at least this many triangles are split into meshlets (0 = never).
+    VertexFormat vertexFormat = VertexFormat::Full; ///< GPU vertex layout. Auto = smallest quantized format fitting each mesh, only for materials whose pipeline supports it (PBR).
+    MeshCPURetention cpuRetention = MeshCPURetention::Keep; ///< CPU data kept per mesh once uploaded (Keep is required by normalize()).
     
     glm::vec3 initialScale = {1.0f, 1.0f, 1.0f};
 };
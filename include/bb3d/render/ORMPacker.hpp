@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace bb3d {
+
+class JobSystem; // Forward declaration
+
+/** @brief Non-owning view of a single-channel 8-bit image (rows packed, top row first). */
+struct GrayImageView {
+    const uint8_t* pixels = nullptr; ///< Null = channel absent (replaced by its default value).
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+/**
+ * @brief CPU packing of occlusion, roughness and metallic maps into one RGBA8 ORM image.
+ *
+ * Rows are processed in bands spread over the JobSystem when one is given. Inputs
+ * whose size differs from the output are resampled on the fly, one row at a time
+ * (bilinear, 8-bit fixed point), so no full-size copy is made. The interleave
+ * kernel writes 16 texels per SSE2 step.
+ *
+ * Vulkan-free: `TextureGenerator::combineORM` decodes the files and uploads the result.
+ */
+namespace ORMPacker {
+
+    /** @brief Channel values used when a map is absent: occlusion 255, roughness 255, metallic 0. */
+    inline constexpr uint8_t DefaultOcclusion = 255;
+    inline constexpr uint8_t DefaultRoughness = 255;
+    inline constexpr uint8_t DefaultMetallic = 0;
+
+    /**
+     * @brief Interleaves three rows into RGBA (alpha = 255).
+     * @param out `count * 4` bytes.
+     */
+    void packRow(const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t* out, uint32_t count);
+
+    /** @brief Row `y` of `image` resampled to `width` x `height` (bilinear, texel centers aligned). */
+    void resampleRow(const GrayImageView& image, uint32_t width, uint32_t height, uint32_t y, uint8_t* out);
+
+    /**
+     * @brief RGBA8 ORM image of size `width` x `height` (R = occlusion, G = roughness, B = metallic).
+     * Absent maps take their default value; maps of another size are resampled.
+     */
+    [[nodiscard]] std::vector<uint8_t> pack(const GrayImageView& occlusion, const GrayImageView& roughness, const GrayImageView& metallic,
+                                            uint32_t width, uint32_t height, JobSystem* jobs = nullptr);
+
+} // namespace ORMPacker
+
+} // namespace bb3d
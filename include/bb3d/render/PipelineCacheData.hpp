@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace bb3d {
+
+/** @brief What a pipeline cache blob is only valid for. */
+struct PipelineCacheIdentity {
+    uint32_t vendorID = 0;
+    uint32_t deviceID = 0;
+    uint32_t driverVersion = 0;
+    std::array<uint8_t, 16> cacheUUID{}; ///< `VkPhysicalDeviceProperties::pipelineCacheUUID`.
+};
+
+/**
+ * @brief Validation and storage of the pipeline cache kept on disk between launches.
+ *
+ * The data returned by `vkGetPipelineCacheData` starts with a
+ * `VkPipelineCacheHeaderVersionOne` (header size, version, vendor, device, cache
+ * UUID), written least significant byte first. Drivers are not required to reject
+ * data from another GPU or driver, so a file is only handed back to Vulkan when its
+ * header matches the current device. Files are named after the cache UUID and the
+ * driver version: a driver update starts a new file instead of loading a stale one.
+ * Called by `VulkanContext::loadPipelineCache()` and `savePipelineCache()`, which own the `vk::PipelineCache`.
+ */
+class PipelineCacheData {
+public:
+    static constexpr uint32_t HeaderSize = 32;       ///< sizeof(VkPipelineCacheHeaderVersionOne).
+    static constexpr uint32_t HeaderVersionOne = 1;  ///< VK_PIPELINE_CACHE_HEADER_VERSION_ONE.
+
+    /** @brief True if `data` starts with a well-formed header written for `device`. */
+    [[nodiscard]] static bool isCompatible(std::span<const std::byte> data, const PipelineCacheIdentity& device);
+
+    /** @brief Cache file name of `device`: "pipelines_<uuid>_<driver version>.bin". */
+    [[nodiscard]] static std::string fileName(const PipelineCacheIdentity& device);
+
+    /** @brief Contents of a cache file (nullopt if missing or unreadable). */
+    [[nodiscard]] static std::optional<std::vector<std::byte>> read(const std::filesystem::path& path);
+
+    /** @brief Writes through a temporary file, so an interrupted write never leaves a partial cache. */
+    static bool write(const std::filesystem::path& path, std::span<const std::byte> data);
+};
+
+} // namespace bb3d
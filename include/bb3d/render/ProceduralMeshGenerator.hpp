@@ -24,6 +24,8 @@ private:
     struct FaceData {
         std::vector<Vertex> vertices;
         std::vector<uint32_t> indices;
+        LODChain lods; ///< Simplified levels, computed on the worker thread.
+        MeshletData meshlets; ///< Cluster decomposition of LOD 0, computed on the worker thread.
     };
 
     static FaceData generateFaceData(
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace bb3d {
+
+/**
+ * @brief Free-list suballocator of a linear range (offsets only, no memory owned).
+ *
+ * Free blocks are kept sorted by offset and coalesced on release; allocation
+ * is best-fit. Alignments do not need to be powers of two, so vertex ranges
+ * can be aligned on their stride (the draw `vertexOffset` is then exact).
+ * Used by `GeometryPool` for the vertex and index regions of its shared buffers.
+ */
+class RangeAllocator {
+public:
+    /** @brief New location of a live allocation after `compact()`. */
+    struct Move {
+        uint64_t from;
+        uint64_t to;
+        uint64_t size;
+    };
+
+    explicit RangeAllocator(uint64_t capacity = 0);
+
+    /**
+     * @brief Reserves `size` bytes at an offset multiple of `alignment`.
+     * @return Offset of the allocation, or nothing if no free block is large enough.
+     */
+    std::optional<uint64_t> allocate(uint64_t size, uint64_t alignment = 1);
+
+    /** @brief Releases the allocation starting at `offset`. */
+    void free(uint64_t offset);
+
+    /** @brief Extends the range (the new space is appended as free memory). */
+    void grow(uint64_t newCapacity);
+
+    /**
+     * @brief Packs every allocation towards offset 0, keeping order and alignment.
+     * @return The old and new location of every live allocation (moved or not).
+     */
+    std::vector<Move> compact();
+
+    [[nodiscard]] uint64_t getCapacity() const { return m_capacity; }
+    [[nodiscard]] uint64_t getUsed() const { return m_used; }
+    [[nodiscard]] size_t getAllocationCount() const { return m_allocations.size(); }
+    [[nodiscard]] uint64_t getLargestFreeBlock() const;
+
+    /** @brief 0 = all free memory is contiguous, close to 1 = scattered in small holes. */
+    [[nodiscard]] float getFragmentation() const;
+
+    /** @brief Size of the allocation starting at `offset` (0 if unknown). */
+    [[nodiscard]] uint64_t getAllocationSize(uint64_t offset) const;
+
+private:
+    struct AllocationInfo {
+        uint64_t size;
+        uint64_t alignment;
+    };
+
+    void insertFree(uint64_t offset, uint64_t size);
+
+    uint64_t m_capacity = 0;
+    uint64_t m_used = 0;
+    std::map<uint64_t, uint64_t> m_freeBlocks;            ///< offset -> size
+    std::map<uint64_t, AllocationInfo> m_allocations;      ///< offset -> info
+};
+
+} // namespace bb3d
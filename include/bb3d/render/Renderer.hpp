@@ -8,11 +8,24 @@
 #include "bb3d/scene/Scene.hpp"
 #include "bb3d/render/Material.hpp"
 #include "bb3d/render/Mesh.hpp"
+#include "bb3d/render/IndirectBuffer.hpp"
+#include "bb3d/render/ClusterCuller.hpp"
+#include "bb3d/render/InstanceCuller.hpp"
+#include "bb3d/render/InstanceBudget.hpp"
+#include "bb3d/render/InstanceData.hpp"
+#include "bb3d/render/ComputePipeline.hpp"
+#include "bb3d/render/StorageBuffer.hpp"
+#include "bb3d/render/DrawSort.hpp"
+#include "bb3d/render/DrawPartition.hpp"
+#include "bb3d/render/TransformCache.hpp"
 #include "bb3d/scene/Components.hpp"
 #include "bb3d/render/RenderTarget.hpp"
+#include "bb3d/render/EnvironmentLighting.hpp"
+#include "bb3d/render/BindlessMaterials.hpp"
 #include "bb3d/core/JobSystem.hpp"
 #include <glm/glm.hpp>
 #include <vector>
+#include <array>
 #include <unordered_map>
 
 #include "bb3d/scene/Frustum.hpp"
@@ -27,12 +40,40 @@ struct RenderCommand {
     Mesh* mesh;
     glm::mat4 transform;
     bool castShadows;
+    bool visible = true;  ///< Inside the camera frustum; off-screen shadow casters are kept for the shadow pass only.
+    uint32_t lod = 0; ///< Level of detail selected for this instance.
+    bool clustered = false;        ///< Drawn from the visible meshlets (indirect) instead of the whole mesh.
+    uint32_t clusterFirstDraw = 0; ///< First indirect command of this instance in the cluster draw buffer.
+    uint32_t clusterDrawCount = 0; ///< Number of indirect commands (0 = every cluster was culled).
+    AABB worldBounds;              ///< Tested against each shadow cascade.
+    bool gpuCulled = false;        ///< Visibility left to the GPU culling pass (drawn by its group's indirect-count draw).
+    uint32_t color = 0xFFFFFFFFu;  ///< Instance tint, RGBA8 (`InstanceData::packColor`); does not break batches.
+};
 
-    bool operator<(const RenderCommand& other) const {
-        if (type != other.type) return type < other.type;
-        if (material != other.material) return material < other.material;
-        return mesh < other.mesh;
-    }
+/** @brief Statistiques de la dernière frame préparée. */
+struct RenderStats {
+    uint32_t renderCommands = 0;      ///< Nombre de commandes de rendu collectées.
+    uint32_t commandsTested = 0;      ///< Commandes testées contre le frustum de la caméra.
+    uint32_t commandsCulled = 0;      ///< Commandes hors champ (les projeteurs d'ombre restent pour la passe d'ombres).
+    uint32_t commandsDrawn = 0;       ///< Commandes dessinées dans la passe principale.
+    uint32_t transformsUpdated = 0;   ///< Matrices monde recalculées (entités déplacées ou modifiées).
+    uint32_t particleEmitters = 0;    ///< Émetteurs dessinés (un draw instancié chacun).
+    uint32_t particlesDrawn = 0;      ///< Particules écrites dans le flux de la frame.
+    uint32_t instancesUploaded = 0;   ///< Instances écrites dans le buffer d'instances de la frame.
+    uint32_t instanceCapacity = 0;    ///< Capacité du buffer d'instances de la frame (agrandi à la demande).
+    uint32_t instancesOverBudget = 0; ///< Instances ignorées car au-delà de `GraphicsConfig::instanceBudget`.
+    uint32_t shadowCasters = 0;       ///< Instances dessinées dans les cascades d'ombres (toutes cascades confondues).
+    uint32_t shadowCastersCulled = 0; ///< Projeteurs écartés d'une cascade par le test en espace lumière.
+    uint32_t shadowCascadesCached = 0; ///< Cascades reprises de la frame précédente sans être re-rendues.
+    uint64_t trianglesSubmitted = 0;  ///< Triangles envoyés au GPU après sélection des LODs.
+    uint64_t trianglesSavedByLOD = 0; ///< Triangles économisés par les LODs (par rapport au LOD 0).
+    ClusterCullStats clusters;        ///< Culling par meshlet (instances découpées en clusters uniquement).
+    uint32_t clusterDraws = 0;        ///< Commandes indirectes émises pour les clusters visibles.
+    uint32_t gpuInstancesTested = 0;  ///< Instances confiées au culling GPU.
+    uint32_t gpuDrawGroups = 0;       ///< Appels `drawIndexedIndirectCount` de la passe principale.
+    uint32_t gpuInstancesDrawn = 0;   ///< Instances retenues par le culling GPU (relu après la fence, donc en retard de MAX_FRAMES_IN_FLIGHT frames).
+    uint32_t secondaryCommandBuffers = 0; ///< Command buffers secondaires enregistrés en parallèle (0 = tout enregistré sur le thread principal).
+    TextureStreamer::Stats textureStreaming; ///< Résidence des mips des textures streamées.
 };
 
 /**
@@ -49,6 +90,9 @@ struct RenderCommand {
  */
 class Renderer {
 public:
+    /** @brief Frames enregistrées en avance sur le GPU ; les ressources libérées attendent autant de frames avant recyclage. */
+    static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 3;
+
     Renderer(VulkanContext& context, Window& window, JobSystem& jobSystem, const EngineConfig& config);
     ~Renderer();
 
@@ -78,6 +122,9 @@ public:
     void setShadowsEnabled(bool enabled) { m_shadowsEnabledRuntime = enabled; }
     bool isShadowsEnabled() const { return m_shadowsEnabledRuntime; }
 
+    /** @brief Statistiques de la dernière frame (LODs, triangles...). */
+    [[nodiscard]] const RenderStats& getStats() const { return m_stats; }
+
     /** @brief Récupère la SwapChain actuelle. */
     SwapChain& getSwapChain() { return *m_swapChain; }
 
@@ -151,6 +198,19 @@ private:
     vk::ImageView m_shadowDepthView; // Vue complete 2D Array
     std::vector<vk::ImageView> m_shadowCascadeViews; // Vues individuelles par cascade
     vk::Sampler m_shadowSampler;
+
+    // Projeteurs visibles par cascade (positions dans l'ordre de dessin) et cache des cascades lointaines
+    struct ShadowCascadeState {
+        glm::mat4 lightViewProj{ 1.0f }; ///< Matrice avec laquelle la couche a été rendue.
+        uint64_t signature = 0;          ///< Projeteurs de la couche (mesh, LOD, transformation).
+        bool valid = false;
+    };
+    std::vector<std::vector<uint32_t>> m_shadowCasters;
+    std::vector<ShadowCascadeState> m_shadowCascadeStates;
+    std::vector<glm::mat4> m_shadowLightVPs;  ///< Matrice lumière de chaque cascade pour la frame.
+    std::vector<uint32_t> m_shadowPasses;     ///< Cascades re-rendues cette frame (les autres sont reprises du cache).
+    uint32_t m_shadowCascadeCount = 0;
+    bool m_shadowAnyReused = false;
     
     Frustum m_frustum;
     
@@ -167,7 +227,6 @@ private:
     std::unordered_map<std::string, Scope<Shader>> m_shaders;
 
     // Frames
-    static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 3;
     uint32_t m_currentFrame = 0;
     bool m_frameStarted = false;
 
@@ -208,27 +267,176 @@ private:
         glm::vec4 fogParams;    // .x = density, .y = start, .z = end, .w = padding
         glm::mat4 skyProj;      // Used EXCLUSIVELY for rendering skybox/skysphere without FOV distortion
         ShaderLight lights[10];
+        glm::vec4 irradianceSH[9]; // Irradiance / pi of the environment (rgb per coefficient)
+        glm::vec4 iblParams;       // .x = enabled, .y = max specular lod, .z = intensity
     };
 #pragma warning(pop)
     std::vector<Scope<UniformBuffer>> m_cameraUbos;
     
-    // Instancing SSBOs
-    static constexpr uint32_t MAX_INSTANCES = 10000;
+    // Instancing SSBOs : une capacité par frame en vol, agrandie géométriquement après la fence de la frame
+    // (les sets de descripteurs de cette frame ne sont alors plus lus par le GPU et peuvent être réécrits)
+    static constexpr uint32_t INITIAL_INSTANCE_CAPACITY = 10000;
+
     std::vector<Scope<Buffer>> m_instanceBuffers;
+    std::vector<uint32_t> m_instanceCapacities;
+    uint32_t m_instanceCount = 0; ///< Positions de dessin de la frame écrites dans le buffer d'instances (budget appliqué).
+    InstanceBudget m_instanceBudget;
+    void createInstanceBuffers(uint32_t frame, uint32_t capacity);
+    void uploadInstanceData();
+
+    // Culling par meshlet : commandes indirectes des clusters visibles (une liste par frame en vol)
+    static constexpr uint32_t MAX_CLUSTER_DRAWS = 65536;
+    std::vector<Scope<IndirectBuffer>> m_clusterDrawBuffers;
+    std::vector<IndexedDrawCommand> m_clusterDraws;
+    void cullClusters(const glm::mat4& viewProj, const glm::vec3& cameraPosition);
+
+    // Culling GPU des instances opaques : bornes et gabarits envoyés au compute, draws émis par drawIndexedIndirectCount.
+    // Les instances visibles sont compactées dans la seconde moitié du buffer d'instances (à partir de sa capacité).
+    static constexpr uint32_t MAX_GPU_DRAW_GROUPS = 1024;
+    /** @brief Suite de positions de dessin partageant pipeline, format, set de matériau et type d'index. */
+    struct GpuDrawGroup {
+        uint32_t firstPosition = 0;
+        uint32_t endPosition = 0;
+        uint32_t firstDraw = 0;  ///< Premier gabarit du groupe (et première commande de sortie).
+        uint32_t drawCount = 0;  ///< Nombre de gabarits : borne du nombre de commandes.
+    };
+    bool m_gpuCulling = false;
+    Scope<ComputePipeline> m_cullPipeline;
+    Scope<ComputePipeline> m_compactPipeline;
+    vk::DescriptorSetLayout m_cullDescriptorLayout;
+    std::vector<vk::DescriptorSet> m_cullDescriptorSets;
+    std::vector<Scope<StorageBuffer>> m_cullInstanceBuffers;
+    std::vector<Scope<StorageBuffer>> m_drawTemplateBuffers;
+    std::vector<Scope<StorageBuffer>> m_drawCountBuffers;
+    std::vector<Scope<IndirectBuffer>> m_gpuDrawBuffers;
+    std::vector<Scope<Buffer>> m_gpuCounterBuffers;
+    std::vector<GpuCullInstance> m_gpuCullInstances;
+    std::vector<GpuDrawTemplate> m_gpuDrawTemplates;
+    std::vector<GpuDrawGroup> m_gpuDrawGroups;
+    GpuCullPushConstants m_gpuCullConstants;
+    void createGpuCulling();
+    void buildGpuDraws(bool frustumCulling);
+    void cullInstancesOnGpu(vk::CommandBuffer cb);
 
     vk::DescriptorSetLayout m_globalDescriptorLayout;
     std::vector<vk::DescriptorSet> m_globalDescriptorSets;
 
+    // Éclairage ambiant IBL : textures liées aux bindings 3/4 de chaque set global (réécrits après la fence de leur frame)
+    Scope<EnvironmentLighting> m_environment;
+    std::vector<uint32_t> m_environmentVersions;
+    std::vector<Ref<Texture>> m_boundEnvironment; ///< Garde en vie le cubemap encore lu par une frame en vol.
+    void bindEnvironment(uint32_t frame);
+
     // Materials
     vk::DescriptorPool m_descriptorPool; 
+
+    // Matériaux PBR bindless (si supporté) : un set partagé, enregistrement du matériau de chaque instance dans son InstanceData
+    Ref<BindlessMaterials> m_bindless;
     
     // Cache pour compatibilité avec les Mesh sans Material explicite
     std::unordered_map<std::string, Ref<Material>> m_defaultMaterials;
 
     // Optimisation : Éviter les réallocations par frame
     std::vector<RenderCommand> m_renderCommands;
+    // Ordre de dessin : les commandes restent dans l'ordre de collecte, seules les clés (64 bits + index) sont triées
+    std::vector<DrawKey> m_drawKeys;
+    std::vector<DrawKey> m_drawKeyScratch;
+    std::unordered_map<const void*, uint32_t> m_sortIds; ///< IDs compacts des matériaux et meshes de la frame.
+    void sortRenderCommands(const Camera* camera);
+
+    // Extraction parallèle : tranches des storages EnTT traitées sur le JobSystem, chacune dans son propre tampon
+    static constexpr uint32_t ENTITIES_PER_EXTRACT_TASK = 1024;
+    static constexpr uint32_t MODELS_PER_EXTRACT_TASK = 128;
+    static constexpr size_t MIN_PARALLEL_MERGE = 4096; ///< En dessous, la fusion des tampons reste sur le thread appelant.
+    enum class ExtractSource : uint8_t { Meshes, Models, Colliders };
+    struct ExtractTask {
+        ExtractSource source = ExtractSource::Meshes;
+        uint32_t begin = 0;
+        uint32_t end = 0;
+    };
+    /** @brief Sélection de LOD différée : l'état d'hystérésis est partagé, il est mis à jour après la fusion. */
+    struct LODRequest {
+        uint32_t command = 0; ///< Index dans le tampon de la tranche.
+        uint64_t key = 0;
+        float screenSize = 0.0f;
+    };
+    struct ExtractChunk {
+        std::vector<RenderCommand> commands;
+        std::vector<LODRequest> lodRequests;
+        uint32_t tested = 0;
+        uint32_t culled = 0;
+        uint32_t transformsUpdated = 0;
+    };
+    std::vector<ExtractTask> m_extractTasks;
+    std::vector<ExtractChunk> m_extractChunks;
+    std::vector<uint32_t> m_extractOffsets;
     std::vector<glm::mat4> m_instanceTransforms;
     std::mutex m_commandMutex;
+    RenderStats m_stats;
+
+    // Sélection des LODs : niveau retenu par instance (entité + mesh) pour l'hystérésis
+    struct LODState {
+        uint32_t level = 0;
+        uint32_t lastFrame = 0;
+    };
+    std::unordered_map<uint64_t, LODState> m_lodStates;
+    uint32_t m_lodFrame = 0;
+    uint32_t selectLOD(uint64_t key, const Mesh& mesh, float screenSize);
+
+    // Enregistrement parallèle : cascades d'ombres et tranches de l'ordre de dessin enregistrées par le JobSystem
+    // dans des command buffers secondaires. Chaque tâche a son pool par frame en vol (un pool n'est jamais partagé
+    // entre deux threads) ; l'état des matériaux est résolu avant, sur le thread principal.
+    static constexpr uint32_t MAX_RECORD_TASKS = 16;
+    static constexpr uint32_t MIN_DRAWS_PER_RECORD_TASK = 512; ///< En dessous, une tranche ne vaut pas un command buffer.
+    static constexpr uint32_t NO_CASCADE = UINT32_MAX;
+    struct RecordTask {
+        uint32_t cascade = NO_CASCADE; ///< Cascade d'ombre enregistrée, ou NO_CASCADE pour une tranche de la passe principale.
+        uint32_t begin = 0;            ///< Positions de dessin [begin, end) de la tranche.
+        uint32_t end = 0;
+    };
+    /** @brief Ciel de la frame, résolu sur le thread principal. */
+    struct SkyDraw {
+        MaterialType type = MaterialType::Skybox;
+        vk::DescriptorSet set;
+        int flipY = 0;
+        bool active = false;
+    };
+    bool m_parallelRecording = false;
+    std::vector<std::array<vk::CommandPool, MAX_RECORD_TASKS>> m_recordPools;
+    std::vector<std::array<vk::CommandBuffer, MAX_RECORD_TASKS>> m_recordBuffers;
+    std::vector<RecordTask> m_recordTasks;
+    std::vector<DrawRange> m_recordRanges;
+    std::vector<DrawRange> m_recordSpans; ///< Groupes GPU de la frame : jamais coupés entre deux tâches.
+    uint32_t m_sceneRecordTasks = 0; ///< Tâches de la passe principale (les dernières de m_recordTasks).
+    std::vector<vk::DescriptorSet> m_drawSets; ///< Set de matériau de chaque position de dessin.
+    SkyDraw m_skyDraw;
+    void createRecordPools();
+    void resolveDrawSets(Scene& scene);
+    void recordSecondaries(bool shadowPass);
+    void recordDraws(vk::CommandBuffer cb, uint32_t begin, uint32_t end);
+    void recordShadowCascade(vk::CommandBuffer cb, uint32_t cascade);
+
+    // Particules : un flux compact (position, taille, couleur) par frame en vol, un quad instancié par émetteur.
+    // Le flux est écrit après la fence de la frame, en parallèle, directement dans le buffer mappé.
+    static constexpr uint32_t INITIAL_PARTICLE_CAPACITY = 65536;
+    struct ParticleDraw {
+        const ParticlePool* pool = nullptr;
+        Material* material = nullptr;
+        Mesh* mesh = nullptr;
+        uint32_t firstInstance = 0; ///< Première particule de l'émetteur dans le flux.
+        uint32_t count = 0;
+        vk::DescriptorSet set;      ///< Set du matériau, résolu avant l'enregistrement.
+    };
+    std::vector<ParticleDraw> m_particleDraws;
+    std::vector<glm::uvec2> m_particleChunks; ///< (émetteur, première particule) de chaque tâche d'écriture du flux.
+    std::vector<Scope<Buffer>> m_particleBuffers;
+    std::vector<uint32_t> m_particleCapacities;
+    uint32_t m_particleCount = 0;
+    std::unordered_map<MaterialType, Scope<GraphicsPipeline>> m_particlePipelines; ///< Particle et Plasma.
+    void createParticleBuffer(uint32_t frame, uint32_t capacity);
+    void prepareParticles(Scene& scene, bool frustumCulling, float viewportHeight);
+    void uploadParticles();
+    void drawParticles(vk::CommandBuffer cb);
 
     Scope<Mesh> m_skyboxCube;
     Scope<Mesh> m_particleQuad;
@@ -252,10 +460,11 @@ private:
     bool m_debugPhysicsEnabled = false;
     Ref<UnlitMaterial> m_debugColliderMat;
 
-    void renderSkybox(vk::CommandBuffer cb, Scene& scene);
-    void drawScene(vk::CommandBuffer cb, Scene& scene, vk::ImageView colorView, vk::ImageView depthView, vk::Extent2D extent);
+    void renderSkybox(vk::CommandBuffer cb);
+    void drawScene(vk::CommandBuffer cb, vk::ImageView colorView, vk::ImageView depthView, vk::Extent2D extent);
     void compositeToSwapchain(vk::CommandBuffer cb, uint32_t imageIndex);
-    void renderShadows(vk::CommandBuffer cb, Scene& scene, GlobalUBO& uboData);
+    bool prepareShadows(Scene& scene, GlobalUBO& uboData);
+    void renderShadows(vk::CommandBuffer cb);
     void updateGlobalUBO(uint32_t currentFrame, Scene& scene, GlobalUBO& uboData);
     void prepareRenderData(Scene& scene);
 
@@ -275,6 +484,7 @@ private:
 
     // A separate instance buffer and descriptor set for the picking pass to avoid overwriting main pass data
     std::vector<Scope<Buffer>> m_pickingInstanceBuffers;
+    std::vector<uint32_t> m_pickingCapacities; ///< Capacité (en instances) de chaque buffer de picking.
     std::vector<vk::DescriptorSet> m_pickingDescriptorSets;
 };
 
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+
+namespace bb3d {
+
+/**
+ * @brief Ring suballocator of a linear range with in-order reclamation (offsets only, no memory owned).
+ *
+ * Allocations are carved at the head and reclaimed from the tail. They may be
+ * released in any order (e.g. upload batches of different threads completing
+ * out of order): the tail only moves past a block once every older block is
+ * released too. Used by `StagingBuffer`, which maps the offsets into its persistent buffer.
+ */
+class RingAllocator {
+public:
+    struct Allocation {
+        uint64_t offset;
+        uint64_t id; ///< Identifier passed to release().
+    };
+
+    explicit RingAllocator(uint64_t capacity = 0);
+
+    /**
+     * @brief Reserves `size` bytes at an offset multiple of `alignment` (power of two).
+     * @return Nothing when the free space is too small (or too fragmented by the wrap-around).
+     */
+    std::optional<Allocation> allocate(uint64_t size, uint64_t alignment = 1);
+
+    /** @brief Marks an allocation as no longer used by the GPU. */
+    void release(uint64_t id);
+
+    [[nodiscard]] uint64_t getCapacity() const { return m_capacity; }
+    /** @brief Bytes between tail and head, alignment and wrap padding included. */
+    [[nodiscard]] uint64_t getUsed() const { return m_used; }
+    /** @brief Allocations not yet reclaimed (released or not). */
+    [[nodiscard]] size_t getBlockCount() const { return m_blocks.size(); }
+
+private:
+    struct Block {
+        uint64_t end;      ///< Head position after this block.
+        uint64_t size;     ///< Bytes consumed, padding included.
+        bool released = false;
+    };
+
+    uint64_t m_capacity = 0;
+    uint64_t m_head = 0;
+    uint64_t m_tail = 0;
+    uint64_t m_used = 0;
+    uint64_t m_firstId = 1; ///< Id of m_blocks.front().
+    std::deque<Block> m_blocks;
+};
+
+} // namespace bb3d
@@ -28,11 +28,15 @@ public:
     /** @brief Récupère le handle Vulkan du module. */
     [[nodiscard]] inline vk::ShaderModule getModule() const { return m_module; }
 
+    /** @brief Vrai si le module déclare la constante de spécialisation `constant_id = id` (ex: VERTEX_FORMAT = 0). */
+    [[nodiscard]] bool hasSpecializationConstant(uint32_t id) const;
+
 private:
     std::vector<char> readFile(std::string_view filename);
 
     VulkanContext& m_context;
     vk::ShaderModule m_module;
+    std::vector<uint32_t> m_specializationIds; ///< Ids des constantes de spécialisation (décorations SpecId du SPIR-V).
 };
 
 } // namespace bb3d
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "bb3d/render/AABB.hpp"
 #include <glm/glm.hpp>
 #include <vector>
 
@@ -35,6 +36,25 @@ public:
         float farZ, 
         uint32_t shadowMapRes
     );
+
+    /**
+     * @brief Test d'un projeteur d'ombre contre le volume orthographique d'une cascade.
+     *
+     * La boîte est extrudée vers la lumière : seuls les côtés et le plan far (côté récepteurs)
+     * sont testés, un objet placé entre la lumière et la cascade y projette toujours son ombre.
+     * @param lightViewProj Matrice retournée par `calculateLightSpaceMatrix`.
+     * @param worldBounds Boîte englobante du projeteur en espace monde.
+     */
+    static bool isCasterVisible(const glm::mat4& lightViewProj, const AABB& worldBounds);
+
+    /**
+     * @brief Indique si une cascade rendue avec `cached` couvre encore la zone de `current`.
+     *
+     * Le texel snapping rend les deux matrices identiques tant que la cascade ne s'est pas déplacée
+     * d'un texel : orientation et échelle doivent correspondre, le décalage rester sous le demi-texel.
+     * La profondeur peut glisser légèrement (les marges de `calculateLightSpaceMatrix` l'absorbent).
+     */
+    static bool canReuse(const glm::mat4& cached, const glm::mat4& current, uint32_t shadowMapRes);
 };
 
 } // namespace bb3d
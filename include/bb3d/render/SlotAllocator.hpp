@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+
+namespace bb3d {
+
+/**
+ * @brief Allocator of fixed-size slots (array indices) with deferred reuse.
+ *
+ * A released slot may still be read by frames in flight: it only becomes
+ * allocatable again after `latency` calls to `nextFrame()`. Recycled slots are
+ * reused before the array grows, so indices stay dense. Used by
+ * `BindlessMaterials` for its texture array and material records.
+ */
+class SlotAllocator {
+public:
+    explicit SlotAllocator(uint32_t capacity = 0, uint32_t latency = 0);
+
+    /** @brief Reserves a slot, or nothing if all of them are taken (or still retiring). */
+    std::optional<uint32_t> allocate();
+
+    /** @brief Releases `slot`; it becomes reusable `latency` frames later. */
+    void release(uint32_t slot);
+
+    /**
+     * @brief Advances the frame counter and recycles the slots released long enough ago.
+     * @param recycled If given, receives the slots that became reusable during this call.
+     */
+    void nextFrame(std::vector<uint32_t>* recycled = nullptr);
+
+    [[nodiscard]] uint32_t getCapacity() const { return m_capacity; }
+    /** @brief Slots allocated and not released (retiring slots are not counted). */
+    [[nodiscard]] uint32_t getUsed() const { return m_used; }
+    /** @brief One past the highest slot ever handed out. */
+    [[nodiscard]] uint32_t getHighWater() const { return m_next; }
+
+private:
+    struct Retired {
+        uint32_t slot;
+        uint64_t frame; ///< Frame from which the slot can be reused.
+    };
+
+    uint32_t m_capacity = 0;
+    uint32_t m_latency = 0;
+    uint32_t m_next = 0;
+    uint32_t m_used = 0;
+    uint64_t m_frame = 0;
+    std::vector<uint32_t> m_free;
+    std::deque<Retired> m_retired; ///< In release order, hence by increasing frame.
+};
+
+} // namespace bb3d
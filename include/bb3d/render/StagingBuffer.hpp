@@ -1,8 +1,8 @@
 #pragma once
 
 #include "bb3d/render/Buffer.hpp"
+#include "bb3d/render/RingAllocator.hpp"
 #include <mutex>
-#include <functional>
 
 namespace bb3d {
 
@@ -10,32 +10,44 @@ class VulkanContext; // Forward declaration
 
 /**
  * @brief Gère un buffer de staging persistant pour optimiser les transferts CPU -> GPU.
- * 
- * Utilise un buffer circulaire pour éviter les réallocations et permet de batcher
- * les commandes de transfert.
+ *
+ * Buffer circulaire : les zones sont réservées en tête et récupérées en queue
+ * quand le lot d'upload qui les lit est terminé (valeur de timeline de l'UploadQueue),
+ * sans jamais attendre tout le device. Les offsets respectent
+ * `optimalBufferCopyOffsetAlignment` (et la taille de bloc des formats compressés).
+ * Les requêtes trop grandes pour l'anneau utilisent un buffer dédié temporaire.
  */
 class StagingBuffer {
 public:
     StagingBuffer(VulkanContext& context, vk::DeviceSize size = 64 * 1024 * 1024);
     ~StagingBuffer();
 
-    /** @brief Réserve une zone dans le buffer de staging. */
+    /** @brief Zone réservée dans le buffer de staging (à confier à `UploadQueue::record`). */
     struct Allocation {
         vk::Buffer buffer;
-        vk::DeviceSize offset;
-        void* mappedData;
+        vk::DeviceSize offset = 0;
+        void* mappedData = nullptr;
+        uint64_t ringId = 0;      ///< Bloc de l'anneau (0 = buffer dédié).
+        Scope<Buffer> dedicated;  ///< Buffer temporaire des requêtes hors anneau.
     };
 
+    /** @brief Réserve une zone (bloque seulement si l'anneau est plein d'uploads en cours). */
     Allocation allocate(vk::DeviceSize size);
 
-    /** @brief Soumet une commande de transfert immédiate (bloquante pour l'instant, mais réutilisable). */
-    void submitCopy(const std::function<void(vk::CommandBuffer, vk::Buffer stagingBuffer, vk::DeviceSize offset)>& copyFunc);
+    /** @brief Rend une zone à l'anneau une fois sa copie exécutée par le GPU. */
+    void release(Allocation& allocation);
+
+    [[nodiscard]] vk::DeviceSize getSize() const { return m_size; }
+    [[nodiscard]] vk::DeviceSize getAlignment() const { return m_alignment; }
 
 private:
+    Allocation allocateDedicated(vk::DeviceSize size);
+
     VulkanContext& m_context;
     Scope<Buffer> m_buffer;
     vk::DeviceSize m_size;
-    vk::DeviceSize m_offset = 0;
+    vk::DeviceSize m_alignment = 16;
+    RingAllocator m_ring;
     std::mutex m_mutex;
 };
 
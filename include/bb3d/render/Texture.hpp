@@ -1,20 +1,41 @@
 #pragma once
 #include "bb3d/render/VulkanContext.hpp"
+#include "bb3d/render/KTX2.hpp"
+#include "bb3d/render/MipGenerator.hpp"
 #include "bb3d/resource/Resource.hpp"
+#include <atomic>
+#include <optional>
 #include <string_view>
 #include <span>
+#include <vector>
 
 namespace bb3d {
 
+/**
+ * @brief Sampled GPU image (2D or cubemap).
+ *
+ * KTX2 files (see `TextureCooker`) are uploaded as-is with their BCn mip chain. When loading
+ * a JPG/PNG whose `.ktx2` sibling exists, is not older than the image and the device samples BC
+ * formats, the cooked file is used.
+ * Otherwise the mips of decoded images are built on the CPU (`MipGenerator`, on the JobSystem)
+ * and every level is uploaded in a single copy.
+ *
+ * 2D images larger than the streaming tail are *streamed* when the TextureStreamer is
+ * enabled (off by default): only the small levels are uploaded at load time, the full chain
+ * stays in system memory and finer levels are made resident according to `requestResolution()`.
+ * Streaming trades VRAM for the same amount of RAM (uncompressed RGBA for non-cooked images).
+ */
 class Texture : public Resource {
 public:
     Texture(VulkanContext& context, std::string_view filepath, bool isColor = true);
-    Texture(VulkanContext& context, std::span<const std::byte> data, bool isColor = true);
+    Texture(VulkanContext& context, std::span<const std::byte> data, bool isColor = true); // Encoded image (PNG, JPG, KTX2...)
     Texture(VulkanContext& context, std::span<const std::byte> data, int width, int height, bool isColor = true); // Raw RGBA data
     
     /** @brief Constructor for a Cubemap from 6 files. */
     Texture(VulkanContext& context, const std::array<std::string, 6>& filepaths, bool isColor = true);
     Texture(VulkanContext& context, std::span<const std::byte> data, int width, int height, int layers, bool isColor = true); // Raw layered data (e.g. Cubemap)
+    /** @brief Texture generated on the CPU with its whole mip chain (e.g. baked lighting, see `IBLBaker`). */
+    Texture(VulkanContext& context, KTX2Texture&& texture);
 
     ~Texture();
 
@@ -26,26 +47,63 @@ public:
     [[nodiscard]] inline int getWidth() const { return m_width; }
     [[nodiscard]] inline int getHeight() const { return m_height; }
     [[nodiscard]] inline bool isCubemap() const { return m_isCubemap; }
+    [[nodiscard]] inline vk::Format getFormat() const { return m_format; }
+    [[nodiscard]] inline uint32_t getMipLevels() const { return m_mipLevels; }
 
     /** @brief Checks if GPU upload is complete and texture is ready for use. */
     bool isReady();
 
+    /** @brief True if only part of the mip chain may be resident (see TextureStreamer). */
+    [[nodiscard]] inline bool isStreamed() const { return m_streamSource != nullptr; }
+    /** @brief Finest mip level in VRAM (0 = full resolution). */
+    [[nodiscard]] inline uint32_t getResidentMip() const { return m_residentMip; }
+    /** @brief Changes each time the image view is replaced by a residency change (descriptors must be rewritten). */
+    [[nodiscard]] inline uint32_t getResidencyVersion() const { return m_residencyVersion; }
+
+    /** @brief Declares that an instance using this texture covers about `screenPixels` pixels this frame (thread-safe). */
+    void requestResolution(float screenPixels);
+
 private:
-    void initFromPixels(const unsigned char* pixels);
+    friend class TextureStreamer;
+    static constexpr uint32_t NoMipRequest = 0xFFFFFFFFu;
+
+    /** @brief Builds the mip chain of decoded RGBA8 layers (m_width x m_height) and loads it like a KTX2. */
+    void initFromPixels(std::span<const unsigned char* const> layers, TextureUsage usage);
+    /** @brief Streamed or fully uploaded, depending on its size and layout. */
+    void loadKTX2(KTX2Texture&& ktx);
+    void initFromKTX2(const KTX2Texture& ktx);
+    /** @brief Format, size and swizzle of a KTX2 texture (throws if the device cannot sample it). */
+    void setupFromKTX2(const KTX2Texture& ktx);
+    /** @brief Loads the `.ktx2` sibling of a source image if it exists, is up to date and is usable. */
+    bool tryLoadCooked(std::string_view filepath);
     void createImage(uint32_t width, uint32_t height, uint32_t layers = 1);
     void createImageView(uint32_t layers = 1);
+    vk::Image allocateImage(uint32_t width, uint32_t height, uint32_t levels, uint32_t layers, VmaAllocation& allocation);
+    vk::ImageView createView(vk::Image image, uint32_t levels, uint32_t layers);
     void createSampler();
-    
-    // Modified methods to support an external CommandBuffer (Async)
-    void generateMipmaps(vk::CommandBuffer cb, uint32_t layers = 1);
-    void transitionLayout(vk::CommandBuffer cb, vk::ImageLayout oldLayout, vk::ImageLayout newLayout, uint32_t layers = 1);
-    void copyBufferToImage(vk::CommandBuffer cb, vk::Buffer buffer, uint32_t layers = 1);
+    /** @brief Copies the prebuilt levels `firstLevel..last` into `image` (one region per level, no blit). */
+    UploadQueue::Ticket uploadLevels(const KTX2Texture& ktx, vk::Image image, uint32_t firstLevel);
+
+    // Streaming (driven by the TextureStreamer during its update)
+    [[nodiscard]] bool canStream(uint32_t width, uint32_t height) const;
+    /** @brief Keeps the chain in system memory and uploads the mip tail only. */
+    void initStreamed(KTX2Texture&& ktx);
+    [[nodiscard]] uint32_t consumeRequest() { return m_requestedMip.exchange(NoMipRequest, std::memory_order_relaxed); }
+    [[nodiscard]] uint32_t getTailMip() const { return m_tailMip; }
+    [[nodiscard]] std::span<const uint64_t> getResidentBytes() const { return m_residentBytes; }
+    [[nodiscard]] bool hasPendingResidency() const { return m_pending.has_value(); }
+    /** @brief Starts uploading a new image holding levels `firstMip..last`. */
+    void beginResidency(uint32_t firstMip);
+    /** @brief Switches to the pending image once its upload has completed. */
+    void pollResidency();
+    void destroyPending();
 
     VulkanContext& m_context;
     int m_width = 0, m_height = 0, m_channels = 0;
     uint32_t m_mipLevels = 1;
     vk::Format m_format = vk::Format::eR8G8B8A8Srgb;
     bool m_isCubemap = false;
+    vk::ComponentMapping m_swizzle{}; ///< BC4 is sampled as R,R,R,1 like a grayscale RGBA image.
     
     vk::Image m_image;
     VmaAllocation m_allocation = nullptr;
@@ -53,9 +111,23 @@ private:
     vk::Sampler m_sampler;
 
     // Async state
-    vk::Fence m_uploadFence = nullptr;
+    UploadQueue::Ticket m_uploadTicket;
     bool m_ready = false;
-    Scope<class Buffer> m_stagingBuffer; // Kept until upload is complete
+
+    // Streaming state
+    struct PendingResidency {
+        vk::Image image;
+        VmaAllocation allocation = nullptr;
+        uint32_t firstMip = 0;
+        UploadQueue::Ticket ticket;
+    };
+    Scope<KTX2Texture> m_streamSource;    ///< Full chain in system memory (null = not streamed).
+    std::vector<uint64_t> m_residentBytes; ///< [m] = VRAM of levels m..last.
+    uint32_t m_residentMip = 0;
+    uint32_t m_tailMip = 0;
+    uint32_t m_residencyVersion = 0;
+    std::atomic<uint32_t> m_requestedMip{ NoMipRequest };
+    std::optional<PendingResidency> m_pending;
 };
 
 } // namespace bb3d
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "bb3d/render/KTX2.hpp"
+#include "bb3d/render/MipGenerator.hpp"
+#include <string_view>
+#include <vector>
+
+namespace bb3d {
+
+/** @brief Options of the offline texture cooker. */
+struct TextureCookSettings {
+    bool fast = false;          ///< Albedo in BC1 (opaque) / BC3 (alpha) instead of BC7: faster to encode, lower quality.
+    bool generateMips = true;   ///< Full mip chain down to 1x1 (otherwise level 0 only).
+    MipFilter mipFilter = MipFilter::Kaiser; ///< Offline: the sharper filter is worth its cost.
+};
+
+/**
+ * @brief Converts RGBA8 images to GPU-ready KTX2 textures (mip chain + BCn), on the CPU.
+ *
+ * Used offline by `bb3d_texture_cooker` so that the runtime neither decodes JPG/PNG
+ * nor blits mips: `Texture` loads the `.ktx2` sibling of a source image when it exists.
+ */
+namespace TextureCooker {
+
+    /** @brief Guesses the usage from the file name (`_Color`, `_NormalGL`, `_Roughness`... suffixes). */
+    TextureUsage detectUsage(std::string_view filename);
+
+    /** @brief Block format stored for a usage. */
+    KTX2Format selectFormat(TextureUsage usage, bool hasAlpha, bool fast);
+
+    /** @brief RGBA8 mip chain (level 0 first), filtered according to the usage (see `MipGenerator`). */
+    std::vector<std::vector<uint8_t>> buildMipChain(const uint8_t* rgba, uint32_t width, uint32_t height, TextureUsage usage, MipFilter filter = MipFilter::Box);
+
+    /** @brief Builds the mip chain and compresses every level. */
+    KTX2Texture cook(const uint8_t* rgba, uint32_t width, uint32_t height, TextureUsage usage, const TextureCookSettings& settings = {});
+
+} // namespace TextureCooker
+
+} // namespace bb3d
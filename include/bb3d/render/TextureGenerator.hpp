@@ -6,18 +6,32 @@
 
 namespace bb3d {
 
+class JobSystem; // Forward declaration
+class ResourceManager;
+
 class TextureGenerator {
 public:
     /**
      * @brief Combine 3 textures (AO, Roughness, Metallic) en une seule texture ORM.
-     * 
+     *
+     * Les trois images sont décodées en parallèle sur le JobSystem s'il est fourni, puis
+     * entrelacées par `ORMPacker`. Si leurs tailles diffèrent, la plus grande est retenue
+     * et les autres sont rééchantillonnées (bilinéaire).
+     *
      * @param context Contexte Vulkan pour créer la texture finale.
      * @param aoPath Chemin vers la map d'Ambient Occlusion (R channel). Peut être vide (blanc par défaut).
      * @param roughnessPath Chemin vers la map de Roughness (G channel). Peut être vide (blanc par défaut).
      * @param metallicPath Chemin vers la map de Metallic (B channel). Peut être vide (noir par défaut).
+     * @param jobs Workers pour les décodages et l'entrelacement (nullptr = thread appelant).
      * @return Ref<Texture> La texture combinée ORM.
      */
-    static Ref<Texture> combineORM(VulkanContext& context, std::string_view aoPath, std::string_view roughnessPath, std::string_view metallicPath);
+    static Ref<Texture> combineORM(VulkanContext& context, std::string_view aoPath, std::string_view roughnessPath, std::string_view metallicPath, JobSystem* jobs = nullptr);
+
+    /**
+     * @brief Variante mise en cache par le ResourceManager : les mêmes trois chemins renvoient la même texture.
+     * @note Utilise les workers du ResourceManager.
+     */
+    static Ref<Texture> combineORM(ResourceManager& resources, std::string_view aoPath, std::string_view roughnessPath, std::string_view metallicPath);
 };
 
 } // namespace bb3d
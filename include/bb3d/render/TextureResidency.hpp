@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace bb3d {
+
+/** @brief Streaming state of one texture, as seen by `TextureResidency::plan`. */
+struct ResidencyEntry {
+    std::span<const uint64_t> residentBytes; ///< `residentBytes[m]`: VRAM used when levels m..last are resident.
+    uint32_t tailMip = 0;    ///< Finest level of the mip tail, always resident.
+    uint32_t desiredMip = 0; ///< Finest level wanted by the visible instances (clamped to the tail).
+    uint32_t targetMip = 0;  ///< Output: finest level to keep resident within the budget.
+};
+
+/**
+ * @brief CPU side of texture streaming: which mip levels each texture should keep in VRAM.
+ *
+ * Vulkan-free so that the policy can be tested on its own; `TextureStreamer` applies it.
+ */
+namespace TextureResidency {
+
+    /**
+     * @brief Finest useful level for a texture covering `screenPixels` pixels.
+     *
+     * One texel per pixel: a 2048 texture covering 256 pixels needs level 3. The
+     * bias is in levels (> 0 blurrier, < 0 sharper).
+     */
+    [[nodiscard]] uint32_t desiredMip(uint32_t textureSize, float screenPixels, uint32_t mipCount, float bias = 0.0f);
+
+    /** @brief First level whose largest side is at most `tailSize` (the always-resident mip tail). */
+    [[nodiscard]] uint32_t tailMip(uint32_t width, uint32_t height, uint32_t mipCount, uint32_t tailSize);
+
+    /**
+     * @brief Chooses `targetMip` for every entry so that the total stays within `budget`.
+     *
+     * Every texture starts at its desired level. While over budget, the finest level of
+     * the least degraded texture (fewest levels dropped, then largest level) is evicted,
+     * so that all textures lose one level before any loses two. Mip tails are never
+     * evicted: the result may exceed the budget if the tails alone do.
+     *
+     * @return Total resident bytes of the plan.
+     */
+    uint64_t plan(std::span<ResidencyEntry> entries, uint64_t budget);
+
+} // namespace TextureResidency
+
+} // namespace bb3d
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "bb3d/render/TextureResidency.hpp"
+#include <vulkan/vulkan.hpp>
+#include <vk_mem_alloc.h>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace bb3d {
+
+class VulkanContext; // Forward declaration
+class Texture;
+
+/**
+ * @brief Keeps the mip levels of streamed textures resident according to their on-screen size.
+ *
+ * A streamed `Texture` is created with its mip tail only (levels of at most `tailSize`
+ * texels) and keeps its full chain in system memory. Each frame the renderer reports
+ * the on-screen size of the instances using each texture (`Texture::requestResolution`);
+ * `update()` then turns the requests into a residency plan within the VRAM budget
+ * (see `TextureResidency::plan`) and starts the transitions:
+ *
+ * - A transition builds a new image holding levels `first..last`, uploaded through the
+ *   UploadQueue. The texture switches to it once the copy has completed, and its
+ *   materials rewrite their descriptors (`Texture::getResidencyVersion`).
+ * - Finer levels are streamed in at most `uploadBytesPerFrame` per frame, most blurry first.
+ * - Replaced images are destroyed `Renderer::MAX_FRAMES_IN_FLIGHT` updates later, when no recorded frame
+ *   can still sample them.
+ * - A texture not requested for `graceFrames` frames falls back to its tail.
+ */
+class TextureStreamer {
+public:
+    struct Settings {
+        bool enabled = false;                          ///< Set by the renderer (GraphicsConfig::enableTextureStreaming).
+        uint64_t budgetBytes = 512ull * 1024 * 1024;   ///< VRAM for the streamed textures (tails included).
+        uint64_t uploadBytesPerFrame = 16ull * 1024 * 1024; ///< Stream-in bandwidth (at least one transition per frame).
+        uint32_t tailSize = 128;                       ///< Largest side of the always-resident levels.
+        uint32_t graceFrames = 300;                    ///< Frames without request before a texture drops to its tail.
+        float bias = 0.0f;                             ///< Mip bias (> 0 blurrier, < 0 sharper).
+    };
+
+    /** @brief State of the last `update()`. */
+    struct Stats {
+        uint32_t textures = 0;        ///< Registered streamed textures.
+        uint64_t residentBytes = 0;   ///< VRAM currently used by their resident levels.
+        uint64_t plannedBytes = 0;    ///< VRAM of the plan (what the resident levels converge to).
+        uint64_t fullBytes = 0;       ///< VRAM if every texture was fully resident.
+        uint32_t pending = 0;         ///< Transitions waiting for their upload.
+        uint32_t streamedIn = 0;      ///< Transitions to finer levels started this frame.
+        uint32_t evicted = 0;         ///< Transitions to coarser levels started this frame.
+    };
+
+    explicit TextureStreamer(VulkanContext& context);
+    ~TextureStreamer();
+
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    void configure(const Settings& settings);
+    [[nodiscard]] const Settings& getSettings() const { return m_settings; }
+    [[nodiscard]] bool isEnabled() const { return m_settings.enabled; }
+
+    /** @brief Called by streamed textures (any thread). */
+    void registerTexture(Texture* texture);
+    void unregisterTexture(Texture* texture);
+
+    /**
+     * @brief Commits completed transitions, plans and starts new ones.
+     * @note Render thread, once per frame, after the fence of the oldest frame has been waited.
+     */
+    void update();
+
+    [[nodiscard]] Stats getStats() const;
+
+private:
+    friend class Texture;
+
+    struct Streamed {
+        Texture* texture;
+        uint32_t desiredMip;   ///< Last requested level (kept during the grace period).
+        uint64_t lastRequest;  ///< Frame of the last request.
+    };
+    struct Retired {
+        vk::Image image;
+        VmaAllocation allocation;
+        vk::ImageView view;
+        uint64_t frame;
+    };
+
+    /** @brief Destroys an image replaced by a transition once the frames in flight are done (called during `update()`). */
+    void retire(vk::Image image, VmaAllocation allocation, vk::ImageView view);
+    void destroyRetired(bool all);
+
+    VulkanContext& m_context;
+    Settings m_settings;
+    std::vector<Streamed> m_textures;
+    std::vector<ResidencyEntry> m_entries;
+    std::vector<size_t> m_streamIns;
+    std::deque<Retired> m_retired;
+    uint64_t m_frame = 0;
+    Stats m_stats;
+    mutable std::mutex m_mutex;
+};
+
+} // namespace bb3d
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "bb3d/render/AABB.hpp"
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace bb3d {
+
+/**
+ * @brief World matrix and bounds of a renderable entity, kept between frames.
+ *
+ * Building a world matrix from Euler angles and transforming the bounds is the
+ * bulk of the extraction cost, and most entities do not move. The cache keeps
+ * the inputs it was built from: `refresh()` compares them with the current ones
+ * and only recomputes when the TRS, the offset, the source (mesh or model) or its
+ * local bounds changed.
+ *
+ * This is a per-entity cache, not a retained draw list: extraction still visits
+ * every entity each frame, since systems edit components in place without `patch()`.
+ */
+struct TransformCache {
+    glm::vec3 translation{ 0.0f };
+    glm::vec3 rotation{ 0.0f }; ///< Euler angles in radians, as in `TransformComponent`.
+    glm::vec3 scale{ 0.0f };
+    glm::vec3 offset{ 0.0f };   ///< Local offset applied after the transform (models).
+    const void* source = nullptr; ///< Mesh or model the bounds were computed for.
+    AABB localBounds;             ///< Bounds of `source` at the last refresh (a mesh can be rebuilt in place).
+
+    glm::mat4 world{ 1.0f };
+    AABB worldBounds;
+
+    /**
+     * @brief Recomputes the world matrix and bounds if an input changed.
+     * @param localBounds Bounds of `source` in its own space.
+     * @return true if the world data was recomputed.
+     */
+    bool refresh(const glm::vec3& translation, const glm::vec3& rotation, const glm::vec3& scale,
+                 const glm::vec3& offset, const void* source, const AABB& localBounds);
+
+    /** @brief Same matrix as `TransformComponent::getTransform()` followed by a translation of `offset`. */
+    [[nodiscard]] static glm::mat4 composeWorld(const glm::vec3& translation, const glm::vec3& rotation, const glm::vec3& scale, const glm::vec3& offset);
+};
+
+/** @brief Cache of a `MeshComponent` (separate storage, so a mesh and a model on one entity never share it). */
+struct MeshTransformCache : TransformCache {};
+
+/**
+ * @brief Cache of a `ModelComponent`, with the world bounds of each of its meshes.
+ *
+ * A mesh of the model can be rebuilt without changing the model bounds, so each
+ * part keeps its own local bounds and is compared separately.
+ */
+struct ModelTransformCache : TransformCache {
+    std::vector<AABB> partLocalBounds;
+    std::vector<AABB> partBounds; ///< World bounds of each mesh, in `Model::getMeshes()` order.
+
+    /** @brief Sizes the part arrays; a new count invalidates every part. @return true if the count changed. */
+    bool resizeParts(size_t count);
+
+    /**
+     * @brief Recomputes the world bounds of part `index` if its local bounds changed.
+     * @param worldChanged true right after `refresh()` or `resizeParts()` returned true.
+     * @return true if the part was recomputed.
+     */
+    bool refreshPart(size_t index, const AABB& localBounds, bool worldChanged);
+};
+
+} // namespace bb3d
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "bb3d/render/StagingBuffer.hpp"
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace bb3d {
+
+class VulkanContext; // Forward declaration
+
+/**
+ * @brief Batches CPU -> GPU transfers and tracks their completion without stalling the queue.
+ *
+ * Each thread records its copies into its own command buffer (one command pool
+ * per thread, so `loadAsync` workers never share a pool). A batch is submitted
+ * once, either explicitly (`submit()`) or by the renderer just before the frame
+ * (`submitAll()`), and signals a timeline semaphore. Staging memory handed
+ * to `record()` is given back to the StagingBuffer ring when its batch has completed.
+ *
+ * Uploads share the graphics queue (see VulkanContext): a batch submitted before
+ * the frame is ordered before it, and every batch ends with a memory barrier
+ * making its writes visible to vertex input, index fetch and shaders.
+ *
+ * @warning Do not allocate staging memory or call `submit*()` / `flush()` from
+ * inside a `record()` callback: the thread batch is locked during the callback.
+ */
+class UploadQueue {
+public:
+    /** @brief Timeline value of a batch, 0 until the batch is submitted. */
+    struct Submission {
+        std::atomic<uint64_t> value{0};
+    };
+    /** @brief Completion handle of an upload (null = nothing to wait for). */
+    using Ticket = Ref<const Submission>;
+
+    explicit UploadQueue(VulkanContext& context);
+    ~UploadQueue();
+
+    UploadQueue(const UploadQueue&) = delete;
+    UploadQueue& operator=(const UploadQueue&) = delete;
+
+    /**
+     * @brief Records transfer commands into the open batch of the calling thread.
+     * @param commands Callback recording copies / layout transitions.
+     * @param keepAlive Resource (e.g. a staging buffer) released once the batch has completed.
+     * @return Ticket of the batch the commands belong to.
+     */
+    Ticket record(const std::function<void(vk::CommandBuffer)>& commands, Scope<Buffer> keepAlive = nullptr);
+
+    /** @brief Same as above, the staging zone read by the commands is released with the batch. */
+    Ticket record(const std::function<void(vk::CommandBuffer)>& commands, StagingBuffer::Allocation staging);
+
+    /** @brief Submits the batch of the calling thread (no-op if empty). */
+    void submit();
+
+    /** @brief Submits the batches of every thread (called by the renderer before each frame). */
+    void submitAll();
+
+    /** @brief Submits everything and waits for all uploads to complete. */
+    void flush();
+
+    /** @brief True when the GPU has executed the batch of this ticket. */
+    [[nodiscard]] bool isComplete(const Ticket& ticket) const;
+
+    /** @brief Blocks until the batch of this ticket has completed (submits it if needed). */
+    void wait(const Ticket& ticket);
+
+    /** @brief Recycles the command buffers and staging resources of completed batches. */
+    void collect();
+
+    /** @brief Number of batches submitted since the start (for statistics). */
+    [[nodiscard]] uint64_t getSubmittedBatchCount() const { return m_lastSubmitted.load(); }
+
+private:
+    struct InFlightBatch {
+        vk::CommandBuffer commandBuffer;
+        uint64_t value = 0;
+        std::vector<Scope<Buffer>> keepAlive;
+        std::vector<StagingBuffer::Allocation> staging;
+    };
+
+    struct ThreadBatch {
+        std::mutex mutex;
+        vk::CommandPool pool;
+        vk::CommandBuffer recording;            ///< Open batch, null when nothing is pending.
+        Ref<Submission> submission;             ///< Ticket of the open batch.
+        std::vector<Scope<Buffer>> keepAlive;   ///< Resources used by the open batch.
+        std::vector<StagingBuffer::Allocation> staging; ///< Staging zones read by the open batch.
+        std::vector<vk::CommandBuffer> freeCommandBuffers;
+        std::deque<InFlightBatch> inFlight;
+    };
+
+    ThreadBatch& currentThreadBatch();
+    /** @brief Locks the calling thread batch, opens it if needed and records into it. */
+    Ticket recordLocked(ThreadBatch& batch, const std::function<void(vk::CommandBuffer)>& commands);
+    void retire(InFlightBatch& batch);
+    void submitLocked(ThreadBatch& batch);
+    void recycleLocked(ThreadBatch& batch);
+    [[nodiscard]] uint64_t getCompletedValue() const;
+    void waitValue(uint64_t value) const;
+
+    VulkanContext& m_context;
+    vk::Semaphore m_timeline;
+    std::atomic<uint64_t> m_lastSubmitted{0};
+
+    std::unordered_map<std::thread::id, Scope<ThreadBatch>> m_threads;
+    mutable std::mutex m_threadsMutex;
+};
+
+} // namespace bb3d
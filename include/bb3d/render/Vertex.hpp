@@ -3,9 +3,12 @@
 #include <glm/gtx/hash.hpp>
 #include <glm/glm.hpp>
 #include "bb3d/core/Config.hpp"
+#include "bb3d/render/VertexPacking.hpp"
 #include <vulkan/vulkan.hpp>
 #include <vector>
 #include <array>
+#include <span>
+#include <cstddef>
 
 namespace bb3d {
 
@@ -82,6 +85,33 @@ struct Vertex {
 
         return attributeDescriptions;
     }
+
+    /** @brief Binding description of a GPU vertex format (stride of the encoded vertex). */
+    static vk::VertexInputBindingDescription getBindingDescription(VertexFormat format);
+
+    /**
+     * @brief Attribute descriptions of a GPU vertex format, indexed by `VertexLayout` location.
+     *
+     * Every location is always described so that pipelines filtering attributes by
+     * location keep working. Locations a format does not store (e.g. the color of
+     * `StaticLit`) alias existing bytes and are ignored by the shaders.
+     */
+    static std::array<vk::VertexInputAttributeDescription, 7> getAttributeDescriptions(VertexFormat format);
+
+    /** @brief Size in bytes of one vertex in the given format. */
+    static uint32_t getStride(VertexFormat format);
+
+    /**
+     * @brief Picks the smallest format able to represent the vertices.
+     *
+     * Skinned data (non-zero weights) with joint indices < 256 -> Skinned, non-white
+     * colors in [0, 1] -> Colored, otherwise StaticLit. Falls back to Full when the
+     * UVs exceed the range where half floats keep sub-texel precision.
+     */
+    static VertexFormat chooseFormat(std::span<const Vertex> vertices);
+
+    /** @brief Encodes vertices into the GPU layout of `format` (`Auto` is resolved first). */
+    static std::vector<std::byte> encode(std::span<const Vertex> vertices, VertexFormat format);
 };
 
 } // namespace bb3d
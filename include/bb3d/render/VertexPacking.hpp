@@ -0,0 +1,170 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace bb3d {
+
+/**
+ * @brief GPU layout of the vertex buffer of a mesh.
+ *
+ * `Full` is the historical 92-byte `Vertex`. The other formats are quantized
+ * encodings of the same data; shaders decode them according to the
+ * `VERTEX_FORMAT` specialization constant (see `assets/shaders/vertex_input.glsl`).
+ */
+enum class VertexFormat : uint8_t {
+    Full = 0,   ///< `Vertex` as is (92 bytes).
+    StaticLit,  ///< Position + octahedral normal/tangent + half UV (24 bytes).
+    Colored,    ///< StaticLit + RGBA8 color (28 bytes).
+    Skinned,    ///< StaticLit + 4 x uint8 joints + 4 x unorm8 weights (32 bytes).
+    Auto        ///< Resolved at upload time to the smallest format able to hold the mesh data.
+};
+
+/** @brief Number of concrete formats (`Auto` excluded). */
+inline constexpr uint32_t VertexFormatCount = 4;
+
+/** @brief Static lit vertex: float3 position, snorm16x2 octahedral normal and tangent, half2 UV. */
+struct VertexStaticLit {
+    glm::vec3 position;
+    int16_t normal[2];   ///< Octahedral encoding.
+    int16_t tangent[2];  ///< Octahedral encoding, bitangent sign stored in the sign of [1].
+    uint16_t uv[2];      ///< IEEE half floats.
+};
+
+/** @brief StaticLit + 8-bit sRGB-agnostic vertex color. */
+struct VertexColored {
+    glm::vec3 position;
+    int16_t normal[2];
+    int16_t tangent[2];
+    uint16_t uv[2];
+    uint8_t color[4];    ///< RGBA unorm8.
+};
+
+/** @brief StaticLit + 4 joint indices (uint8) and 4 weights (unorm8). */
+struct VertexSkinned {
+    glm::vec3 position;
+    int16_t normal[2];
+    int16_t tangent[2];
+    uint16_t uv[2];
+    uint8_t joints[4];
+    uint8_t weights[4];
+};
+
+static_assert(sizeof(VertexStaticLit) == 24, "VertexStaticLit must stay 24 bytes");
+static_assert(sizeof(VertexColored) == 28, "VertexColored must stay 28 bytes");
+static_assert(sizeof(VertexSkinned) == 32, "VertexSkinned must stay 32 bytes");
+
+/** @brief Scalar quantization helpers shared by the vertex encoders (and their tests). */
+namespace VertexPacking {
+
+    inline int16_t toSnorm16(float v) {
+        return static_cast<int16_t>(std::lround(std::clamp(v, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    inline float fromSnorm16(int16_t v) {
+        return std::max(static_cast<float>(v) / 32767.0f, -1.0f);
+    }
+
+    inline uint8_t toUnorm8(float v) {
+        return static_cast<uint8_t>(std::lround(std::clamp(v, 0.0f, 1.0f) * 255.0f));
+    }
+
+    /** @brief Maps a unit vector onto the [-1, 1]^2 octahedron. */
+    inline glm::vec2 octEncode(const glm::vec3& n) {
+        float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+        if (l1 <= 0.0f) return glm::vec2(0.0f);
+        glm::vec2 p(n.x / l1, n.y / l1);
+        if (n.z < 0.0f) {
+            p = glm::vec2((1.0f - std::abs(p.y)) * (p.x >= 0.0f ? 1.0f : -1.0f),
+                          (1.0f - std::abs(p.x)) * (p.y >= 0.0f ? 1.0f : -1.0f));
+        }
+        return p;
+    }
+
+    /** @brief Inverse of octEncode (same code as the shader). */
+    inline glm::vec3 octDecode(const glm::vec2& e) {
+        glm::vec3 n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+        float t = std::max(-n.z, 0.0f);
+        n.x += n.x >= 0.0f ? -t : t;
+        n.y += n.y >= 0.0f ? -t : t;
+        return glm::normalize(n);
+    }
+
+    inline void encodeNormal(const glm::vec3& n, int16_t out[2]) {
+        glm::vec2 e = octEncode(n);
+        out[0] = toSnorm16(e.x);
+        out[1] = toSnorm16(e.y);
+    }
+
+    /**
+     * @brief Encodes a tangent (xyz) and its bitangent sign (w).
+     *
+     * The second octahedral coordinate is remapped to [0, 1] and its sign
+     * carries `w`; it is kept away from 0 so that the sign survives.
+     */
+    inline void encodeTangent(const glm::vec4& t, int16_t out[2]) {
+        glm::vec2 e = octEncode(glm::vec3(t));
+        float y = std::max(e.y * 0.5f + 0.5f, 1.0f / 32767.0f);
+        out[0] = toSnorm16(e.x);
+        out[1] = toSnorm16(t.w < 0.0f ? -y : y);
+    }
+
+    inline glm::vec4 decodeTangent(const int16_t in[2]) {
+        float y = fromSnorm16(in[1]);
+        glm::vec2 e(fromSnorm16(in[0]), std::abs(y) * 2.0f - 1.0f);
+        return glm::vec4(octDecode(e), y < 0.0f ? -1.0f : 1.0f);
+    }
+
+    /** @brief float -> IEEE 754 half (round to nearest even, overflow to infinity). */
+    inline uint16_t toHalf(float value) {
+        uint32_t f;
+        std::memcpy(&f, &value, sizeof(f));
+        uint32_t sign = (f >> 16) & 0x8000u;
+        uint32_t abs = f & 0x7FFFFFFFu;
+        if (abs >= 0x7F800000u) return static_cast<uint16_t>(sign | 0x7C00u | (abs > 0x7F800000u ? 0x200u : 0u));
+        if (abs >= 0x477FF000u) return static_cast<uint16_t>(sign | 0x7C00u); // Rounds above 65504
+        if (abs < 0x38800000u) {
+            // Subnormal half
+            if (abs < 0x33000000u) return static_cast<uint16_t>(sign);
+            uint32_t mantissa = (abs & 0x007FFFFFu) | 0x00800000u;
+            uint32_t shift = 113u - (abs >> 23) + 13u;
+            uint32_t half = mantissa >> shift;
+            uint32_t rest = mantissa & ((1u << shift) - 1u);
+            uint32_t halfway = 1u << (shift - 1u);
+            if (rest > halfway || (rest == halfway && (half & 1u))) half++;
+            return static_cast<uint16_t>(sign | half);
+        }
+        uint32_t half = ((abs - 0x38000000u) >> 13);
+        uint32_t rest = abs & 0x1FFFu;
+        if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) half++;
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    inline float fromHalf(uint16_t h) {
+        uint32_t sign = (static_cast<uint32_t>(h) & 0x8000u) << 16;
+        uint32_t exponent = (h >> 10) & 0x1Fu;
+        uint32_t mantissa = h & 0x3FFu;
+        uint32_t f;
+        if (exponent == 0) {
+            if (mantissa == 0) f = sign;
+            else {
+                exponent = 113;
+                while ((mantissa & 0x400u) == 0) { mantissa <<= 1; exponent--; }
+                f = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+            }
+        } else if (exponent == 31) {
+            f = sign | 0x7F800000u | (mantissa << 13);
+        } else {
+            f = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+        }
+        float out;
+        std::memcpy(&out, &f, sizeof(out));
+        return out;
+    }
+
+} // namespace VertexPacking
+
+} // namespace bb3d
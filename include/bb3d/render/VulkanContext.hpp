@@ -2,10 +2,18 @@
 
 #include "bb3d/core/Base.hpp"
 #include "bb3d/render/StagingBuffer.hpp"
+#include "bb3d/render/GeometryPool.hpp"
+#include "bb3d/render/UploadQueue.hpp"
+#include "bb3d/render/TextureStreamer.hpp"
+#include "bb3d/render/PipelineCacheData.hpp"
 #include <vulkan/vulkan.hpp>
 #include <vk_mem_alloc.h>
+#include <filesystem>
+#include <mutex>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <unordered_map>
 
 struct SDL_Window;
 
@@ -60,16 +68,59 @@ public:
     /** @brief Récupère le gestionnaire de staging buffer. */
     [[nodiscard]] StagingBuffer& getStagingBuffer() { return *m_stagingBuffer; }
 
+    /** @brief Récupère les buffers de vertices/indices partagés par tous les meshes. */
+    [[nodiscard]] GeometryPool& getGeometryPool() { return *m_geometryPool; }
+    [[nodiscard]] const GeometryPool& getGeometryPool() const { return *m_geometryPool; }
+
+    /** @brief Faux avant init() et après cleanup() (les meshes détruits plus tard n'ont rien à libérer). */
+    [[nodiscard]] inline bool hasGeometryPool() const { return m_geometryPool != nullptr; }
+
+    /** @brief Récupère la file d'uploads groupés (copies enregistrées par thread, suivies par timeline semaphore). */
+    [[nodiscard]] UploadQueue& getUploadQueue() { return *m_uploadQueue; }
+
+    /** @brief Récupère le gestionnaire de résidence des mips des textures streamées (configuré par le Renderer). */
+    [[nodiscard]] TextureStreamer& getTextureStreamer() { return *m_textureStreamer; }
+
+    /** @brief Cache de pipelines partagé par toutes les créations (synchronisé en interne : utilisable depuis les workers). */
+    [[nodiscard]] inline vk::PipelineCache getPipelineCache() const { return m_pipelineCache; }
+
+    /**
+     * @brief Crée le cache de pipelines, pré-rempli avec le fichier de `directory` si son en-tête correspond au GPU et au driver.
+     * @note À appeler après init() et avant la création des pipelines.
+     */
+    void loadPipelineCache(const std::filesystem::path& directory);
+
+    /** @brief Écrit le cache de pipelines sur disque (aussi fait par cleanup()). */
+    void savePipelineCache();
+
+    /**
+     * @brief Mutex à prendre autour de tout `vkQueueSubmit` / `vkQueuePresentKHR`.
+     * @note Les transferts partagent la file graphique : les workers de chargement et le rendu soumettent sur le même VkQueue.
+     */
+    [[nodiscard]] std::mutex& getQueueMutex() { return m_queueMutex; }
+
+    /** @brief Indique si plusieurs draws indirects peuvent être émis en un seul appel (feature multiDrawIndirect). */
+    [[nodiscard]] inline bool supportsMultiDrawIndirect() const { return m_multiDrawIndirect; }
+
+    /** @brief Indique si le nombre de draws indirects peut être lu dans un buffer GPU (VK_KHR_draw_indirect_count + multiDrawIndirect). */
+    [[nodiscard]] inline bool supportsDrawIndirectCount() const { return m_drawIndirectCount; }
+
+    /** @brief Indique si les textures compressées BC1-BC7 sont échantillonnables (feature textureCompressionBC). */
+    [[nodiscard]] inline bool supportsBCTextures() const { return m_textureCompressionBC; }
+
+    /** @brief Indique si les textures peuvent être indexées dynamiquement dans un tableau de descripteurs (descriptor indexing, bindless). */
+    [[nodiscard]] inline bool supportsBindless() const { return m_descriptorIndexing; }
+
     /** @brief Nom commercial du GPU utilisé (ex: "NVIDIA GeForce RTX 3080"). */
     [[nodiscard]] inline std::string_view getDeviceName() const { return m_deviceName; }
 
     /** 
      * @brief Démarre un command buffer temporaire pour un transfert unique (CPU->GPU).
-     * @note Utilise une pool de commandes dédiée aux tâches courtes sur la queue graphique.
+     * @note Utilise la pool de commandes du thread appelant (une par thread, les pools ne sont pas thread-safe).
      */
     vk::CommandBuffer beginSingleTimeCommands();
 
-    /** @brief Soumet et termine un command buffer de transfert, puis attend la fin de l'exécution (bloquant). */
+    /** @brief Soumet et termine un command buffer de transfert, puis attend sa fence (bloquant, sans vider toute la file). */
     void endSingleTimeCommands(vk::CommandBuffer commandBuffer);
 
     /** 
@@ -99,11 +150,25 @@ private:
     uint32_t m_presentQueueFamily = 0;
     uint32_t m_transferQueueFamily = 0;
 
+    /** @brief Pool de commandes courtes du thread appelant (créée à la demande). */
+    vk::CommandPool getThreadCommandPool();
+
     VmaAllocator m_allocator = nullptr;
-    vk::CommandPool m_shortLivedCommandPool;
-    vk::CommandPool m_transferCommandPool;
+    std::unordered_map<std::thread::id, vk::CommandPool> m_threadCommandPools;
+    std::mutex m_commandPoolMutex;
+    std::mutex m_queueMutex;
     Scope<class StagingBuffer> m_stagingBuffer;
+    Scope<UploadQueue> m_uploadQueue;
+    Scope<GeometryPool> m_geometryPool;
+    Scope<TextureStreamer> m_textureStreamer;
     std::string m_deviceName;
+    vk::PipelineCache m_pipelineCache;
+    PipelineCacheIdentity m_pipelineCacheIdentity;
+    std::filesystem::path m_pipelineCachePath;
+    bool m_multiDrawIndirect = false;
+    bool m_drawIndirectCount = false;
+    bool m_textureCompressionBC = false;
+    bool m_descriptorIndexing = false;
 };
 
 } // namespace bb3d
\ No newline at end of file
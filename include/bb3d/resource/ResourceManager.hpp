@@ -9,6 +9,7 @@
 #include <string>
 #include <string_view>
 #include <shared_mutex>
+#include <future>
 #include <functional>
 #include <typeindex>
 #include <type_traits>
@@ -38,7 +39,9 @@ class ResourceManager;
  * @tparam T Type de la ressource (doit dériver de Resource).
  * 
  * @note Cette classe est interne au ResourceManager. Elle utilise un `std::shared_mutex`
- * pour permettre plusieurs lectures simultanées mais une seule écriture lors du chargement.
+ * pour permettre plusieurs lectures simultanées. Le chargement lui-même se fait hors verrou :
+ * la clé est d'abord réservée par un futur partagé, que les autres demandeurs attendent.
+ * Un chargement peut ainsi utiliser le JobSystem ou charger d'autres ressources du même type.
  */
 template<typename T>
 class ResourceCache : public IResourceCache {
@@ -57,50 +60,100 @@ public:
      */
     template<typename... Args>
     Ref<T> getOrLoad(std::string_view path, Args&&... args) {
+        return acquire(path, [&]() -> Ref<T> {
+            BB_CORE_INFO("ResourceCache: Loading '{0}'", path);
+
+            Ref<T> resource = nullptr;
+            try {
+                // Détection automatique du constructeur approprié via SFINAE/Concepts
+                if constexpr (std::is_constructible_v<T, VulkanContext&, ResourceManager&, std::string, Args...>) {
+                    resource = CreateRef<T>(m_context, *m_manager, std::string(path), std::forward<Args>(args)...);
+                } else if constexpr (std::is_constructible_v<T, VulkanContext&, std::string, Args...>) {
+                    resource = CreateRef<T>(m_context, std::string(path), std::forward<Args>(args)...);
+                }
+            } catch (const std::exception& e) {
+                BB_CORE_ERROR("ResourceCache: Failed to load '{0}': {1}", path, e.what());
+                return nullptr;
+            }
+
+            BB_CORE_INFO("ResourceCache: Successfully loaded '{0}'", path);
+            return resource;
+        });
+    }
+
+    /**
+     * @brief Récupère la ressource `key` du cache ou la crée avec `create`.
+     * Pour les ressources générées sans fichier source unique (ex: texture ORM combinée).
+     * Un résultat nul n'est pas mis en cache.
+     */
+    Ref<T> getOrCreate(std::string_view key, const std::function<Ref<T>()>& create) {
+        // `create` s'exécute hors verrou : il peut utiliser le JobSystem (ex: combineORM) ou charger d'autres textures
+        return acquire(key, [&]() -> Ref<T> {
+            try {
+                return create();
+            } catch (const std::exception& e) {
+                BB_CORE_ERROR("ResourceCache: Failed to create '{0}': {1}", key, e.what());
+                return nullptr;
+            }
+        });
+    }
+
+    /** @brief Vide le cache et libère les Refs (peut déclencher la destruction des objets GPU). */
+    void clear() override {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        m_resources.clear();
+    }
+
+private:
+    /**
+     * @brief Renvoie la ressource `key`, ou la construit avec `build` hors verrou.
+     * Un seul thread construit une clé donnée : les autres attendent son résultat. Un résultat nul n'est pas mis en cache.
+     */
+    template<typename Build>
+    Ref<T> acquire(std::string_view key, Build&& build) {
         // 1. Essai de lecture rapide (Shared Lock)
         {
             std::shared_lock<std::shared_mutex> readLock(m_mutex);
-            auto it = m_resources.find(path);
+            auto it = m_resources.find(key);
             if (it != m_resources.end()) return it->second;
         }
 
-        // 2. Double-check lock pour l'écriture (chargement réel)
-        std::unique_lock<std::shared_mutex> writeLock(m_mutex);
-        auto it = m_resources.find(path);
-        if (it != m_resources.end()) return it->second;
+        // 2. Double-check sous verrou exclusif, puis réservation de la clé
+        std::promise<Ref<T>> promise;
+        std::shared_future<Ref<T>> inFlight;
+        {
+            std::unique_lock<std::shared_mutex> writeLock(m_mutex);
+            auto it = m_resources.find(key);
+            if (it != m_resources.end()) return it->second;
+            auto pending = m_pending.find(key);
+            if (pending != m_pending.end()) inFlight = pending->second;
+            else m_pending.emplace(std::string(key), promise.get_future().share());
+        }
+        if (inFlight.valid()) return inFlight.get();
 
-        BB_CORE_INFO("ResourceCache: Loading '{0}'", path);
-        
+        // 3. Construction hors verrou, puis publication
         Ref<T> resource = nullptr;
         try {
-            // Détection automatique du constructeur approprié via SFINAE/Concepts
-            if constexpr (std::is_constructible_v<T, VulkanContext&, ResourceManager&, std::string, Args...>) {
-                resource = CreateRef<T>(m_context, *m_manager, std::string(path), std::forward<Args>(args)...);
-            } else if constexpr (std::is_constructible_v<T, VulkanContext&, std::string, Args...>) {
-                resource = CreateRef<T>(m_context, std::string(path), std::forward<Args>(args)...);
-            }
-        } catch (const std::exception& e) {
-            BB_CORE_ERROR("ResourceCache: Failed to load '{0}': {1}", path, e.what());
-            return nullptr; 
+            resource = build();
+        } catch (...) {
+            BB_CORE_ERROR("ResourceCache: Unknown error while building '{0}'", key);
         }
-
-        m_resources[std::string(path)] = resource;
-        BB_CORE_INFO("ResourceCache: Successfully loaded '{0}'", path);
+        {
+            std::unique_lock<std::shared_mutex> writeLock(m_mutex);
+            if (resource) m_resources[std::string(key)] = resource;
+            m_pending.erase(m_pending.find(key));
+        }
+        promise.set_value(resource);
         return resource;
     }
 
-    /** @brief Vide le cache et libère les Refs (peut déclencher la destruction des objets GPU). */
-    void clear() override {
-        std::unique_lock<std::shared_mutex> lock(m_mutex);
-        m_resources.clear();
-    }
-
-private:
     VulkanContext& m_context;
     ResourceManager* m_manager;
     std::shared_mutex m_mutex;
     // Map utilisant un StringHash transparent pour éviter des allocations de std::string lors de la recherche par string_view.
     std::unordered_map<std::string, Ref<T>, StringHash, std::equal_to<>> m_resources;
+    // Clés en cours de construction : les demandeurs concurrents attendent le même résultat.
+    std::unordered_map<std::string, std::shared_future<Ref<T>>, StringHash, std::equal_to<>> m_pending;
 };
 
 /**
@@ -150,14 +203,34 @@ public:
             auto resource = std::apply([&](auto&&... unpackedArgs) {
                 return load<T>(sPath, std::forward<decltype(unpackedArgs)>(unpackedArgs)...);
             }, tupleArgs);
+            // Les copies GPU du worker partent avant que la ressource soit visible ailleurs
+            submitUploads();
             if (callback) callback(resource);
         });
     }
 
+    /**
+     * @brief Récupère une ressource générée du cache, ou la crée (voir `ResourceCache::getOrCreate`).
+     * @param key Identifiant unique, distinct des chemins de fichiers (ex: "orm:...").
+     */
+    template<typename T>
+    Ref<T> getOrCreate(std::string_view key, const std::function<Ref<T>()>& create) {
+        return getCache<T>().getOrCreate(key, create);
+    }
+
     /** @brief Vide tous les caches de ressources. */
     void clearCache();
 
+    /** @brief Workers partagés (chargements parallèles, ex: images d'un glTF). */
+    [[nodiscard]] JobSystem& getJobSystem() { return m_jobSystem; }
+
+    /** @brief Contexte Vulkan des ressources (création de ressources générées). */
+    [[nodiscard]] VulkanContext& getContext() { return m_context; }
+
 private:
+    /** @brief Soumet les uploads enregistrés par le thread appelant (fin d'un chargement async). */
+    void submitUploads();
+
     /** @brief Récupère ou crée dynamiquement le cache pour un type spécifique. */
     template<typename T>
     ResourceCache<T>& getCache() {
@@ -12,6 +12,7 @@
 #include <string>
 
 #include "bb3d/scene/Camera.hpp"
+#include "bb3d/scene/ParticlePool.hpp"
 #include <variant>
 #include <functional>
 #include <nlohmann/json.hpp>
@@ -552,83 +553,33 @@ struct NativeScriptComponent {
 
 namespace bb3d {
 
-struct Particle {
-    glm::vec3 position{ 0.0f };
-    glm::vec3 velocity{ 0.0f };
-    glm::vec4 colorBegin{ 1.0f };
-    glm::vec4 colorEnd{ 1.0f };
-    float sizeBegin = 1.0f;
-    float sizeEnd = 0.0f;
-    float lifeTime = 1.0f;
-    float lifeRemaining = 0.0f;
-
-    // Optional Jolt integration
-    uint32_t physicsEntityId = 0; // 0 if unused
-};
-
-struct ParticleProps {
-    glm::vec3 position;
-    glm::vec3 velocity;
-    glm::vec3 velocityVariation;
-    glm::vec4 colorBegin;
-    glm::vec4 colorEnd;
-    float sizeBegin;
-    float sizeEnd;
-    float sizeVariation;
-    float lifeTime;
-};
-
-/** @brief Component to manage and emit particles. */
+/**
+ * @brief Component to manage and emit particles.
+ * @note The pool is updated by `Scene::onUpdate` and drawn as one instanced quad per emitter.
+ */
 struct ParticleSystemComponent {
-    std::vector<Particle> particlePool;
-    uint32_t poolIndex = 0;
+    ParticlePool pool;
 
     // Visual
-    Ref<Material> material; // Usually an UnlitMaterial with transparency
-    Ref<Mesh> mesh;         // If null, the Engine will use a default 2D Billboard Quad.
+    Ref<Material> material; // ParticleMaterial or PlasmaMaterial (additive); other types use the default particle material.
+    Ref<Mesh> mesh;         // If null, the Engine will use a default 2D Billboard Quad. Faces the camera like the quad.
 
     // Behavior
     bool injectIntoPhysics = false;
 
-    ParticleSystemComponent(uint32_t maxParticles = 1000) {
-        particlePool.resize(maxParticles);
-        poolIndex = maxParticles - 1;
-    }
+    ParticleSystemComponent(uint32_t maxParticles = 1000) : pool(maxParticles) {}
 
-    void emit(const ParticleProps& particleProps) {
-        Particle& particle = particlePool[poolIndex];
-        particle.position = particleProps.position;
-        
-        // Add variation
-        float rx = ((rand() % 100) / 100.0f) * 2.0f - 1.0f;
-        float ry = ((rand() % 100) / 100.0f) * 2.0f - 1.0f;
-        float rz = ((rand() % 100) / 100.0f) * 2.0f - 1.0f;
-        
-        particle.velocity = particleProps.velocity + particleProps.velocityVariation * glm::vec3(rx, ry, rz);
-        particle.colorBegin = particleProps.colorBegin;
-        particle.colorEnd = particleProps.colorEnd;
-        particle.lifeTime = particleProps.lifeTime;
-        particle.lifeRemaining = particleProps.lifeTime;
-        
-        particle.sizeBegin = particleProps.sizeBegin + particleProps.sizeVariation * rx;
-        particle.sizeEnd = particleProps.sizeEnd;
-
-        poolIndex = (poolIndex == 0) ? (uint32_t)particlePool.size() - 1 : poolIndex - 1;
-    }
+    void emit(const ParticleProps& particleProps) { pool.emit(particleProps); }
 
     void serialize(json& j) const {
         j["injectIntoPhysics"] = injectIntoPhysics;
-        j["maxParticles"] = particlePool.size();
+        j["maxParticles"] = pool.getCapacity();
         // We don't serialize active particles, just the configuration
     }
 
     void deserialize(const json& j) {
         if (j.contains("injectIntoPhysics")) j.at("injectIntoPhysics").get_to(injectIntoPhysics);
-        if (j.contains("maxParticles")) {
-            uint32_t maxP = j.at("maxParticles").get<uint32_t>();
-            particlePool.resize(maxP);
-            poolIndex = maxP - 1;
-        }
+        if (j.contains("maxParticles")) pool.resize(j.at("maxParticles").get<uint32_t>());
     }
 };
 
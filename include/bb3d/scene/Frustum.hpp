@@ -2,7 +2,7 @@
 
 #include <glm/glm.hpp>
 #include <array>
-#include "bb3d/render/Mesh.hpp" // Pour AABB
+#include "bb3d/render/AABB.hpp"
 
 namespace bb3d {
 
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "bb3d/render/AABB.hpp"
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+
+namespace bb3d {
+
+struct ParticleProps {
+    glm::vec3 position;
+    glm::vec3 velocity;
+    glm::vec3 velocityVariation;
+    glm::vec4 colorBegin;
+    glm::vec4 colorEnd;
+    float sizeBegin;
+    float sizeEnd;
+    float sizeVariation;
+    float lifeTime;
+};
+
+/** @brief Per-emitter random generator (xorshift32): a few cycles per draw, no shared state between emitters. */
+class ParticleRandom {
+public:
+    explicit ParticleRandom(uint32_t seed = 0x9E3779B9u) : m_state(seed != 0 ? seed : 1u) {}
+
+    uint32_t next() {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 17;
+        m_state ^= m_state << 5;
+        return m_state;
+    }
+
+    /** @brief Uniform in [0, 1). */
+    float unit() { return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f); }
+
+    /** @brief Uniform in [-1, 1). */
+    float signedUnit() { return unit() * 2.0f - 1.0f; }
+
+private:
+    uint32_t m_state;
+};
+
+/** @brief One particle of the GPU stream read by `particle_stream.vert` (std430, 20 bytes). */
+struct ParticleInstance {
+    float position[3];
+    float size;
+    uint32_t color; ///< RGBA8, same packing as `InstanceData::packColor`.
+};
+
+/**
+ * @brief Particles of one emitter, stored as structure of arrays.
+ *
+ * Each attribute has its own array and the live particles are kept packed in
+ * `[0, getAliveCount())`, so the update kernel streams through contiguous floats,
+ * four particles per SSE operation (`Float4`), and only touches live particles.
+ *
+ * A frame runs `update()` on disjoint ranges (safe from several threads), then
+ * `removeDead()` once: dead particles are replaced by the last live ones and the
+ * bounds of the emitter are recomputed for culling. `writeInstances()` turns a
+ * range into the compact GPU stream (position, size and color at the particle's age).
+ *
+ * When the pool is full, `emit()` recycles live particles in round-robin order.
+ * The pool owns no GPU memory: the renderer passes the mapped range of its stream
+ * buffer to `writeInstances()`.
+ */
+class ParticlePool {
+public:
+    /** @brief Particles per update or stream job. */
+    static constexpr uint32_t CHUNK_SIZE = 16384;
+
+    /** @param seed Random seed (0 = a different seed for each pool). */
+    explicit ParticlePool(uint32_t capacity = 1000, uint32_t seed = 0);
+
+    /** @brief Changes the capacity; live particles are dropped. */
+    void resize(uint32_t capacity);
+
+    void emit(const ParticleProps& props);
+
+    /** @brief Ages and moves the particles of `[begin, end)`. Ranges may run concurrently. */
+    void update(float deltaTime, uint32_t begin, uint32_t end);
+
+    /** @brief Packs the live particles after `update()` and recomputes the bounds. */
+    void removeDead();
+
+    /** @brief Single-threaded update of the whole pool. */
+    void update(float deltaTime) { update(deltaTime, 0, m_alive); removeDead(); }
+
+    /** @brief Writes the stream of the live particles of `[begin, end)` to `out` (`end - begin` entries). */
+    void writeInstances(ParticleInstance* out, uint32_t begin, uint32_t end) const;
+
+    [[nodiscard]] uint32_t getCapacity() const { return m_capacity; }
+    [[nodiscard]] uint32_t getAliveCount() const { return m_alive; }
+    /** @brief Positions of the live particles grown by their largest size (recomputed by `removeDead()`, extended by `emit()`). */
+    [[nodiscard]] const AABB& getBounds() const { return m_bounds; }
+    [[nodiscard]] ParticleRandom& random() { return m_random; }
+
+private:
+    void move(uint32_t from, uint32_t to);
+
+    uint32_t m_capacity = 0;
+    uint32_t m_alive = 0;
+    uint32_t m_recycle = 0; ///< Next live particle replaced when the pool is full.
+    ParticleRandom m_random;
+    AABB m_bounds;
+
+    std::vector<float> m_positionX, m_positionY, m_positionZ;
+    std::vector<float> m_velocityX, m_velocityY, m_velocityZ;
+    std::vector<float> m_lifeRemaining;
+    std::vector<float> m_inverseLifeTime;
+    std::vector<float> m_sizeBegin, m_sizeEnd;
+    std::vector<uint32_t> m_colorBegin, m_colorEnd; ///< RGBA8, interpolated per channel.
+};
+
+static_assert(sizeof(ParticleInstance) == 20, "ParticleInstance must match the std430 layout of particle_stream.vert");
+
+} // namespace bb3d
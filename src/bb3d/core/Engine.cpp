@@ -12,6 +12,7 @@
 #include <SDL3/SDL.h>
 #include <stdexcept>
 #include <fstream>
+#include <filesystem>
 
 namespace bb3d {
 
@@ -105,10 +106,14 @@ void Engine::Init() {
     // Initializes Vulkan by attaching to the SDL window created just before.
     m_VulkanContext = CreateScope<VulkanContext>();
     m_VulkanContext->init(m_Window->GetNativeWindow(), m_Config.window.title, m_Config.graphics.enableValidationLayers);
+    // Compiled pipelines from the previous launches (same GPU and driver only)
+    m_VulkanContext->loadPipelineCache(std::filesystem::path(m_Config.system.cacheDirectory) / "pipelines");
 
     // 6. Renderer (SwapChain, Pipelines, RenderPasses)
     // Depends on VulkanContext and Window.
     m_Renderer = CreateScope<Renderer>(*m_VulkanContext, *m_Window, *m_JobSystem, m_Config);
+    // Saved right away: the next launch benefits even if this one does not exit cleanly
+    m_VulkanContext->savePipelineCache();
 
     // 6.5 ImGui Layer (Editor UI)
 #if defined(BB3D_ENABLE_EDITOR)
@@ -217,6 +222,7 @@ void Engine::Run() {
     BB_CORE_INFO("Engine: Entering main loop.");
     float fpsTimer = 0.0f;
     int frameCount = 0;
+    uint32_t reportedInstanceCapacity = 0;
 
     m_LastTime = m_Window->GetTime(); // Initialize m_LastTime
 
@@ -232,6 +238,37 @@ void Engine::Run() {
         frameCount++;
         if (fpsTimer >= 1.0f) {
             BB_CORE_INFO("FPS: {} ({:.2f} ms)", frameCount, 1000.0f / frameCount);
+            if (m_Renderer) {
+                const auto& stats = m_Renderer->getStats();
+                BB_CORE_TRACE("Render: {} commands, {} triangles ({} saved by LOD)", stats.renderCommands, stats.trianglesSubmitted, stats.trianglesSavedByLOD);
+                if (stats.commandsTested > 0) {
+                    BB_CORE_TRACE("Frustum: {}/{} commands culled, {} drawn", stats.commandsCulled, stats.commandsTested, stats.commandsDrawn);
+                }
+                if (stats.instancesOverBudget > 0 || stats.instanceCapacity != reportedInstanceCapacity) {
+                    BB_CORE_TRACE("Instances: {}/{} slots used, {} over budget", stats.instancesUploaded, stats.instanceCapacity, stats.instancesOverBudget);
+                    reportedInstanceCapacity = stats.instanceCapacity;
+                }
+                if (stats.particleEmitters > 0) {
+                    BB_CORE_TRACE("Particles: {} in {} emitters", stats.particlesDrawn, stats.particleEmitters);
+                }
+                if (stats.secondaryCommandBuffers > 0) {
+                    BB_CORE_TRACE("Recording: {} secondary command buffers", stats.secondaryCommandBuffers);
+                }
+                if (stats.gpuInstancesTested > 0) {
+                    BB_CORE_TRACE("GPU culling: {} instances in {} groups, {} visible", stats.gpuInstancesTested, stats.gpuDrawGroups, stats.gpuInstancesDrawn);
+                }
+                if (stats.shadowCasters + stats.shadowCastersCulled > 0 || stats.shadowCascadesCached > 0) {
+                    BB_CORE_TRACE("Shadows: {} casters drawn, {} culled, {} cascades cached", stats.shadowCasters, stats.shadowCastersCulled, stats.shadowCascadesCached);
+                }
+                if (stats.clusters.tested > 0) {
+                    BB_CORE_TRACE("Clusters: {}/{} visible ({} frustum, {} backface), {} indirect draws", stats.clusters.visible, stats.clusters.tested, stats.clusters.frustumCulled, stats.clusters.backfaceCulled, stats.clusterDraws);
+                }
+                if (stats.textureStreaming.textures > 0) {
+                    const auto& tex = stats.textureStreaming;
+                    BB_CORE_TRACE("Textures: {} streamed, {} MB resident / {} MB full (plan {} MB), {} pending", tex.textures,
+                        tex.residentBytes >> 20, tex.fullBytes >> 20, tex.plannedBytes >> 20, tex.pending);
+                }
+            }
             fpsTimer = 0.0f;
             frameCount = 0;
         }
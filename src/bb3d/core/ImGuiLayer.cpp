@@ -59,6 +59,7 @@ ImGuiLayer::ImGuiLayer(VulkanContext& context, Window& window, SwapChain& swapCh
     initInfo.QueueFamily = m_context.getGraphicsQueueFamily();
     initInfo.Queue = m_context.getGraphicsQueue();
     initInfo.DescriptorPool = m_descriptorPool;
+    initInfo.PipelineCache = m_context.getPipelineCache();
     initInfo.MinImageCount = 2;
     initInfo.ImageCount = static_cast<uint32_t>(swapChain.getImageCount());
     initInfo.MSAASamples = VK_SAMPLE_COUNT_1_BIT;
@@ -664,7 +665,7 @@ void ImGuiLayer::showInspector() {
                         auto TextureSlot = [&](const char* label, bool isColor, std::function<void(Ref<Texture>)> setter) {
                             ImGui::PushID(label);
                             if (ImGui::Button(ICON_FA_FOLDER_OPEN)) {
-                                auto selection = pfd::open_file("Load Texture", ".", { "Image Files", "*.png *.jpg *.jpeg *.tga *.bmp" }).result();
+                                auto selection = pfd::open_file("Load Texture", ".", { "Image Files", "*.png *.jpg *.jpeg *.tga *.bmp *.ktx2" }).result();
                                 if (!selection.empty()) {
                                     try {
                                         auto tex = Engine::Get().assets().load<Texture>(selection[0], isColor);
@@ -1004,7 +1005,8 @@ void ImGuiLayer::showInspector() {
             } else if (m_focusedComponent == "ParticleSystem" && m_selectedEntity.has<bb3d::ParticleSystemComponent>()) {
                 if (ComponentPropertiesHeader("ParticleSystem", ICON_FA_FIRE, colRender, true, [&](){ m_selectedEntity.remove<bb3d::ParticleSystemComponent>(); m_focusedComponent = ""; })) {
                     auto& ps = m_selectedEntity.get<bb3d::ParticleSystemComponent>();
-                    ImGui::Text("Max Particles: %d", (int)ps.particlePool.size());
+                    ImGui::Text("Max Particles: %d", (int)ps.pool.getCapacity());
+                    ImGui::Text("Live Particles: %d", (int)ps.pool.getAliveCount());
                     
                     if (ps.material) {
                         auto partMat = std::dynamic_pointer_cast<bb3d::ParticleMaterial>(ps.material);
@@ -1013,7 +1015,7 @@ void ImGuiLayer::showInspector() {
                                 auto TextureSlot = [&](const char* label, std::function<void(bb3d::Ref<bb3d::Texture>)> setter) {
                                     ImGui::PushID(label);
                                     if (ImGui::Button(ICON_FA_FOLDER_OPEN)) {
-                                        auto selection = pfd::open_file("Load Particle Texture", ".", { "Image Files", "*.png *.jpg *.jpeg *.tga *.bmp" }).result();
+                                        auto selection = pfd::open_file("Load Particle Texture", ".", { "Image Files", "*.png *.jpg *.jpeg *.tga *.bmp *.ktx2" }).result();
                                         if (!selection.empty()) {
                                             try {
                                                 auto tex = bb3d::Engine::Get().assets().load<bb3d::Texture>(selection[0], true);
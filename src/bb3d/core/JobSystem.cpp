@@ -1,5 +1,6 @@
 #include "bb3d/core/JobSystem.hpp"
 #include "bb3d/core/Log.hpp"
+#include <algorithm>
 
 namespace bb3d {
 
@@ -44,7 +45,7 @@ void JobSystem::shutdown() {
     m_queues.clear();
 }
 
-void JobSystem::pushInternal(std::function<void(std::stop_token)>&& job) {
+void JobSystem::pushInternal(std::function<void(std::stop_token)>&& job, const std::atomic<int>* counter) {
     // Round-Robin Dispatch : On distribue équitablement les tâches
     // Cela évite qu'une seule queue soit surchargée (diminue la nécessité du vol)
     const uint32_t queueCount = static_cast<uint32_t>(m_queues.size());
@@ -52,7 +53,7 @@ void JobSystem::pushInternal(std::function<void(std::stop_token)>&& job) {
 
     {
         std::lock_guard<std::mutex> lock(m_queues[queueIndex]->mutex);
-        m_queues[queueIndex]->queue.push_back({std::move(job)});
+        m_queues[queueIndex]->queue.push_back({std::move(job), counter});
     }
     
     // Réveil massif pour garantir que les jobs sont pris en charge rapidement
@@ -94,6 +95,19 @@ bool JobSystem::popJob(Job& outJob, uint32_t threadIndex) {
     return false;
 }
 
+bool JobSystem::popJobOf(Job& outJob, const std::atomic<int>* counter) {
+    for (auto& queue : m_queues) {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        auto it = std::find_if(queue->queue.begin(), queue->queue.end(), [counter](const Job& job) { return job.counter == counter; });
+        if (it != queue->queue.end()) {
+            outJob = std::move(*it);
+            queue->queue.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
 void JobSystem::workerLoop(uint32_t threadIndex, std::stop_token st) {
     while (!st.stop_requested()) {
         Job job;
@@ -143,11 +157,9 @@ void JobSystem::wait(const JobCounter& counter) {
     // Tant que le compteur n'est pas à 0
     while (counter->load(std::memory_order_acquire) > 0) {
         Job job;
-        // Le Main Thread (ou appelant) participe !
-        // On utilise un index "fictif" (ex: tournant) pour qu'il vole un peu partout
-        static std::atomic<uint32_t> callerIndex{0};
-        
-        if (popJob(job, callerIndex++)) {
+        // L'appelant participe, mais uniquement aux jobs de son compteur : il peut tenir des verrous
+        // (cache de ressources) que des jobs étrangers reprendraient. Les workers exécutent le reste.
+        if (popJobOf(job, counter.get())) {
             job.task(std::stop_token{}); 
             yieldCount = 0;
         } else {
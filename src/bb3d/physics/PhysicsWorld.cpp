@@ -326,7 +326,7 @@ namespace bb3d {
                     JPH::ConvexHullShapeSettings settings;
                     settings.mMaxConvexRadius = phys.collisionMargin;
                     for (const auto& mesh : targetMeshes) {
-                        for (const auto& v : mesh->getVertices()) settings.mPoints.push_back(toJPH(v.position * tf.scale));
+                        mesh->forEachPosition([&](const glm::vec3& p) { settings.mPoints.push_back(toJPH(p * tf.scale)); });
                     }
                     shape = settings.Create().Get();
                 } else {
@@ -334,12 +334,16 @@ namespace bb3d {
                     JPH::IndexedTriangleList triangles;
                     uint32_t vertexBase = 0;
                     for (const auto& mesh : targetMeshes) {
-                        for (const auto& v : mesh->getVertices()) vertices.push_back(toJPHFloat3(v.position * tf.scale));
+                        if (!mesh->hasCollisionData()) {
+                            BB_CORE_WARN("Physics: Mesh collider skipped, its CPU data was dropped after upload.");
+                            continue;
+                        }
+                        mesh->forEachPosition([&](const glm::vec3& p) { vertices.push_back(toJPHFloat3(p * tf.scale)); });
                         const auto& indices = mesh->getIndices();
                         for (size_t i = 0; i < indices.size(); i += 3) {
                             triangles.push_back({indices[i] + vertexBase, indices[i+1] + vertexBase, indices[i+2] + vertexBase});
                         }
-                        vertexBase += (uint32_t)mesh->getVertices().size();
+                        vertexBase += (uint32_t)mesh->getPositionCount();
                     }
                     shape = JPH::MeshShapeSettings(vertices, triangles).Create().Get();
                 }
@@ -0,0 +1,166 @@
+#include "bb3d/render/BindlessMaterials.hpp"
+#include "bb3d/render/Texture.hpp"
+#include "bb3d/render/VulkanContext.hpp"
+#include "bb3d/render/Renderer.hpp"
+#include "bb3d/core/Log.hpp"
+#include <algorithm>
+#include <array>
+
+namespace bb3d {
+
+BindlessMaterials::BindlessMaterials(VulkanContext& context) : m_context(context) {
+    auto dev = m_context.getDevice();
+    constexpr uint32_t FramesInFlight = Renderer::MAX_FRAMES_IN_FLIGHT;
+    m_sets.resize(FramesInFlight);
+    m_materialBuffers.resize(FramesInFlight);
+    m_pendingTextures.resize(FramesInFlight);
+    m_pendingMaterials.resize(FramesInFlight);
+
+    // Update-after-bind is only used for its limits, far above the classic per-stage sampler limits
+    auto properties = m_context.getPhysicalDevice().getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceDescriptorIndexingProperties>();
+    const auto& limits = properties.get<vk::PhysicalDeviceDescriptorIndexingProperties>();
+    const uint32_t textureCapacity = std::min({ MaxTextures,
+        limits.maxPerStageDescriptorUpdateAfterBindSamplers, limits.maxPerStageDescriptorUpdateAfterBindSampledImages,
+        limits.maxDescriptorSetUpdateAfterBindSamplers, limits.maxDescriptorSetUpdateAfterBindSampledImages });
+    m_textureAllocator = SlotAllocator(textureCapacity, FramesInFlight);
+    m_materialAllocator = SlotAllocator(MaxMaterials, FramesInFlight);
+    m_textures.resize(textureCapacity);
+    m_materials.resize(MaxMaterials);
+
+    std::array<vk::DescriptorSetLayoutBinding, 2> bindings = {
+        vk::DescriptorSetLayoutBinding{0, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eFragment},
+        vk::DescriptorSetLayoutBinding{1, vk::DescriptorType::eCombinedImageSampler, textureCapacity, vk::ShaderStageFlagBits::eFragment}
+    };
+    std::array<vk::DescriptorBindingFlags, 2> bindingFlags = {
+        vk::DescriptorBindingFlags{},
+        vk::DescriptorBindingFlagBits::ePartiallyBound | vk::DescriptorBindingFlagBits::eUpdateAfterBind
+    };
+    vk::DescriptorSetLayoutBindingFlagsCreateInfo flagsInfo(static_cast<uint32_t>(bindingFlags.size()), bindingFlags.data());
+    vk::DescriptorSetLayoutCreateInfo layoutInfo(vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool, static_cast<uint32_t>(bindings.size()), bindings.data());
+    layoutInfo.pNext = &flagsInfo;
+    m_layout = dev.createDescriptorSetLayout(layoutInfo);
+
+    std::array<vk::DescriptorPoolSize, 2> poolSizes = {
+        vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer, FramesInFlight},
+        vk::DescriptorPoolSize{vk::DescriptorType::eCombinedImageSampler, textureCapacity * FramesInFlight}
+    };
+    m_pool = dev.createDescriptorPool({ vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind, FramesInFlight, static_cast<uint32_t>(poolSizes.size()), poolSizes.data() });
+
+    std::array<vk::DescriptorSetLayout, FramesInFlight> layouts;
+    layouts.fill(m_layout);
+    auto sets = dev.allocateDescriptorSets({ m_pool, FramesInFlight, layouts.data() });
+    for (uint32_t i = 0; i < FramesInFlight; ++i) {
+        m_sets[i] = sets[i];
+        m_materialBuffers[i] = CreateScope<Buffer>(m_context, sizeof(GPUMaterial) * MaxMaterials, vk::BufferUsageFlagBits::eStorageBuffer, VMA_MEMORY_USAGE_CPU_TO_GPU, VMA_ALLOCATION_CREATE_MAPPED_BIT);
+        vk::DescriptorBufferInfo bufferInfo(m_materialBuffers[i]->getHandle(), 0, VK_WHOLE_SIZE);
+        vk::WriteDescriptorSet write(m_sets[i], 0, 0, 1, vk::DescriptorType::eStorageBuffer, nullptr, &bufferInfo);
+        dev.updateDescriptorSets(write, {});
+    }
+
+    BB_CORE_INFO("BindlessMaterials: {0} texture slots, {1} material records", textureCapacity, MaxMaterials);
+}
+
+BindlessMaterials::~BindlessMaterials() {
+    auto dev = m_context.getDevice();
+    for (auto& buffer : m_materialBuffers) buffer.reset();
+    m_textures.clear();
+    if (m_pool) dev.destroyDescriptorPool(m_pool);
+    if (m_layout) dev.destroyDescriptorSetLayout(m_layout);
+}
+
+std::optional<uint32_t> BindlessMaterials::acquireTexture(const Ref<Texture>& texture) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (auto it = m_textureSlots.find(texture.get()); it != m_textureSlots.end()) {
+        m_textures[it->second].references++;
+        return it->second;
+    }
+    auto slot = m_textureAllocator.allocate();
+    if (!slot) {
+        if (!m_warnedFull) BB_CORE_WARN("BindlessMaterials: Texture array full ({0} slots)", m_textureAllocator.getCapacity());
+        m_warnedFull = true;
+        return std::nullopt;
+    }
+    m_textures[*slot] = { texture, 1, texture->getResidencyVersion() };
+    m_textureSlots[texture.get()] = *slot;
+    markTexture(*slot);
+    return slot;
+}
+
+void BindlessMaterials::releaseTexture(uint32_t slot) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (slot >= m_textures.size() || m_textures[slot].references == 0) return;
+    if (--m_textures[slot].references > 0) return;
+    // The texture itself stays referenced until the slot is recycled
+    m_textureSlots.erase(m_textures[slot].texture.get());
+    m_textureAllocator.release(slot);
+}
+
+std::optional<uint32_t> BindlessMaterials::allocateMaterial() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto index = m_materialAllocator.allocate();
+    if (!index) {
+        if (!m_warnedFull) BB_CORE_WARN("BindlessMaterials: Material buffer full ({0} records)", MaxMaterials);
+        m_warnedFull = true;
+    }
+    return index;
+}
+
+void BindlessMaterials::releaseMaterial(uint32_t index) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_materialAllocator.release(index);
+}
+
+void BindlessMaterials::setMaterial(uint32_t index, const GPUMaterial& material) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (index >= m_materials.size()) return;
+    m_materials[index] = material;
+    for (auto& pending : m_pendingMaterials) pending.push_back(index);
+}
+
+void BindlessMaterials::markTexture(uint32_t slot) {
+    for (auto& pending : m_pendingTextures) pending.push_back(slot);
+}
+
+void BindlessMaterials::update(uint32_t frame) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Slots released MAX_FRAMES_IN_FLIGHT frames ago are no longer read by the GPU
+    m_recycled.clear();
+    m_textureAllocator.nextFrame(&m_recycled);
+    for (uint32_t slot : m_recycled) {
+        if (m_textures[slot].references == 0) m_textures[slot].texture.reset();
+    }
+    m_materialAllocator.nextFrame();
+
+    // Streamed textures replace their image view when their resident mips change
+    const uint32_t highWater = m_textureAllocator.getHighWater();
+    for (uint32_t slot = 0; slot < highWater; ++slot) {
+        TextureSlot& entry = m_textures[slot];
+        if (entry.references == 0 || entry.texture->getResidencyVersion() == entry.residencyVersion) continue;
+        entry.residencyVersion = entry.texture->getResidencyVersion();
+        markTexture(slot);
+    }
+
+    auto& pendingTextures = m_pendingTextures[frame];
+    if (!pendingTextures.empty()) {
+        std::vector<vk::DescriptorImageInfo> infos;
+        std::vector<vk::WriteDescriptorSet> writes;
+        infos.reserve(pendingTextures.size());
+        writes.reserve(pendingTextures.size());
+        for (uint32_t slot : pendingTextures) {
+            const Ref<Texture>& texture = m_textures[slot].texture;
+            if (m_textures[slot].references == 0 || !texture) continue;
+            infos.emplace_back(texture->getSampler(), texture->getImageView(), vk::ImageLayout::eShaderReadOnlyOptimal);
+            writes.emplace_back(m_sets[frame], 1, slot, 1, vk::DescriptorType::eCombinedImageSampler, &infos.back(), nullptr);
+        }
+        if (!writes.empty()) m_context.getDevice().updateDescriptorSets(writes, {});
+        pendingTextures.clear();
+    }
+
+    auto& pendingMaterials = m_pendingMaterials[frame];
+    auto* records = static_cast<GPUMaterial*>(m_materialBuffers[frame]->getMappedData());
+    for (uint32_t index : pendingMaterials) records[index] = m_materials[index];
+    pendingMaterials.clear();
+}
+
+} // namespace bb3d
@@ -0,0 +1,481 @@
+#include "bb3d/render/BlockCompression.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace bb3d {
+
+namespace {
+
+/** @brief Principal axis of a point cloud (power iteration on the covariance matrix). */
+template<int N>
+void principalAxis(const float (*points)[N], int count, float mean[N], float axis[N]) {
+    for (int c = 0; c < N; ++c) mean[c] = 0.0f;
+    for (int i = 0; i < count; ++i) for (int c = 0; c < N; ++c) mean[c] += points[i][c];
+    for (int c = 0; c < N; ++c) mean[c] /= static_cast<float>(std::max(count, 1));
+
+    float cov[N][N] = {};
+    for (int i = 0; i < count; ++i) {
+        for (int a = 0; a < N; ++a) {
+            for (int b = 0; b < N; ++b) cov[a][b] += (points[i][a] - mean[a]) * (points[i][b] - mean[b]);
+        }
+    }
+
+    for (int c = 0; c < N; ++c) axis[c] = 1.0f;
+    for (int iteration = 0; iteration < 8; ++iteration) {
+        float next[N] = {};
+        for (int a = 0; a < N; ++a) for (int b = 0; b < N; ++b) next[a] += cov[a][b] * axis[b];
+        float length = 0.0f;
+        for (int c = 0; c < N; ++c) length = std::max(length, std::abs(next[c]));
+        if (length <= 1e-12f) break; // Flat block: any axis works
+        for (int c = 0; c < N; ++c) axis[c] = next[c] / length;
+    }
+}
+
+/** @brief Endpoints at the extreme projections of the points on their principal axis. */
+template<int N>
+void fitEndpoints(const float (*points)[N], int count, float e0[N], float e1[N]) {
+    float mean[N], axis[N];
+    principalAxis<N>(points, count, mean, axis);
+    float minT = std::numeric_limits<float>::max(), maxT = -std::numeric_limits<float>::max();
+    for (int i = 0; i < count; ++i) {
+        float t = 0.0f;
+        for (int c = 0; c < N; ++c) t += (points[i][c] - mean[c]) * axis[c];
+        minT = std::min(minT, t);
+        maxT = std::max(maxT, t);
+    }
+    if (count == 0) minT = maxT = 0.0f;
+    for (int c = 0; c < N; ++c) {
+        e0[c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+        e1[c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+    }
+}
+
+/** @brief Least-squares endpoints for fixed interpolation weights (x = (1-t) e0 + t e1). */
+template<int N>
+bool solveEndpoints(const float (*points)[N], const float* weights, int count, float e0[N], float e1[N]) {
+    float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+    float ax[N] = {}, bx[N] = {};
+    for (int i = 0; i < count; ++i) {
+        const float b = weights[i], a = 1.0f - b;
+        aa += a * a; ab += a * b; bb += b * b;
+        for (int c = 0; c < N; ++c) { ax[c] += a * points[i][c]; bx[c] += b * points[i][c]; }
+    }
+    const float det = aa * bb - ab * ab;
+    if (std::abs(det) < 1e-6f) return false;
+    for (int c = 0; c < N; ++c) {
+        e0[c] = std::clamp((ax[c] * bb - bx[c] * ab) / det, 0.0f, 255.0f);
+        e1[c] = std::clamp((bx[c] * aa - ax[c] * ab) / det, 0.0f, 255.0f);
+    }
+    return true;
+}
+
+// --- BC1 ---
+
+uint16_t packRGB565(const float c[3]) {
+    const int r = static_cast<int>(std::lround(c[0] * 31.0f / 255.0f));
+    const int g = static_cast<int>(std::lround(c[1] * 63.0f / 255.0f));
+    const int b = static_cast<int>(std::lround(c[2] * 31.0f / 255.0f));
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+void unpackRGB565(uint16_t v, int out[3]) {
+    const int r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+    out[0] = (r << 3) | (r >> 2);
+    out[1] = (g << 2) | (g >> 4);
+    out[2] = (b << 3) | (b >> 2);
+}
+
+/** @brief BC1 palette (4 entries) as the decoder computes it. */
+void bc1Palette(uint16_t c0, uint16_t c1, bool fourColors, int palette[4][3]) {
+    unpackRGB565(c0, palette[0]);
+    unpackRGB565(c1, palette[1]);
+    for (int c = 0; c < 3; ++c) {
+        if (fourColors) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        } else {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+}
+
+struct BC1Candidate {
+    uint16_t c0 = 0, c1 = 0;
+    uint8_t indices[16] = {};
+    float error = std::numeric_limits<float>::max();
+};
+
+/** @brief Quantizes the endpoints, orders them for the requested mode and picks the indices. */
+BC1Candidate evaluateBC1(const float e0[3], const float e1[3], const float (*points)[3], const bool* transparent, bool fourColors) {
+    BC1Candidate candidate;
+    candidate.c0 = packRGB565(e0);
+    candidate.c1 = packRGB565(e1);
+    // The decoder selects the mode from the endpoint order: 4 colors needs c0 > c1, 3 colors c0 <= c1
+    if (fourColors ? candidate.c0 < candidate.c1 : candidate.c0 > candidate.c1) std::swap(candidate.c0, candidate.c1);
+    const bool degenerate = fourColors && candidate.c0 == candidate.c1; // Decoded as 3 colors: only index 0 is safe
+
+    int palette[4][3];
+    bc1Palette(candidate.c0, candidate.c1, fourColors && !degenerate, palette);
+    const int usable = degenerate ? 1 : (fourColors ? 4 : 3);
+
+    candidate.error = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        if (transparent[i]) { candidate.indices[i] = 3; continue; }
+        float best = std::numeric_limits<float>::max();
+        for (int k = 0; k < usable; ++k) {
+            float d = 0.0f;
+            for (int c = 0; c < 3; ++c) { const float diff = points[i][c] - palette[k][c]; d += diff * diff; }
+            if (d < best) { best = d; candidate.indices[i] = static_cast<uint8_t>(k); }
+        }
+        candidate.error += best;
+    }
+    return candidate;
+}
+
+void encodeBC1(const uint8_t rgba[64], uint8_t* out, bool allowTransparency) {
+    float points[16][3];
+    bool transparent[16];
+    float opaque[16][3];
+    int opaqueCount = 0;
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 3; ++c) points[i][c] = rgba[i * 4 + c];
+        transparent[i] = allowTransparency && rgba[i * 4 + 3] < 128;
+        if (!transparent[i]) { std::memcpy(opaque[opaqueCount], points[i], sizeof(points[i])); opaqueCount++; }
+    }
+    const bool fourColors = opaqueCount == 16;
+
+    BC1Candidate best;
+    if (opaqueCount == 0) {
+        best.c0 = best.c1 = 0;
+        std::fill(std::begin(best.indices), std::end(best.indices), uint8_t(3));
+    } else {
+        float e0[3], e1[3];
+        fitEndpoints<3>(opaque, opaqueCount, e0, e1);
+        best = evaluateBC1(e0, e1, points, transparent, fourColors);
+
+        // Least-squares refinement with the chosen indices
+        static constexpr float fourWeights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+        static constexpr float threeWeights[4] = { 0.0f, 1.0f, 0.5f, 0.0f };
+        for (int iteration = 0; iteration < 2 && best.error > 0.0f; ++iteration) {
+            float fitted[16][3], weights[16];
+            int n = 0;
+            for (int i = 0; i < 16; ++i) {
+                if (transparent[i]) continue;
+                weights[n] = (fourColors ? fourWeights : threeWeights)[best.indices[i]];
+                std::memcpy(fitted[n], points[i], sizeof(points[i]));
+                n++;
+            }
+            if (!solveEndpoints<3>(fitted, weights, n, e0, e1)) break;
+            BC1Candidate refined = evaluateBC1(e0, e1, points, transparent, fourColors);
+            if (refined.error >= best.error) break;
+            best = refined;
+        }
+    }
+
+    out[0] = static_cast<uint8_t>(best.c0 & 0xFF);
+    out[1] = static_cast<uint8_t>(best.c0 >> 8);
+    out[2] = static_cast<uint8_t>(best.c1 & 0xFF);
+    out[3] = static_cast<uint8_t>(best.c1 >> 8);
+    uint32_t bits = 0;
+    for (int i = 0; i < 16; ++i) bits |= static_cast<uint32_t>(best.indices[i]) << (2 * i);
+    std::memcpy(out + 4, &bits, 4);
+}
+
+void decodeBC1(const uint8_t* block, uint8_t rgba[64], bool forceFourColors) {
+    const uint16_t c0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+    const uint16_t c1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+    const bool fourColors = forceFourColors || c0 > c1;
+    int palette[4][3];
+    bc1Palette(c0, c1, fourColors, palette);
+    uint32_t bits;
+    std::memcpy(&bits, block + 4, 4);
+    for (int i = 0; i < 16; ++i) {
+        const uint32_t index = (bits >> (2 * i)) & 3;
+        for (int c = 0; c < 3; ++c) rgba[i * 4 + c] = static_cast<uint8_t>(palette[index][c]);
+        rgba[i * 4 + 3] = (!fourColors && index == 3) ? 0 : 255;
+    }
+}
+
+// --- BC4 (also the alpha block of BC3 and both halves of BC5) ---
+
+void bc4Palette(int r0, int r1, int palette[8]) {
+    palette[0] = r0;
+    palette[1] = r1;
+    if (r0 > r1) {
+        for (int i = 2; i < 8; ++i) palette[i] = ((8 - i) * r0 + (i - 1) * r1) / 7;
+    } else {
+        for (int i = 2; i < 6; ++i) palette[i] = ((6 - i) * r0 + (i - 1) * r1) / 5;
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+void encodeBC4(const uint8_t values[16], uint8_t* out) {
+    const auto [mn, mx] = std::minmax_element(values, values + 16);
+    const int r0 = *mx, r1 = *mn;
+    int palette[8];
+    bc4Palette(r0, r1, palette);
+
+    uint64_t bits = 0;
+    if (r0 != r1) {
+        for (int i = 0; i < 16; ++i) {
+            int bestIndex = 0, bestError = 256;
+            for (int k = 0; k < 8; ++k) {
+                const int error = std::abs(values[i] - palette[k]);
+                if (error < bestError) { bestError = error; bestIndex = k; }
+            }
+            bits |= static_cast<uint64_t>(bestIndex) << (3 * i);
+        }
+    }
+    out[0] = static_cast<uint8_t>(r0);
+    out[1] = static_cast<uint8_t>(r1);
+    for (int b = 0; b < 6; ++b) out[2 + b] = static_cast<uint8_t>(bits >> (8 * b));
+}
+
+void decodeBC4(const uint8_t* block, uint8_t values[16]) {
+    int palette[8];
+    bc4Palette(block[0], block[1], palette);
+    uint64_t bits = 0;
+    for (int b = 0; b < 6; ++b) bits |= static_cast<uint64_t>(block[2 + b]) << (8 * b);
+    for (int i = 0; i < 16; ++i) values[i] = static_cast<uint8_t>(palette[(bits >> (3 * i)) & 7]);
+}
+
+// --- BC7 (mode 6) ---
+
+constexpr int BC7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+class BitWriter {
+public:
+    explicit BitWriter(uint8_t* out) : m_out(out) { std::memset(out, 0, 16); }
+    void write(uint32_t value, int count) {
+        for (int i = 0; i < count; ++i, ++m_position) {
+            if ((value >> i) & 1u) m_out[m_position >> 3] |= static_cast<uint8_t>(1u << (m_position & 7));
+        }
+    }
+private:
+    uint8_t* m_out;
+    int m_position = 0;
+};
+
+class BitReader {
+public:
+    explicit BitReader(const uint8_t* in) : m_in(in) {}
+    uint32_t read(int count) {
+        uint32_t value = 0;
+        for (int i = 0; i < count; ++i, ++m_position) value |= static_cast<uint32_t>((m_in[m_position >> 3] >> (m_position & 7)) & 1u) << i;
+        return value;
+    }
+private:
+    const uint8_t* m_in;
+    int m_position = 0;
+};
+
+struct BC7Candidate {
+    uint8_t endpoints[2][4] = {}; ///< 7-bit values.
+    uint8_t pbits[2] = {};
+    uint8_t indices[16] = {};
+    float error = std::numeric_limits<float>::max();
+};
+
+/** @brief Quantizes an endpoint to 7 bits + shared p-bit, picking the p-bit with the lowest error. */
+void quantizeBC7Endpoint(const float value[4], uint8_t q[4], uint8_t& pbit) {
+    float bestError = std::numeric_limits<float>::max();
+    for (uint8_t p = 0; p < 2; ++p) {
+        uint8_t candidate[4];
+        float error = 0.0f;
+        for (int c = 0; c < 4; ++c) {
+            const int v = std::clamp(static_cast<int>(std::lround((value[c] - p) / 2.0f)), 0, 127);
+            candidate[c] = static_cast<uint8_t>(v);
+            const float diff = value[c] - static_cast<float>((v << 1) | p);
+            error += diff * diff;
+        }
+        if (error < bestError) {
+            bestError = error;
+            std::memcpy(q, candidate, 4);
+            pbit = p;
+        }
+    }
+}
+
+void bc7Palette(const uint8_t endpoints[2][4], const uint8_t pbits[2], int palette[16][4]) {
+    int e[2][4];
+    for (int k = 0; k < 2; ++k) for (int c = 0; c < 4; ++c) e[k][c] = (endpoints[k][c] << 1) | pbits[k];
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 4; ++c) palette[i][c] = ((64 - BC7Weights4[i]) * e[0][c] + BC7Weights4[i] * e[1][c] + 32) >> 6;
+    }
+}
+
+BC7Candidate evaluateBC7(const float e0[4], const float e1[4], const float (*points)[4]) {
+    BC7Candidate candidate;
+    quantizeBC7Endpoint(e0, candidate.endpoints[0], candidate.pbits[0]);
+    quantizeBC7Endpoint(e1, candidate.endpoints[1], candidate.pbits[1]);
+    int palette[16][4];
+    bc7Palette(candidate.endpoints, candidate.pbits, palette);
+
+    candidate.error = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        float best = std::numeric_limits<float>::max();
+        for (int k = 0; k < 16; ++k) {
+            float d = 0.0f;
+            for (int c = 0; c < 4; ++c) { const float diff = points[i][c] - palette[k][c]; d += diff * diff; }
+            if (d < best) { best = d; candidate.indices[i] = static_cast<uint8_t>(k); }
+        }
+        candidate.error += best;
+    }
+    return candidate;
+}
+
+void encodeBC7(const uint8_t rgba[64], uint8_t* out) {
+    float points[16][4];
+    for (int i = 0; i < 16; ++i) for (int c = 0; c < 4; ++c) points[i][c] = rgba[i * 4 + c];
+
+    float e0[4], e1[4];
+    fitEndpoints<4>(points, 16, e0, e1);
+    BC7Candidate best = evaluateBC7(e0, e1, points);
+
+    for (int iteration = 0; iteration < 2 && best.error > 0.0f; ++iteration) {
+        float weights[16];
+        for (int i = 0; i < 16; ++i) weights[i] = BC7Weights4[best.indices[i]] / 64.0f;
+        if (!solveEndpoints<4>(points, weights, 16, e0, e1)) break;
+        BC7Candidate refined = evaluateBC7(e0, e1, points);
+        if (refined.error >= best.error) break;
+        best = refined;
+    }
+
+    // The anchor (texel 0) index is stored with 3 bits: its high bit must be 0
+    if (best.indices[0] & 8) {
+        for (int c = 0; c < 4; ++c) std::swap(best.endpoints[0][c], best.endpoints[1][c]);
+        std::swap(best.pbits[0], best.pbits[1]);
+        for (auto& index : best.indices) index = static_cast<uint8_t>(15 - index);
+    }
+
+    BitWriter writer(out);
+    writer.write(1u << 6, 7); // Mode 6
+    for (int c = 0; c < 4; ++c) {
+        writer.write(best.endpoints[0][c], 7);
+        writer.write(best.endpoints[1][c], 7);
+    }
+    writer.write(best.pbits[0], 1);
+    writer.write(best.pbits[1], 1);
+    writer.write(best.indices[0], 3);
+    for (int i = 1; i < 16; ++i) writer.write(best.indices[i], 4);
+}
+
+bool decodeBC7(const uint8_t* block, uint8_t rgba[64]) {
+    if ((block[0] & 0x7F) != 0x40) {
+        // Other modes (partitions, rotations) are never produced by the cooker
+        for (int i = 0; i < 16; ++i) { rgba[i * 4] = 255; rgba[i * 4 + 1] = 0; rgba[i * 4 + 2] = 255; rgba[i * 4 + 3] = 255; }
+        return false;
+    }
+    BitReader reader(block);
+    reader.read(7);
+    BC7Candidate decoded;
+    for (int c = 0; c < 4; ++c) {
+        decoded.endpoints[0][c] = static_cast<uint8_t>(reader.read(7));
+        decoded.endpoints[1][c] = static_cast<uint8_t>(reader.read(7));
+    }
+    decoded.pbits[0] = static_cast<uint8_t>(reader.read(1));
+    decoded.pbits[1] = static_cast<uint8_t>(reader.read(1));
+    int palette[16][4];
+    bc7Palette(decoded.endpoints, decoded.pbits, palette);
+    for (int i = 0; i < 16; ++i) {
+        const uint32_t index = reader.read(i == 0 ? 3 : 4);
+        for (int c = 0; c < 4; ++c) rgba[i * 4 + c] = static_cast<uint8_t>(palette[index][c]);
+    }
+    return true;
+}
+
+} // namespace
+
+namespace BlockCompression {
+
+uint32_t blockBytes(BlockFormat format) {
+    return (format == BlockFormat::BC1 || format == BlockFormat::BC4) ? 8u : 16u;
+}
+
+size_t compressedSize(BlockFormat format, uint32_t width, uint32_t height) {
+    return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * blockBytes(format);
+}
+
+void encodeBlock(BlockFormat format, const uint8_t rgba[64], uint8_t* out) {
+    uint8_t channel[16];
+    switch (format) {
+        case BlockFormat::BC1:
+            encodeBC1(rgba, out, true);
+            break;
+        case BlockFormat::BC3:
+            for (int i = 0; i < 16; ++i) channel[i] = rgba[i * 4 + 3];
+            encodeBC4(channel, out);
+            encodeBC1(rgba, out + 8, false);
+            break;
+        case BlockFormat::BC4:
+            for (int i = 0; i < 16; ++i) channel[i] = rgba[i * 4];
+            encodeBC4(channel, out);
+            break;
+        case BlockFormat::BC5:
+            for (int i = 0; i < 16; ++i) channel[i] = rgba[i * 4];
+            encodeBC4(channel, out);
+            for (int i = 0; i < 16; ++i) channel[i] = rgba[i * 4 + 1];
+            encodeBC4(channel, out + 8);
+            break;
+        case BlockFormat::BC7:
+            encodeBC7(rgba, out);
+            break;
+    }
+}
+
+bool decodeBlock(BlockFormat format, const uint8_t* block, uint8_t rgba[64]) {
+    uint8_t channel[16];
+    switch (format) {
+        case BlockFormat::BC1:
+            decodeBC1(block, rgba, false);
+            return true;
+        case BlockFormat::BC3:
+            decodeBC1(block + 8, rgba, true);
+            decodeBC4(block, channel);
+            for (int i = 0; i < 16; ++i) rgba[i * 4 + 3] = channel[i];
+            return true;
+        case BlockFormat::BC4:
+            decodeBC4(block, channel);
+            for (int i = 0; i < 16; ++i) { rgba[i * 4] = rgba[i * 4 + 1] = rgba[i * 4 + 2] = channel[i]; rgba[i * 4 + 3] = 255; }
+            return true;
+        case BlockFormat::BC5:
+            decodeBC4(block, channel);
+            for (int i = 0; i < 16; ++i) rgba[i * 4] = channel[i];
+            decodeBC4(block + 8, channel);
+            for (int i = 0; i < 16; ++i) { rgba[i * 4 + 1] = channel[i]; rgba[i * 4 + 2] = 0; rgba[i * 4 + 3] = 255; }
+            return true;
+        case BlockFormat::BC7:
+            return decodeBC7(block, rgba);
+    }
+    return false;
+}
+
+std::vector<uint8_t> compress(BlockFormat format, const uint8_t* rgba, uint32_t width, uint32_t height) {
+    const uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    const uint32_t stride = blockBytes(format);
+    std::vector<uint8_t> out(compressedSize(format, width, height));
+
+    uint8_t block[64];
+    for (uint32_t by = 0; by < blocksY; ++by) {
+        for (uint32_t bx = 0; bx < blocksX; ++bx) {
+            for (uint32_t y = 0; y < 4; ++y) {
+                // Partial blocks replicate the last row/column instead of pulling in black
+                const uint32_t sy = std::min(by * 4 + y, height - 1);
+                for (uint32_t x = 0; x < 4; ++x) {
+                    const uint32_t sx = std::min(bx * 4 + x, width - 1);
+                    std::memcpy(block + (y * 4 + x) * 4, rgba + (static_cast<size_t>(sy) * width + sx) * 4, 4);
+                }
+            }
+            encodeBlock(format, block, out.data() + (static_cast<size_t>(by) * blocksX + bx) * stride);
+        }
+    }
+    return out;
+}
+
+} // namespace BlockCompression
+
+} // namespace bb3d
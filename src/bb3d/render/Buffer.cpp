@@ -53,11 +53,15 @@ Scope<Buffer> Buffer::CreateVertexBuffer(VulkanContext& context, const void* dat
     // 2. Vertex Buffer (Device Local)
     auto vertexBuffer = CreateScope<Buffer>(context, size, vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eVertexBuffer, VMA_MEMORY_USAGE_GPU_ONLY);
 
-    // 3. Copy
-    vk::CommandBuffer commandBuffer = context.beginSingleTimeCommands();
-    vk::BufferCopy copyRegion(stagingAlloc.offset, 0, size);
-    commandBuffer.copyBuffer(stagingAlloc.buffer, vertexBuffer->getHandle(), 1, &copyRegion);
-    context.endSingleTimeCommands(commandBuffer);
+    // 3. Copy, batched with the other uploads of this thread (submitted before the next frame)
+    vk::Buffer dst = vertexBuffer->getHandle();
+    // The staging zone goes back to the ring once the batch has executed
+    const vk::Buffer src = stagingAlloc.buffer;
+    const vk::DeviceSize srcOffset = stagingAlloc.offset;
+    context.getUploadQueue().record([&](vk::CommandBuffer commandBuffer) {
+        vk::BufferCopy copyRegion(srcOffset, 0, size);
+        commandBuffer.copyBuffer(src, dst, 1, &copyRegion);
+    }, std::move(stagingAlloc));
 
     return vertexBuffer;
 }
@@ -68,10 +72,14 @@ Scope<Buffer> Buffer::CreateIndexBuffer(VulkanContext& context, const void* data
 
     auto indexBuffer = CreateScope<Buffer>(context, size, vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eIndexBuffer, VMA_MEMORY_USAGE_GPU_ONLY);
 
-    vk::CommandBuffer commandBuffer = context.beginSingleTimeCommands();
-    vk::BufferCopy copyRegion(stagingAlloc.offset, 0, size);
-    commandBuffer.copyBuffer(stagingAlloc.buffer, indexBuffer->getHandle(), 1, &copyRegion);
-    context.endSingleTimeCommands(commandBuffer);
+    vk::Buffer dst = indexBuffer->getHandle();
+    // The staging zone goes back to the ring once the batch has executed
+    const vk::Buffer src = stagingAlloc.buffer;
+    const vk::DeviceSize srcOffset = stagingAlloc.offset;
+    context.getUploadQueue().record([&](vk::CommandBuffer commandBuffer) {
+        vk::BufferCopy copyRegion(srcOffset, 0, size);
+        commandBuffer.copyBuffer(src, dst, 1, &copyRegion);
+    }, std::move(stagingAlloc));
 
     return indexBuffer;
 }
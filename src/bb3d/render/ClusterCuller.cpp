@@ -0,0 +1,60 @@
+#include "bb3d/render/ClusterCuller.hpp"
+
+namespace bb3d {
+
+ClusterCuller::View ClusterCuller::toObjectSpace(const std::array<glm::vec4, 6>& worldPlanes, const glm::vec3& cameraPosition, const glm::mat4& model) {
+    View view;
+    // A plane transforms with the transpose of the matrix mapping object to world space.
+    glm::mat4 planeTransform = glm::transpose(model);
+    for (size_t i = 0; i < worldPlanes.size(); ++i) {
+        glm::vec4 p = planeTransform * worldPlanes[i];
+        float len = glm::length(glm::vec3(p));
+        view.planes[i] = len > 0.0f ? p / len : p;
+    }
+    view.cameraPosition = glm::vec3(glm::inverse(model) * glm::vec4(cameraPosition, 1.0f));
+    return view;
+}
+
+uint32_t ClusterCuller::cull(const MeshletData& meshlets, const View& view, uint32_t firstInstance,
+                             std::vector<IndexedDrawCommand>& out, ClusterCullStats* stats) {
+    ClusterCullStats local;
+    const size_t firstCommand = out.size();
+    uint32_t nextContiguousIndex = UINT32_MAX;
+
+    for (const auto& m : meshlets.meshlets) {
+        local.tested++;
+
+        bool inside = true;
+        for (const auto& plane : view.planes) {
+            if (glm::dot(glm::vec3(plane), m.center) + plane.w < -m.radius) { inside = false; break; }
+        }
+        if (!inside) { local.frustumCulled++; continue; }
+
+        // Every triangle faces away if the whole bounding sphere is seen inside the
+        // backface region of the normal cone: dot(d, axis) >= sin(a) * |d| + r * (1 + sin(a)).
+        if (view.backfaceCulling && m.coneCutoff < 1.0f) {
+            glm::vec3 d = m.center - view.cameraPosition;
+            float dist = glm::length(d);
+            if (glm::dot(d, m.coneAxis) >= m.coneCutoff * dist + m.radius * (1.0f + m.coneCutoff)) {
+                local.backfaceCulled++;
+                continue;
+            }
+        }
+
+        local.visible++;
+        local.trianglesVisible += m.indexCount / 3;
+
+        // Clusters are contiguous in the index buffer: merge neighbours into a single draw.
+        if (m.firstIndex == nextContiguousIndex && out.size() > firstCommand) {
+            out.back().indexCount += m.indexCount;
+        } else {
+            out.push_back({ m.indexCount, 1, m.firstIndex, 0, firstInstance });
+        }
+        nextContiguousIndex = m.firstIndex + m.indexCount;
+    }
+
+    if (stats) stats->add(local);
+    return static_cast<uint32_t>(out.size() - firstCommand);
+}
+
+} // namespace bb3d
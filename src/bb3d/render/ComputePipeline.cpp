@@ -18,7 +18,7 @@ ComputePipeline::ComputePipeline(VulkanContext& context, const Shader& computeSh
         vk::PipelineShaderStageCreateInfo({}, vk::ShaderStageFlagBits::eCompute, computeShader.getModule(), "main"),
         m_pipelineLayout);
 
-    auto result = m_context.getDevice().createComputePipeline(nullptr, pipelineInfo);
+    auto result = m_context.getDevice().createComputePipeline(m_context.getPipelineCache(), pipelineInfo);
     if (result.result != vk::Result::eSuccess) {
         throw std::runtime_error("Failed to create compute pipeline!");
     }
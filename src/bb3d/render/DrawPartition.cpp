@@ -0,0 +1,23 @@
+#include "bb3d/render/DrawPartition.hpp"
+#include <algorithm>
+
+namespace bb3d {
+
+void DrawPartition::split(uint32_t drawCount, uint32_t minDraws, uint32_t maxRanges, const std::vector<DrawRange>& spans, std::vector<DrawRange>& out) {
+    out.clear();
+    const uint32_t rangeCount = std::clamp(drawCount / std::max(minDraws, 1u), 1u, std::max(maxRanges, 1u));
+    uint32_t begin = 0;
+    size_t span = 0;
+    for (uint32_t r = 0; r < rangeCount && begin < drawCount; ++r) {
+        uint32_t end = r + 1 == rangeCount ? drawCount : static_cast<uint32_t>(uint64_t(drawCount) * (r + 1) / rangeCount);
+        // A cut inside a span moves to its end
+        while (span < spans.size() && spans[span].end <= end) ++span;
+        if (span < spans.size() && spans[span].begin < end) end = std::min<uint32_t>(spans[span].end, drawCount);
+        if (end <= begin) continue;
+        out.push_back({ begin, end });
+        begin = end;
+    }
+    if (out.empty()) out.push_back({ 0, drawCount });
+}
+
+} // namespace bb3d
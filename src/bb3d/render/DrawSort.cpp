@@ -0,0 +1,61 @@
+#include "bb3d/render/DrawSort.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace bb3d {
+
+namespace DrawSort {
+
+uint32_t quantizeDepth(float depth) {
+    if (!(depth > 0.0f)) return 0; // NaN included
+    return static_cast<uint32_t>(std::lround(std::min(depth, 1.0f) * 65535.0f));
+}
+
+uint64_t makeKey(const KeyFields& fields) {
+    const uint64_t type = fields.type & 0xFu;
+    const uint64_t format = fields.format & 0x7u;
+    const uint64_t material = fields.material & 0xFFFFu;
+    const uint64_t mesh = fields.mesh & 0xFFFFu;
+    const uint64_t lod = fields.lod & 0x7u;
+    const uint64_t hidden = fields.hidden ? 1u : 0u;
+    const uint64_t depth = quantizeDepth(fields.depth);
+
+    // Batch part shared by both layouts: format | material | mesh | lod | hidden (39 bits)
+    const uint64_t batch = (format << 36) | (material << 20) | (mesh << 4) | (lod << 1) | hidden;
+    if (fields.translucent) {
+        return (1ull << 63) | (type << 59) | ((0xFFFFu - depth) << 43) | (batch << 4);
+    }
+    return (type << 59) | (batch << 20) | depth;
+}
+
+void radixSort(std::vector<DrawKey>& keys, std::vector<DrawKey>& scratch) {
+    if (keys.size() < 2) return;
+
+    // All eight histograms in one read of the keys
+    std::array<std::array<uint32_t, 256>, 8> counts{};
+    for (const auto& k : keys) {
+        for (uint32_t pass = 0; pass < 8; ++pass) counts[pass][(k.key >> (pass * 8)) & 0xFF]++;
+    }
+
+    scratch.resize(keys.size());
+    const uint32_t total = static_cast<uint32_t>(keys.size());
+    for (uint32_t pass = 0; pass < 8; ++pass) {
+        auto& count = counts[pass];
+        if (std::ranges::any_of(count, [total](uint32_t c) { return c == total; })) continue;
+
+        uint32_t offset = 0;
+        for (auto& c : count) {
+            const uint32_t n = c;
+            c = offset;
+            offset += n;
+        }
+        const uint32_t shift = pass * 8;
+        for (const auto& k : keys) scratch[count[(k.key >> shift) & 0xFF]++] = k;
+        keys.swap(scratch);
+    }
+}
+
+} // namespace DrawSort
+
+} // namespace bb3d
@@ -0,0 +1,188 @@
+#include "bb3d/render/EnvironmentLighting.hpp"
+#include "bb3d/render/Texture.hpp"
+#include "bb3d/core/Config.hpp"
+#include "bb3d/core/Log.hpp"
+#include <stb_image.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+namespace bb3d {
+
+namespace {
+
+std::optional<std::vector<std::byte>> readFile(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return std::nullopt;
+    std::vector<std::byte> bytes(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file) return std::nullopt;
+    return bytes;
+}
+
+/** @brief Writes through a temporary file so that a concurrent reader never sees a partial cache entry. */
+void writeFile(const std::filesystem::path& path, std::span<const std::byte> bytes) {
+    std::error_code error;
+    std::filesystem::create_directories(path.parent_path(), error);
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!file) {
+            BB_CORE_WARN("EnvironmentLighting: Failed to write cache file '{0}'", temporary.string());
+            return;
+        }
+    }
+    std::filesystem::rename(temporary, path, error);
+    if (error) BB_CORE_WARN("EnvironmentLighting: Failed to write cache file '{0}' ({1})", path.string(), error.message());
+}
+
+uint64_t settingsKey(const IBLBakeSettings& settings, bool flipY) {
+    const uint32_t values[] = { IBLBaker::Version, settings.specularSize, settings.specularLevels, settings.specularSamples, flipY ? 1u : 0u };
+    return IBLBaker::hash(std::as_bytes(std::span(values)));
+}
+
+std::string hexKey(uint64_t key) {
+    char text[17];
+    std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(key));
+    return text;
+}
+
+} // namespace
+
+EnvironmentLighting::EnvironmentLighting(VulkanContext& context, JobSystem& jobs, const EngineConfig& config)
+    : m_context(context), m_jobs(jobs), m_enabled(config.graphics.enableIBL),
+      m_cacheDirectory(std::filesystem::path(config.system.cacheDirectory) / "ibl"),
+      m_inFlight(std::make_shared<std::atomic<int>>(0)) {
+    m_settings.specularSize = std::max(config.graphics.iblSpecularSize, 1u);
+
+    // Bound while there is no environment (the shader then ignores it)
+    KTX2Texture black;
+    black.format = KTX2Format::R16G16B16A16_SFLOAT;
+    black.width = 1;
+    black.height = 1;
+    black.faceCount = 6;
+    black.levels.emplace_back(KTX2::getImageSize(black.format, 1, 1) * 6, uint8_t{ 0 });
+    m_blackCube = CreateRef<Texture>(m_context, std::move(black));
+    m_specular = m_blackCube;
+
+    const auto tablePath = m_cacheDirectory / ("brdf_" + std::to_string(m_settings.brdfSize) + "_" + std::to_string(m_settings.brdfSamples) +
+                                               "_v" + std::to_string(IBLBaker::Version) + ".ktx2");
+    std::optional<KTX2Texture> table;
+    if (auto bytes = readFile(tablePath)) {
+        try { table = KTX2::read(*bytes); } catch (const std::exception& e) {
+            BB_CORE_WARN("EnvironmentLighting: Ignoring '{0}' ({1})", tablePath.string(), e.what());
+        }
+    }
+    if (!table) {
+        table = IBLBaker::integrateBRDF(m_settings.brdfSize, m_settings.brdfSamples, &m_jobs);
+        writeFile(tablePath, KTX2::write(*table));
+    }
+    m_brdfTable = CreateRef<Texture>(m_context, std::move(*table));
+}
+
+EnvironmentLighting::~EnvironmentLighting() {
+    // Abandoned bakes still write to their own state only, but they use the JobSystem and the cache
+    m_jobs.wait(m_inFlight);
+}
+
+void EnvironmentLighting::update(const std::string& assetPath, bool flipY) {
+    if (!m_enabled) return;
+
+    if (assetPath != m_source || flipY != m_flipY) {
+        m_source = assetPath;
+        m_flipY = flipY;
+        m_pending.reset(); // A running bake of the previous sky finishes in the background and is dropped
+        if (assetPath.empty()) {
+            clear();
+        } else {
+            auto bake = std::make_shared<Bake>();
+            bake->source = assetPath;
+            bake->flipY = flipY;
+            m_pending = bake;
+
+            auto job = [bake, settings = m_settings, cacheDirectory = m_cacheDirectory, &jobs = m_jobs]() {
+                run(*bake, settings, cacheDirectory, jobs);
+            };
+            if (m_jobs.getThreadCount() > 0) {
+                m_inFlight->fetch_add(1, std::memory_order_relaxed);
+                m_jobs.executeSafe(std::move(job), m_inFlight);
+            } else {
+                job();
+            }
+        }
+    }
+
+    if (m_pending && m_pending->done.load(std::memory_order_acquire)) {
+        auto bake = std::move(m_pending);
+        if (bake->result) {
+            BB_CORE_INFO("EnvironmentLighting: '{0}' {1} in {2:.1f} ms", bake->source, bake->fromCache ? "loaded from cache" : "baked", bake->milliseconds);
+            install(std::move(*bake->result));
+        } else {
+            clear();
+        }
+    }
+}
+
+void EnvironmentLighting::run(Bake& bake, const IBLBakeSettings& settings, const std::filesystem::path& cacheDirectory, JobSystem& jobs) {
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        const auto source = readFile(bake.source);
+        if (!source) throw std::runtime_error("cannot read the file");
+
+        const auto cachePath = cacheDirectory / (hexKey(IBLBaker::hash(*source, settingsKey(settings, bake.flipY))) + ".ibl");
+        if (auto cached = readFile(cachePath)) {
+            try {
+                bake.result = IBLBaker::deserialize(*cached);
+                bake.fromCache = true;
+            } catch (const std::exception& e) {
+                BB_CORE_WARN("EnvironmentLighting: Ignoring '{0}' ({1})", cachePath.string(), e.what());
+            }
+        }
+
+        if (!bake.result) {
+            int width = 0, height = 0, channels = 0;
+            float* texels = stbi_loadf_from_memory(reinterpret_cast<const stbi_uc*>(source->data()), static_cast<int>(source->size()), &width, &height, &channels, STBI_rgb_alpha);
+            if (!texels) throw std::runtime_error(stbi_failure_reason());
+
+            HDRImage image{ static_cast<uint32_t>(width), static_cast<uint32_t>(height), {} };
+            const size_t rowFloats = static_cast<size_t>(width) * 4;
+            image.texels.resize(rowFloats * image.height);
+            for (uint32_t y = 0; y < image.height; ++y) {
+                const uint32_t sourceRow = bake.flipY ? image.height - 1 - y : y;
+                std::copy_n(texels + sourceRow * rowFloats, rowFloats, image.texels.begin() + static_cast<std::ptrdiff_t>(y * rowFloats));
+            }
+            stbi_image_free(texels);
+
+            bake.result = IBLBaker::bake(image, settings, &jobs);
+            writeFile(cachePath, IBLBaker::serialize(*bake.result));
+        }
+    } catch (const std::exception& e) {
+        BB_CORE_ERROR("EnvironmentLighting: Cannot light the scene from '{0}' ({1})", bake.source, e.what());
+        bake.result.reset();
+    }
+    bake.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    bake.done.store(true, std::memory_order_release);
+}
+
+void EnvironmentLighting::install(BakedEnvironment&& environment) {
+    m_irradiance = environment.irradiance;
+    m_specularMaxLod = static_cast<float>(environment.specular.levels.size() - 1);
+    m_specular = CreateRef<Texture>(m_context, std::move(environment.specular));
+    m_active = true;
+    m_version++;
+}
+
+void EnvironmentLighting::clear() {
+    if (!m_active) return;
+    m_active = false;
+    m_irradiance = {};
+    m_specular = m_blackCube;
+    m_specularMaxLod = 0.0f;
+    m_version++;
+}
+
+} // namespace bb3d
@@ -0,0 +1,242 @@
+#include "bb3d/render/GeometryPool.hpp"
+#include "bb3d/render/VulkanContext.hpp"
+#include "bb3d/render/Renderer.hpp"
+#include "bb3d/core/Log.hpp"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace bb3d {
+
+// Uploads are split so that a single mesh never needs the whole staging buffer
+static constexpr vk::DeviceSize MaxUploadChunk = 16ull * 1024 * 1024;
+
+GeometryPool::GeometryPool(VulkanContext& context, vk::DeviceSize vertexCapacity, vk::DeviceSize indexCapacity)
+    : m_context(context), m_vertexRanges(vertexCapacity), m_indexRanges(indexCapacity) {
+    m_vertexBuffer = createBuffer(Region::Vertex, vertexCapacity);
+    m_indexBuffer = createBuffer(Region::Index, indexCapacity);
+    BB_CORE_INFO("GeometryPool initialized ({0} MB vertices, {1} MB indices).", vertexCapacity / (1024 * 1024), indexCapacity / (1024 * 1024));
+}
+
+GeometryPool::~GeometryPool() {
+    // Releases still pending are expected (meshes destroyed during the last frames)
+    size_t leaked = m_vertexRanges.getAllocationCount() + m_indexRanges.getAllocationCount() - m_pendingFrees.size();
+    if (leaked > 0) BB_CORE_WARN("GeometryPool: {0} ranges still allocated at shutdown.", leaked);
+}
+
+Scope<Buffer> GeometryPool::createBuffer(Region region, vk::DeviceSize size) const {
+    vk::BufferUsageFlags usage = vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eTransferSrc;
+    usage |= region == Region::Vertex ? vk::BufferUsageFlagBits::eVertexBuffer : vk::BufferUsageFlagBits::eIndexBuffer;
+    return CreateScope<Buffer>(m_context, size, usage, VMA_MEMORY_USAGE_GPU_ONLY);
+}
+
+GeometryPool::Handle GeometryPool::allocateVertices(const void* data, vk::DeviceSize size, uint32_t stride) {
+    return allocate(Region::Vertex, data, size, stride);
+}
+
+GeometryPool::Handle GeometryPool::allocateIndices(const void* data, vk::DeviceSize size, uint32_t indexSize) {
+    return allocate(Region::Index, data, size, indexSize);
+}
+
+uint64_t GeometryPool::allocateRangeLocked(Region region, vk::DeviceSize size, uint32_t elementSize) {
+    RangeAllocator& ranges = region == Region::Vertex ? m_vertexRanges : m_indexRanges;
+    auto offset = ranges.allocate(size, elementSize);
+    if (!offset) {
+        growLocked(region, size + elementSize);
+        offset = ranges.allocate(size, elementSize);
+        if (!offset) throw std::runtime_error("GeometryPool: allocation failed after growing the pool");
+    }
+    return *offset;
+}
+
+GeometryPool::Handle GeometryPool::allocate(Region region, const void* data, vk::DeviceSize size, uint32_t elementSize) {
+    if (size == 0) return InvalidHandle;
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const uint64_t offset = allocateRangeLocked(region, size, elementSize);
+
+    Handle handle;
+    if (!m_freeSlots.empty()) {
+        handle = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else {
+        handle = static_cast<Handle>(m_slots.size());
+        m_slots.emplace_back();
+    }
+    m_slots[handle] = { region, offset, size, elementSize, true };
+
+    if (data) upload(region == Region::Vertex ? m_vertexBuffer->getHandle() : m_indexBuffer->getHandle(), offset, data, size);
+    return handle;
+}
+
+void GeometryPool::update(Handle handle, const void* data, vk::DeviceSize size) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (handle >= m_slots.size() || !m_slots[handle].live) return;
+    if (size > m_slots[handle].size) throw std::runtime_error("GeometryPool: update larger than the allocated range");
+
+    // Recorded frames may still read the current range: write a new one and retire the old one like a release
+    const Region region = m_slots[handle].region;
+    const uint64_t offset = allocateRangeLocked(region, m_slots[handle].size, m_slots[handle].elementSize);
+    m_pendingFrees.push_back({ region, m_slots[handle].offset, InvalidHandle, m_frame });
+    m_slots[handle].offset = offset;
+    upload(region == Region::Vertex ? m_vertexBuffer->getHandle() : m_indexBuffer->getHandle(), offset, data, size);
+}
+
+void GeometryPool::upload(vk::Buffer dst, vk::DeviceSize offset, const void* data, vk::DeviceSize size) {
+    const auto* src = static_cast<const uint8_t*>(data);
+    for (vk::DeviceSize done = 0; done < size; done += MaxUploadChunk) {
+        vk::DeviceSize chunk = std::min(MaxUploadChunk, size - done);
+        auto stagingAlloc = m_context.getStagingBuffer().allocate(chunk);
+        std::memcpy(stagingAlloc.mappedData, src + done, static_cast<size_t>(chunk));
+
+        const vk::Buffer src = stagingAlloc.buffer;
+        const vk::DeviceSize srcOffset = stagingAlloc.offset;
+        m_context.getUploadQueue().record([&](vk::CommandBuffer commandBuffer) {
+            vk::BufferCopy copyRegion(srcOffset, offset + done, chunk);
+            commandBuffer.copyBuffer(src, dst, 1, &copyRegion);
+        }, std::move(stagingAlloc));
+    }
+}
+
+void GeometryPool::free(Handle handle) {
+    if (handle == InvalidHandle) return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (handle >= m_slots.size() || !m_slots[handle].live) return;
+    const Slot& slot = m_slots[handle];
+    m_pendingFrees.push_back({ slot.region, slot.offset, handle, m_frame });
+}
+
+void GeometryPool::nextFrame() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_frame++;
+    // Ranges released MAX_FRAMES_IN_FLIGHT frames ago can no longer be read by the GPU
+    auto released = std::remove_if(m_pendingFrees.begin(), m_pendingFrees.end(), [&](const PendingFree& pending) {
+        if (m_frame - pending.frame < Renderer::MAX_FRAMES_IN_FLIGHT) return false;
+        releaseLocked(pending);
+        return true;
+    });
+    m_pendingFrees.erase(released, m_pendingFrees.end());
+
+    std::erase_if(m_retiredBuffers, [&](const auto& retired) { return m_frame - retired.second >= Renderer::MAX_FRAMES_IN_FLIGHT; });
+}
+
+void GeometryPool::releaseLocked(const PendingFree& pending) {
+    (pending.region == Region::Vertex ? m_vertexRanges : m_indexRanges).free(pending.offset);
+    if (pending.handle == InvalidHandle) return;
+    m_slots[pending.handle].live = false;
+    m_freeSlots.push_back(pending.handle);
+}
+
+void GeometryPool::growLocked(Region region, vk::DeviceSize minFree) {
+    RangeAllocator& ranges = region == Region::Vertex ? m_vertexRanges : m_indexRanges;
+    Scope<Buffer>& buffer = region == Region::Vertex ? m_vertexBuffer : m_indexBuffer;
+
+    vk::DeviceSize oldCapacity = ranges.getCapacity();
+    vk::DeviceSize newCapacity = std::max(oldCapacity * 2, oldCapacity + minFree);
+    BB_CORE_WARN("GeometryPool: growing {0} buffer from {1} MB to {2} MB.", region == Region::Vertex ? "vertex" : "index",
+                 oldCapacity / (1024 * 1024), newCapacity / (1024 * 1024));
+
+    // Pending copies into the old buffer (any thread) must land before it is duplicated
+    auto& uploads = m_context.getUploadQueue();
+    uploads.flush();
+
+    auto grown = createBuffer(region, newCapacity);
+    uploads.record([&](vk::CommandBuffer commandBuffer) {
+        vk::BufferCopy copyRegion(0, 0, oldCapacity);
+        commandBuffer.copyBuffer(buffer->getHandle(), grown->getHandle(), 1, &copyRegion);
+    });
+    // Submitted right away: later uploads to the new buffer are ordered after the duplication
+    uploads.submit();
+
+    // Frames in flight (or being recorded) may still reference the old buffer
+    m_retiredBuffers.emplace_back(std::move(buffer), m_frame);
+    buffer = std::move(grown);
+    ranges.grow(newCapacity);
+}
+
+void GeometryPool::defragment() {
+    BB_PROFILE_SCOPE("GeometryPool::defragment");
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_context.getUploadQueue().flush();
+    m_context.getDevice().waitIdle();
+
+    // Nothing is in flight anymore: pending releases can be applied right away
+    for (const auto& pending : m_pendingFrees) releaseLocked(pending);
+    m_pendingFrees.clear();
+    m_retiredBuffers.clear();
+
+    auto packRegion = [&](Region region) {
+        RangeAllocator& ranges = region == Region::Vertex ? m_vertexRanges : m_indexRanges;
+        Scope<Buffer>& buffer = region == Region::Vertex ? m_vertexBuffer : m_indexBuffer;
+        if (ranges.getFragmentation() == 0.0f) return;
+
+        auto moves = ranges.compact();
+        auto packed = createBuffer(region, ranges.getCapacity());
+        std::vector<vk::BufferCopy> copies;
+        std::unordered_map<uint64_t, uint64_t> remap;
+        copies.reserve(moves.size());
+        for (const auto& move : moves) {
+            copies.emplace_back(move.from, move.to, move.size);
+            remap[move.from] = move.to;
+        }
+
+        if (!copies.empty()) {
+            // The old buffer is released once the copy has completed
+            vk::Buffer src = buffer->getHandle();
+            m_context.getUploadQueue().record([&](vk::CommandBuffer commandBuffer) {
+                commandBuffer.copyBuffer(src, packed->getHandle(), static_cast<uint32_t>(copies.size()), copies.data());
+            }, std::move(buffer));
+        }
+        buffer = std::move(packed);
+
+        for (auto& slot : m_slots) {
+            if (slot.live && slot.region == region) slot.offset = remap[slot.offset];
+        }
+    };
+
+    packRegion(Region::Vertex);
+    packRegion(Region::Index);
+    m_context.getUploadQueue().submit();
+    BB_CORE_INFO("GeometryPool: defragmented ({0} KB vertices, {1} KB indices in use).", m_vertexRanges.getUsed() / 1024, m_indexRanges.getUsed() / 1024);
+}
+
+int32_t GeometryPool::getVertexOffset(Handle handle) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (handle >= m_slots.size()) return 0;
+    const Slot& slot = m_slots[handle];
+    return static_cast<int32_t>(slot.offset / slot.elementSize);
+}
+
+uint32_t GeometryPool::getFirstIndex(Handle handle) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (handle >= m_slots.size()) return 0;
+    const Slot& slot = m_slots[handle];
+    return static_cast<uint32_t>(slot.offset / slot.elementSize);
+}
+
+vk::DeviceSize GeometryPool::getSize(Handle handle) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return handle < m_slots.size() ? m_slots[handle].size : 0;
+}
+
+void GeometryPool::bind(vk::CommandBuffer commandBuffer, vk::IndexType indexType) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    vk::Buffer vertexBuffers[] = { m_vertexBuffer->getHandle() };
+    vk::DeviceSize offsets[] = { 0 };
+    commandBuffer.bindVertexBuffers(0, 1, vertexBuffers, offsets);
+    commandBuffer.bindIndexBuffer(m_indexBuffer->getHandle(), 0, indexType);
+}
+
+GeometryPool::Stats GeometryPool::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats stats;
+    stats.vertexUsed = m_vertexRanges.getUsed();
+    stats.vertexCapacity = m_vertexRanges.getCapacity();
+    stats.indexUsed = m_indexRanges.getUsed();
+    stats.indexCapacity = m_indexRanges.getCapacity();
+    stats.allocations = static_cast<uint32_t>(m_vertexRanges.getAllocationCount() + m_indexRanges.getAllocationCount());
+    stats.fragmentation = std::max(m_vertexRanges.getFragmentation(), m_indexRanges.getFragmentation());
+    return stats;
+}
+
+} // namespace bb3d
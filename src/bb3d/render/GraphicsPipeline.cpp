@@ -47,7 +47,7 @@ GraphicsPipeline::GraphicsPipeline(VulkanContext& context, vk::Format colorForma
 
 GraphicsPipeline::~GraphicsPipeline() {
     auto device = m_context.getDevice();
-    if (m_pipeline) device.destroyPipeline(m_pipeline);
+    for (auto variant : m_variants) if (variant) device.destroyPipeline(variant);
     if (m_pipelineLayout) device.destroyPipelineLayout(m_pipelineLayout);
 }
 
@@ -55,6 +55,17 @@ void GraphicsPipeline::bind(vk::CommandBuffer commandBuffer) {
     commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, m_pipeline);
 }
 
+void GraphicsPipeline::bind(vk::CommandBuffer commandBuffer, VertexFormat format) {
+    commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, getHandle(format));
+}
+
+vk::Pipeline GraphicsPipeline::getHandle(VertexFormat format) const {
+    uint32_t index = static_cast<uint32_t>(format);
+    if (index < VertexFormatCount && m_variants[index]) return m_variants[index];
+    BB_CORE_ERROR("GraphicsPipeline: No variant for vertex format {}, falling back to the full layout.", index);
+    return m_pipeline;
+}
+
 void GraphicsPipeline::createPipelineLayout(const std::vector<vk::DescriptorSetLayout>& descriptorSetLayouts,
                                              const std::vector<vk::PushConstantRange>& pushConstantRanges) {
     vk::PipelineLayoutCreateInfo pipelineLayoutInfo({}, 
@@ -72,11 +83,14 @@ void GraphicsPipeline::createPipeline(const Shader& vertShader, const Shader& fr
     };
 
     vk::PipelineVertexInputStateCreateInfo vertexInputInfo;
-    auto bindingDescription = Vertex::getBindingDescription();
-    auto allAttributes = Vertex::getAttributeDescriptions();
+    vk::VertexInputBindingDescription bindingDescription;
     std::vector<vk::VertexInputAttributeDescription> filteredAttributes;
 
-    if (useVertexInput) {
+    auto setVertexFormat = [&](VertexFormat format) {
+        if (!useVertexInput) return;
+        bindingDescription = Vertex::getBindingDescription(format);
+        auto allAttributes = Vertex::getAttributeDescriptions(format);
+        filteredAttributes.clear();
         if (enabledAttributes.empty()) {
             for(const auto& a : allAttributes) filteredAttributes.push_back(a);
         } else {
@@ -86,7 +100,13 @@ void GraphicsPipeline::createPipeline(const Shader& vertShader, const Shader& fr
         }
         vertexInputInfo.setVertexBindingDescriptions(bindingDescription);
         vertexInputInfo.setVertexAttributeDescriptions(filteredAttributes);
-    }
+    };
+
+    // The vertex shader decodes the quantized formats according to constant_id 0 (VERTEX_FORMAT)
+    int32_t formatConstant = 0;
+    vk::SpecializationMapEntry formatEntry(0, 0, sizeof(int32_t));
+    vk::SpecializationInfo specialization(1, &formatEntry, sizeof(int32_t), &formatConstant);
+    shaderStages[0].pSpecializationInfo = &specialization;
 
     vk::PipelineInputAssemblyStateCreateInfo inputAssembly({}, topology, VK_FALSE);
     vk::PipelineViewportStateCreateInfo viewportState({}, 1, nullptr, 1, nullptr);
@@ -143,9 +163,20 @@ void GraphicsPipeline::createPipeline(const Shader& vertShader, const Shader& fr
     vk::GraphicsPipelineCreateInfo pipelineInfo({}, static_cast<uint32_t>(shaderStages.size()), shaderStages.data(), &vertexInputInfo, &inputAssembly, nullptr, &viewportState, &rasterizer, &multisampling, &depthStencil, &colorBlending, &dynamicState, m_pipelineLayout);
     pipelineInfo.pNext = &renderingInfo;
 
-    auto result = m_context.getDevice().createGraphicsPipeline(nullptr, pipelineInfo);
-    if (result.result != vk::Result::eSuccess) throw std::runtime_error("Failed to create graphics pipeline!");
-    m_pipeline = result.value;
+    // Quantized variants only make sense for pipelines reading the position alone (a float3 at offset 0 in
+    // every format) or whose vertex shader decodes the formats (vertex_input.glsl, VERTEX_FORMAT).
+    // Others (e.g. skybox, unlit, toon) keep the full layout.
+    const bool positionOnly = enabledAttributes.size() == 1 && enabledAttributes[0] == VertexLayout::Position;
+    const bool decodesFormats = enabledAttributes.empty() && vertShader.hasSpecializationConstant(0);
+    bool quantizable = useVertexInput && (positionOnly || decodesFormats);
+    for (uint32_t f = 0; f < (quantizable ? VertexFormatCount : 1u); ++f) {
+        setVertexFormat(static_cast<VertexFormat>(f));
+        formatConstant = static_cast<int32_t>(f);
+        auto result = m_context.getDevice().createGraphicsPipeline(m_context.getPipelineCache(), pipelineInfo);
+        if (result.result != vk::Result::eSuccess) throw std::runtime_error("Failed to create graphics pipeline!");
+        m_variants[f] = result.value;
+    }
+    m_pipeline = m_variants[static_cast<uint32_t>(VertexFormat::Full)];
 }
 
 } // namespace bb3d
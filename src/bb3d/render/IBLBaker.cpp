@@ -0,0 +1,423 @@
+#include "bb3d/render/IBLBaker.hpp"
+#include "bb3d/core/Float4.hpp"
+#include "bb3d/core/JobSystem.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <numbers>
+#include <stdexcept>
+#include <string>
+
+namespace bb3d {
+
+namespace {
+
+constexpr float Pi = std::numbers::pi_v<float>;
+constexpr uint32_t SHSourceWidth = 256; ///< SH9 is band-limited: a 256x128 version of the source is plenty.
+constexpr char CacheMagic[4] = { 'B', 'B', 'I', 'L' };
+
+/** @brief Runs `fn(i)` for i in [0, count), in groups of `groupSize` on the JobSystem when there is one. */
+void parallelFor(JobSystem* jobs, uint32_t count, uint32_t groupSize, const std::function<void(uint32_t)>& fn) {
+    if (jobs && count > groupSize && jobs->getThreadCount() > 0) {
+        jobs->dispatch(count, groupSize, [&](uint32_t i, uint32_t) { fn(i); });
+    } else {
+        for (uint32_t i = 0; i < count; ++i) fn(i);
+    }
+}
+
+/** @brief One level of the float pyramid of the equirectangular source. */
+struct Level {
+    uint32_t width = 0, height = 0;
+    std::vector<Float4> texels;
+
+    Float4 at(uint32_t x, uint32_t y) const { return texels[static_cast<size_t>(y) * width + x]; }
+
+    /** @brief Bilinear fetch: wraps horizontally, clamps at the poles. */
+    Float4 sample(float u, float v) const {
+        const float fx = u * static_cast<float>(width) - 0.5f;
+        const float fy = std::clamp(v * static_cast<float>(height) - 0.5f, 0.0f, static_cast<float>(height - 1));
+        const float x0f = std::floor(fx), y0f = std::floor(fy);
+        const float tx = fx - x0f, ty = fy - y0f;
+        const auto wrap = [this](int x) { return static_cast<uint32_t>(((x % static_cast<int>(width)) + static_cast<int>(width)) % static_cast<int>(width)); };
+        const uint32_t x0 = wrap(static_cast<int>(x0f)), x1 = wrap(static_cast<int>(x0f) + 1);
+        const uint32_t y0 = static_cast<uint32_t>(y0f), y1 = std::min(y0 + 1, height - 1);
+        const Float4 top = at(x0, y0) * (1.0f - tx) + at(x1, y0) * tx;
+        const Float4 bottom = at(x0, y1) * (1.0f - tx) + at(x1, y1) * tx;
+        return top * (1.0f - ty) + bottom * ty;
+    }
+};
+
+/** @brief Box-filtered float pyramid of the source, down to a few texels (filtered importance sampling). */
+std::vector<Level> buildPyramid(const HDRImage& image, JobSystem* jobs) {
+    if (image.width == 0 || image.height == 0 || image.texels.size() < static_cast<size_t>(image.width) * image.height * 4) {
+        throw std::runtime_error("IBLBaker: Invalid environment image");
+    }
+    std::vector<Level> levels(1);
+    levels[0].width = image.width;
+    levels[0].height = image.height;
+    levels[0].texels.resize(static_cast<size_t>(image.width) * image.height);
+    for (size_t i = 0; i < levels[0].texels.size(); ++i) levels[0].texels[i] = Float4::load(&image.texels[i * 4]);
+
+    while (levels.back().width > 8 && levels.back().height > 4) {
+        const Level& src = levels.back();
+        Level dst;
+        dst.width = std::max(src.width / 2, 1u);
+        dst.height = std::max(src.height / 2, 1u);
+        dst.texels.resize(static_cast<size_t>(dst.width) * dst.height);
+        parallelFor(jobs, dst.height, std::max(4096u / dst.width, 1u), [&](uint32_t y) {
+            const uint32_t ya = std::min(y * 2, src.height - 1), yb = std::min(y * 2 + 1, src.height - 1);
+            for (uint32_t x = 0; x < dst.width; ++x) {
+                const uint32_t xa = std::min(x * 2, src.width - 1), xb = std::min(x * 2 + 1, src.width - 1);
+                dst.texels[static_cast<size_t>(y) * dst.width + x] = (src.at(xa, ya) + src.at(xb, ya) + src.at(xa, yb) + src.at(xb, yb)) * 0.25f;
+            }
+        });
+        levels.push_back(std::move(dst));
+    }
+    return levels;
+}
+
+/** @brief Trilinear fetch of the pyramid in direction `dir` (`lod` in levels of the source). */
+Float4 sampleEnvironment(const std::vector<Level>& pyramid, const glm::vec3& dir, float lod) {
+    const float u = 0.5f + std::atan2(dir.z, dir.x) / (2.0f * Pi);
+    const float v = std::acos(std::clamp(dir.y, -1.0f, 1.0f)) / Pi;
+    lod = std::clamp(lod, 0.0f, static_cast<float>(pyramid.size() - 1));
+    const uint32_t fine = static_cast<uint32_t>(lod);
+    const float t = lod - static_cast<float>(fine);
+    const Float4 color = pyramid[fine].sample(u, v);
+    if (t <= 0.0f || fine + 1 >= pyramid.size()) return color;
+    return color * (1.0f - t) + pyramid[fine + 1].sample(u, v) * t;
+}
+
+float radicalInverse(uint32_t bits) {
+    bits = (bits << 16u) | (bits >> 16u);
+    bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+    bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+    bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+    bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+    return static_cast<float>(bits) * 2.3283064365386963e-10f;
+}
+
+/** @brief GGX half vector in tangent space (N = +Z) for the Hammersley point `i` of `count`. */
+glm::vec3 importanceSampleGGX(uint32_t i, uint32_t count, float roughness) {
+    const float a = roughness * roughness;
+    const float phi = 2.0f * Pi * (static_cast<float>(i) + 0.5f) / static_cast<float>(count);
+    const float xi = radicalInverse(i);
+    const float cosTheta = std::sqrt((1.0f - xi) / (1.0f + (a * a - 1.0f) * xi));
+    const float sinTheta = std::sqrt(std::max(1.0f - cosTheta * cosTheta, 0.0f));
+    return { sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta };
+}
+
+float distributionGGX(float NdotH, float roughness) {
+    const float a2 = roughness * roughness * roughness * roughness;
+    const float d = NdotH * NdotH * (a2 - 1.0f) + 1.0f;
+    return a2 / (Pi * d * d);
+}
+
+/** @brief Smith-Schlick visibility with the IBL remapping k = roughness^2 / 2. */
+float geometrySmith(float NdotV, float NdotL, float roughness) {
+    const float k = roughness * roughness * 0.5f;
+    return (NdotV / (NdotV * (1.0f - k) + k)) * (NdotL / (NdotL * (1.0f - k) + k));
+}
+
+/** @brief Light direction (tangent space) and source lod of one prefilter sample. */
+struct LobeSample {
+    glm::vec3 direction;
+    float weight; ///< NdotL
+    float lod;
+};
+
+/** @brief Samples of one roughness: with V = N they do not depend on the texel, only their frame does. */
+std::vector<LobeSample> buildLobe(float roughness, uint32_t count, const Level& source) {
+    // Filtered importance sampling: each sample reads the pyramid level whose texels cover its solid angle
+    const float texelSolidAngle = 4.0f * Pi / (static_cast<float>(source.width) * static_cast<float>(source.height));
+    std::vector<LobeSample> lobe;
+    lobe.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const glm::vec3 H = importanceSampleGGX(i, count, roughness);
+        const glm::vec3 L = H * (2.0f * H.z) - glm::vec3(0.0f, 0.0f, 1.0f);
+        if (L.z <= 0.0f) continue;
+        const float pdf = distributionGGX(H.z, roughness) * 0.25f;
+        const float sampleSolidAngle = 1.0f / (static_cast<float>(count) * pdf + 1e-6f);
+        lobe.push_back({ L, L.z, std::max(0.5f * std::log2(sampleSolidAngle / texelSolidAngle) + 1.0f, 0.0f) });
+    }
+    return lobe;
+}
+
+void storeHalf4(Float4 color, uint16_t* out) {
+    float c[4];
+    color.store(c);
+    for (int i = 0; i < 3; ++i) out[i] = IBLBaker::toHalf(std::max(c[i], 0.0f));
+    out[3] = IBLBaker::toHalf(1.0f);
+}
+
+template<typename T>
+void append(std::vector<std::byte>& out, const T& value) {
+    const auto* bytes = reinterpret_cast<const std::byte*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+} // namespace
+
+namespace IBLBaker {
+
+glm::vec3 equirectDirection(float u, float v) {
+    const float phi = (u - 0.5f) * 2.0f * Pi;
+    const float theta = v * Pi;
+    return { std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi) };
+}
+
+glm::vec3 cubeDirection(uint32_t face, uint32_t x, uint32_t y, uint32_t size) {
+    const float s = 2.0f * (static_cast<float>(x) + 0.5f) / static_cast<float>(size) - 1.0f;
+    const float t = 2.0f * (static_cast<float>(y) + 0.5f) / static_cast<float>(size) - 1.0f;
+    glm::vec3 dir;
+    switch (face) {
+        case 0: dir = { 1.0f, -t, -s }; break;
+        case 1: dir = { -1.0f, -t, s }; break;
+        case 2: dir = { s, 1.0f, t }; break;
+        case 3: dir = { s, -1.0f, -t }; break;
+        case 4: dir = { s, -t, 1.0f }; break;
+        default: dir = { -s, -t, -1.0f }; break;
+    }
+    return glm::normalize(dir);
+}
+
+static SHCoefficients projectPyramid(const std::vector<Level>& pyramid, JobSystem* jobs) {
+    const Level* source = &pyramid[0];
+    for (const Level& level : pyramid) {
+        source = &level;
+        if (level.width <= SHSourceWidth) break;
+    }
+
+    // One partial sum per row, reduced in order: the result does not depend on the thread count
+    std::vector<std::array<double, 27>> rows(source->height);
+    parallelFor(jobs, source->height, 8, [&](uint32_t y) {
+        std::array<double, 27>& sum = rows[y];
+        sum.fill(0.0);
+        const float v = (static_cast<float>(y) + 0.5f) / static_cast<float>(source->height);
+        const float solidAngle = (2.0f * Pi / static_cast<float>(source->width)) * (Pi / static_cast<float>(source->height)) * std::sin(v * Pi);
+        for (uint32_t x = 0; x < source->width; ++x) {
+            const glm::vec3 d = equirectDirection((static_cast<float>(x) + 0.5f) / static_cast<float>(source->width), v);
+            const float basis[9] = {
+                0.282095f,
+                0.488603f * d.y, 0.488603f * d.z, 0.488603f * d.x,
+                1.092548f * d.x * d.y, 1.092548f * d.y * d.z, 0.315392f * (3.0f * d.z * d.z - 1.0f),
+                1.092548f * d.x * d.z, 0.546274f * (d.x * d.x - d.y * d.y)
+            };
+            float c[4];
+            (source->at(x, y) * solidAngle).store(c);
+            for (int i = 0; i < 9; ++i) {
+                for (int k = 0; k < 3; ++k) sum[i * 3 + k] += static_cast<double>(c[k] * basis[i]);
+            }
+        }
+    });
+
+    std::array<double, 27> total{};
+    for (const auto& row : rows) {
+        for (size_t i = 0; i < total.size(); ++i) total[i] += row[i];
+    }
+
+    // Cosine lobe convolution per band (A0 = pi, A1 = 2pi/3, A2 = pi/4), divided by pi for the shader
+    constexpr double band[9] = { 1.0, 2.0 / 3.0, 2.0 / 3.0, 2.0 / 3.0, 0.25, 0.25, 0.25, 0.25, 0.25 };
+    SHCoefficients sh{};
+    for (int i = 0; i < 9; ++i) {
+        sh[i] = glm::vec4(static_cast<float>(total[i * 3] * band[i]), static_cast<float>(total[i * 3 + 1] * band[i]),
+                          static_cast<float>(total[i * 3 + 2] * band[i]), 0.0f);
+    }
+    return sh;
+}
+
+SHCoefficients projectIrradiance(const HDRImage& environment, JobSystem* jobs) {
+    return projectPyramid(buildPyramid(environment, jobs), jobs);
+}
+
+glm::vec3 evaluateIrradiance(const SHCoefficients& sh, const glm::vec3& n) {
+    const float basis[9] = {
+        0.282095f,
+        0.488603f * n.y, 0.488603f * n.z, 0.488603f * n.x,
+        1.092548f * n.x * n.y, 1.092548f * n.y * n.z, 0.315392f * (3.0f * n.z * n.z - 1.0f),
+        1.092548f * n.x * n.z, 0.546274f * (n.x * n.x - n.y * n.y)
+    };
+    glm::vec3 result(0.0f);
+    for (int i = 0; i < 9; ++i) result += glm::vec3(sh[i]) * basis[i];
+    return glm::max(result, glm::vec3(0.0f));
+}
+
+static KTX2Texture prefilterPyramid(const std::vector<Level>& pyramid, const IBLBakeSettings& settings, JobSystem* jobs) {
+    const uint32_t size = std::max(settings.specularSize, 1u);
+    uint32_t levels = 1;
+    while (levels < settings.specularLevels && (size >> levels) > 0) levels++;
+
+    KTX2Texture cube;
+    cube.format = KTX2Format::R16G16B16A16_SFLOAT;
+    cube.width = size;
+    cube.height = size;
+    cube.faceCount = 6;
+    cube.levels.resize(levels);
+
+    // A face covers a quarter of the source width: level 0 (mirror) reads the matching pyramid level
+    const float mirrorLod = std::max(std::log2(static_cast<float>(pyramid[0].width) / (4.0f * static_cast<float>(size))), 0.0f);
+    for (uint32_t level = 0; level < levels; ++level) {
+        const uint32_t levelSize = cube.getLevelWidth(level);
+        const float roughness = levels > 1 ? static_cast<float>(level) / static_cast<float>(levels - 1) : 0.0f;
+        const std::vector<LobeSample> lobe = level == 0 ? std::vector<LobeSample>{} : buildLobe(roughness, std::max(settings.specularSamples, 1u), pyramid[0]);
+
+        auto& data = cube.levels[level];
+        data.resize(KTX2::getImageSize(cube.format, levelSize, levelSize) * 6);
+        auto* out = reinterpret_cast<uint16_t*>(data.data());
+        parallelFor(jobs, 6 * levelSize, std::max(256u / levelSize, 1u), [&](uint32_t row) {
+            const uint32_t face = row / levelSize, y = row % levelSize;
+            for (uint32_t x = 0; x < levelSize; ++x) {
+                const glm::vec3 N = cubeDirection(face, x, y, levelSize);
+                Float4 color = Float4::zero();
+                if (lobe.empty()) {
+                    color = sampleEnvironment(pyramid, N, mirrorLod);
+                } else {
+                    const glm::vec3 up = std::abs(N.z) < 0.999f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+                    const glm::vec3 T = glm::normalize(glm::cross(up, N));
+                    const glm::vec3 B = glm::cross(N, T);
+                    float totalWeight = 0.0f;
+                    for (const LobeSample& s : lobe) {
+                        const glm::vec3 L = T * s.direction.x + B * s.direction.y + N * s.direction.z;
+                        color += sampleEnvironment(pyramid, L, s.lod) * s.weight;
+                        totalWeight += s.weight;
+                    }
+                    color = color * (1.0f / std::max(totalWeight, 1e-6f));
+                }
+                storeHalf4(color, out + ((static_cast<size_t>(face) * levelSize + y) * levelSize + x) * 4);
+            }
+        });
+    }
+    return cube;
+}
+
+KTX2Texture prefilterSpecular(const HDRImage& environment, const IBLBakeSettings& settings, JobSystem* jobs) {
+    return prefilterPyramid(buildPyramid(environment, jobs), settings, jobs);
+}
+
+KTX2Texture integrateBRDF(uint32_t size, uint32_t samples, JobSystem* jobs) {
+    size = std::max(size, 1u);
+    samples = std::max(samples, 1u);
+
+    KTX2Texture lut;
+    lut.format = KTX2Format::R16G16_SFLOAT;
+    lut.width = size;
+    lut.height = size;
+    lut.levels.resize(1);
+    lut.levels[0].resize(KTX2::getImageSize(lut.format, size, size));
+    auto* out = reinterpret_cast<uint16_t*>(lut.levels[0].data());
+
+    parallelFor(jobs, size, 4, [&](uint32_t y) {
+        const float roughness = (static_cast<float>(y) + 0.5f) / static_cast<float>(size);
+        for (uint32_t x = 0; x < size; ++x) {
+            const float NdotV = (static_cast<float>(x) + 0.5f) / static_cast<float>(size);
+            const glm::vec3 V(std::sqrt(1.0f - NdotV * NdotV), 0.0f, NdotV);
+            float scale = 0.0f, bias = 0.0f;
+            for (uint32_t i = 0; i < samples; ++i) {
+                const glm::vec3 H = importanceSampleGGX(i, samples, roughness);
+                const float VdotH = glm::dot(V, H);
+                const glm::vec3 L = H * (2.0f * VdotH) - V;
+                if (L.z <= 0.0f) continue;
+                const float visibility = geometrySmith(NdotV, L.z, roughness) * std::max(VdotH, 0.0f) / (H.z * NdotV);
+                const float fresnel = std::pow(1.0f - std::max(VdotH, 0.0f), 5.0f);
+                scale += (1.0f - fresnel) * visibility;
+                bias += fresnel * visibility;
+            }
+            uint16_t* texel = out + (static_cast<size_t>(y) * size + x) * 2;
+            texel[0] = toHalf(scale / static_cast<float>(samples));
+            texel[1] = toHalf(bias / static_cast<float>(samples));
+        }
+    });
+    return lut;
+}
+
+BakedEnvironment bake(const HDRImage& environment, const IBLBakeSettings& settings, JobSystem* jobs) {
+    const std::vector<Level> pyramid = buildPyramid(environment, jobs);
+    BakedEnvironment baked;
+    baked.irradiance = projectPyramid(pyramid, jobs);
+    baked.specular = prefilterPyramid(pyramid, settings, jobs);
+    return baked;
+}
+
+uint64_t hash(std::span<const std::byte> data, uint64_t seed) {
+    uint64_t h = seed;
+    for (std::byte b : data) {
+        h ^= static_cast<uint64_t>(b);
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+std::vector<std::byte> serialize(const BakedEnvironment& environment) {
+    std::vector<std::byte> out;
+    append(out, CacheMagic);
+    append(out, Version);
+    for (const glm::vec4& c : environment.irradiance) {
+        const float rgb[3] = { c.x, c.y, c.z };
+        append(out, rgb);
+    }
+    const std::vector<std::byte> cube = KTX2::write(environment.specular);
+    out.insert(out.end(), cube.begin(), cube.end());
+    return out;
+}
+
+BakedEnvironment deserialize(std::span<const std::byte> data) {
+    constexpr size_t HeaderSize = sizeof(CacheMagic) + sizeof(uint32_t) + 9 * 3 * sizeof(float);
+    uint32_t version = 0;
+    if (data.size() >= HeaderSize) std::memcpy(&version, data.data() + sizeof(CacheMagic), sizeof(version));
+    if (data.size() < HeaderSize || std::memcmp(data.data(), CacheMagic, sizeof(CacheMagic)) != 0 || version != Version) {
+        throw std::runtime_error("IBLBaker: Not a cache file of version " + std::to_string(Version));
+    }
+
+    BakedEnvironment environment;
+    const std::byte* cursor = data.data() + sizeof(CacheMagic) + sizeof(uint32_t);
+    for (glm::vec4& c : environment.irradiance) {
+        float rgb[3];
+        std::memcpy(rgb, cursor, sizeof(rgb));
+        cursor += sizeof(rgb);
+        c = glm::vec4(rgb[0], rgb[1], rgb[2], 0.0f);
+    }
+    environment.specular = KTX2::read(data.subspan(HeaderSize));
+    if (environment.specular.format != KTX2Format::R16G16B16A16_SFLOAT || environment.specular.faceCount != 6) {
+        throw std::runtime_error("IBLBaker: Cache file does not hold an RGBA16F cubemap");
+    }
+    return environment;
+}
+
+uint16_t toHalf(float value) {
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+    const float magnitude = std::fabs(value);
+    if (std::isnan(value)) return sign | 0x7E00u;
+    if (magnitude >= 65504.0f) return sign | 0x7BFFu;
+    if (magnitude < 6.103515625e-05f) { // Subnormal: multiples of 2^-24
+        return static_cast<uint16_t>(sign | static_cast<uint16_t>(std::lrint(magnitude * 16777216.0f)));
+    }
+
+    std::memcpy(&bits, &magnitude, sizeof(bits));
+    const uint32_t exponent = (bits >> 23) - 127 + 15;
+    const uint32_t mantissa = bits & 0x7FFFFFu;
+    uint32_t half = (exponent << 10) | (mantissa >> 13);
+    const uint32_t rest = mantissa & 0x1FFFu;
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) half++; // Round to nearest even (may carry into the exponent)
+    return static_cast<uint16_t>(sign | half);
+}
+
+float fromHalf(uint16_t value) {
+    const uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1Fu;
+    const uint32_t mantissa = value & 0x3FFu;
+    if (exponent == 0) {
+        const float magnitude = static_cast<float>(mantissa) / 16777216.0f;
+        return sign ? -magnitude : magnitude;
+    }
+    const uint32_t bits = sign | (exponent == 31 ? (0xFFu << 23) | (mantissa << 13) : ((exponent - 15 + 127) << 23) | (mantissa << 13));
+    float result = 0.0f;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+} // namespace IBLBaker
+
+} // namespace bb3d
@@ -0,0 +1,26 @@
+#include "bb3d/render/InstanceBudget.hpp"
+#include <algorithm>
+
+namespace bb3d {
+
+uint32_t InstanceBudget::grow(uint32_t current, uint32_t required) const {
+    if (m_budget > 0) required = std::min(required, m_budget);
+    if (required <= current) return current;
+    const uint64_t doubled = std::max<uint64_t>(uint64_t(current) * 2, 1);
+    uint64_t capacity = std::max<uint64_t>(doubled, required);
+    if (m_budget > 0) capacity = std::min<uint64_t>(capacity, m_budget);
+    return static_cast<uint32_t>(std::min<uint64_t>(capacity, UINT32_MAX));
+}
+
+uint32_t InstanceBudget::admit(uint32_t requested, bool& firstOverflow) {
+    firstOverflow = false;
+    if (m_budget == 0 || requested <= m_budget) {
+        m_overflowing = false;
+        return requested;
+    }
+    firstOverflow = !m_overflowing;
+    m_overflowing = true;
+    return m_budget;
+}
+
+} // namespace bb3d
@@ -0,0 +1,42 @@
+#include "bb3d/render/InstanceCuller.hpp"
+
+namespace bb3d {
+
+bool InstanceCuller::isVisible(const std::array<glm::vec4, 6>& planes, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    for (const auto& plane : planes) {
+        glm::vec3 positive = boundsMin;
+        if (plane.x >= 0) positive.x = boundsMax.x;
+        if (plane.y >= 0) positive.y = boundsMax.y;
+        if (plane.z >= 0) positive.z = boundsMax.z;
+        if (glm::dot(glm::vec3(plane), positive) + plane.w < 0) return false;
+    }
+    return true;
+}
+
+void InstanceCuller::cull(const GpuCullPushConstants& constants, const std::vector<GpuCullInstance>& instances,
+                          const std::vector<GpuDrawTemplate>& templates, uint32_t groupCount, Result& result) {
+    result.drawCounts.assign(constants.drawCount, 0);
+    result.counters.assign(groupCount + 1, 0);
+    result.compacted.assign(constants.instanceCount, UINT32_MAX);
+    result.commands.assign(constants.drawCount, IndexedDrawCommand{});
+
+    // Pass 1: one invocation per instance
+    for (uint32_t id = 0; id < constants.instanceCount; ++id) {
+        const GpuCullInstance& instance = instances[id];
+        if (!isVisible(constants.planes, instance.boundsMin, instance.boundsMax)) continue;
+        const uint32_t slot = result.drawCounts[instance.draw]++;
+        result.compacted[templates[instance.draw].firstInstance + slot] = instance.instance;
+        result.counters[0]++;
+    }
+
+    // Pass 2: one invocation per template
+    for (uint32_t id = 0; id < constants.drawCount; ++id) {
+        const uint32_t count = result.drawCounts[id];
+        if (count == 0) continue;
+        const GpuDrawTemplate& draw = templates[id];
+        const uint32_t slot = result.counters[1 + draw.group]++;
+        result.commands[draw.groupFirstDraw + slot] = { draw.indexCount, count, draw.firstIndex, draw.vertexOffset, constants.outputBase + draw.firstInstance };
+    }
+}
+
+} // namespace bb3d
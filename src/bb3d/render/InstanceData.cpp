@@ -0,0 +1,40 @@
+#include "bb3d/render/InstanceData.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace bb3d {
+
+InstanceData InstanceData::pack(const glm::mat4& world, uint32_t materialIndex, uint32_t color, uint32_t flags) {
+    InstanceData data;
+    // glm is column-major: row r gathers element r of each column
+    for (int r = 0; r < 3; ++r) data.rows[r] = glm::vec4(world[0][r], world[1][r], world[2][r], world[3][r]);
+    data.materialIndex = materialIndex;
+    data.color = color;
+    data.flags = flags;
+    return data;
+}
+
+glm::mat4 InstanceData::unpackTransform(const InstanceData& data) {
+    glm::mat4 world(1.0f);
+    for (int c = 0; c < 4; ++c) {
+        for (int r = 0; r < 3; ++r) world[c][r] = data.rows[r][c];
+    }
+    return world;
+}
+
+uint32_t InstanceData::packColor(const glm::vec4& color) {
+    uint32_t packed = 0;
+    for (int i = 0; i < 4; ++i) {
+        const float unorm = std::round(std::clamp(color[i], 0.0f, 1.0f) * 255.0f);
+        packed |= static_cast<uint32_t>(unorm) << (8 * i);
+    }
+    return packed;
+}
+
+glm::vec4 InstanceData::unpackColor(uint32_t color) {
+    glm::vec4 result;
+    for (int i = 0; i < 4; ++i) result[i] = static_cast<float>((color >> (8 * i)) & 0xFFu) / 255.0f;
+    return result;
+}
+
+} // namespace bb3d
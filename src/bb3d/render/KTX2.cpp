@@ -0,0 +1,252 @@
+#include "bb3d/render/KTX2.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace bb3d {
+
+namespace {
+
+constexpr uint8_t Identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+constexpr size_t HeaderSize = 12 + 9 * 4 + 4 * 4 + 2 * 8; // Identifier, header, index
+constexpr size_t LevelIndexEntrySize = 3 * 8;
+
+// Data Format Descriptor constants (Khronos Data Format Specification 1.3)
+constexpr uint8_t ModelRGBSDA = 1, ModelBC1A = 128, ModelBC3 = 130, ModelBC4 = 131, ModelBC5 = 132, ModelBC7 = 134;
+constexpr uint8_t PrimariesBT709 = 1;
+constexpr uint8_t TransferLinear = 1, TransferSRGB = 2;
+constexpr uint8_t ChannelAlpha = 15, QualifierLinear = 0x10, QualifierSigned = 0x40, QualifierFloat = 0x80;
+constexpr uint32_t FloatMinusOne = 0xBF800000u, FloatOne = 0x3F800000u; // sampleLower/Upper of float channels
+
+template<typename T>
+T readValue(std::span<const std::byte> data, size_t offset) {
+    if (offset + sizeof(T) > data.size()) throw std::runtime_error("KTX2: Truncated file");
+    T value;
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    return value;
+}
+
+template<typename T>
+void writeValue(std::vector<std::byte>& out, size_t offset, T value) {
+    std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+bool isKnownFormat(uint32_t format) {
+    switch (static_cast<KTX2Format>(format)) {
+        case KTX2Format::R8G8B8A8_UNORM: case KTX2Format::R8G8B8A8_SRGB:
+        case KTX2Format::R16G16_SFLOAT: case KTX2Format::R16G16B16A16_SFLOAT:
+        case KTX2Format::BC1_RGBA_UNORM: case KTX2Format::BC1_RGBA_SRGB:
+        case KTX2Format::BC3_UNORM: case KTX2Format::BC3_SRGB:
+        case KTX2Format::BC4_UNORM: case KTX2Format::BC5_UNORM:
+        case KTX2Format::BC7_UNORM: case KTX2Format::BC7_SRGB:
+            return true;
+        default:
+            return false;
+    }
+}
+
+struct Sample { uint16_t bitOffset; uint8_t bitLength; uint8_t channelType; uint32_t upper; uint32_t lower = 0; };
+
+/** @brief Basic Data Format Descriptor of the supported formats. */
+std::vector<uint32_t> buildDFD(KTX2Format format) {
+    const bool srgb = KTX2::isSRGB(format);
+    const uint8_t alpha = static_cast<uint8_t>(ChannelAlpha | (srgb ? QualifierLinear : 0));
+    uint8_t model = ModelRGBSDA, blockDim = 0, bytesPlane0 = 4;
+    std::vector<Sample> samples;
+
+    switch (format) {
+        case KTX2Format::BC1_RGBA_UNORM: case KTX2Format::BC1_RGBA_SRGB:
+            model = ModelBC1A; blockDim = 3; bytesPlane0 = 8;
+            samples = { { 0, 63, 1, 0xFFFFFFFFu } }; // Alpha-present channel
+            break;
+        case KTX2Format::BC3_UNORM: case KTX2Format::BC3_SRGB:
+            model = ModelBC3; blockDim = 3; bytesPlane0 = 16;
+            samples = { { 0, 63, alpha, 0xFFFFFFFFu }, { 64, 63, 0, 0xFFFFFFFFu } };
+            break;
+        case KTX2Format::BC4_UNORM:
+            model = ModelBC4; blockDim = 3; bytesPlane0 = 8;
+            samples = { { 0, 63, 0, 0xFFFFFFFFu } };
+            break;
+        case KTX2Format::BC5_UNORM:
+            model = ModelBC5; blockDim = 3; bytesPlane0 = 16;
+            samples = { { 0, 63, 0, 0xFFFFFFFFu }, { 64, 63, 1, 0xFFFFFFFFu } };
+            break;
+        case KTX2Format::BC7_UNORM: case KTX2Format::BC7_SRGB:
+            model = ModelBC7; blockDim = 3; bytesPlane0 = 16;
+            samples = { { 0, 127, 0, 0xFFFFFFFFu } };
+            break;
+        case KTX2Format::R16G16_SFLOAT: case KTX2Format::R16G16B16A16_SFLOAT: {
+            const uint8_t half = QualifierFloat | QualifierSigned;
+            const uint8_t channels = format == KTX2Format::R16G16_SFLOAT ? 2 : 4;
+            bytesPlane0 = channels * 2;
+            for (uint8_t c = 0; c < channels; ++c) {
+                const uint8_t type = static_cast<uint8_t>((c == 3 ? ChannelAlpha : c) | half);
+                samples.push_back({ static_cast<uint16_t>(c * 16), 15, type, FloatOne, FloatMinusOne });
+            }
+            break;
+        }
+        default:
+            samples = { { 0, 7, 0, 255 }, { 8, 7, 1, 255 }, { 16, 7, 2, 255 }, { 24, 7, alpha, 255 } };
+            break;
+    }
+
+    const uint32_t blockSize = 24 + 16 * static_cast<uint32_t>(samples.size());
+    std::vector<uint32_t> words;
+    words.push_back(4 + blockSize);                       // dfdTotalSize
+    words.push_back(0);                                   // vendorId = Khronos, descriptorType = basic
+    words.push_back(2u | (blockSize << 16));              // versionNumber, descriptorBlockSize
+    words.push_back(model | (PrimariesBT709 << 8) | ((srgb ? TransferSRGB : TransferLinear) << 16));
+    words.push_back(blockDim | (blockDim << 8));          // texelBlockDimension0..3 (minus one)
+    words.push_back(bytesPlane0);                         // bytesPlane0..3
+    words.push_back(0);                                   // bytesPlane4..7
+    for (const auto& sample : samples) {
+        words.push_back(sample.bitOffset | (static_cast<uint32_t>(sample.bitLength) << 16) | (static_cast<uint32_t>(sample.channelType) << 24));
+        words.push_back(0);                               // samplePosition
+        words.push_back(sample.lower);
+        words.push_back(sample.upper);
+    }
+    return words;
+}
+
+} // namespace
+
+namespace KTX2 {
+
+bool isKTX2(std::span<const std::byte> data) {
+    return data.size() >= sizeof(Identifier) && std::memcmp(data.data(), Identifier, sizeof(Identifier)) == 0;
+}
+
+std::optional<BlockFormat> getBlockFormat(KTX2Format format) {
+    switch (format) {
+        case KTX2Format::BC1_RGBA_UNORM: case KTX2Format::BC1_RGBA_SRGB: return BlockFormat::BC1;
+        case KTX2Format::BC3_UNORM: case KTX2Format::BC3_SRGB: return BlockFormat::BC3;
+        case KTX2Format::BC4_UNORM: return BlockFormat::BC4;
+        case KTX2Format::BC5_UNORM: return BlockFormat::BC5;
+        case KTX2Format::BC7_UNORM: case KTX2Format::BC7_SRGB: return BlockFormat::BC7;
+        default: return std::nullopt;
+    }
+}
+
+bool isSRGB(KTX2Format format) {
+    return format == KTX2Format::R8G8B8A8_SRGB || format == KTX2Format::BC1_RGBA_SRGB ||
+           format == KTX2Format::BC3_SRGB || format == KTX2Format::BC7_SRGB;
+}
+
+bool isFloat(KTX2Format format) {
+    return format == KTX2Format::R16G16_SFLOAT || format == KTX2Format::R16G16B16A16_SFLOAT;
+}
+
+size_t getImageSize(KTX2Format format, uint32_t width, uint32_t height) {
+    if (auto block = getBlockFormat(format)) return BlockCompression::compressedSize(*block, width, height);
+    const size_t texelBytes = format == KTX2Format::R16G16B16A16_SFLOAT ? 8 : 4;
+    return static_cast<size_t>(width) * height * texelBytes;
+}
+
+KTX2Texture read(std::span<const std::byte> data) {
+    if (!isKTX2(data)) throw std::runtime_error("KTX2: Invalid identifier");
+
+    const uint32_t vkFormat = readValue<uint32_t>(data, 12);
+    const uint32_t pixelWidth = readValue<uint32_t>(data, 20);
+    const uint32_t pixelHeight = readValue<uint32_t>(data, 24);
+    const uint32_t pixelDepth = readValue<uint32_t>(data, 28);
+    const uint32_t layerCount = readValue<uint32_t>(data, 32);
+    const uint32_t faceCount = readValue<uint32_t>(data, 36);
+    const uint32_t levelCount = std::max(readValue<uint32_t>(data, 40), 1u);
+    const uint32_t supercompression = readValue<uint32_t>(data, 44);
+
+    if (!isKnownFormat(vkFormat)) throw std::runtime_error("KTX2: Unsupported format " + std::to_string(vkFormat));
+    if (supercompression != 0) throw std::runtime_error("KTX2: Supercompressed files are not supported");
+    if (pixelWidth == 0 || pixelHeight == 0 || pixelDepth > 1 || layerCount > 1) throw std::runtime_error("KTX2: Only 2D textures and cubemaps are supported");
+    if (faceCount != 1 && faceCount != 6) throw std::runtime_error("KTX2: Invalid face count");
+    if (levelCount > 32 || (std::max(pixelWidth, pixelHeight) >> (levelCount - 1)) == 0) throw std::runtime_error("KTX2: Invalid level count");
+
+    KTX2Texture texture;
+    texture.format = static_cast<KTX2Format>(vkFormat);
+    texture.width = pixelWidth;
+    texture.height = pixelHeight;
+    texture.faceCount = faceCount;
+    texture.levels.resize(levelCount);
+
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        const size_t entry = HeaderSize + level * LevelIndexEntrySize;
+        const uint64_t offset = readValue<uint64_t>(data, entry);
+        const uint64_t length = readValue<uint64_t>(data, entry + 8);
+        const size_t expected = getImageSize(texture.format, texture.getLevelWidth(level), texture.getLevelHeight(level)) * faceCount;
+        if (length < expected || offset > data.size() || length > data.size() - offset) {
+            throw std::runtime_error("KTX2: Level " + std::to_string(level) + " is out of bounds");
+        }
+        const auto* begin = reinterpret_cast<const uint8_t*>(data.data()) + offset;
+        texture.levels[level].assign(begin, begin + expected);
+    }
+    return texture;
+}
+
+std::vector<std::byte> write(const KTX2Texture& texture) {
+    if (texture.levels.empty()) throw std::runtime_error("KTX2: Texture has no level");
+
+    const auto blockFormat = getBlockFormat(texture.format);
+    const uint32_t typeSize = isFloat(texture.format) ? 2 : 1;
+    const size_t levelAlignment = blockFormat ? BlockCompression::blockBytes(*blockFormat)
+                                              : std::max<size_t>(getImageSize(texture.format, 1, 1), 4); // lcm(texel block size, 4)
+    const uint32_t levelCount = static_cast<uint32_t>(texture.levels.size());
+
+    const std::vector<uint32_t> dfd = buildDFD(texture.format);
+    static constexpr char Key[] = "KTXwriter";
+    static constexpr char Value[] = "bb3d texture cooker";
+    const uint32_t kvLength = sizeof(Key) + sizeof(Value);
+
+    const size_t dfdOffset = HeaderSize + levelCount * LevelIndexEntrySize;
+    const size_t dfdLength = dfd.size() * 4;
+    const size_t kvdOffset = dfdOffset + dfdLength;
+    const size_t kvdLength = alignUp(4 + kvLength, 4);
+
+    // Levels are stored smallest first (mip padding order recommended by the specification)
+    std::vector<size_t> levelOffsets(levelCount);
+    size_t cursor = kvdOffset + kvdLength;
+    for (uint32_t level = levelCount; level-- > 0;) {
+        cursor = alignUp(cursor, levelAlignment);
+        levelOffsets[level] = cursor;
+        cursor += texture.levels[level].size();
+    }
+
+    std::vector<std::byte> out(cursor);
+    std::memcpy(out.data(), Identifier, sizeof(Identifier));
+    writeValue<uint32_t>(out, 12, static_cast<uint32_t>(texture.format));
+    writeValue<uint32_t>(out, 16, typeSize);
+    writeValue<uint32_t>(out, 20, texture.width);
+    writeValue<uint32_t>(out, 24, texture.height);
+    writeValue<uint32_t>(out, 28, 0);              // pixelDepth
+    writeValue<uint32_t>(out, 32, 0);              // layerCount (not an array)
+    writeValue<uint32_t>(out, 36, texture.faceCount);
+    writeValue<uint32_t>(out, 40, levelCount);
+    writeValue<uint32_t>(out, 44, 0);              // supercompressionScheme
+    writeValue<uint32_t>(out, 48, static_cast<uint32_t>(dfdOffset));
+    writeValue<uint32_t>(out, 52, static_cast<uint32_t>(dfdLength));
+    writeValue<uint32_t>(out, 56, static_cast<uint32_t>(kvdOffset));
+    writeValue<uint32_t>(out, 60, static_cast<uint32_t>(kvdLength));
+    writeValue<uint64_t>(out, 64, 0);              // sgdByteOffset
+    writeValue<uint64_t>(out, 72, 0);              // sgdByteLength
+
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        const size_t entry = HeaderSize + level * LevelIndexEntrySize;
+        writeValue<uint64_t>(out, entry, levelOffsets[level]);
+        writeValue<uint64_t>(out, entry + 8, texture.levels[level].size());
+        writeValue<uint64_t>(out, entry + 16, texture.levels[level].size());
+        std::memcpy(out.data() + levelOffsets[level], texture.levels[level].data(), texture.levels[level].size());
+    }
+
+    std::memcpy(out.data() + dfdOffset, dfd.data(), dfdLength);
+    writeValue<uint32_t>(out, kvdOffset, kvLength);
+    std::memcpy(out.data() + kvdOffset + 4, Key, sizeof(Key));
+    std::memcpy(out.data() + kvdOffset + 4 + sizeof(Key), Value, sizeof(Value));
+    return out;
+}
+
+} // namespace KTX2
+
+} // namespace bb3d
@@ -1,5 +1,6 @@
 #include "bb3d/render/Material.hpp"
 #include "bb3d/render/UniformBuffer.hpp"
+#include "bb3d/render/BindlessMaterials.hpp"
 #include <array>
 
 namespace bb3d {
@@ -27,6 +28,16 @@ void Material::Cleanup() {
     s_defaultNormal = nullptr; 
 }
 
+bool Material::residencyChanged(std::initializer_list<const Texture*> textures) {
+    uint64_t stamp = 0;
+    for (const Texture* texture : textures) {
+        if (texture) stamp += texture->getResidencyVersion();
+    }
+    if (stamp == m_residencyStamp) return false;
+    m_residencyStamp = stamp;
+    return true;
+}
+
 // --- PBRMaterial ---
 PBRMaterial::PBRMaterial(VulkanContext& context) : Material(context) {
     InitDefaults(context);
@@ -38,6 +49,7 @@ PBRMaterial::PBRMaterial(VulkanContext& context) : Material(context) {
     }
 }
 PBRMaterial::~PBRMaterial() { 
+    releaseBindless();
     for (auto& buffer : m_paramBuffers) buffer.reset(); 
 }
 vk::DescriptorSetLayout PBRMaterial::CreateLayout(vk::Device device) {
@@ -57,6 +69,9 @@ vk::DescriptorSet PBRMaterial::getDescriptorSet(vk::DescriptorPool pool, vk::Des
         m_dirty[frame] = true; 
     }
 
+    // Streamed textures replace their image view when their resident mips change
+    if (residencyChanged({ m_albedoMap.get(), m_normalMap.get(), m_ormMap.get(), m_emissiveMap.get() })) m_dirty.fill(true);
+
     // If a texture is not ready, we stay dirty to retry next frame
     if ((m_albedoMap && !m_albedoMap->isReady()) || 
         (m_normalMap && !m_normalMap->isReady()) || 
@@ -71,6 +86,52 @@ vk::DescriptorSet PBRMaterial::getDescriptorSet(vk::DescriptorPool pool, vk::Des
     }
     return m_sets[frame];
 }
+void PBRMaterial::requestTextureResolution(float screenPixels) {
+    for (Texture* texture : { m_albedoMap.get(), m_normalMap.get(), m_ormMap.get(), m_emissiveMap.get() }) {
+        if (texture) texture->requestResolution(screenPixels);
+    }
+}
+uint32_t PBRMaterial::getBindlessIndex(const Ref<BindlessMaterials>& table) {
+    if (!m_bindlessIndex) {
+        m_bindlessIndex = table->allocateMaterial();
+        if (!m_bindlessIndex) return 0;
+        m_bindless = table;
+        m_bindlessDirty = true;
+    }
+    if (!m_bindlessDirty) return *m_bindlessIndex;
+
+    // Textures that are not ready yet are replaced by the defaults; we stay dirty to retry next frame
+    const std::array<std::pair<const Ref<Texture>*, const Ref<Texture>*>, 4> maps = {{
+        { &m_albedoMap, &s_defaultWhite }, { &m_normalMap, &s_defaultNormal }, { &m_ormMap, &s_defaultWhite }, { &m_emissiveMap, &s_defaultBlack }
+    }};
+    bool complete = true;
+    std::array<std::optional<uint32_t>, 4> slots;
+    GPUMaterial record;
+    for (size_t i = 0; i < maps.size(); ++i) {
+        const Ref<Texture>& map = *maps[i].first;
+        const bool ready = map && map->isReady();
+        complete = complete && (ready || !map);
+        slots[i] = table->acquireTexture(ready ? map : *maps[i].second);
+        record.textures[static_cast<int>(i)] = slots[i].value_or(0);
+    }
+    // Acquired before releasing: unchanged textures keep their slot
+    for (auto& slot : m_bindlessTextures) if (slot) table->releaseTexture(*slot);
+    m_bindlessTextures = slots;
+
+    record.baseColorFactor = m_parameters.baseColorFactor;
+    record.factors = { m_parameters.metallicFactor, m_parameters.roughnessFactor, m_parameters.normalScale, m_parameters.occlusionStrength };
+    table->setMaterial(*m_bindlessIndex, record);
+    m_bindlessDirty = !complete;
+    return *m_bindlessIndex;
+}
+void PBRMaterial::releaseBindless() {
+    auto table = m_bindless.lock();
+    if (!table) return;
+    for (auto& slot : m_bindlessTextures) if (slot) table->releaseTexture(*slot);
+    if (m_bindlessIndex) table->releaseMaterial(*m_bindlessIndex);
+    m_bindlessTextures = {};
+    m_bindlessIndex.reset();
+}
 void PBRMaterial::updateDescriptorSet(uint32_t frame) {
     m_paramBuffers[frame]->update(&m_parameters, sizeof(PBRParameters));
     vk::DescriptorBufferInfo bInfo(m_paramBuffers[frame]->getHandle(), 0, sizeof(PBRParameters));
@@ -115,6 +176,8 @@ vk::DescriptorSet UnlitMaterial::getDescriptorSet(vk::DescriptorPool pool, vk::D
         m_dirty[frame] = true; 
     }
     
+    if (residencyChanged({ m_baseMap.get() })) m_dirty.fill(true);
+
     // If texture is not ready, we stay dirty to retry later without blocking
     if (m_baseMap && !m_baseMap->isReady()) m_dirty[frame] = true;
 
@@ -159,6 +222,7 @@ vk::DescriptorSet ToonMaterial::getDescriptorSet(vk::DescriptorPool pool, vk::De
         m_dirty[frame] = true; 
     }
 
+    if (residencyChanged({ m_baseMap.get() })) m_dirty.fill(true);
     if (m_baseMap && !m_baseMap->isReady()) m_dirty[frame] = true;
 
     if (m_dirty[frame]) { updateDescriptorSet(frame); m_dirty[frame] = false; }
@@ -219,6 +283,7 @@ vk::DescriptorSet SkySphereMaterial::getDescriptorSet(vk::DescriptorPool pool, v
         m_dirty[frame] = true; 
     }
 
+    if (residencyChanged({ m_texture.get() })) m_dirty.fill(true);
     if (m_texture && !m_texture->isReady()) m_dirty[frame] = true;
 
     if (m_dirty[frame]) { updateDescriptorSet(frame); m_dirty[frame] = false; }
@@ -255,6 +320,7 @@ vk::DescriptorSet PlasmaMaterial::getDescriptorSet(vk::DescriptorPool pool, vk::
         m_dirty[frame] = true; 
     }
     
+    if (residencyChanged({ m_baseMap.get() })) m_dirty.fill(true);
     if (m_baseMap && !m_baseMap->isReady()) m_dirty[frame] = true;
 
     if (m_dirty[frame]) { updateDescriptorSet(frame); m_dirty[frame] = false; }
@@ -298,6 +364,7 @@ vk::DescriptorSet ParticleMaterial::getDescriptorSet(vk::DescriptorPool pool, vk
         m_dirty[frame] = true; 
     }
     
+    if (residencyChanged({ m_baseMap.get() })) m_dirty.fill(true);
     if (m_baseMap && !m_baseMap->isReady()) m_dirty[frame] = true;
 
     if (m_dirty[frame]) { updateDescriptorSet(frame); m_dirty[frame] = false; }
@@ -27,7 +27,7 @@ Scope<Mesh> MeshGenerator::createCube(VulkanContext& context, float size, const
         indices.push_back(offset + 2); indices.push_back(offset + 3); indices.push_back(offset + 0);
     }
 
-    return CreateScope<Mesh>(context, vertices, indices);
+    return CreateScope<Mesh>(context, std::move(vertices), std::move(indices));
 }
 
 Scope<Mesh> MeshGenerator::createWireframeCube(VulkanContext& context, float size, const glm::vec3& color) {
@@ -55,7 +55,7 @@ Scope<Mesh> MeshGenerator::createWireframeCube(VulkanContext& context, float siz
         0, 4,  1, 5,  2, 6,  3, 7
     };
 
-    return CreateScope<Mesh>(context, vertices, indices);
+    return CreateScope<Mesh>(context, std::move(vertices), std::move(indices));
 }
 
 Scope<Mesh> MeshGenerator::createSphere(VulkanContext& context, float radius, uint32_t segments, const glm::vec3& color) {
@@ -93,7 +93,7 @@ Scope<Mesh> MeshGenerator::createSphere(VulkanContext& context, float radius, ui
         }
     }
 
-    return CreateScope<Mesh>(context, vertices, indices);
+    return CreateScope<Mesh>(context, std::move(vertices), std::move(indices));
 }
 
 Scope<Mesh> MeshGenerator::createCone(VulkanContext& context, float radius, float height, uint32_t segments, const glm::vec3& color) {
@@ -184,7 +184,7 @@ Scope<Mesh> MeshGenerator::createCone(VulkanContext& context, float radius, floa
         indices.push_back(tip1); // Tip connects the two bases.
     }
 
-    return CreateScope<Mesh>(context, vertices, indices);
+    return CreateScope<Mesh>(context, std::move(vertices), std::move(indices));
 }
 
 
@@ -214,7 +214,7 @@ Scope<Mesh> MeshGenerator::createCheckerboardPlane(VulkanContext& context, float
         }
     }
 
-    return CreateScope<Mesh>(context, vertices, indices);
+    return CreateScope<Mesh>(context, std::move(vertices), std::move(indices));
 }
 
 Scope<Mesh> MeshGenerator::createQuad(VulkanContext& context, float size, const glm::vec3& color) {
@@ -228,7 +228,7 @@ Scope<Mesh> MeshGenerator::createQuad(VulkanContext& context, float size, const
 
     std::vector<uint32_t> indices = { 0, 1, 2, 2, 3, 0 };
 
-    return CreateScope<Mesh>(context, vertices, indices);
+    return CreateScope<Mesh>(context, std::move(vertices), std::move(indices));
 }
 
 } // namespace bb3d
\ No newline at end of file
@@ -0,0 +1,260 @@
+#include "bb3d/render/MeshSimplifier.hpp"
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <queue>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace bb3d {
+
+namespace {
+
+/** @brief Symmetric 4x4 quadric stored as its 10 unique coefficients, plus the total weight of its planes. */
+struct Quadric {
+    double a2 = 0, ab = 0, ac = 0, ad = 0;
+    double b2 = 0, bc = 0, bd = 0;
+    double c2 = 0, cd = 0;
+    double d2 = 0;
+    double weight = 0;
+
+    void addPlane(const glm::dvec3& n, double d, double w) {
+        a2 += w * n.x * n.x; ab += w * n.x * n.y; ac += w * n.x * n.z; ad += w * n.x * d;
+        b2 += w * n.y * n.y; bc += w * n.y * n.z; bd += w * n.y * d;
+        c2 += w * n.z * n.z; cd += w * n.z * d;
+        d2 += w * d * d;
+        weight += w;
+    }
+
+    void add(const Quadric& o) {
+        a2 += o.a2; ab += o.ab; ac += o.ac; ad += o.ad;
+        b2 += o.b2; bc += o.bc; bd += o.bd;
+        c2 += o.c2; cd += o.cd;
+        d2 += o.d2;
+        weight += o.weight;
+    }
+
+    /** @brief Area-weighted mean squared distance to the planes: a squared length, whatever the mesh scale. */
+    [[nodiscard]] double meanError(const glm::dvec3& p) const {
+        return weight > 0.0 ? std::max(0.0, error(p)) / weight : 0.0;
+    }
+
+    [[nodiscard]] double error(const glm::dvec3& p) const {
+        double x = p.x, y = p.y, z = p.z;
+        return a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x
+             + b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y
+             + c2 * z * z + 2.0 * cd * z
+             + d2;
+    }
+};
+
+struct Collapse {
+    double cost;
+    uint32_t from, to;
+    uint32_t fromVersion, toVersion;
+
+    bool operator>(const Collapse& o) const { return cost > o.cost; }
+};
+
+inline uint64_t edgeKey(uint32_t a, uint32_t b) {
+    if (a > b) std::swap(a, b);
+    return (static_cast<uint64_t>(a) << 32) | b;
+}
+
+} // namespace
+
+std::vector<uint32_t> MeshSimplifier::simplify(const float* positions, size_t vertexCount, size_t stride,
+                                               std::span<const uint32_t> indices,
+                                               size_t targetIndexCount, float targetError,
+                                               float* outError) {
+    if (outError) *outError = 0.0f;
+    std::vector<uint32_t> result(indices.begin(), indices.end());
+    if (!positions || vertexCount == 0 || indices.size() < 3 || targetIndexCount >= indices.size()) return result;
+
+    // 1. Gather positions and extent
+    std::vector<glm::dvec3> pos(vertexCount);
+    glm::dvec3 minP(std::numeric_limits<double>::max()), maxP(std::numeric_limits<double>::lowest());
+    for (size_t i = 0; i < vertexCount; ++i) {
+        const float* p = reinterpret_cast<const float*>(reinterpret_cast<const char*>(positions) + i * stride);
+        pos[i] = glm::dvec3(p[0], p[1], p[2]);
+        minP = glm::min(minP, pos[i]);
+        maxP = glm::max(maxP, pos[i]);
+    }
+    double extent = glm::length(maxP - minP);
+    if (extent <= 0.0) return result;
+
+    // 2. Triangles (degenerate inputs are dropped)
+    std::vector<glm::uvec3> tris;
+    tris.reserve(indices.size() / 3);
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        uint32_t a = indices[i], b = indices[i + 1], c = indices[i + 2];
+        if (a >= vertexCount || b >= vertexCount || c >= vertexCount) continue;
+        if (a == b || b == c || a == c) continue;
+        tris.emplace_back(a, b, c);
+    }
+    std::vector<bool> triAlive(tris.size(), true);
+    size_t liveIndexCount = tris.size() * 3;
+
+    // 3. Border / seam detection: edges used by exactly one triangle (or non-manifold ones) lock their vertices
+    std::unordered_map<uint64_t, uint32_t> edgeUse;
+    edgeUse.reserve(tris.size() * 3);
+    for (const auto& t : tris) {
+        edgeUse[edgeKey(t.x, t.y)]++;
+        edgeUse[edgeKey(t.y, t.z)]++;
+        edgeUse[edgeKey(t.z, t.x)]++;
+    }
+    std::vector<bool> locked(vertexCount, false);
+    for (const auto& [key, count] : edgeUse) {
+        if (count != 2) {
+            locked[static_cast<uint32_t>(key >> 32)] = true;
+            locked[static_cast<uint32_t>(key & 0xFFFFFFFFu)] = true;
+        }
+    }
+
+    // 4. Quadrics (area weighted) and vertex -> triangle adjacency
+    std::vector<Quadric> quadrics(vertexCount);
+    std::vector<std::vector<uint32_t>> vertexTris(vertexCount);
+    for (uint32_t t = 0; t < static_cast<uint32_t>(tris.size()); ++t) {
+        const auto& tri = tris[t];
+        glm::dvec3 n = glm::cross(pos[tri.y] - pos[tri.x], pos[tri.z] - pos[tri.x]);
+        double len = glm::length(n);
+        if (len > 0.0) {
+            n /= len;
+            double d = -glm::dot(n, pos[tri.x]);
+            double w = len * 0.5;
+            quadrics[tri.x].addPlane(n, d, w);
+            quadrics[tri.y].addPlane(n, d, w);
+            quadrics[tri.z].addPlane(n, d, w);
+        }
+        vertexTris[tri.x].push_back(t);
+        vertexTris[tri.y].push_back(t);
+        vertexTris[tri.z].push_back(t);
+    }
+
+    // 5. Candidate collapses
+    std::vector<uint32_t> version(vertexCount, 0);
+    std::vector<bool> removed(vertexCount, false);
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> heap;
+
+    auto pushCollapse = [&](uint32_t from, uint32_t to) {
+        if (locked[from]) return;
+        Quadric q = quadrics[from];
+        q.add(quadrics[to]);
+        heap.push({ q.meanError(pos[to]), from, to, version[from], version[to] });
+    };
+
+    for (const auto& t : tris) {
+        pushCollapse(t.x, t.y); pushCollapse(t.y, t.x);
+        pushCollapse(t.y, t.z); pushCollapse(t.z, t.y);
+        pushCollapse(t.z, t.x); pushCollapse(t.x, t.z);
+    }
+
+    // Collapsing `from` onto `to` must not flip any remaining triangle around `from`.
+    auto flipsTriangle = [&](uint32_t from, uint32_t to) {
+        for (uint32_t t : vertexTris[from]) {
+            if (!triAlive[t]) continue;
+            const auto& tri = tris[t];
+            if (tri.x == to || tri.y == to || tri.z == to) continue; // Will become degenerate
+            glm::dvec3 p[3] = { pos[tri.x], pos[tri.y], pos[tri.z] };
+            glm::dvec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+            for (int k = 0; k < 3; ++k) if (tri[k] == from) p[k] = pos[to];
+            glm::dvec3 after = glm::cross(p[1] - p[0], p[2] - p[0]);
+            if (glm::dot(before, after) <= 0.0) return true;
+        }
+        return false;
+    };
+
+    // 6. Greedy collapse loop
+    double maxErrorReached = 0.0;
+    const double errorLimit = static_cast<double>(targetError) * extent;
+    while (liveIndexCount > targetIndexCount && !heap.empty()) {
+        Collapse c = heap.top();
+        heap.pop();
+
+        if (removed[c.from] || removed[c.to]) continue;
+        if (c.fromVersion != version[c.from] || c.toVersion != version[c.to]) continue;
+
+        double geomError = std::sqrt(c.cost);
+        if (geomError > errorLimit) break;
+        if (flipsTriangle(c.from, c.to)) continue;
+
+        quadrics[c.to].add(quadrics[c.from]);
+        removed[c.from] = true;
+        maxErrorReached = std::max(maxErrorReached, geomError);
+
+        for (uint32_t t : vertexTris[c.from]) {
+            if (!triAlive[t]) continue;
+            auto& tri = tris[t];
+            for (int k = 0; k < 3; ++k) if (tri[k] == c.from) tri[k] = c.to;
+            if (tri.x == tri.y || tri.y == tri.z || tri.x == tri.z) {
+                triAlive[t] = false;
+                liveIndexCount -= 3;
+            } else {
+                vertexTris[c.to].push_back(t);
+            }
+        }
+        vertexTris[c.from].clear();
+        version[c.to]++;
+
+        // Compact the adjacency list and refresh the costs around the merged vertex
+        auto& adj = vertexTris[c.to];
+        std::erase_if(adj, [&](uint32_t t) { return !triAlive[t]; });
+        std::sort(adj.begin(), adj.end());
+        adj.erase(std::unique(adj.begin(), adj.end()), adj.end());
+        for (uint32_t t : adj) {
+            const auto& tri = tris[t];
+            for (int k = 0; k < 3; ++k) {
+                uint32_t w = tri[k];
+                if (w == c.to) continue;
+                pushCollapse(c.to, w);
+                pushCollapse(w, c.to);
+            }
+        }
+    }
+
+    // 7. Output
+    result.clear();
+    result.reserve(liveIndexCount);
+    for (size_t t = 0; t < tris.size(); ++t) {
+        if (!triAlive[t]) continue;
+        result.push_back(tris[t].x);
+        result.push_back(tris[t].y);
+        result.push_back(tris[t].z);
+    }
+    if (outError) *outError = static_cast<float>(maxErrorReached / extent);
+    return result;
+}
+
+LODChain MeshSimplifier::buildLODChain(const float* positions, size_t vertexCount, size_t stride,
+                                       std::span<const uint32_t> indices,
+                                       const LODSettings& settings) {
+    LODChain chain;
+    chain.indices.assign(indices.begin(), indices.end());
+    chain.levels.push_back({ 0, static_cast<uint32_t>(indices.size()), 1.0f, 0.0f });
+
+    if (indices.size() / 3 < settings.minTriangles) return chain;
+
+    std::vector<uint32_t> current(indices.begin(), indices.end());
+    float screenSize = settings.firstScreenSize;
+    float accumulatedError = 0.0f;
+
+    for (uint32_t level = 1; level < settings.levels; ++level) {
+        size_t target = static_cast<size_t>(static_cast<float>(current.size() / 3) * settings.reductionPerLevel) * 3;
+        if (target < 3) break;
+
+        float error = 0.0f;
+        auto lod = simplify(positions, vertexCount, stride, current, target, settings.maxError, &error);
+
+        // Stop when the error bound (or locked borders) prevents any meaningful reduction.
+        if (lod.empty() || lod.size() * 20 >= current.size() * 19) break;
+
+        accumulatedError += error;
+        chain.levels.push_back({ static_cast<uint32_t>(chain.indices.size()), static_cast<uint32_t>(lod.size()), screenSize, accumulatedError });
+        chain.indices.insert(chain.indices.end(), lod.begin(), lod.end());
+        current = std::move(lod);
+        screenSize *= 0.5f;
+    }
+    return chain;
+}
+
+} // namespace bb3d
@@ -0,0 +1,143 @@
+#include "bb3d/render/Meshlet.hpp"
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace bb3d {
+
+MeshletData MeshletBuilder::build(const float* positions, size_t vertexCount, size_t stride,
+                                  std::span<const uint32_t> indices,
+                                  uint32_t maxVertices, uint32_t maxTriangles) {
+    MeshletData data;
+    const size_t triCount = indices.size() / 3;
+    if (!positions || vertexCount == 0 || triCount == 0) return data;
+    maxVertices = std::max(maxVertices, 3u);
+    maxTriangles = std::max(maxTriangles, 1u);
+
+    auto position = [&](uint32_t v) {
+        const float* p = reinterpret_cast<const float*>(reinterpret_cast<const char*>(positions) + v * stride);
+        return glm::vec3(p[0], p[1], p[2]);
+    };
+
+    // 1. Vertex -> triangle adjacency (CSR)
+    std::vector<uint32_t> adjOffsets(vertexCount + 1, 0);
+    for (size_t i = 0; i < triCount * 3; ++i) adjOffsets[indices[i] + 1]++;
+    for (size_t v = 0; v < vertexCount; ++v) adjOffsets[v + 1] += adjOffsets[v];
+    std::vector<uint32_t> adjTris(triCount * 3);
+    {
+        std::vector<uint32_t> cursor(adjOffsets.begin(), adjOffsets.end() - 1);
+        for (uint32_t t = 0; t < triCount; ++t) {
+            for (int k = 0; k < 3; ++k) adjTris[cursor[indices[t * 3 + k]]++] = t;
+        }
+    }
+
+    std::vector<glm::vec3> triCenters(triCount);
+    for (uint32_t t = 0; t < triCount; ++t) {
+        triCenters[t] = (position(indices[t * 3]) + position(indices[t * 3 + 1]) + position(indices[t * 3 + 2])) / 3.0f;
+    }
+
+    // 2. Greedy growth
+    std::vector<bool> used(triCount, false);
+    std::vector<uint32_t> vertexStamp(vertexCount, std::numeric_limits<uint32_t>::max());
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> clusterTris;
+    std::vector<uint32_t> clusterVerts;
+    data.indices.reserve(triCount * 3);
+
+    size_t seedCursor = 0;
+    size_t emitted = 0;
+    while (emitted < triCount) {
+        while (used[seedCursor]) seedCursor++;
+
+        const uint32_t id = static_cast<uint32_t>(data.meshlets.size());
+        clusterTris.clear();
+        clusterVerts.clear();
+        candidates.clear();
+        glm::vec3 centroidSum(0.0f);
+
+        auto newVertexCount = [&](uint32_t t) {
+            uint32_t n = 0;
+            for (int k = 0; k < 3; ++k) n += (vertexStamp[indices[t * 3 + k]] != id) ? 1u : 0u;
+            return n;
+        };
+
+        auto addTriangle = [&](uint32_t t) {
+            used[t] = true;
+            clusterTris.push_back(t);
+            for (int k = 0; k < 3; ++k) {
+                uint32_t v = indices[t * 3 + k];
+                if (vertexStamp[v] == id) continue;
+                vertexStamp[v] = id;
+                clusterVerts.push_back(v);
+                centroidSum += position(v);
+                for (uint32_t a = adjOffsets[v]; a < adjOffsets[v + 1]; ++a) {
+                    if (!used[adjTris[a]]) candidates.push_back(adjTris[a]);
+                }
+            }
+        };
+
+        addTriangle(static_cast<uint32_t>(seedCursor));
+
+        while (clusterTris.size() < maxTriangles) {
+            std::erase_if(candidates, [&](uint32_t t) { return used[t]; });
+            glm::vec3 centroid = centroidSum / static_cast<float>(clusterVerts.size());
+
+            uint32_t best = std::numeric_limits<uint32_t>::max();
+            uint32_t bestNew = 4;
+            float bestDist = std::numeric_limits<float>::max();
+            for (uint32_t t : candidates) {
+                uint32_t n = newVertexCount(t);
+                if (clusterVerts.size() + n > maxVertices) continue;
+                float dist = glm::dot(triCenters[t] - centroid, triCenters[t] - centroid);
+                if (n < bestNew || (n == bestNew && dist < bestDist)) {
+                    best = t; bestNew = n; bestDist = dist;
+                }
+            }
+            if (best == std::numeric_limits<uint32_t>::max()) break;
+            addTriangle(best);
+        }
+
+        // 3. Emit triangles and bounds
+        Meshlet m;
+        m.firstIndex = static_cast<uint32_t>(data.indices.size());
+        m.indexCount = static_cast<uint32_t>(clusterTris.size() * 3);
+        m.vertexCount = static_cast<uint32_t>(clusterVerts.size());
+
+        glm::vec3 minP(std::numeric_limits<float>::max()), maxP(std::numeric_limits<float>::lowest());
+        for (uint32_t v : clusterVerts) {
+            minP = glm::min(minP, position(v));
+            maxP = glm::max(maxP, position(v));
+        }
+        m.center = (minP + maxP) * 0.5f;
+        for (uint32_t v : clusterVerts) m.radius = std::max(m.radius, glm::distance(m.center, position(v)));
+
+        glm::vec3 axis(0.0f);
+        std::vector<glm::vec3> normals;
+        normals.reserve(clusterTris.size());
+        for (uint32_t t : clusterTris) {
+            glm::vec3 p0 = position(indices[t * 3]), p1 = position(indices[t * 3 + 1]), p2 = position(indices[t * 3 + 2]);
+            data.indices.insert(data.indices.end(), { indices[t * 3], indices[t * 3 + 1], indices[t * 3 + 2] });
+            glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+            float len = glm::length(n);
+            if (len <= 0.0f) continue;
+            axis += n; // Area weighted
+            normals.push_back(n / len);
+        }
+
+        float axisLen = glm::length(axis);
+        if (axisLen > 0.0f && !normals.empty()) {
+            m.coneAxis = axis / axisLen;
+            float minDot = 1.0f;
+            for (const auto& n : normals) minDot = std::min(minDot, glm::dot(n, m.coneAxis));
+            // A spread close to (or above) 90 degrees makes the cone useless for culling.
+            m.coneCutoff = (minDot <= 0.1f) ? 1.0f : std::sqrt(1.0f - minDot * minDot);
+        }
+
+        data.meshlets.push_back(m);
+        emitted += clusterTris.size();
+    }
+
+    return data;
+}
+
+} // namespace bb3d
@@ -0,0 +1,211 @@
+#include "bb3d/render/MipGenerator.hpp"
+#include "bb3d/core/Float4.hpp"
+#include "bb3d/core/JobSystem.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+
+namespace bb3d {
+
+namespace {
+
+constexpr uint32_t KaiserTaps = 8;
+constexpr uint32_t SrgbEncodeSize = 16384; ///< Linear -> sRGB table: under 0.2 units of error at the steepest point.
+constexpr uint32_t TexelsPerJob = 16384;
+
+float srgbToLinear(float c) {
+    return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+float linearToSrgb(float l) {
+    return l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+}
+
+struct Tables {
+    std::array<float, 256> srgb;   ///< 8-bit sRGB -> linear.
+    std::array<float, 256> normal; ///< 8-bit -> [-1, 1].
+    std::array<float, 256> unorm;  ///< 8-bit -> [0, 1].
+    std::array<uint8_t, SrgbEncodeSize> encodeSrgb; ///< Linear [0, 1] -> 8-bit sRGB.
+    std::array<float, KaiserTaps> kaiser; ///< Normalized weights of source taps 2x-3 .. 2x+4.
+};
+
+/** @brief Modified Bessel function of the first kind, order 0 (Kaiser window). */
+double besselI0(double x) {
+    double sum = 1.0, term = 1.0;
+    for (int k = 1; k < 32; ++k) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+const Tables& tables() {
+    static const Tables instance = [] {
+        Tables t{};
+        for (int i = 0; i < 256; ++i) {
+            t.srgb[i] = srgbToLinear(i / 255.0f);
+            t.normal[i] = i / 127.5f - 1.0f;
+            t.unorm[i] = i / 255.0f;
+        }
+        for (uint32_t i = 0; i < SrgbEncodeSize; ++i) {
+            t.encodeSrgb[i] = static_cast<uint8_t>(std::lround(linearToSrgb(i / float(SrgbEncodeSize - 1)) * 255.0f));
+        }
+
+        // Sinc at the destination Nyquist frequency, Kaiser window of 2 destination texels (alpha 4)
+        constexpr double alpha = 4.0, width = 2.0;
+        double total = 0.0;
+        std::array<double, KaiserTaps> weights{};
+        for (uint32_t k = 0; k < KaiserTaps; ++k) {
+            const double d = (static_cast<double>(k) - 3.5) * 0.5; // Destination texels between tap and center
+            const double sinc = std::sin(std::numbers::pi * d) / (std::numbers::pi * d);
+            const double window = besselI0(alpha * std::sqrt(1.0 - (d / width) * (d / width))) / besselI0(alpha);
+            weights[k] = sinc * window;
+            total += weights[k];
+        }
+        for (uint32_t k = 0; k < KaiserTaps; ++k) t.kaiser[k] = static_cast<float>(weights[k] / total);
+        return t;
+    }();
+    return instance;
+}
+
+/** @brief Decodes one RGBA8 row into filtering space. */
+void decodeRow(const uint8_t* src, uint32_t width, TextureUsage usage, Float4* out) {
+    const Tables& t = tables();
+    const auto& color = usage == TextureUsage::Albedo ? t.srgb : (usage == TextureUsage::Normal ? t.normal : t.unorm);
+    for (uint32_t x = 0; x < width; ++x, src += 4) {
+        out[x] = Float4::set(color[src[0]], color[src[1]], color[src[2]], t.unorm[src[3]]);
+    }
+}
+
+uint8_t toUnorm8(float v) {
+    return static_cast<uint8_t>(std::lround(std::clamp(v, 0.0f, 1.0f) * 255.0f));
+}
+
+void encodeTexel(Float4 texel, TextureUsage usage, uint8_t* out) {
+    float v[4];
+    texel.store(v);
+    if (usage == TextureUsage::Albedo) {
+        const auto& encode = tables().encodeSrgb;
+        for (int c = 0; c < 3; ++c) out[c] = encode[static_cast<uint32_t>(std::clamp(v[c], 0.0f, 1.0f) * (SrgbEncodeSize - 1) + 0.5f)];
+    } else if (usage == TextureUsage::Normal) {
+        // Filtered normals get shorter: renormalize so that distant surfaces keep their lighting
+        const float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        float n[3] = { 0.0f, 0.0f, 1.0f };
+        if (length > 1e-6f) for (int c = 0; c < 3; ++c) n[c] = v[c] / length;
+        for (int c = 0; c < 3; ++c) out[c] = toUnorm8(n[c] * 0.5f + 0.5f);
+    } else {
+        for (int c = 0; c < 3; ++c) out[c] = toUnorm8(v[c]);
+    }
+    out[3] = toUnorm8(v[3]);
+}
+
+struct Level {
+    const uint8_t* src;
+    uint32_t width, height;
+    uint8_t* dst;
+    uint32_t dstWidth, dstHeight;
+    TextureUsage usage;
+};
+
+/** @brief 2x2 average of destination rows [y0, y1). */
+void boxRows(const Level& level, uint32_t y0, uint32_t y1) {
+    std::vector<Float4> rowA(level.width), rowB(level.width);
+    for (uint32_t y = y0; y < y1; ++y) {
+        const uint32_t ya = std::min(y * 2, level.height - 1), yb = std::min(y * 2 + 1, level.height - 1);
+        decodeRow(level.src + static_cast<size_t>(ya) * level.width * 4, level.width, level.usage, rowA.data());
+        decodeRow(level.src + static_cast<size_t>(yb) * level.width * 4, level.width, level.usage, rowB.data());
+
+        uint8_t* out = level.dst + static_cast<size_t>(y) * level.dstWidth * 4;
+        for (uint32_t x = 0; x < level.dstWidth; ++x, out += 4) {
+            const uint32_t xa = std::min(x * 2, level.width - 1), xb = std::min(x * 2 + 1, level.width - 1);
+            encodeTexel((rowA[xa] + rowA[xb] + rowB[xa] + rowB[xb]) * 0.25f, level.usage, out);
+        }
+    }
+}
+
+/** @brief Separable Kaiser filter of destination rows [y0, y1): horizontal pass per source row, then vertical. */
+void kaiserRows(const Level& level, uint32_t y0, uint32_t y1) {
+    const auto& weights = tables().kaiser;
+    const int lastRow = static_cast<int>(level.height) - 1, lastColumn = static_cast<int>(level.width) - 1;
+    const int firstSource = std::max(static_cast<int>(y0) * 2 - 3, 0);
+    const int lastSource = std::min(static_cast<int>(y1 - 1) * 2 + 4, lastRow);
+
+    std::vector<Float4> row(level.width);
+    std::vector<Float4> filtered(static_cast<size_t>(lastSource - firstSource + 1) * level.dstWidth);
+    for (int r = firstSource; r <= lastSource; ++r) {
+        decodeRow(level.src + static_cast<size_t>(r) * level.width * 4, level.width, level.usage, row.data());
+        Float4* out = &filtered[static_cast<size_t>(r - firstSource) * level.dstWidth];
+        for (uint32_t x = 0; x < level.dstWidth; ++x) {
+            Float4 sum = Float4::zero();
+            for (uint32_t k = 0; k < KaiserTaps; ++k) {
+                sum = sum + row[std::clamp(static_cast<int>(x) * 2 - 3 + static_cast<int>(k), 0, lastColumn)] * weights[k];
+            }
+            out[x] = sum;
+        }
+    }
+
+    std::array<const Float4*, KaiserTaps> taps;
+    for (uint32_t y = y0; y < y1; ++y) {
+        for (uint32_t k = 0; k < KaiserTaps; ++k) {
+            const int r = std::clamp(static_cast<int>(y) * 2 - 3 + static_cast<int>(k), 0, lastRow);
+            taps[k] = &filtered[static_cast<size_t>(r - firstSource) * level.dstWidth];
+        }
+        uint8_t* out = level.dst + static_cast<size_t>(y) * level.dstWidth * 4;
+        for (uint32_t x = 0; x < level.dstWidth; ++x, out += 4) {
+            Float4 sum = Float4::zero();
+            for (uint32_t k = 0; k < KaiserTaps; ++k) sum = sum + taps[k][x] * weights[k];
+            encodeTexel(sum, level.usage, out);
+        }
+    }
+}
+
+} // namespace
+
+namespace MipGenerator {
+
+uint32_t levelCount(uint32_t width, uint32_t height) {
+    uint32_t levels = 1;
+    while (width > 1 || height > 1) {
+        width = std::max(width / 2, 1u);
+        height = std::max(height / 2, 1u);
+        levels++;
+    }
+    return levels;
+}
+
+std::vector<uint8_t> downsample(const uint8_t* rgba, uint32_t width, uint32_t height, TextureUsage usage, MipFilter filter, JobSystem* jobs) {
+    const uint32_t dstWidth = std::max(width / 2, 1u), dstHeight = std::max(height / 2, 1u);
+    std::vector<uint8_t> dst(static_cast<size_t>(dstWidth) * dstHeight * 4);
+    const Level level{ rgba, width, height, dst.data(), dstWidth, dstHeight, usage };
+    auto filterRows = filter == MipFilter::Kaiser ? &kaiserRows : &boxRows;
+
+    // Bands of rows: each job decodes its own source rows, the output bands do not overlap
+    const uint32_t rowsPerJob = std::max(TexelsPerJob / dstWidth, 1u);
+    const uint32_t bandCount = (dstHeight + rowsPerJob - 1) / rowsPerJob;
+    auto band = [&](uint32_t index, uint32_t) {
+        filterRows(level, index * rowsPerJob, std::min((index + 1) * rowsPerJob, dstHeight));
+    };
+    if (jobs && bandCount > 1 && jobs->getThreadCount() > 0) {
+        jobs->dispatch(bandCount, 1, band);
+    } else {
+        for (uint32_t i = 0; i < bandCount; ++i) band(i, 1);
+    }
+    return dst;
+}
+
+std::vector<std::vector<uint8_t>> buildMipChain(const uint8_t* rgba, uint32_t width, uint32_t height, TextureUsage usage, MipFilter filter, JobSystem* jobs) {
+    std::vector<std::vector<uint8_t>> levels;
+    levels.reserve(levelCount(width, height));
+    levels.emplace_back(rgba, rgba + static_cast<size_t>(width) * height * 4);
+    while (width > 1 || height > 1) {
+        levels.push_back(downsample(levels.back().data(), width, height, usage, filter, jobs));
+        width = std::max(width / 2, 1u);
+        height = std::max(height / 2, 1u);
+    }
+    return levels;
+}
+
+} // namespace MipGenerator
+
+} // namespace bb3d
@@ -20,6 +20,8 @@
 #include <variant>
 #include <unordered_map>
 #include <filesystem>
+#include <exception>
+#include <mutex>
 
 // Trait for GLM in fastgltf
 template <>
@@ -93,6 +95,10 @@ glm::vec3 Model::normalize(const glm::vec3& targetSize) {
     if (scale == std::numeric_limits<float>::max()) scale = 1.0f;
 
     for (auto& mesh : m_meshes) {
+        if (mesh->isCPUDataReleased()) {
+            BB_CORE_WARN("Model: Cannot normalize a mesh whose CPU data has been released (see ModelLoadConfig::cpuRetention).");
+            continue;
+        }
         auto& vertices = mesh->getVertices();
         for (auto& v : vertices) v.position = (v.position - center) * scale;
         mesh->updateVertices();
@@ -200,7 +206,11 @@ void Model::loadOBJ(std::string_view path, const ModelLoadConfig& config) {
             indexOffset += fv;
         }
 
-        auto mesh = CreateRef<Mesh>(m_context, vertices, indices);
+        uniqueVertices = {}; // The dedup map holds a copy of every vertex
+        auto mesh = CreateRef<Mesh>(m_context, std::move(vertices), std::move(indices), config.vertexFormat);
+        if (config.generateLODs) mesh->generateLODs(config.lodSettings);
+        if (config.meshletMinTriangles > 0 && mesh->getIndexCount() / 3 >= config.meshletMinTriangles) mesh->buildMeshlets();
+        mesh->setCPURetention(config.cpuRetention);
         
         if (!shape.mesh.material_ids.empty() && shape.mesh.material_ids[0] >= 0) {
             size_t matId = static_cast<size_t>(shape.mesh.material_ids[0]);
@@ -238,9 +248,9 @@ void Model::loadGLTF(std::string_view path, const ModelLoadConfig& config) {
 
     const auto& gltf = assetParse.get();
 
-    // 1. Process Textures
-    for (const auto& image : gltf.images) {
-        auto texture = std::visit(fastgltf::visitor {
+    // 1. Process Textures (one job per image: decode and mip generation run concurrently)
+    auto loadImageTexture = [&](const fastgltf::Image& image) -> Ref<Texture> {
+        return std::visit(fastgltf::visitor {
             [&](const fastgltf::sources::Vector& vector) -> Ref<Texture> { return CreateRef<Texture>(m_context, std::span<const std::byte>(vector.bytes.data(), vector.bytes.size())); },
             [&](const fastgltf::sources::Array& array) -> Ref<Texture> { return CreateRef<Texture>(m_context, std::span<const std::byte>(array.bytes.data(), array.bytes.size())); },
             [&](const fastgltf::sources::ByteView& byteView) -> Ref<Texture> { return CreateRef<Texture>(m_context, byteView.bytes); },
@@ -259,8 +269,25 @@ void Model::loadGLTF(std::string_view path, const ModelLoadConfig& config) {
             },
             [](auto&) -> Ref<Texture> { return nullptr; }
         }, image.data);
-        m_textures.push_back(texture);
+    };
+    m_textures.assign(gltf.images.size(), nullptr);
+    std::exception_ptr textureError;
+    std::mutex textureErrorMutex;
+    auto loadImage = [&](uint32_t index, uint32_t) {
+        try {
+            m_textures[index] = loadImageTexture(gltf.images[index]);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(textureErrorMutex);
+            if (!textureError) textureError = std::current_exception();
+        }
+    };
+    const auto imageCount = static_cast<uint32_t>(gltf.images.size());
+    if (JobSystem& jobs = m_resourceManager.getJobSystem(); jobs.getThreadCount() > 0) {
+        jobs.dispatch(imageCount, 1, loadImage);
+    } else {
+        for (uint32_t i = 0; i < imageCount; ++i) loadImage(i, 1);
     }
+    if (textureError) std::rethrow_exception(textureError);
 
     // 2. Load Materials
     std::vector<Ref<Material>> materials;
@@ -408,7 +435,11 @@ void Model::loadGLTF(std::string_view path, const ModelLoadConfig& config) {
                     }
                 }
 
-                auto newMesh = CreateRef<Mesh>(m_context, vertices, indices);
+                auto newMesh = CreateRef<Mesh>(m_context, std::move(vertices), std::move(indices), config.vertexFormat);
+                if (config.generateLODs) newMesh->generateLODs(config.lodSettings);
+                if (config.meshletMinTriangles > 0 && newMesh->getIndexCount() / 3 >= config.meshletMinTriangles) newMesh->buildMeshlets();
+                // LODs and meshlets are built: the CPU copy can now be reduced
+                newMesh->setCPURetention(config.cpuRetention);
                 if (prim.materialIndex.has_value() && config.loadMaterials) {
                     newMesh->setMaterial(materials[prim.materialIndex.value()]);
                 }
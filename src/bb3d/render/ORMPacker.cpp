@@ -0,0 +1,147 @@
+#include "bb3d/render/ORMPacker.hpp"
+#include "bb3d/core/Float4.hpp" // BB_FLOAT4_SSE: SSE2 available
+#include "bb3d/core/JobSystem.hpp"
+#include <algorithm>
+
+namespace bb3d {
+
+namespace {
+
+constexpr uint32_t TexelsPerJob = 64 * 1024;
+
+/** @brief Precomputed horizontal taps of a bilinear resample (16.16 fixed point). */
+struct Resampler {
+    GrayImageView image;
+    uint32_t width = 0, height = 0;
+    std::vector<uint32_t> x0;
+    std::vector<uint16_t> fx; ///< Weight of x0 + 1, out of 256.
+
+    Resampler(const GrayImageView& source, uint32_t dstWidth, uint32_t dstHeight) : image(source), width(dstWidth), height(dstHeight) {
+        x0.resize(width);
+        fx.resize(width);
+        for (uint32_t x = 0; x < width; ++x) {
+            const int64_t position = sourcePosition(x, width, image.width);
+            x0[x] = static_cast<uint32_t>(position >> 16);
+            fx[x] = static_cast<uint16_t>((position >> 8) & 0xFF);
+        }
+    }
+
+    /** @brief Texel centers aligned: source coordinate of destination texel `i`, clamped to the edges. */
+    static int64_t sourcePosition(uint32_t i, uint32_t dstSize, uint32_t srcSize) {
+        const int64_t step = (static_cast<int64_t>(srcSize) << 16) / dstSize;
+        const int64_t position = static_cast<int64_t>(i) * step + step / 2 - 32768;
+        return std::clamp<int64_t>(position, 0, static_cast<int64_t>(srcSize - 1) << 16);
+    }
+
+    void row(uint32_t y, uint8_t* out) const {
+        const int64_t position = sourcePosition(y, height, image.height);
+        const uint32_t y0 = static_cast<uint32_t>(position >> 16);
+        const uint32_t y1 = std::min(y0 + 1, image.height - 1);
+        const uint32_t fy = static_cast<uint32_t>((position >> 8) & 0xFF);
+        const uint8_t* r0 = image.pixels + static_cast<size_t>(y0) * image.width;
+        const uint8_t* r1 = image.pixels + static_cast<size_t>(y1) * image.width;
+        const uint32_t lastX = image.width - 1;
+        for (uint32_t x = 0; x < width; ++x) {
+            const uint32_t a = x0[x], b = std::min(a + 1, lastX), f = fx[x];
+            const uint32_t top = r0[a] * (256 - f) + r0[b] * f;
+            const uint32_t bottom = r1[a] * (256 - f) + r1[b] * f;
+            out[x] = static_cast<uint8_t>((top * (256 - fy) + bottom * fy + 32768) >> 16);
+        }
+    }
+};
+
+/** @brief Where one channel of a band comes from: the image rows, resampled rows or a constant. */
+struct Channel {
+    const GrayImageView* image = nullptr;
+    const Resampler* resampler = nullptr;
+    uint8_t value = 0;
+};
+
+} // namespace
+
+namespace ORMPacker {
+
+void packRow(const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t* out, uint32_t count) {
+    uint32_t x = 0;
+#ifdef BB_FLOAT4_SSE
+    const __m128i alpha = _mm_set1_epi8(static_cast<char>(0xFF));
+    for (; x + 16 <= count; x += 16) {
+        const __m128i vr = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r + x));
+        const __m128i vg = _mm_loadu_si128(reinterpret_cast<const __m128i*>(g + x));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + x));
+        const __m128i rgLow = _mm_unpacklo_epi8(vr, vg), rgHigh = _mm_unpackhi_epi8(vr, vg);
+        const __m128i baLow = _mm_unpacklo_epi8(vb, alpha), baHigh = _mm_unpackhi_epi8(vb, alpha);
+        __m128i* dst = reinterpret_cast<__m128i*>(out + x * 4);
+        _mm_storeu_si128(dst + 0, _mm_unpacklo_epi16(rgLow, baLow));
+        _mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(rgLow, baLow));
+        _mm_storeu_si128(dst + 2, _mm_unpacklo_epi16(rgHigh, baHigh));
+        _mm_storeu_si128(dst + 3, _mm_unpackhi_epi16(rgHigh, baHigh));
+    }
+#endif
+    for (; x < count; ++x) {
+        out[x * 4 + 0] = r[x];
+        out[x * 4 + 1] = g[x];
+        out[x * 4 + 2] = b[x];
+        out[x * 4 + 3] = 255;
+    }
+}
+
+void resampleRow(const GrayImageView& image, uint32_t width, uint32_t height, uint32_t y, uint8_t* out) {
+    Resampler(image, width, height).row(y, out);
+}
+
+std::vector<uint8_t> pack(const GrayImageView& occlusion, const GrayImageView& roughness, const GrayImageView& metallic,
+                          uint32_t width, uint32_t height, JobSystem* jobs) {
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+    if (width == 0 || height == 0) return rgba;
+
+    // Taps are shared by every band; only mismatched maps need them
+    const GrayImageView* images[3] = { &occlusion, &roughness, &metallic };
+    const uint8_t defaults[3] = { DefaultOcclusion, DefaultRoughness, DefaultMetallic };
+    std::vector<Resampler> resamplers;
+    resamplers.reserve(3);
+    Channel channels[3];
+    for (int c = 0; c < 3; ++c) {
+        const GrayImageView& image = *images[c];
+        channels[c].value = defaults[c];
+        if (!image.pixels || image.width == 0 || image.height == 0) continue;
+        if (image.width == width && image.height == height) {
+            channels[c].image = &image;
+        } else {
+            channels[c].resampler = &resamplers.emplace_back(image, width, height);
+        }
+    }
+
+    const uint32_t rowsPerJob = std::max(TexelsPerJob / width, 1u);
+    const uint32_t bandCount = (height + rowsPerJob - 1) / rowsPerJob;
+    auto band = [&](uint32_t index, uint32_t) {
+        // Scratch rows of this band: resampled or constant channels
+        std::vector<uint8_t> scratch[3];
+        for (int c = 0; c < 3; ++c) {
+            if (!channels[c].image) scratch[c].assign(width, channels[c].value);
+        }
+        const uint32_t end = std::min((index + 1) * rowsPerJob, height);
+        for (uint32_t y = index * rowsPerJob; y < end; ++y) {
+            const uint8_t* rows[3];
+            for (int c = 0; c < 3; ++c) {
+                if (channels[c].image) {
+                    rows[c] = channels[c].image->pixels + static_cast<size_t>(y) * width;
+                } else {
+                    if (channels[c].resampler) channels[c].resampler->row(y, scratch[c].data());
+                    rows[c] = scratch[c].data();
+                }
+            }
+            packRow(rows[0], rows[1], rows[2], rgba.data() + static_cast<size_t>(y) * width * 4, width);
+        }
+    };
+    if (jobs && bandCount > 1 && jobs->getThreadCount() > 0) {
+        jobs->dispatch(bandCount, 1, band);
+    } else {
+        for (uint32_t i = 0; i < bandCount; ++i) band(i, 1);
+    }
+    return rgba;
+}
+
+} // namespace ORMPacker
+
+} // namespace bb3d
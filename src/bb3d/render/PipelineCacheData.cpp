@@ -0,0 +1,61 @@
+#include "bb3d/render/PipelineCacheData.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace bb3d {
+
+namespace {
+
+uint32_t readLE32(std::span<const std::byte> data, size_t offset) {
+    return std::to_integer<uint32_t>(data[offset]) | (std::to_integer<uint32_t>(data[offset + 1]) << 8) |
+           (std::to_integer<uint32_t>(data[offset + 2]) << 16) | (std::to_integer<uint32_t>(data[offset + 3]) << 24);
+}
+
+} // namespace
+
+bool PipelineCacheData::isCompatible(std::span<const std::byte> data, const PipelineCacheIdentity& device) {
+    if (data.size() < HeaderSize) return false;
+    const uint32_t headerSize = readLE32(data, 0);
+    if (headerSize < HeaderSize || headerSize > data.size()) return false;
+    if (readLE32(data, 4) != HeaderVersionOne) return false;
+    if (readLE32(data, 8) != device.vendorID || readLE32(data, 12) != device.deviceID) return false;
+    return std::equal(device.cacheUUID.begin(), device.cacheUUID.end(), data.begin() + 16,
+                      [](uint8_t expected, std::byte stored) { return std::to_integer<uint8_t>(stored) == expected; });
+}
+
+std::string PipelineCacheData::fileName(const PipelineCacheIdentity& device) {
+    std::string name = "pipelines_";
+    char hex[3];
+    for (uint8_t byte : device.cacheUUID) {
+        std::snprintf(hex, sizeof(hex), "%02x", byte);
+        name += hex;
+    }
+    return name + "_" + std::to_string(device.driverVersion) + ".bin";
+}
+
+std::optional<std::vector<std::byte>> PipelineCacheData::read(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return std::nullopt;
+    std::vector<std::byte> bytes(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file) return std::nullopt;
+    return bytes;
+}
+
+bool PipelineCacheData::write(const std::filesystem::path& path, std::span<const std::byte> data) {
+    std::error_code error;
+    std::filesystem::create_directories(path.parent_path(), error);
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file) return false;
+    }
+    std::filesystem::rename(temporary, path, error);
+    return !error;
+}
+
+} // namespace bb3d
@@ -87,13 +87,19 @@ Scope<Model> ProceduralMeshGenerator::createPlanet(VulkanContext& context, Resou
     for (int i = 0; i < 6; i++) {
         jobSystem.execute([&, i]() {
             faceData[i] = generateFaceData(faceDirections[i], component);
+            // Face borders are locked by the simplifier: the 6 faces stay crack-free whatever their LOD.
+            faceData[i].lods = MeshSimplifier::buildLODChain(&faceData[i].vertices[0].position.x, faceData[i].vertices.size(), sizeof(Vertex), faceData[i].indices);
+            faceData[i].meshlets = MeshletBuilder::build(&faceData[i].vertices[0].position.x, faceData[i].vertices.size(), sizeof(Vertex), faceData[i].indices);
         }, counter);
     }
     jobSystem.wait(counter);
 
     // 2. Sequential Upload to GPU (Must be on main thread or synchronized)
+    // The face lists are moved into the mesh, which only keeps positions/indices for a mesh collider.
     for (int i = 0; i < 6; i++) {
-        auto mesh = CreateRef<Mesh>(context, faceData[i].vertices, faceData[i].indices);
+        auto mesh = CreateRef<Mesh>(context, std::move(faceData[i].vertices), std::move(faceData[i].indices), VertexFormat::Auto, MeshCPURetention::PhysicsOnly);
+        mesh->setLODChain(faceData[i].lods);
+        mesh->setMeshlets(std::move(faceData[i].meshlets));
         model->addMesh(std::move(mesh));
     }
 
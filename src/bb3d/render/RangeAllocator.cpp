@@ -0,0 +1,125 @@
+#include "bb3d/render/RangeAllocator.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace bb3d {
+
+static uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return alignment <= 1 ? value : ((value + alignment - 1) / alignment) * alignment;
+}
+
+RangeAllocator::RangeAllocator(uint64_t capacity) : m_capacity(capacity) {
+    if (capacity > 0) m_freeBlocks[0] = capacity;
+}
+
+std::optional<uint64_t> RangeAllocator::allocate(uint64_t size, uint64_t alignment) {
+    if (size == 0) return std::nullopt;
+    alignment = std::max<uint64_t>(alignment, 1);
+
+    // Best fit: smallest block still holding the aligned request
+    auto best = m_freeBlocks.end();
+    uint64_t bestWaste = std::numeric_limits<uint64_t>::max();
+    for (auto it = m_freeBlocks.begin(); it != m_freeBlocks.end(); ++it) {
+        uint64_t aligned = alignUp(it->first, alignment);
+        uint64_t end = it->first + it->second;
+        if (aligned + size > end) continue;
+        uint64_t waste = it->second - size;
+        if (waste < bestWaste) {
+            best = it;
+            bestWaste = waste;
+            if (waste == 0) break;
+        }
+    }
+    if (best == m_freeBlocks.end()) return std::nullopt;
+
+    const uint64_t blockOffset = best->first;
+    const uint64_t blockEnd = best->first + best->second;
+    const uint64_t offset = alignUp(blockOffset, alignment);
+    m_freeBlocks.erase(best);
+
+    // Alignment padding and tail stay free
+    if (offset > blockOffset) m_freeBlocks[blockOffset] = offset - blockOffset;
+    if (offset + size < blockEnd) m_freeBlocks[offset + size] = blockEnd - (offset + size);
+
+    m_allocations[offset] = { size, alignment };
+    m_used += size;
+    return offset;
+}
+
+void RangeAllocator::free(uint64_t offset) {
+    auto it = m_allocations.find(offset);
+    if (it == m_allocations.end()) return;
+    uint64_t size = it->second.size;
+    m_used -= size;
+    m_allocations.erase(it);
+    insertFree(offset, size);
+}
+
+void RangeAllocator::insertFree(uint64_t offset, uint64_t size) {
+    auto next = m_freeBlocks.lower_bound(offset);
+    // Merge with the following block
+    if (next != m_freeBlocks.end() && next->first == offset + size) {
+        size += next->second;
+        next = m_freeBlocks.erase(next);
+    }
+    // Merge with the previous block
+    if (next != m_freeBlocks.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            prev->second += size;
+            return;
+        }
+    }
+    m_freeBlocks[offset] = size;
+}
+
+void RangeAllocator::grow(uint64_t newCapacity) {
+    if (newCapacity <= m_capacity) return;
+    uint64_t oldCapacity = m_capacity;
+    m_capacity = newCapacity;
+    insertFree(oldCapacity, newCapacity - oldCapacity);
+}
+
+std::vector<RangeAllocator::Move> RangeAllocator::compact() {
+    std::vector<Move> moves;
+    moves.reserve(m_allocations.size());
+
+    std::map<uint64_t, AllocationInfo> packed;
+    uint64_t cursor = 0;
+    for (const auto& [offset, info] : m_allocations) {
+        uint64_t to = alignUp(cursor, info.alignment);
+        moves.push_back({ offset, to, info.size });
+        packed[to] = info;
+        cursor = to + info.size;
+    }
+
+    m_allocations = std::move(packed);
+    m_freeBlocks.clear();
+    // Rebuild the free list: alignment holes between allocations plus the tail
+    uint64_t previousEnd = 0;
+    for (const auto& [offset, info] : m_allocations) {
+        if (offset > previousEnd) m_freeBlocks[previousEnd] = offset - previousEnd;
+        previousEnd = offset + info.size;
+    }
+    if (previousEnd < m_capacity) m_freeBlocks[previousEnd] = m_capacity - previousEnd;
+    return moves;
+}
+
+uint64_t RangeAllocator::getLargestFreeBlock() const {
+    uint64_t largest = 0;
+    for (const auto& [offset, size] : m_freeBlocks) largest = std::max(largest, size);
+    return largest;
+}
+
+float RangeAllocator::getFragmentation() const {
+    uint64_t freeBytes = m_capacity - m_used;
+    if (freeBytes == 0) return 0.0f;
+    return 1.0f - static_cast<float>(getLargestFreeBlock()) / static_cast<float>(freeBytes);
+}
+
+uint64_t RangeAllocator::getAllocationSize(uint64_t offset) const {
+    auto it = m_allocations.find(offset);
+    return it != m_allocations.end() ? it->second.size : 0;
+}
+
+} // namespace bb3d
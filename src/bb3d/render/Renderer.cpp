@@ -7,6 +7,11 @@
 #include "bb3d/render/MeshGenerator.hpp"
 #include <array>
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <limits>
 #include <stb_image_write.h>
 #include <SDL3/SDL.h>
 #include <filesystem>
@@ -16,12 +21,76 @@
 
 namespace bb3d {
 
+static_assert(sizeof(IndexedDrawCommand) == sizeof(vk::DrawIndexedIndirectCommand), "IndexedDrawCommand must match VkDrawIndexedIndirectCommand");
+
+namespace {
+
+// Every mesh lives in the shared GeometryPool buffers: they are only rebound when the index type changes
+struct GeometryBinding {
+    bool bound = false;
+    vk::IndexType indexType = vk::IndexType::eUint32;
+
+    void bind(vk::CommandBuffer cb, const Mesh& mesh) {
+        if (bound && indexType == mesh.getIndexType()) return;
+        mesh.bindBuffers(cb);
+        bound = true;
+        indexType = mesh.getIndexType();
+    }
+};
+
+// Transform caches follow the component lifetimes; motion is detected by TransformCache::refresh
+struct TransformCacheTracking {};
+
+template <typename Cache>
+void addTransformCache(entt::registry& registry, entt::entity entity) { registry.emplace_or_replace<Cache>(entity); }
+
+template <typename Cache>
+void removeTransformCache(entt::registry& registry, entt::entity entity) { registry.remove<Cache>(entity); }
+
+/** @brief Creates the transform caches of a scene's existing entities and keeps them in step with their components. */
+void trackTransformCaches(entt::registry& registry) {
+    if (registry.ctx().contains<TransformCacheTracking>()) return;
+    registry.ctx().emplace<TransformCacheTracking>();
+
+    registry.on_construct<MeshComponent>().connect<&addTransformCache<MeshTransformCache>>();
+    registry.on_destroy<MeshComponent>().connect<&removeTransformCache<MeshTransformCache>>();
+    registry.on_construct<ModelComponent>().connect<&addTransformCache<ModelTransformCache>>();
+    registry.on_destroy<ModelComponent>().connect<&removeTransformCache<ModelTransformCache>>();
+
+    for (auto entity : registry.view<MeshComponent>()) registry.emplace_or_replace<MeshTransformCache>(entity);
+    for (auto entity : registry.view<ModelComponent>()) registry.emplace_or_replace<ModelTransformCache>(entity);
+}
+
+// Shadow cascades are bounded by GlobalUBO::shadowCascades
+constexpr uint32_t MAX_SHADOW_CASCADES = 4;
+
+// Hash of a shadow caster, to detect changes in a cached cascade (splitmix64 finalizer)
+uint64_t mixSignature(uint64_t hash, uint64_t value) {
+    uint64_t z = hash + 0x9E3779B97F4A7C15ull + value;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+uint64_t mixSignature(uint64_t hash, const glm::mat4& m) {
+    const float* f = &m[0][0];
+    for (int i = 0; i < 16; i += 2) {
+        uint32_t lo, hi;
+        std::memcpy(&lo, f + i, sizeof(lo));
+        std::memcpy(&hi, f + i + 1, sizeof(hi));
+        hash = mixSignature(hash, (uint64_t(hi) << 32) | lo);
+    }
+    return hash;
+}
+
+} // namespace
+
 Renderer::Renderer(VulkanContext& context, Window& window, JobSystem& jobSystem, const EngineConfig& config)
     : m_context(context), m_window(window), m_jobSystem(jobSystem), m_config(config), m_shadowsEnabledRuntime(config.graphics.shadowsEnabled) {
     m_swapChain = CreateScope<SwapChain>(context, config.window.width, config.window.height);
     
     m_renderCommands.reserve(1000);
-    m_instanceTransforms.reserve(MAX_INSTANCES);
+    m_instanceTransforms.reserve(INITIAL_INSTANCE_CAPACITY);
 
     if (m_config.graphics.enableOffscreenRendering) {
         uint32_t w = static_cast<uint32_t>(m_swapChain->getExtent().width * m_config.graphics.renderScale);
@@ -31,10 +100,35 @@ Renderer::Renderer(VulkanContext& context, Window& window, JobSystem& jobSystem,
         BB_CORE_INFO("Renderer: Offscreen Rendering Enabled (Resolution: {0}x{1})", w, h);
     }
 
+    // Texture streaming needs the mip chains; configured before any texture is loaded
+    TextureStreamer::Settings streaming;
+    streaming.enabled = config.graphics.enableTextureStreaming && config.graphics.enableMipmapping;
+    streaming.budgetBytes = static_cast<uint64_t>(config.graphics.textureBudgetMB) * 1024 * 1024;
+    streaming.bias = config.graphics.textureStreamingBias;
+    m_context.getTextureStreamer().configure(streaming);
+
+    m_environment = CreateScope<EnvironmentLighting>(m_context, m_jobSystem, config);
+
+    // GPU culling needs the draw count in a buffer; the CPU culling stays the path of reference
+    m_gpuCulling = config.graphics.enableGPUCulling && m_context.supportsDrawIndirectCount();
+    if (config.graphics.enableGPUCulling && !m_gpuCulling) {
+        BB_CORE_WARN("Renderer: GPU culling requested but drawIndirectCount is not supported, using CPU culling.");
+    }
+    m_instanceBudget = InstanceBudget(config.graphics.instanceBudget);
+    // Secondary command buffers only pay off when workers record them
+    m_parallelRecording = config.graphics.enableParallelRecording && m_jobSystem.getThreadCount() > 0;
+
     createSyncObjects();
+    createRecordPools();
     createShadowObjects();
     createGlobalDescriptors();
     createPipelines(config);
+    createGpuCulling();
+    m_instanceCapacities.assign(MAX_FRAMES_IN_FLIGHT, 0);
+    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) createInstanceBuffers(i, m_instanceBudget.grow(0, INITIAL_INSTANCE_CAPACITY));
+    m_particleBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+    m_particleCapacities.assign(MAX_FRAMES_IN_FLIGHT, 0);
+    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) createParticleBuffer(i, INITIAL_PARTICLE_CAPACITY);
     createCopyPipeline();
 
     m_skyboxCube = MeshGenerator::createCube(m_context, 1.0f); 
@@ -64,21 +158,35 @@ Renderer::~Renderer() {
         try { dev.waitIdle(); } catch(...) {}
 
         m_renderCommands.clear();
+        m_drawKeys.clear();
         m_instanceTransforms.clear();
         m_defaultMaterials.clear();
         m_pipelines.clear();
+        m_particlePipelines.clear();
         m_shaders.clear();
 
         m_internalSkyboxMat.reset();
         m_internalSkySphereMat.reset();
         m_defaultParticleMat.reset();
         m_fallbackMaterial.reset();
+        m_boundEnvironment.clear();
+        m_environment.reset();
+        m_bindless.reset();
         m_skyboxCube.reset();
         m_particleQuad.reset();
         for (auto& ubo : m_cameraUbos) ubo.reset();
         m_cameraUbos.clear();
         for (auto& buf : m_instanceBuffers) buf.reset();
         m_instanceBuffers.clear();
+        m_particleBuffers.clear();
+        m_clusterDrawBuffers.clear();
+        m_cullPipeline.reset();
+        m_compactPipeline.reset();
+        m_cullInstanceBuffers.clear();
+        m_drawTemplateBuffers.clear();
+        m_drawCountBuffers.clear();
+        m_gpuDrawBuffers.clear();
+        m_gpuCounterBuffers.clear();
 
         for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
             if (m_imageAvailableSemaphores[i]) dev.destroySemaphore(m_imageAvailableSemaphores[i]);
@@ -109,7 +217,9 @@ Renderer::~Renderer() {
         if (m_shadowDepthImage) vmaDestroyImage(m_context.getAllocator(), m_shadowDepthImage, m_shadowDepthAllocation);
         if (m_globalDescriptorLayout) dev.destroyDescriptorSetLayout(m_globalDescriptorLayout);
         if (m_copyLayout) dev.destroyDescriptorSetLayout(m_copyLayout);
+        if (m_cullDescriptorLayout) dev.destroyDescriptorSetLayout(m_cullDescriptorLayout);
         for (auto& [type, layout] : m_layouts) if(layout) dev.destroyDescriptorSetLayout(layout);
+        for (auto& pools : m_recordPools) for (vk::CommandPool pool : pools) if (pool) dev.destroyCommandPool(pool);
         if (m_commandPool) dev.destroyCommandPool(m_commandPool);
     }
 }
@@ -129,6 +239,20 @@ void Renderer::createSyncObjects() {
     m_imagesInUseFences.assign(m_swapChain->getImageCount(), nullptr);
 }
 
+void Renderer::createRecordPools() {
+    if (!m_parallelRecording) return;
+    auto dev = m_context.getDevice();
+    m_recordPools.resize(MAX_FRAMES_IN_FLIGHT);
+    m_recordBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+    for (uint32_t frame = 0; frame < MAX_FRAMES_IN_FLIGHT; ++frame) {
+        for (uint32_t task = 0; task < MAX_RECORD_TASKS; ++task) {
+            // One buffer per pool: the whole pool is reset by the job that records it
+            m_recordPools[frame][task] = dev.createCommandPool({ vk::CommandPoolCreateFlagBits::eTransient, m_context.getGraphicsQueueFamily() });
+            m_recordBuffers[frame][task] = dev.allocateCommandBuffers({ m_recordPools[frame][task], vk::CommandBufferLevel::eSecondary, 1 })[0];
+        }
+    }
+}
+
 void Renderer::createShadowObjects() {
     auto dev = m_context.getDevice();
     auto allocator = m_context.getAllocator();
@@ -206,14 +330,18 @@ void Renderer::createGlobalDescriptors() {
     auto dev = m_context.getDevice();
     m_cameraUbos.resize(MAX_FRAMES_IN_FLIGHT);
     m_instanceBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+    m_clusterDrawBuffers.resize(MAX_FRAMES_IN_FLIGHT);
     for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
         m_cameraUbos[i] = CreateScope<UniformBuffer>(m_context, sizeof(GlobalUBO));
-        m_instanceBuffers[i] = CreateScope<Buffer>(m_context, sizeof(glm::mat4) * MAX_INSTANCES, vk::BufferUsageFlagBits::eStorageBuffer, VMA_MEMORY_USAGE_CPU_TO_GPU, VMA_ALLOCATION_CREATE_MAPPED_BIT);
+        m_clusterDrawBuffers[i] = CreateScope<IndirectBuffer>(m_context, MAX_CLUSTER_DRAWS);
     }
     std::vector<vk::DescriptorSetLayoutBinding> bindings = {
         {0, vk::DescriptorType::eUniformBuffer, 1, vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment},
         {1, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eVertex},
-        {2, vk::DescriptorType::eCombinedImageSampler, 1, vk::ShaderStageFlagBits::eFragment}
+        {2, vk::DescriptorType::eCombinedImageSampler, 1, vk::ShaderStageFlagBits::eFragment},
+        {3, vk::DescriptorType::eCombinedImageSampler, 1, vk::ShaderStageFlagBits::eFragment}, // Prefiltered environment
+        {4, vk::DescriptorType::eCombinedImageSampler, 1, vk::ShaderStageFlagBits::eFragment}, // BRDF table
+        {5, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eVertex}           // Particle stream
     };
     m_globalDescriptorLayout = dev.createDescriptorSetLayout({ {}, (uint32_t)bindings.size(), bindings.data() });
     std::vector<vk::DescriptorPoolSize> pSizes = { {vk::DescriptorType::eUniformBuffer, 500}, {vk::DescriptorType::eCombinedImageSampler, 1000}, {vk::DescriptorType::eStorageBuffer, 100} };
@@ -222,16 +350,33 @@ void Renderer::createGlobalDescriptors() {
     m_globalDescriptorSets = dev.allocateDescriptorSets({ m_descriptorPool, MAX_FRAMES_IN_FLIGHT, layouts.data() });
     for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
         vk::DescriptorBufferInfo camInfo(m_cameraUbos[i]->getHandle(), 0, sizeof(GlobalUBO));
-        vk::DescriptorBufferInfo instInfo(m_instanceBuffers[i]->getHandle(), 0, sizeof(glm::mat4) * MAX_INSTANCES);
         vk::DescriptorImageInfo shadowInfo(m_shadowSampler, m_shadowDepthView, vk::ImageLayout::eDepthStencilReadOnlyOptimal);
         
+        // Bindings 1 (instance records) and 5 (particles) are written by createInstanceBuffers and createParticleBuffer
         std::vector<vk::WriteDescriptorSet> writes = { 
             {m_globalDescriptorSets[i], 0, 0, 1, vk::DescriptorType::eUniformBuffer, nullptr, &camInfo}, 
-            {m_globalDescriptorSets[i], 1, 0, 1, vk::DescriptorType::eStorageBuffer, nullptr, &instInfo},
             {m_globalDescriptorSets[i], 2, 0, 1, vk::DescriptorType::eCombinedImageSampler, &shadowInfo, nullptr}
         };
         dev.updateDescriptorSets(writes, {});
     }
+
+    m_environmentVersions.assign(MAX_FRAMES_IN_FLIGHT, 0);
+    m_boundEnvironment.assign(MAX_FRAMES_IN_FLIGHT, nullptr);
+    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) bindEnvironment(i);
+}
+
+void Renderer::bindEnvironment(uint32_t frame) {
+    const Ref<Texture>& specular = m_environment->getSpecular();
+    const Ref<Texture>& brdf = m_environment->getBRDFTable();
+    vk::DescriptorImageInfo specularInfo(specular->getSampler(), specular->getImageView(), vk::ImageLayout::eShaderReadOnlyOptimal);
+    vk::DescriptorImageInfo brdfInfo(brdf->getSampler(), brdf->getImageView(), vk::ImageLayout::eShaderReadOnlyOptimal);
+    std::array<vk::WriteDescriptorSet, 2> writes = {
+        vk::WriteDescriptorSet{m_globalDescriptorSets[frame], 3, 0, 1, vk::DescriptorType::eCombinedImageSampler, &specularInfo, nullptr},
+        vk::WriteDescriptorSet{m_globalDescriptorSets[frame], 4, 0, 1, vk::DescriptorType::eCombinedImageSampler, &brdfInfo, nullptr}
+    };
+    m_context.getDevice().updateDescriptorSets(writes, {});
+    m_environmentVersions[frame] = m_environment->getVersion();
+    m_boundEnvironment[frame] = specular;
 }
 
 void Renderer::createPipelines(const EngineConfig& config) {
@@ -245,6 +390,18 @@ void Renderer::createPipelines(const EngineConfig& config) {
     m_layouts[MaterialType::Plasma] = PlasmaMaterial::CreateLayout(dev);
     m_layouts[MaterialType::Particle] = ParticleMaterial::CreateLayout(dev);
 
+    // Bindless PBR: one set for every material, the per-material sets above stay for the other types
+    if (config.graphics.enableBindlessMaterials && m_context.supportsBindless()) {
+        m_bindless = CreateRef<BindlessMaterials>(m_context);
+    }
+
+    // Pipelines are only declared here (slot + build) and compiled together on the JobSystem at the end:
+    // each build reads shaders and layouts created beforehand and writes its own slot
+    std::vector<std::function<void()>> builds;
+    auto defer = [&builds](Scope<GraphicsPipeline>& slot, std::function<Scope<GraphicsPipeline>()> create) {
+        builds.push_back([&slot, create = std::move(create)]() { slot = create(); });
+    };
+
     m_shaders["shadow.vert"] = CreateScope<Shader>(m_context, "assets/shaders/shadow.vert.spv");
     m_shaders["shadow.frag"] = CreateScope<Shader>(m_context, "assets/shaders/shadow.frag.spv");
     
@@ -259,24 +416,27 @@ void Renderer::createPipelines(const EngineConfig& config) {
     shadowConfig.rasterizer.setCullMode("None");
     shadowConfig.rasterizer.depthBiasEnable = true;
 
-    m_pipelines[static_cast<MaterialType>(99)] = CreateScope<GraphicsPipeline>(
-        m_context,
-        vk::Format::eUndefined,  // no color attachment
-        m_swapChain->getDepthFormat(),
-        *m_shaders["shadow.vert"], *m_shaders["shadow.frag"],
-        shadowConfig,
-        std::vector<vk::DescriptorSetLayout>{m_globalDescriptorLayout},
-        std::vector<vk::PushConstantRange>{pushConstant},
-        true, // useVertexInput
-        true, // depthWrite
-        vk::CompareOp::eLess,
-        std::vector<uint32_t>{0}, // position only
-        vk::PrimitiveTopology::eTriangleList,
-        BlendMode::Opaque // no blending
-    );
+    defer(m_pipelines[static_cast<MaterialType>(99)], [this, &shadowConfig, pushConstant, shadowDepthFmt = m_swapChain->getDepthFormat(),
+                                                         vert = m_shaders["shadow.vert"].get(), frag = m_shaders["shadow.frag"].get()]() {
+        return CreateScope<GraphicsPipeline>(
+            m_context,
+            vk::Format::eUndefined,  // no color attachment
+            shadowDepthFmt,
+            *vert, *frag,
+            shadowConfig,
+            std::vector<vk::DescriptorSetLayout>{m_globalDescriptorLayout},
+            std::vector<vk::PushConstantRange>{pushConstant},
+            true, // useVertexInput
+            true, // depthWrite
+            vk::CompareOp::eLess,
+            std::vector<uint32_t>{0}, // position only
+            vk::PrimitiveTopology::eTriangleList,
+            BlendMode::Opaque // no blending
+        );
+    });
 
     m_shaders["pbr.vert"] = CreateScope<Shader>(m_context, "assets/shaders/pbr.vert.spv");
-    m_shaders["pbr.frag"] = CreateScope<Shader>(m_context, "assets/shaders/pbr.frag.spv");
+    m_shaders["pbr.frag"] = CreateScope<Shader>(m_context, m_bindless ? "assets/shaders/pbr_bindless.frag.spv" : "assets/shaders/pbr.frag.spv");
     m_shaders["unlit.vert"] = CreateScope<Shader>(m_context, "assets/shaders/unlit.vert.spv");
     m_shaders["unlit.frag"] = CreateScope<Shader>(m_context, "assets/shaders/unlit.frag.spv");
     m_shaders["toon.vert"] = CreateScope<Shader>(m_context, "assets/shaders/toon.vert.spv");
@@ -290,37 +450,55 @@ void Renderer::createPipelines(const EngineConfig& config) {
     m_shaders["plasma.frag"] = CreateScope<Shader>(m_context, "assets/shaders/plasma.frag.spv");
     m_shaders["particle.vert"] = CreateScope<Shader>(m_context, "assets/shaders/particle.vert.spv");
     m_shaders["particle.frag"] = CreateScope<Shader>(m_context, "assets/shaders/particle.frag.spv");
+    m_shaders["particle_stream.vert"] = CreateScope<Shader>(m_context, "assets/shaders/particle_stream.vert.spv");
+    m_shaders["particle_stream.frag"] = CreateScope<Shader>(m_context, "assets/shaders/particle_stream.frag.spv");
 
     vk::Format colorFmt = m_config.graphics.enableOffscreenRendering ? m_renderTarget->getColorFormat() : m_swapChain->getImageFormat();
     vk::Format depthFmt = m_config.graphics.enableOffscreenRendering ? m_renderTarget->getDepthFormat() : m_swapChain->getDepthFormat();
 
-    auto createP = [&](MaterialType t, const std::string& v, const std::string& f, const EngineConfig& cfg, bool dWrite, vk::CompareOp op, const std::vector<uint32_t>& attr = {}, vk::PrimitiveTopology top = vk::PrimitiveTopology::eTriangleList, BlendMode blend = BlendMode::Opaque) {
-        std::vector<vk::DescriptorSetLayout> ls = { m_globalDescriptorLayout, m_layouts[t] };
-        return CreateScope<GraphicsPipeline>(m_context, colorFmt, depthFmt, *m_shaders[v], *m_shaders[f], cfg, ls, std::vector<vk::PushConstantRange>{}, true, dWrite, op, attr, top, blend);
+    // `cfg` must outlive the builds: `config` or one of the configs below
+    auto createP = [&](Scope<GraphicsPipeline>& slot, MaterialType t, const std::string& v, const std::string& f, const EngineConfig& cfg, bool dWrite, vk::CompareOp op, const std::vector<uint32_t>& attr = {}, vk::PrimitiveTopology top = vk::PrimitiveTopology::eTriangleList, BlendMode blend = BlendMode::Opaque,
+                       const std::vector<vk::PushConstantRange>& pcr = {}) {
+        std::vector<vk::DescriptorSetLayout> ls = { m_globalDescriptorLayout, (t == MaterialType::PBR && m_bindless) ? m_bindless->getLayout() : m_layouts[t] };
+        defer(slot, [this, colorFmt, depthFmt, vert = m_shaders[v].get(), frag = m_shaders[f].get(), &cfg, ls, pcr, dWrite, op, attr, top, blend]() {
+            return CreateScope<GraphicsPipeline>(m_context, colorFmt, depthFmt, *vert, *frag, cfg, ls, pcr, true, dWrite, op, attr, top, blend);
+        });
     };
 
-    m_pipelines[MaterialType::PBR] = createP(MaterialType::PBR, "pbr.vert", "pbr.frag", config, true, vk::CompareOp::eLess);
+    createP(m_pipelines[MaterialType::PBR], MaterialType::PBR, "pbr.vert", "pbr.frag", config, true, vk::CompareOp::eLess);
     EngineConfig envCfg = config; envCfg.rasterizer.setCullMode("None");
     
     // Standard Unlit (For 3D Models without lighting) - Opaque, Depth Write, Cull Back
-    m_pipelines[MaterialType::Unlit] = createP(MaterialType::Unlit, "unlit.vert", "unlit.frag", config, true, vk::CompareOp::eLess);
-    m_pipelines[MaterialType::Toon] = createP(MaterialType::Toon, "toon.vert", "toon.frag", config, true, vk::CompareOp::eLess);
+    createP(m_pipelines[MaterialType::Unlit], MaterialType::Unlit, "unlit.vert", "unlit.frag", config, true, vk::CompareOp::eLess);
+    createP(m_pipelines[MaterialType::Toon], MaterialType::Toon, "toon.vert", "toon.frag", config, true, vk::CompareOp::eLess);
     std::vector<uint32_t> envAttr = { 0, 1, 2, 3, 4 };
-    m_pipelines[MaterialType::Skybox] = createP(MaterialType::Skybox, "skybox.vert", "skybox.frag", envCfg, false, vk::CompareOp::eAlways, envAttr);
+    createP(m_pipelines[MaterialType::Skybox], MaterialType::Skybox, "skybox.vert", "skybox.frag", envCfg, false, vk::CompareOp::eAlways, envAttr);
     
     // SkySphere has a push constant for flipY
     std::vector<vk::PushConstantRange> skySpherePCR = { vk::PushConstantRange(vk::ShaderStageFlagBits::eFragment, 0, sizeof(int)) };
-    std::vector<vk::DescriptorSetLayout> lsSkySphere = { m_globalDescriptorLayout, m_layouts[MaterialType::SkySphere] };
-    m_pipelines[MaterialType::SkySphere] = CreateScope<GraphicsPipeline>(m_context, colorFmt, depthFmt, *m_shaders["skysphere.vert"], *m_shaders["skysphere.frag"], envCfg, lsSkySphere, skySpherePCR, true, false, vk::CompareOp::eAlways, envAttr, vk::PrimitiveTopology::eTriangleList);
+    createP(m_pipelines[MaterialType::SkySphere], MaterialType::SkySphere, "skysphere.vert", "skysphere.frag", envCfg, false, vk::CompareOp::eAlways, envAttr, vk::PrimitiveTopology::eTriangleList, BlendMode::Opaque, skySpherePCR);
     
     // Highlight Pipeline uses LINE_LIST topology
-    m_pipelines[MaterialType::Highlight] = createP(MaterialType::Highlight, "unlit.vert", "unlit.frag", envCfg, false, vk::CompareOp::eAlways, {}, vk::PrimitiveTopology::eLineList);
+    createP(m_pipelines[MaterialType::Highlight], MaterialType::Highlight, "unlit.vert", "unlit.frag", envCfg, false, vk::CompareOp::eAlways, {}, vk::PrimitiveTopology::eLineList);
 
     // Plasma Pipeline: Additive Blending, No Depth Write
-    m_pipelines[MaterialType::Plasma] = createP(MaterialType::Plasma, "unlit.vert", "plasma.frag", envCfg, false, vk::CompareOp::eLess, {}, vk::PrimitiveTopology::eTriangleList, BlendMode::Additive);
+    createP(m_pipelines[MaterialType::Plasma], MaterialType::Plasma, "unlit.vert", "plasma.frag", envCfg, false, vk::CompareOp::eLess, {}, vk::PrimitiveTopology::eTriangleList, BlendMode::Additive);
 
     // Particle Pipeline: Additive Blending (best for light/fire FX with black backgrounds), No Depth Write
-    m_pipelines[MaterialType::Particle] = createP(MaterialType::Particle, "particle.vert", "particle.frag", envCfg, false, vk::CompareOp::eLess, {}, vk::PrimitiveTopology::eTriangleList, BlendMode::Additive);
+    createP(m_pipelines[MaterialType::Particle], MaterialType::Particle, "particle.vert", "particle.frag", envCfg, false, vk::CompareOp::eLess, {}, vk::PrimitiveTopology::eTriangleList, BlendMode::Additive);
+
+    // Particle streams: one camera-facing instanced mesh per emitter, additive, intensity pushed per emitter
+    std::vector<vk::PushConstantRange> particlePCR = { vk::PushConstantRange(vk::ShaderStageFlagBits::eFragment, 0, sizeof(float)) };
+    for (MaterialType t : { MaterialType::Particle, MaterialType::Plasma }) {
+        createP(m_particlePipelines[t], t, "particle_stream.vert", "particle_stream.frag", envCfg, false, vk::CompareOp::eLess, {}, vk::PrimitiveTopology::eTriangleList, BlendMode::Additive, particlePCR);
+    }
+
+    // Independent builds sharing the context's pipeline cache (internally synchronized). A failure is rethrown here.
+    std::vector<std::exception_ptr> errors(builds.size());
+    m_jobSystem.dispatch(static_cast<uint32_t>(builds.size()), 1, [&](uint32_t i, uint32_t) {
+        try { builds[i](); } catch (...) { errors[i] = std::current_exception(); }
+    });
+    for (const auto& error : errors) if (error) std::rethrow_exception(error);
 }
 
 void Renderer::createCopyPipeline() {
@@ -349,6 +527,80 @@ void Renderer::createCopyPipeline() {
     }
 }
 
+void Renderer::createInstanceBuffers(uint32_t frame, uint32_t capacity) {
+    auto dev = m_context.getDevice();
+    m_instanceCapacities[frame] = capacity;
+
+    // GPU culling: the second half receives the visible instances, compacted batch by batch
+    const vk::DeviceSize slots = m_gpuCulling ? vk::DeviceSize(capacity) * 2 : vk::DeviceSize(capacity);
+    m_instanceBuffers[frame] = CreateScope<Buffer>(m_context, sizeof(InstanceData) * slots, vk::BufferUsageFlagBits::eStorageBuffer, VMA_MEMORY_USAGE_CPU_TO_GPU, VMA_ALLOCATION_CREATE_MAPPED_BIT);
+
+    vk::DescriptorBufferInfo instInfo(m_instanceBuffers[frame]->getHandle(), 0, VK_WHOLE_SIZE);
+    vk::WriteDescriptorSet write(m_globalDescriptorSets[frame], 1, 0, 1, vk::DescriptorType::eStorageBuffer, nullptr, &instInfo);
+    dev.updateDescriptorSets(write, nullptr);
+
+    if (!m_gpuCulling) return;
+    m_cullInstanceBuffers[frame] = CreateScope<StorageBuffer>(m_context, sizeof(GpuCullInstance) * capacity);
+    m_drawTemplateBuffers[frame] = CreateScope<StorageBuffer>(m_context, sizeof(GpuDrawTemplate) * capacity);
+    m_drawCountBuffers[frame] = CreateScope<StorageBuffer>(m_context, sizeof(uint32_t) * capacity);
+    m_gpuDrawBuffers[frame] = CreateScope<IndirectBuffer>(m_context, capacity);
+
+    // 0 bounds, 1 templates, 2 draw counts, 3 instance records, 4 output commands, 5 counters
+    const vk::Buffer buffers[6] = {
+        m_cullInstanceBuffers[frame]->getHandle(), m_drawTemplateBuffers[frame]->getHandle(), m_drawCountBuffers[frame]->getHandle(),
+        m_instanceBuffers[frame]->getHandle(), m_gpuDrawBuffers[frame]->getHandle(), m_gpuCounterBuffers[frame]->getHandle()
+    };
+    std::array<vk::DescriptorBufferInfo, 6> infos;
+    std::vector<vk::WriteDescriptorSet> cullWrites;
+    for (uint32_t b = 0; b < 6; ++b) {
+        infos[b] = vk::DescriptorBufferInfo(buffers[b], 0, VK_WHOLE_SIZE);
+        cullWrites.push_back({ m_cullDescriptorSets[frame], b, 0, 1, vk::DescriptorType::eStorageBuffer, nullptr, &infos[b] });
+    }
+    dev.updateDescriptorSets(cullWrites, {});
+}
+
+void Renderer::createParticleBuffer(uint32_t frame, uint32_t capacity) {
+    m_particleCapacities[frame] = capacity;
+    m_particleBuffers[frame] = CreateScope<Buffer>(m_context, sizeof(ParticleInstance) * capacity, vk::BufferUsageFlagBits::eStorageBuffer, VMA_MEMORY_USAGE_CPU_TO_GPU, VMA_ALLOCATION_CREATE_MAPPED_BIT);
+    vk::DescriptorBufferInfo info(m_particleBuffers[frame]->getHandle(), 0, VK_WHOLE_SIZE);
+    vk::WriteDescriptorSet write(m_globalDescriptorSets[frame], 5, 0, 1, vk::DescriptorType::eStorageBuffer, nullptr, &info);
+    m_context.getDevice().updateDescriptorSets(write, nullptr);
+}
+
+void Renderer::createGpuCulling() {
+    if (!m_gpuCulling) return;
+    auto dev = m_context.getDevice();
+
+    // 0 bounds, 1 templates, 2 draw counts, 3 instance records, 4 output commands, 5 counters
+    std::vector<vk::DescriptorSetLayoutBinding> bindings;
+    for (uint32_t b = 0; b <= 5; ++b) bindings.push_back({ b, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute });
+    m_cullDescriptorLayout = dev.createDescriptorSetLayout({ {}, (uint32_t)bindings.size(), bindings.data() });
+
+    m_shaders["cull_instances.comp"] = CreateScope<Shader>(m_context, "assets/shaders/cull_instances.comp.spv");
+    m_shaders["compact_draws.comp"] = CreateScope<Shader>(m_context, "assets/shaders/compact_draws.comp.spv");
+    std::vector<vk::DescriptorSetLayout> layouts = { m_cullDescriptorLayout };
+    std::vector<vk::PushConstantRange> ranges = { vk::PushConstantRange(vk::ShaderStageFlagBits::eCompute, 0, sizeof(GpuCullPushConstants)) };
+    m_cullPipeline = CreateScope<ComputePipeline>(m_context, *m_shaders["cull_instances.comp"], layouts, ranges);
+    m_compactPipeline = CreateScope<ComputePipeline>(m_context, *m_shaders["compact_draws.comp"], layouts, ranges);
+
+    m_cullInstanceBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+    m_drawTemplateBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+    m_drawCountBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+    m_gpuDrawBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+    m_gpuCounterBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+    std::vector<vk::DescriptorSetLayout> setLayouts(MAX_FRAMES_IN_FLIGHT, m_cullDescriptorLayout);
+    m_cullDescriptorSets = dev.allocateDescriptorSets({ m_descriptorPool, MAX_FRAMES_IN_FLIGHT, setLayouts.data() });
+    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
+        // Host-visible: counter 0 (visible instances) is read back once the frame's fence is signaled
+        m_gpuCounterBuffers[i] = CreateScope<Buffer>(m_context, sizeof(uint32_t) * (MAX_GPU_DRAW_GROUPS + 1),
+            vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer | vk::BufferUsageFlagBits::eTransferDst,
+            VMA_MEMORY_USAGE_CPU_TO_GPU, VMA_ALLOCATION_CREATE_MAPPED_BIT);
+        std::memset(m_gpuCounterBuffers[i]->getMappedData(), 0, sizeof(uint32_t) * (MAX_GPU_DRAW_GROUPS + 1));
+    }
+    // The buffers sized by the instance count and the descriptor sets are filled by createInstanceBuffers
+    BB_CORE_INFO("Renderer: GPU culling enabled (compute + drawIndexedIndirectCount).");
+}
+
 Ref<Material> Renderer::getMaterialForTexture(Ref<Texture> texture) {
     if (!texture) return nullptr;
     std::string key = std::string(texture->getPath());
@@ -410,6 +662,15 @@ bool Renderer::render(Scene& scene) {
     // 1. Prepare data (Collect commands and fill instance buffers)
     prepareRenderData(scene);
 
+    // Ambient lighting follows the sky sphere (bakes run on the JobSystem, finished ones are installed here)
+    auto skySphereView = scene.getRegistry().view<SkySphereComponent>();
+    if (!skySphereView.empty()) {
+        const auto& sky = skySphereView.get<SkySphereComponent>(skySphereView.front());
+        m_environment->update(sky.texture ? sky.assetPath : std::string(), sky.flipY);
+    } else {
+        m_environment->update({}, false);
+    }
+
     // 2. Identify active camera and setup UBO
     GlobalUBO uboData{}; // Zero-initialize to avoid rendering with garbage if update fails
     updateGlobalUBO(m_currentFrame, scene, uboData);
@@ -418,6 +679,28 @@ bool Renderer::render(Scene& scene) {
     // 3. Begin Command Buffer
     auto dev = m_context.getDevice();
     (void)dev.waitForFences(1, &m_inFlightFences[m_currentFrame], VK_TRUE, UINT64_MAX);
+    // The oldest frame is finished: geometry released since then can be recycled
+    m_context.getGeometryPool().nextFrame();
+    m_context.getUploadQueue().collect();
+    // Requests of prepareRenderData -> residency changes (their uploads go out with this frame)
+    m_context.getTextureStreamer().update();
+    m_stats.textureStreaming = m_context.getTextureStreamer().getStats();
+    // Visible instances of the GPU culling pass of the frame that just finished with this slot
+    if (m_gpuCulling) m_stats.gpuInstancesDrawn = *static_cast<const uint32_t*>(m_gpuCounterBuffers[m_currentFrame]->getMappedData());
+    // This frame's descriptor set is no longer read by the GPU: it can follow the environment
+    if (m_environmentVersions[m_currentFrame] != m_environment->getVersion()) bindEnvironment(m_currentFrame);
+    // Same for the bindless texture array and material records registered since this frame was last drawn
+    if (m_bindless) m_bindless->update(m_currentFrame);
+    // The instance buffers of this frame are free too: grow them if the scene outgrew them, then fill them
+    if (m_instanceCount > m_instanceCapacities[m_currentFrame]) {
+        createInstanceBuffers(m_currentFrame, m_instanceBudget.grow(m_instanceCapacities[m_currentFrame], m_instanceCount));
+    }
+    uploadInstanceData();
+    m_stats.instanceCapacity = m_instanceCapacities[m_currentFrame];
+    if (m_particleCount > m_particleCapacities[m_currentFrame]) {
+        createParticleBuffer(m_currentFrame, InstanceBudget().grow(m_particleCapacities[m_currentFrame], m_particleCount));
+    }
+    uploadParticles();
     
     uint32_t imageIndex;
     try { imageIndex = m_swapChain->acquireNextImage(m_imageAvailableSemaphores[m_currentFrame]); } 
@@ -432,9 +715,17 @@ bool Renderer::render(Scene& scene) {
     cb.begin({ vk::CommandBufferUsageFlagBits::eOneTimeSubmit });
     m_frameStarted = true;
 
-    // 4. Shadow Pass
-    if (uboData.globalParams.y > 0.0f && m_shadowsEnabledRuntime) {
-        renderShadows(cb, scene, uboData);
+    // 3b. GPU culling: indirect commands and compacted instances of the main pass
+    if (m_gpuCulling) cullInstancesOnGpu(cb);
+
+    // 4. Shadow cascades to render and material sets, then the secondary command buffers (recorded by the workers)
+    const bool shadowPass = uboData.globalParams.y > 0.0f && m_shadowsEnabledRuntime && prepareShadows(scene, uboData);
+    resolveDrawSets(scene);
+    recordSecondaries(shadowPass);
+
+    // 4b. Shadow Pass
+    if (shadowPass) {
+        renderShadows(cb);
         BB_CORE_TRACE("Renderer: Shadows rendered");
     }
 
@@ -462,7 +753,7 @@ bool Renderer::render(Scene& scene) {
         vk::ImageMemoryBarrier dBarrier({}, vk::AccessFlagBits::eDepthStencilAttachmentWrite, vk::ImageLayout::eUndefined, vk::ImageLayout::eDepthStencilAttachmentOptimal, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, dImage, { vk::ImageAspectFlagBits::eDepth, 0, 1, 0, 1 });
         cb.pipelineBarrier(vk::PipelineStageFlagBits::eEarlyFragmentTests, vk::PipelineStageFlagBits::eEarlyFragmentTests, {}, nullptr, nullptr, dBarrier);
         
-        drawScene(cb, scene, colorView, depthView, extent);
+        drawScene(cb, colorView, depthView, extent);
         
         bool editorActive = false;
 #if defined(BB3D_ENABLE_EDITOR)
@@ -491,7 +782,7 @@ bool Renderer::render(Scene& scene) {
         vk::ImageMemoryBarrier dBarrier({}, vk::AccessFlagBits::eDepthStencilAttachmentWrite, vk::ImageLayout::eUndefined, vk::ImageLayout::eDepthStencilAttachmentOptimal, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, dImage, { vk::ImageAspectFlagBits::eDepth, 0, 1, 0, 1 });
         cb.pipelineBarrier(vk::PipelineStageFlagBits::eEarlyFragmentTests, vk::PipelineStageFlagBits::eEarlyFragmentTests, {}, nullptr, nullptr, dBarrier);
         
-        drawScene(cb, scene, colorView, depthView, extent);
+        drawScene(cb, colorView, depthView, extent);
     }
     BB_CORE_TRACE("Renderer: Scene drawn");
 
@@ -509,14 +800,17 @@ void Renderer::submitAndPresent() {
     cb.end();
     vk::PipelineStageFlags waitStages[] = { vk::PipelineStageFlagBits::eColorAttachmentOutput };
     vk::SubmitInfo submitInfo(1, &m_imageAvailableSemaphores[m_currentFrame], waitStages, 1, &cb, 1, &m_renderFinishedSemaphores[imageIndex]);
+    // Uploads recorded by any thread so far are queued ahead of the frame that may use them
+    m_context.getUploadQueue().submitAll();
     try {
+        std::lock_guard<std::mutex> queueLock(m_context.getQueueMutex());
         m_context.getGraphicsQueue().submit(submitInfo, m_inFlightFences[m_currentFrame]);
         m_swapChain->present(m_renderFinishedSemaphores[imageIndex], imageIndex);
     } catch (...) { onResize(m_window.GetWidth(), m_window.GetHeight()); }
     m_currentFrame = (m_currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
 }
 
-void Renderer::drawScene(vk::CommandBuffer cb, Scene& scene, vk::ImageView colorView, vk::ImageView depthView, vk::Extent2D extent) {
+void Renderer::drawScene(vk::CommandBuffer cb, vk::ImageView colorView, vk::ImageView depthView, vk::Extent2D extent) {
     BB_CORE_TRACE("Renderer: Drawing scene (Frame: {})", m_currentFrame);
     
     vk::RenderingAttachmentInfo colorAttr;
@@ -533,84 +827,257 @@ void Renderer::drawScene(vk::CommandBuffer cb, Scene& scene, vk::ImageView color
     depthAttr.storeOp = vk::AttachmentStoreOp::eStore;
     depthAttr.clearValue = vk::ClearValue(vk::ClearDepthStencilValue(1.0f, 0));
 
+    if (m_sceneRecordTasks > 0) {
+        // Ranges recorded by the workers (recordSecondaries), executed in draw order
+        cb.beginRendering({ vk::RenderingFlagBits::eContentsSecondaryCommandBuffers, {{0, 0}, extent}, 1, 0, 1, &colorAttr, &depthAttr });
+        const uint32_t firstSceneTask = static_cast<uint32_t>(m_recordTasks.size()) - m_sceneRecordTasks;
+        cb.executeCommands(m_sceneRecordTasks, &m_recordBuffers[m_currentFrame][firstSceneTask]);
+        cb.endRendering();
+        return;
+    }
+
     cb.beginRendering({ {}, {{0, 0}, extent}, 1, 0, 1, &colorAttr, &depthAttr });
     cb.setViewport(0, vk::Viewport(0, 0, (float)extent.width, (float)extent.height, 0, 1));
     cb.setScissor(0, vk::Rect2D({0, 0}, extent));
-    renderSkybox(cb, scene);
-    
+    renderSkybox(cb);
+    recordDraws(cb, 0, static_cast<uint32_t>(m_drawSets.size()));
+    drawParticles(cb);
+    cb.endRendering();
+}
+
+void Renderer::recordDraws(vk::CommandBuffer cb, uint32_t begin, uint32_t end) {
     // The commands are already sorted and the instance buffer is filled in prepareRenderData
     GraphicsPipeline* lastPipeline = nullptr; 
     Material* lastMaterial = nullptr; 
     Mesh* lastMesh = nullptr;
+    uint32_t lastLod = 0;
+    VertexFormat lastFormat = VertexFormat::Full;
     
-    uint32_t currentBatchStart = 0;
+    uint32_t currentBatchStart = begin;
     uint32_t currentBatchCount = 0;
+    // First GPU-culled group of the range (ranges never split a group)
+    uint32_t nextGroup = static_cast<uint32_t>(std::lower_bound(m_gpuDrawGroups.begin(), m_gpuDrawGroups.end(), begin,
+        [](const GpuDrawGroup& group, uint32_t position) { return group.firstPosition < position; }) - m_gpuDrawGroups.begin());
+    GeometryBinding geometry;
 
     auto flushBatch = [&]() {
         if (currentBatchCount == 0) return;
-        lastMesh->draw(cb, currentBatchCount, currentBatchStart);
+        geometry.bind(cb, *lastMesh);
+        lastMesh->drawBound(cb, currentBatchCount, currentBatchStart, lastLod);
         currentBatchStart += currentBatchCount;
         currentBatchCount = 0;
     };
 
-    for (uint32_t i = 0; i < (uint32_t)m_renderCommands.size(); ++i) {
-        const auto& cmd = m_renderCommands[i];
-        if (i >= MAX_INSTANCES) break;
+    for (uint32_t i = begin; i < end; ++i) {
+        const auto& cmd = m_renderCommands[m_drawKeys[i].index];
 
         if (cmd.type == MaterialType::Skybox || cmd.type == MaterialType::SkySphere) continue;
+        if (!cmd.visible) {
+            // Off-screen shadow caster: the next visible instance starts a new batch
+            flushBatch();
+            currentBatchStart = i + 1;
+            continue;
+        }
 
-        auto& pipeline = m_pipelines[cmd.type];
+        auto& pipeline = m_pipelines.at(cmd.type);
+        const VertexFormat format = cmd.mesh->getVertexFormat();
         bool pipelineChanged = false;
         if (pipeline.get() != lastPipeline) {
             flushBatch();
-            pipeline->bind(cb);
+            pipeline->bind(cb, format);
             lastPipeline = pipeline.get();
+            lastFormat = format;
             cb.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeline->getLayout(), 0, 1, &m_globalDescriptorSets[m_currentFrame], 0, nullptr);
             pipelineChanged = true;
             currentBatchStart = i; // Reset start for new pipeline/batch
+        } else if (format != lastFormat) {
+            // Same layout: the bound descriptor sets stay valid across the variants
+            flushBatch();
+            pipeline->bind(cb, format);
+            lastFormat = format;
+            currentBatchStart = i;
         }
 
-        if (cmd.material != lastMaterial || pipelineChanged) {
+        if (cmd.type == MaterialType::PBR && m_bindless) {
+            // Bindless: the material of each instance is read from the instance data, batches span materials
+            if (pipelineChanged) {
+                vk::DescriptorSet ds = m_bindless->getDescriptorSet(m_currentFrame);
+                cb.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeline->getLayout(), 1, 1, &ds, 0, nullptr);
+                lastMaterial = nullptr;
+            }
+        } else if (cmd.material != lastMaterial || pipelineChanged) {
             flushBatch();
-            vk::DescriptorSet ds = cmd.material->getDescriptorSet(m_descriptorPool, m_layouts[cmd.type]);
-            cb.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeline->getLayout(), 1, 1, &ds, 0, nullptr);
+            cb.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeline->getLayout(), 1, 1, &m_drawSets[i], 0, nullptr);
             lastMaterial = cmd.material;
             currentBatchStart = i;
         }
 
-        if (cmd.mesh != lastMesh) {
+        if (nextGroup < m_gpuDrawGroups.size() && m_gpuDrawGroups[nextGroup].firstPosition == i) {
+            // GPU-culled group: its commands and their count were written by the compute pass
+            const uint32_t groupIndex = nextGroup++;
+            const auto& group = m_gpuDrawGroups[groupIndex];
+            flushBatch();
+            geometry.bind(cb, *cmd.mesh);
+            cb.drawIndexedIndirectCountKHR(m_gpuDrawBuffers[m_currentFrame]->getHandle(), group.firstDraw * sizeof(vk::DrawIndexedIndirectCommand),
+                                           m_gpuCounterBuffers[m_currentFrame]->getHandle(), (1 + groupIndex) * sizeof(uint32_t),
+                                           group.drawCount, sizeof(vk::DrawIndexedIndirectCommand));
+            lastMesh = nullptr;
+            i = group.endPosition - 1;
+            currentBatchStart = group.endPosition;
+            continue;
+        }
+
+        if (cmd.clustered) {
+            // Visible meshlets only: one indirect draw list per instance, never merged into a batch
+            flushBatch();
+            geometry.bind(cb, *cmd.mesh);
+            cmd.mesh->drawClusters(cb, m_clusterDrawBuffers[m_currentFrame]->getHandle(), cmd.clusterFirstDraw * sizeof(vk::DrawIndexedIndirectCommand), cmd.clusterDrawCount);
+            lastMesh = nullptr;
+            currentBatchStart = i + 1;
+            continue;
+        }
+
+        if (cmd.mesh != lastMesh || cmd.lod != lastLod) {
             flushBatch();
             lastMesh = cmd.mesh;
+            lastLod = cmd.lod;
             currentBatchStart = i;
         }
 
         currentBatchCount++;
     }
     flushBatch();
-    cb.endRendering();
 }
 
-void Renderer::renderSkybox(vk::CommandBuffer cb, Scene& scene) {
+void Renderer::drawParticles(vk::CommandBuffer cb) {
+    // Additive blending: emitters need no sorting
+    GeometryBinding geometry;
+    GraphicsPipeline* lastPipeline = nullptr;
+    for (const auto& draw : m_particleDraws) {
+        const MaterialType type = draw.material->getType();
+        auto& pipeline = m_particlePipelines.at(type);
+        pipeline->bind(cb, draw.mesh->getVertexFormat());
+        if (pipeline.get() != lastPipeline) {
+            cb.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeline->getLayout(), 0, 1, &m_globalDescriptorSets[m_currentFrame], 0, nullptr);
+            lastPipeline = pipeline.get();
+        }
+        cb.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeline->getLayout(), 1, 1, &draw.set, 0, nullptr);
+        const float intensity = type == MaterialType::Plasma ? static_cast<PlasmaMaterial*>(draw.material)->getIntensity() : 1.0f;
+        cb.pushConstants(pipeline->getLayout(), vk::ShaderStageFlagBits::eFragment, 0, sizeof(float), &intensity);
+        geometry.bind(cb, *draw.mesh);
+        draw.mesh->drawBound(cb, draw.count, draw.firstInstance);
+    }
+}
+
+void Renderer::renderSkybox(vk::CommandBuffer cb) {
+    if (!m_skyDraw.active) return;
+    auto& pipeline = m_pipelines.at(m_skyDraw.type);
+    pipeline->bind(cb);
+    cb.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeline->getLayout(), 0, 1, &m_globalDescriptorSets[m_currentFrame], 0, nullptr);
+    cb.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeline->getLayout(), 1, 1, &m_skyDraw.set, 0, nullptr);
+    if (m_skyDraw.type == MaterialType::SkySphere) cb.pushConstants(pipeline->getLayout(), vk::ShaderStageFlagBits::eFragment, 0, sizeof(int), &m_skyDraw.flipY);
+    m_skyboxCube->draw(cb);
+}
+
+void Renderer::resolveDrawSets(Scene& scene) {
+    // Materials allocate and rewrite their sets lazily: resolved once here, only read by the recording threads
+    const uint32_t drawCount = std::min(m_instanceCount, static_cast<uint32_t>(m_drawKeys.size()));
+    m_drawSets.resize(drawCount);
+    Material* lastMaterial = nullptr;
+    vk::DescriptorSet lastSet;
+    for (uint32_t i = 0; i < drawCount; ++i) {
+        const auto& cmd = m_renderCommands[m_drawKeys[i].index];
+        m_drawSets[i] = vk::DescriptorSet{};
+        if (!cmd.visible || cmd.type == MaterialType::Skybox || cmd.type == MaterialType::SkySphere) continue;
+        if (cmd.type == MaterialType::PBR && m_bindless) continue; // Shared bindless set
+        if (cmd.material != lastMaterial) {
+            lastSet = cmd.material->getDescriptorSet(m_descriptorPool, m_layouts[cmd.type]);
+            lastMaterial = cmd.material;
+        }
+        m_drawSets[i] = lastSet;
+    }
+    for (auto& draw : m_particleDraws) draw.set = draw.material->getDescriptorSet(m_descriptorPool, m_layouts[draw.material->getType()]);
+
+    m_skyDraw = SkyDraw{};
     auto skySphereView = scene.getRegistry().view<SkySphereComponent>();
     if (!skySphereView.empty()) {
-        auto entity = skySphereView.front(); auto& sky = skySphereView.get<SkySphereComponent>(entity);
+        auto& sky = skySphereView.get<SkySphereComponent>(skySphereView.front());
         if (sky.texture) {
-            m_internalSkySphereMat->setTexture(sky.texture); auto& pipeline = m_pipelines[MaterialType::SkySphere]; pipeline->bind(cb);
-            cb.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeline->getLayout(), 0, 1, &m_globalDescriptorSets[m_currentFrame], 0, nullptr);
-            vk::DescriptorSet ds = m_internalSkySphereMat->getDescriptorSet(m_descriptorPool, m_layouts[MaterialType::SkySphere]);
-            cb.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeline->getLayout(), 1, 1, &ds, 0, nullptr);
-            int flipY = sky.flipY ? 1 : 0;
-            cb.pushConstants(pipeline->getLayout(), vk::ShaderStageFlagBits::eFragment, 0, sizeof(int), &flipY);
-            m_skyboxCube->draw(cb); return; 
+            sky.texture->requestResolution(std::numeric_limits<float>::max()); // Wraps around the view: always full resolution
+            m_internalSkySphereMat->setTexture(sky.texture);
+            m_skyDraw = { MaterialType::SkySphere, m_internalSkySphereMat->getDescriptorSet(m_descriptorPool, m_layouts[MaterialType::SkySphere]), sky.flipY ? 1 : 0, true };
+            return;
         }
     }
     if (scene.getSkybox()) {
-        m_internalSkyboxMat->setCubemap(scene.getSkybox()); auto& pipeline = m_pipelines[MaterialType::Skybox]; pipeline->bind(cb);
-        cb.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeline->getLayout(), 0, 1, &m_globalDescriptorSets[m_currentFrame], 0, nullptr);
-        vk::DescriptorSet ds = m_internalSkyboxMat->getDescriptorSet(m_descriptorPool, m_layouts[MaterialType::Skybox]);
-        cb.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeline->getLayout(), 1, 1, &ds, 0, nullptr);
-        m_skyboxCube->draw(cb);
+        m_internalSkyboxMat->setCubemap(scene.getSkybox());
+        m_skyDraw = { MaterialType::Skybox, m_internalSkyboxMat->getDescriptorSet(m_descriptorPool, m_layouts[MaterialType::Skybox]), 0, true };
+    }
+}
+
+void Renderer::recordSecondaries(bool shadowPass) {
+    m_recordTasks.clear();
+    m_sceneRecordTasks = 0;
+    m_stats.secondaryCommandBuffers = 0;
+    if (!m_parallelRecording) return;
+
+    if (shadowPass) {
+        for (uint32_t cascade : m_shadowPasses) m_recordTasks.push_back({ cascade, 0, 0 });
+    }
+    const uint32_t shadowTasks = static_cast<uint32_t>(m_recordTasks.size());
+
+    // Scene ranges of similar size; a GPU-culled group (one indirect-count draw) is never split
+    m_recordSpans.clear();
+    for (const auto& group : m_gpuDrawGroups) m_recordSpans.push_back({ group.firstPosition, group.endPosition });
+    DrawPartition::split(static_cast<uint32_t>(m_drawSets.size()), MIN_DRAWS_PER_RECORD_TASK, MAX_RECORD_TASKS - shadowTasks, m_recordSpans, m_recordRanges);
+    for (const auto& range : m_recordRanges) m_recordTasks.push_back({ NO_CASCADE, range.begin, range.end });
+    m_sceneRecordTasks = static_cast<uint32_t>(m_recordTasks.size()) - shadowTasks;
+
+    if (m_recordTasks.size() < 2) {
+        // A single task: the primary records it directly
+        m_recordTasks.clear();
+        m_sceneRecordTasks = 0;
+        return;
     }
+
+    const bool offscreen = m_config.graphics.enableOffscreenRendering && m_renderTarget;
+    const vk::Format colorFormat = offscreen ? m_renderTarget->getColorFormat() : m_swapChain->getImageFormat();
+    const vk::Format depthFormat = offscreen ? m_renderTarget->getDepthFormat() : m_swapChain->getDepthFormat();
+    const vk::Extent2D extent = offscreen ? m_renderTarget->getExtent() : m_swapChain->getExtent();
+    auto dev = m_context.getDevice();
+
+    m_jobSystem.dispatch(static_cast<uint32_t>(m_recordTasks.size()), 1, [&](uint32_t t, uint32_t) {
+        const RecordTask& task = m_recordTasks[t];
+        // Only this job touches the pool of the task: resetting it recycles its buffer
+        dev.resetCommandPool(m_recordPools[m_currentFrame][t]);
+        vk::CommandBuffer cb = m_recordBuffers[m_currentFrame][t];
+
+        // Scene ranges continue the rendering begun by the primary; a shadow cascade holds its own
+        vk::CommandBufferInheritanceRenderingInfo renderingInfo;
+        renderingInfo.colorAttachmentCount = 1;
+        renderingInfo.pColorAttachmentFormats = &colorFormat;
+        renderingInfo.depthAttachmentFormat = depthFormat;
+        renderingInfo.rasterizationSamples = vk::SampleCountFlagBits::e1;
+        vk::CommandBufferInheritanceInfo inheritance;
+        vk::CommandBufferUsageFlags usage = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
+        if (task.cascade == NO_CASCADE) {
+            inheritance.pNext = &renderingInfo;
+            usage |= vk::CommandBufferUsageFlagBits::eRenderPassContinue;
+        }
+        cb.begin({ usage, &inheritance });
+        if (task.cascade != NO_CASCADE) {
+            recordShadowCascade(cb, task.cascade);
+        } else {
+            // Dynamic state is not inherited
+            cb.setViewport(0, vk::Viewport(0, 0, (float)extent.width, (float)extent.height, 0, 1));
+            cb.setScissor(0, vk::Rect2D({0, 0}, extent));
+            if (t == shadowTasks) renderSkybox(cb);
+            recordDraws(cb, task.begin, task.end);
+            if (t + 1 == m_recordTasks.size()) drawParticles(cb);
+        }
+        cb.end();
+    });
+    m_stats.secondaryCommandBuffers = static_cast<uint32_t>(m_recordTasks.size());
 }
 
 void Renderer::compositeToSwapchain(vk::CommandBuffer cb, uint32_t imageIndex) {
@@ -654,14 +1121,15 @@ void Renderer::updateGlobalUBO(uint32_t currentFrame, Scene& scene, GlobalUBO& u
         return;
     }
 
-    if (m_config.graphics.enableFrustumCulling) {
-        m_frustum.update(activeCamera->getProjectionMatrix() * activeCamera->getViewMatrix());
-    }
-
     uboData.view = activeCamera->getViewMatrix();
     uboData.proj = activeCamera->getProjectionMatrix();
     uboData.camPos = glm::vec4(activeCamera->getPosition(), 1.0f);
     uboData.ambientColor = glm::vec4(0.15f, 0.15f, 0.2f, 1.0f);
+    if (m_environment->isActive()) {
+        const auto& sh = m_environment->getIrradiance();
+        std::copy(sh.begin(), sh.end(), uboData.irradianceSH);
+        uboData.iblParams = glm::vec4(1.0f, m_environment->getSpecularMaxLod(), m_config.graphics.iblIntensity, 0.0f);
+    }
     
     // Extract aspect ratio from the active camera projection and calculate a fixed FOV for skyboxes
     float aspect = 1.77f;
@@ -706,142 +1174,660 @@ void Renderer::updateGlobalUBO(uint32_t currentFrame, Scene& scene, GlobalUBO& u
     uboData.fogParams = glm::vec4(fog.density, fog.start, fog.end, 0.0f);
 }
 
+uint32_t Renderer::selectLOD(uint64_t key, const Mesh& mesh, float screenSize) {
+    if (mesh.getLODCount() <= 1) return 0;
+    auto& state = m_lodStates[key];
+    state.level = LOD::selectLevel(mesh.getLODs(), screenSize, state.level, m_config.graphics.lodHysteresis);
+    state.lastFrame = m_lodFrame;
+    return state.level;
+}
+
+void Renderer::cullClusters(const glm::mat4& viewProj, const glm::vec3& cameraPosition) {
+    BB_PROFILE_SCOPE("Renderer::cullClusters");
+    m_clusterDraws.clear();
+
+    Frustum frustum;
+    frustum.update(viewProj);
+    // The normal cones assume counter-clockwise front faces culled by the rasterizer
+    const bool backface = m_config.rasterizer.cullMode == "Back" && m_config.rasterizer.frontFace == "CCW";
+
+    const uint32_t count = m_instanceCount;
+    for (uint32_t i = 0; i < count; ++i) {
+        auto& cmd = m_renderCommands[m_drawKeys[i].index];
+        if (!cmd.visible || cmd.lod != 0 || !cmd.mesh->hasMeshlets()) continue;
+        if (cmd.type != MaterialType::PBR && cmd.type != MaterialType::Unlit && cmd.type != MaterialType::Toon) continue;
+
+        auto view = ClusterCuller::toObjectSpace(frustum.getPlanes(), cameraPosition, cmd.transform);
+        view.backfaceCulling = backface;
+        const uint32_t first = static_cast<uint32_t>(m_clusterDraws.size());
+        ClusterCullStats stats;
+        uint32_t drawCount = ClusterCuller::cull(cmd.mesh->getMeshlets(), view, i, m_clusterDraws, &stats);
+
+        if (m_clusterDraws.size() > MAX_CLUSTER_DRAWS) {
+            // Out of indirect commands: this instance falls back to the full mesh
+            m_clusterDraws.resize(first);
+            continue;
+        }
+        // Ranges are relative to the meshlet indices: rebase them in the shared geometry buffers
+        const uint32_t indexBase = cmd.mesh->getClusterFirstIndex();
+        const int32_t vertexOffset = cmd.mesh->getVertexOffset();
+        for (size_t d = first; d < m_clusterDraws.size(); ++d) {
+            m_clusterDraws[d].firstIndex += indexBase;
+            m_clusterDraws[d].vertexOffset = vertexOffset;
+        }
+        cmd.clustered = true;
+        cmd.clusterFirstDraw = first;
+        cmd.clusterDrawCount = drawCount;
+        m_stats.clusters.add(stats);
+    }
+
+    // Uploaded by uploadInstanceData, once the frame's fence says the GPU is done with this slot
+    m_stats.clusterDraws = static_cast<uint32_t>(m_clusterDraws.size());
+}
+
+void Renderer::buildGpuDraws(bool frustumCulling) {
+    m_gpuCullInstances.clear();
+    m_gpuDrawTemplates.clear();
+    m_gpuDrawGroups.clear();
+
+    // Without frustum culling, planes (0, 0, 0, 1) accept every instance
+    auto& constants = m_gpuCullConstants;
+    if (frustumCulling) constants.planes = m_frustum.getPlanes();
+    else constants.planes.fill(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+
+    // Groups follow the state changes of drawScene; translucent draws keep their order and clustered ones their meshlet draws on the CPU path
+    const uint32_t count = m_instanceCount;
+    MaterialType lastType = MaterialType::PBR;
+    VertexFormat lastFormat = VertexFormat::Full;
+    const Material* lastMaterial = nullptr;
+    vk::IndexType lastIndexType = vk::IndexType::eUint32;
+    const Mesh* lastMesh = nullptr;
+    uint32_t lastLod = 0;
+    bool inGroup = false;
+    for (uint32_t i = 0; i < count; ++i) {
+        auto& cmd = m_renderCommands[m_drawKeys[i].index];
+        cmd.gpuCulled = false;
+        if (cmd.type == MaterialType::Skybox || cmd.type == MaterialType::SkySphere) { inGroup = false; continue; }
+
+        const Material* material = (cmd.type == MaterialType::PBR && m_bindless) ? nullptr : cmd.material;
+        const VertexFormat format = cmd.mesh->getVertexFormat();
+        const bool sameState = inGroup && cmd.type == lastType && format == lastFormat && material == lastMaterial && cmd.mesh->getIndexType() == lastIndexType;
+        const bool eligible = !cmd.clustered && !DrawSort::isTranslucent(m_drawKeys[i].key) && (sameState || m_gpuDrawGroups.size() < MAX_GPU_DRAW_GROUPS);
+        if (!eligible) {
+            inGroup = false;
+            if (frustumCulling && !cmd.clustered) {
+                m_stats.commandsTested++;
+                cmd.visible = m_frustum.intersects(cmd.worldBounds);
+                if (!cmd.visible) m_stats.commandsCulled++;
+            }
+            continue;
+        }
+
+        if (!sameState) {
+            m_gpuDrawGroups.push_back({ i, i, static_cast<uint32_t>(m_gpuDrawTemplates.size()), 0 });
+            lastType = cmd.type;
+            lastFormat = format;
+            lastMaterial = material;
+            lastIndexType = cmd.mesh->getIndexType();
+            lastMesh = nullptr;
+            inGroup = true;
+        }
+        auto& group = m_gpuDrawGroups.back();
+        if (cmd.mesh != lastMesh || cmd.lod != lastLod) {
+            const auto& lods = cmd.mesh->getLODs();
+            const MeshLOD& level = lods[std::min<size_t>(cmd.lod, lods.size() - 1)];
+            GpuDrawTemplate draw;
+            draw.indexCount = level.indexCount;
+            draw.firstIndex = cmd.mesh->getFirstIndex() + level.firstIndex;
+            draw.vertexOffset = cmd.mesh->getVertexOffset();
+            draw.firstInstance = i;
+            draw.group = static_cast<uint32_t>(m_gpuDrawGroups.size() - 1);
+            draw.groupFirstDraw = group.firstDraw;
+            m_gpuDrawTemplates.push_back(draw);
+            group.drawCount++;
+            lastMesh = cmd.mesh;
+            lastLod = cmd.lod;
+        }
+        m_gpuCullInstances.push_back({ cmd.worldBounds.min, static_cast<uint32_t>(m_gpuDrawTemplates.size() - 1), cmd.worldBounds.max, i });
+        group.endPosition = i + 1;
+        cmd.gpuCulled = true;
+    }
+
+    constants.instanceCount = static_cast<uint32_t>(m_gpuCullInstances.size());
+    constants.drawCount = static_cast<uint32_t>(m_gpuDrawTemplates.size());
+    m_stats.gpuInstancesTested = constants.instanceCount;
+    m_stats.gpuDrawGroups = static_cast<uint32_t>(m_gpuDrawGroups.size());
+    // outputBase and the upload wait for the frame's buffers (uploadInstanceData)
+}
+
+void Renderer::cullInstancesOnGpu(vk::CommandBuffer cb) {
+    const auto& constants = m_gpuCullConstants;
+    const vk::Buffer counters = m_gpuCounterBuffers[m_currentFrame]->getHandle();
+    cb.fillBuffer(counters, 0, VK_WHOLE_SIZE, 0);
+    if (constants.drawCount > 0) cb.fillBuffer(m_drawCountBuffers[m_currentFrame]->getHandle(), 0, sizeof(uint32_t) * constants.drawCount, 0);
+    vk::MemoryBarrier clearBarrier(vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite);
+    cb.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eComputeShader, {}, clearBarrier, nullptr, nullptr);
+
+    if (constants.instanceCount > 0) {
+        // Pass 1: frustum test and compaction of the visible instances
+        m_cullPipeline->bind(cb);
+        cb.bindDescriptorSets(vk::PipelineBindPoint::eCompute, m_cullPipeline->getLayout(), 0, 1, &m_cullDescriptorSets[m_currentFrame], 0, nullptr);
+        cb.pushConstants(m_cullPipeline->getLayout(), vk::ShaderStageFlagBits::eCompute, 0, sizeof(GpuCullPushConstants), &constants);
+        m_cullPipeline->dispatch(cb, (constants.instanceCount + 63) / 64);
+
+        vk::MemoryBarrier cullBarrier(vk::AccessFlagBits::eShaderWrite, vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite);
+        cb.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eComputeShader, {}, cullBarrier, nullptr, nullptr);
+
+        // Pass 2: one command per batch with visible instances, packed per group (same layout and push constants)
+        m_compactPipeline->bind(cb);
+        cb.bindDescriptorSets(vk::PipelineBindPoint::eCompute, m_compactPipeline->getLayout(), 0, 1, &m_cullDescriptorSets[m_currentFrame], 0, nullptr);
+        cb.pushConstants(m_compactPipeline->getLayout(), vk::ShaderStageFlagBits::eCompute, 0, sizeof(GpuCullPushConstants), &constants);
+        m_compactPipeline->dispatch(cb, (constants.drawCount + 63) / 64);
+    }
+
+    vk::MemoryBarrier drawBarrier(vk::AccessFlagBits::eShaderWrite | vk::AccessFlagBits::eTransferWrite,
+                                  vk::AccessFlagBits::eIndirectCommandRead | vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eHostRead);
+    cb.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader | vk::PipelineStageFlagBits::eTransfer,
+                       vk::PipelineStageFlagBits::eDrawIndirect | vk::PipelineStageFlagBits::eVertexShader | vk::PipelineStageFlagBits::eHost,
+                       {}, drawBarrier, nullptr, nullptr);
+}
+
+void Renderer::sortRenderCommands(const Camera* camera) {
+    BB_PROFILE_SCOPE("Renderer::sortRenderCommands");
+    const glm::vec3 camPos = camera ? camera->getPosition() : glm::vec3(0.0f);
+    const float invFar = camera ? 1.0f / camera->getFarPlane() : 0.0f;
+
+    // Compact IDs in order of appearance: only equality matters for batching.
+    // Past 16 bits they alias, which only splits batches (the draw loops compare the pointers).
+    m_sortIds.clear();
+    auto sortId = [this](const void* object) {
+        return m_sortIds.try_emplace(object, static_cast<uint32_t>(m_sortIds.size())).first->second;
+    };
+
+    // Bindless PBR materials do not break batches: same mesh first, whatever the material
+    const bool bindlessPBR = m_bindless != nullptr;
+    m_drawKeys.resize(m_renderCommands.size());
+    for (uint32_t i = 0; i < (uint32_t)m_renderCommands.size(); ++i) {
+        const auto& cmd = m_renderCommands[i];
+        DrawSort::KeyFields fields;
+        fields.type = static_cast<uint32_t>(cmd.type);
+        fields.format = static_cast<uint32_t>(cmd.mesh->getVertexFormat());
+        fields.material = (bindlessPBR && cmd.type == MaterialType::PBR) ? 0 : sortId(cmd.material);
+        fields.mesh = sortId(cmd.mesh);
+        fields.lod = cmd.lod;
+        fields.hidden = !cmd.visible;
+        fields.translucent = cmd.material->getAlphaMode() == AlphaMode::Blend;
+        if (camera) {
+            const glm::vec3 center = glm::vec3(cmd.transform * glm::vec4(cmd.mesh->getBounds().center(), 1.0f));
+            fields.depth = glm::distance(center, camPos) * invFar;
+        }
+        m_drawKeys[i] = { DrawSort::makeKey(fields), i };
+    }
+    DrawSort::radixSort(m_drawKeys, m_drawKeyScratch);
+}
+
 void Renderer::prepareRenderData(Scene& scene) {
+    BB_PROFILE_SCOPE("Renderer::prepareRenderData");
     std::lock_guard<std::mutex> lock(m_commandMutex);
     m_renderCommands.clear();
+    m_drawKeys.clear();
     m_instanceTransforms.clear();
+    m_stats = {};
 
-    // 1. Collect MeshComponent commands
-    auto meshView = scene.getRegistry().view<MeshComponent, TransformComponent>();
-    for (auto entity : meshView) {
-        auto& meshComp = meshView.get<MeshComponent>(entity);
-        if (!meshComp.mesh || !meshComp.visible) continue;
-        
-        RenderCommand cmd;
-        auto mat = meshComp.mesh->getMaterial();
-        if (!mat) mat = m_fallbackMaterial;
-        
-        cmd.type = mat->getType();
-        cmd.material = mat.get();
-        cmd.mesh = meshComp.mesh.get();
-        cmd.transform = meshView.get<TransformComponent>(entity).getTransform();
-        cmd.castShadows = meshComp.castShadows;
-        
-        m_renderCommands.push_back(cmd);
+    Camera* activeCamera = nullptr;
+    auto camView = scene.getRegistry().view<CameraComponent>();
+    for (auto entity : camView) {
+        auto& camComp = camView.get<CameraComponent>(entity);
+        if (camComp.active && camComp.camera) {
+            activeCamera = camComp.camera.get();
+            break;
+        }
     }
 
-    // 2. Collect ModelComponent commands
-    auto modelView = scene.getRegistry().view<ModelComponent, TransformComponent>();
-    for (auto entity : modelView) {
-        auto& modelComp = modelView.get<ModelComponent>(entity);
-        if (!modelComp.model || !modelComp.visible) continue;
-        
-        glm::mat4 baseTransform = modelView.get<TransformComponent>(entity).getTransform();
-        glm::mat4 modelTransform = glm::translate(baseTransform, modelComp.offset);
-        
-        for (const auto& mesh : modelComp.model->getMeshes()) {
-            if (!mesh->isVisible()) continue;
-            
-            RenderCommand cmd;
-            auto mat = mesh->getMaterial();
-            if (!mat) mat = m_fallbackMaterial;
-
-            cmd.type = mat->getType();
-            cmd.material = mat.get();
-            cmd.mesh = mesh.get();
-            cmd.transform = modelTransform; 
-            cmd.castShadows = modelComp.castShadows;
-            
-            m_renderCommands.push_back(cmd);
+    // LOD: projected size of the bounding sphere, scaled by the bias (each unit halves the size)
+    glm::vec3 camPos = activeCamera ? activeCamera->getPosition() : glm::vec3(0.0f);
+    float projYScale = 0.0f;
+    if (m_config.graphics.enableLOD && activeCamera) {
+        projYScale = activeCamera->getProjectionMatrix()[1][1] * std::exp2(-m_config.graphics.lodBias);
+    }
+    m_lodFrame++;
+    auto projectedSize = [&](const AABB& worldBounds) {
+        if (projYScale == 0.0f) return 1.0f;
+        return LOD::screenSize(glm::length(worldBounds.size()) * 0.5f, glm::distance(worldBounds.center(), camPos), projYScale);
+    };
+
+    // Texture streaming: on-screen height of each instance in pixels (no camera = full resolution)
+    const bool streamTextures = m_context.getTextureStreamer().isEnabled();
+    const float viewportHeight = static_cast<float>(m_renderTarget ? m_renderTarget->getExtent().height : m_swapChain->getExtent().height);
+    const float texProjYScale = activeCamera ? activeCamera->getProjectionMatrix()[1][1] : 0.0f;
+    auto screenPixels = [&](const AABB& worldBounds) {
+        if (texProjYScale == 0.0f) return viewportHeight;
+        return LOD::screenSize(glm::length(worldBounds.size()) * 0.5f, glm::distance(worldBounds.center(), camPos), texProjYScale) * viewportHeight;
+    };
+
+    // Frustum culling: off-screen shadow casters are kept (flagged) for the shadow pass, the others are dropped
+    // With GPU culling the extraction keeps everything: the compute pass tests the instances (buildGpuDraws the others)
+    const bool frustumCulling = m_config.graphics.enableFrustumCulling && activeCamera;
+    const bool cullFrustum = frustumCulling && !m_gpuCulling;
+    if (frustumCulling) m_frustum.update(activeCamera->getProjectionMatrix() * activeCamera->getViewMatrix());
+    auto keep = [&](RenderCommand& cmd, const AABB& worldBounds, ExtractChunk& chunk) {
+        cmd.worldBounds = worldBounds;
+        if (!cullFrustum) return true;
+        chunk.tested++;
+        cmd.visible = m_frustum.intersects(worldBounds);
+        if (cmd.visible) return true;
+        chunk.culled++;
+        return cmd.castShadows;
+    };
+
+    // Extraction tasks: ranges of each component storage, cut on the main thread. Storages are only read by the workers.
+    auto& registry = scene.getRegistry();
+    trackTransformCaches(registry);
+    auto& meshCaches = registry.storage<MeshTransformCache>();
+    auto& modelCaches = registry.storage<ModelTransformCache>();
+    auto& meshes = registry.storage<MeshComponent>();
+    auto& models = registry.storage<ModelComponent>();
+    auto& transforms = registry.storage<TransformComponent>();
+    m_extractTasks.clear();
+    auto addRanges = [&](ExtractTask task, uint32_t count, uint32_t perTask) {
+        for (uint32_t begin = 0; begin < count; begin += perTask) {
+            task.begin = begin;
+            task.end = (std::min)(begin + perTask, count);
+            m_extractTasks.push_back(task);
+        }
+    };
+    addRanges({ ExtractSource::Meshes }, static_cast<uint32_t>(meshes.size()), ENTITIES_PER_EXTRACT_TASK);
+    addRanges({ ExtractSource::Models }, static_cast<uint32_t>(models.size()), MODELS_PER_EXTRACT_TASK);
+
+    // Particle systems: one stream range per visible emitter, written after the fence (uploadParticles)
+    prepareParticles(scene, frustumCulling, viewportHeight);
+
+    const bool debugColliders = m_debugPhysicsEnabled && m_highlightCube && m_debugColliderMat;
+    auto& colliders = registry.storage<PhysicsComponent>();
+    if (debugColliders) addRanges({ ExtractSource::Colliders }, static_cast<uint32_t>(colliders.size()), ENTITIES_PER_EXTRACT_TASK);
+
+    if (m_extractChunks.size() < m_extractTasks.size()) m_extractChunks.resize(m_extractTasks.size());
+
+    auto extract = [&](uint32_t taskIndex, uint32_t) {
+        const ExtractTask& task = m_extractTasks[taskIndex];
+        ExtractChunk& chunk = m_extractChunks[taskIndex];
+        chunk.commands.clear();
+        chunk.lodRequests.clear();
+        chunk.tested = chunk.culled = chunk.transformsUpdated = 0;
+
+        switch (task.source) {
+        case ExtractSource::Meshes:
+            // 1. MeshComponent commands
+            for (uint32_t i = task.begin; i < task.end; ++i) {
+                const entt::entity entity = meshes.data()[i];
+                auto& meshComp = meshes.get(entity);
+                if (!meshComp.mesh || !meshComp.visible || !transforms.contains(entity) || !meshCaches.contains(entity)) continue;
+
+                // Static entities reuse their cached world matrix and bounds
+                auto& cache = meshCaches.get(entity);
+                const auto& tf = transforms.get(entity);
+                if (cache.refresh(tf.translation, tf.rotation, tf.scale, glm::vec3(0.0f), meshComp.mesh.get(), meshComp.mesh->getBounds())) chunk.transformsUpdated++;
+
+                RenderCommand cmd;
+                auto mat = meshComp.mesh->getMaterial();
+                if (!mat) mat = m_fallbackMaterial;
+
+                cmd.type = mat->getType();
+                cmd.material = mat.get();
+                cmd.mesh = meshComp.mesh.get();
+                cmd.transform = cache.world;
+                cmd.castShadows = meshComp.castShadows;
+                cmd.color = InstanceData::packColor(glm::vec4(meshComp.color, 1.0f));
+                const AABB& worldBounds = cache.worldBounds;
+                if (streamTextures) mat->requestTextureResolution(screenPixels(worldBounds));
+                if (!keep(cmd, worldBounds, chunk)) continue;
+                if (projYScale != 0.0f && cmd.mesh->getLODCount() > 1) {
+                    uint64_t key = (static_cast<uint64_t>(entity) << 32) | 0xFFFFFFFFu;
+                    chunk.lodRequests.push_back({ static_cast<uint32_t>(chunk.commands.size()), key, projectedSize(worldBounds) });
+                }
+                chunk.commands.push_back(cmd);
+            }
+            break;
+
+        case ExtractSource::Models:
+            // 2. ModelComponent commands
+            for (uint32_t i = task.begin; i < task.end; ++i) {
+                const entt::entity entity = models.data()[i];
+                auto& modelComp = models.get(entity);
+                if (!modelComp.model || !modelComp.visible || !transforms.contains(entity) || !modelCaches.contains(entity)) continue;
+
+                const auto& modelMeshes = modelComp.model->getMeshes();
+                auto& cache = modelCaches.get(entity);
+                const auto& tf = transforms.get(entity);
+                bool worldChanged = cache.refresh(tf.translation, tf.rotation, tf.scale, modelComp.offset, modelComp.model.get(), modelComp.model->getBounds());
+                if (worldChanged) chunk.transformsUpdated++;
+                // Each mesh is checked on its own: one can be rebuilt without changing the model bounds
+                worldChanged |= cache.resizeParts(modelMeshes.size());
+                for (size_t m = 0; m < modelMeshes.size(); ++m) cache.refreshPart(m, modelMeshes[m]->getBounds(), worldChanged);
+                const glm::mat4& modelTransform = cache.world;
+                // One projected size for the whole model, so that all its meshes switch together
+                const AABB& modelBounds = cache.worldBounds;
+                const float modelSize = projectedSize(modelBounds);
+                const float modelPixels = streamTextures ? screenPixels(modelBounds) : 0.0f;
+
+                for (uint32_t meshIdx = 0; meshIdx < static_cast<uint32_t>(modelMeshes.size()); ++meshIdx) {
+                    const auto& mesh = modelMeshes[meshIdx];
+                    if (!mesh->isVisible()) continue;
+
+                    RenderCommand cmd;
+                    auto mat = mesh->getMaterial();
+                    if (!mat) mat = m_fallbackMaterial;
+
+                    cmd.type = mat->getType();
+                    cmd.material = mat.get();
+                    cmd.mesh = mesh.get();
+                    cmd.transform = modelTransform;
+                    cmd.castShadows = modelComp.castShadows;
+                    if (streamTextures) mat->requestTextureResolution(modelPixels);
+                    if (!keep(cmd, cache.partBounds[meshIdx], chunk)) continue;
+                    if (projYScale != 0.0f && mesh->getLODCount() > 1) {
+                        chunk.lodRequests.push_back({ static_cast<uint32_t>(chunk.commands.size()), (static_cast<uint64_t>(entity) << 32) | meshIdx, modelSize });
+                    }
+                    chunk.commands.push_back(cmd);
+                }
+            }
+            break;
+
+        case ExtractSource::Colliders:
+            // 4. Physics debug colliders
+            for (uint32_t i = task.begin; i < task.end; ++i) {
+                const entt::entity entity = colliders.data()[i];
+                if (!transforms.contains(entity)) continue;
+                auto& phys = colliders.get(entity);
+                auto& tf = transforms.get(entity);
+                glm::vec3 colliderScale(1.0f);
+                if (phys.colliderType == ColliderType::Box) colliderScale = phys.boxHalfExtents * tf.scale * 2.0f;
+                else if (phys.colliderType == ColliderType::Sphere) {
+                    float maxS = glm::max(tf.scale.x, glm::max(tf.scale.y, tf.scale.z));
+                    colliderScale = glm::vec3(phys.radius * maxS * 2.0f);
+                } else if (phys.colliderType == ColliderType::Capsule) {
+                    float rScaled = phys.radius * glm::max(tf.scale.x, tf.scale.z) * 2.0f;
+                    colliderScale = glm::vec3(rScaled, phys.height * tf.scale.y, rScaled);
+                } else colliderScale = tf.scale;
+
+                glm::mat4 model = glm::translate(glm::mat4(1.0f), tf.translation) * glm::toMat4(glm::quat(tf.rotation)) * glm::scale(glm::mat4(1.0f), colliderScale);
+                RenderCommand cmd{ MaterialType::Highlight, m_debugColliderMat.get(), m_highlightCube.get(), model, false };
+                if (keep(cmd, cmd.mesh->getBounds().transform(model), chunk)) chunk.commands.push_back(cmd);
+            }
+            break;
+        }
+    };
+
+    const uint32_t taskCount = static_cast<uint32_t>(m_extractTasks.size());
+    const bool parallel = taskCount > 1 && m_jobSystem.getThreadCount() > 0;
+    if (parallel) {
+        m_jobSystem.dispatch(taskCount, 1, extract);
+    } else {
+        for (uint32_t i = 0; i < taskCount; ++i) extract(i, 1);
+    }
+
+    // Merge: offsets of the chunks (exclusive scan of their sizes), then one copy per chunk
+    m_extractOffsets.resize(taskCount + 1);
+    m_extractOffsets[0] = 0;
+    for (uint32_t i = 0; i < taskCount; ++i) {
+        const ExtractChunk& chunk = m_extractChunks[i];
+        m_extractOffsets[i + 1] = m_extractOffsets[i] + static_cast<uint32_t>(chunk.commands.size());
+        m_stats.commandsTested += chunk.tested;
+        m_stats.commandsCulled += chunk.culled;
+        m_stats.transformsUpdated += chunk.transformsUpdated;
+    }
+    m_renderCommands.resize(m_extractOffsets[taskCount]);
+    auto merge = [&](uint32_t taskIndex, uint32_t) {
+        const auto& commands = m_extractChunks[taskIndex].commands;
+        std::copy(commands.begin(), commands.end(), m_renderCommands.begin() + m_extractOffsets[taskIndex]);
+    };
+    if (parallel && m_renderCommands.size() > MIN_PARALLEL_MERGE) {
+        m_jobSystem.dispatch(taskCount, 1, merge);
+    } else {
+        for (uint32_t i = 0; i < taskCount; ++i) merge(i, 1);
+    }
+
+    // LOD hysteresis states are shared between instances: selected here, on the calling thread
+    for (uint32_t i = 0; i < taskCount; ++i) {
+        for (const auto& request : m_extractChunks[i].lodRequests) {
+            auto& cmd = m_renderCommands[m_extractOffsets[i] + request.command];
+            cmd.lod = selectLOD(request.key, *cmd.mesh, request.screenSize);
+        }
+    }
+
+    auto addOverlay = [&](Material* mat, const glm::mat4& transform) {
+        RenderCommand cmd{ MaterialType::Highlight, mat, m_highlightCube.get(), transform, false };
+        ExtractChunk counters;
+        if (keep(cmd, cmd.mesh->getBounds().transform(transform), counters)) m_renderCommands.push_back(cmd);
+        m_stats.commandsTested += counters.tested;
+        m_stats.commandsCulled += counters.culled;
+    };
+    if (m_highlightActive && m_highlightCube && m_highlightMat) addOverlay(m_highlightMat.get(), m_highlightTransform);
+    if (m_hoveredActive && m_highlightCube && m_hoveredMat) addOverlay(m_hoveredMat.get(), m_hoveredTransform);
+
+    // Forget the LOD history of instances that have not been drawn for a while
+    if ((m_lodFrame & 255u) == 0) {
+        std::erase_if(m_lodStates, [&](const auto& entry) { return m_lodFrame - entry.second.lastFrame > 256u; });
+    }
+
+    sortRenderCommands(activeCamera);
+
+    // Draw positions past the budget are dropped (the last ones in draw order)
+    bool firstOverflow = false;
+    m_instanceCount = m_instanceBudget.admit(static_cast<uint32_t>(m_drawKeys.size()), firstOverflow);
+    m_stats.instancesUploaded = m_instanceCount;
+    m_stats.instancesOverBudget = static_cast<uint32_t>(m_drawKeys.size()) - m_instanceCount;
+    if (firstOverflow) {
+        BB_CORE_WARN("Renderer: {} instances exceed the instance budget of {}, the last {} in draw order are skipped.",
+            m_drawKeys.size(), m_instanceBudget.getBudget(), m_stats.instancesOverBudget);
+    }
+
+    if (m_config.graphics.enableClusterCulling && activeCamera) {
+        cullClusters(activeCamera->getProjectionMatrix() * activeCamera->getViewMatrix(), camPos);
+    }
+
+    if (m_gpuCulling) buildGpuDraws(frustumCulling);
+
+    m_stats.renderCommands = static_cast<uint32_t>(m_renderCommands.size());
+    m_stats.trianglesSubmitted = m_stats.clusters.trianglesVisible;
+    for (const auto& cmd : m_renderCommands) {
+        if (!cmd.visible) continue;
+        if (!cmd.gpuCulled) m_stats.commandsDrawn++;
+        if (cmd.clustered) continue;
+        const auto& lods = cmd.mesh->getLODs();
+        const MeshLOD& level = lods[std::min<size_t>(cmd.lod, lods.size() - 1)];
+        m_stats.trianglesSubmitted += level.indexCount / 3;
+        m_stats.trianglesSavedByLOD += (lods[0].indexCount - level.indexCount) / 3;
+    }
+}
+
+void Renderer::uploadInstanceData() {
+    // Records go straight from the commands to their sorted slot in the instance buffer
+    auto* instanceData = static_cast<InstanceData*>(m_instanceBuffers[m_currentFrame]->getMappedData());
+    Material* lastMaterial = nullptr;
+    uint32_t lastIndex = 0;
+    for (uint32_t i = 0; i < m_instanceCount; ++i) {
+        const auto& cmd = m_renderCommands[m_drawKeys[i].index];
+        uint32_t materialIndex = 0;
+        if (m_bindless && cmd.type == MaterialType::PBR && cmd.visible) {
+            if (cmd.material != lastMaterial) {
+                lastMaterial = cmd.material;
+                lastIndex = static_cast<PBRMaterial*>(cmd.material)->getBindlessIndex(m_bindless);
+            }
+            materialIndex = lastIndex;
         }
+        instanceData[i] = InstanceData::pack(cmd.transform, materialIndex, cmd.color);
     }
 
-    // 3. Collect ParticleSystem
+    if (m_gpuCulling) {
+        auto& constants = m_gpuCullConstants;
+        constants.outputBase = m_instanceCapacities[m_currentFrame];
+        if (constants.instanceCount > 0) {
+            std::memcpy(m_cullInstanceBuffers[m_currentFrame]->getMappedData(), m_gpuCullInstances.data(), m_gpuCullInstances.size() * sizeof(GpuCullInstance));
+            std::memcpy(m_drawTemplateBuffers[m_currentFrame]->getMappedData(), m_gpuDrawTemplates.data(), m_gpuDrawTemplates.size() * sizeof(GpuDrawTemplate));
+        }
+    }
+
+    if (!m_clusterDraws.empty()) {
+        m_clusterDrawBuffers[m_currentFrame]->update(m_clusterDraws.data(), m_clusterDraws.size() * sizeof(IndexedDrawCommand));
+    }
+}
+
+void Renderer::prepareParticles(Scene& scene, bool frustumCulling, float viewportHeight) {
+    m_particleDraws.clear();
+    m_particleCount = 0;
+    const bool streamTextures = m_context.getTextureStreamer().isEnabled();
     auto particleView = scene.getRegistry().view<ParticleSystemComponent>();
     for (entt::entity entity : particleView) {
         auto& particleSys = particleView.get<ParticleSystemComponent>(entity);
+        const ParticlePool& pool = particleSys.pool;
+        if (pool.getAliveCount() == 0) continue;
+        if (frustumCulling && !m_frustum.intersects(pool.getBounds())) continue;
+
+        // The stream pipelines exist for the additive particle materials only
         Material* mat = particleSys.material ? particleSys.material.get() : m_defaultParticleMat.get();
-        Mesh* mesh = particleSys.mesh ? particleSys.mesh.get() : m_particleQuad.get(); 
+        if (!m_particlePipelines.contains(mat->getType())) mat = m_defaultParticleMat.get();
+        Mesh* mesh = particleSys.mesh ? particleSys.mesh.get() : m_particleQuad.get();
         if (!mesh) mesh = m_highlightCube.get();
 
         if (mat->getType() == MaterialType::Plasma) {
             static_cast<PlasmaMaterial*>(mat)->setTime((float)SDL_GetTicks() / 1000.0f);
         }
+        if (streamTextures) mat->requestTextureResolution(viewportHeight);
 
-        for (const auto& p : particleSys.particlePool) {
-            if (p.lifeRemaining <= 0.0f) continue;
-            float t = 1.0f - (p.lifeRemaining / p.lifeTime);
-            float currentSize = p.sizeBegin + (p.sizeEnd - p.sizeBegin) * t;
-            glm::mat4 pt = glm::translate(glm::mat4(1.0f), p.position);
-            pt = glm::scale(pt, glm::vec3(currentSize));
-            m_renderCommands.push_back({ mat->getType(), mat, mesh, pt, false });
-        }
-    }
-    
-    if (m_highlightActive && m_highlightCube && m_highlightMat) {
-        m_renderCommands.push_back({ MaterialType::Highlight, m_highlightMat.get(), m_highlightCube.get(), m_highlightTransform, false });
-    }
-    if (m_hoveredActive && m_highlightCube && m_hoveredMat) {
-        m_renderCommands.push_back({ MaterialType::Highlight, m_hoveredMat.get(), m_highlightCube.get(), m_hoveredTransform, false });
-    }
-
-    if (m_debugPhysicsEnabled && m_highlightCube && m_debugColliderMat) {
-        auto physView = scene.getRegistry().view<PhysicsComponent, TransformComponent>();
-        for (auto entity : physView) {
-            auto& phys = physView.get<PhysicsComponent>(entity);
-            auto& tf = physView.get<TransformComponent>(entity);
-            glm::vec3 colliderScale(1.0f);
-            if (phys.colliderType == ColliderType::Box) colliderScale = phys.boxHalfExtents * tf.scale * 2.0f;
-            else if (phys.colliderType == ColliderType::Sphere) {
-                float maxS = glm::max(tf.scale.x, glm::max(tf.scale.y, tf.scale.z));
-                colliderScale = glm::vec3(phys.radius * maxS * 2.0f);
-            } else if (phys.colliderType == ColliderType::Capsule) {
-                float rScaled = phys.radius * glm::max(tf.scale.x, tf.scale.z) * 2.0f;
-                colliderScale = glm::vec3(rScaled, phys.height * tf.scale.y, rScaled);
-            } else colliderScale = tf.scale;
-
-            glm::mat4 model = glm::translate(glm::mat4(1.0f), tf.translation) * glm::toMat4(glm::quat(tf.rotation)) * glm::scale(glm::mat4(1.0f), colliderScale);
-            m_renderCommands.push_back({ MaterialType::Highlight, m_debugColliderMat.get(), m_highlightCube.get(), model, false });
-        }
+        m_particleDraws.push_back({ &pool, mat, mesh, m_particleCount, pool.getAliveCount() });
+        m_particleCount += pool.getAliveCount();
     }
+    m_stats.particleEmitters = static_cast<uint32_t>(m_particleDraws.size());
+    m_stats.particlesDrawn = m_particleCount;
+}
 
-    std::ranges::sort(m_renderCommands, [](const RenderCommand& a, const RenderCommand& b) {
-        if (a.type != b.type) return a.type < b.type;
-        if (a.material != b.material) return a.material < b.material;
-        return a.mesh < b.mesh;
-    });
-
-    void* mappedData = m_instanceBuffers[m_currentFrame]->getMappedData();
-    uint32_t count = (std::min)((uint32_t)m_renderCommands.size(), MAX_INSTANCES);
-    for (uint32_t i = 0; i < count; ++i) {
-        void* dst = static_cast<char*>(mappedData) + (i * sizeof(glm::mat4));
-        memcpy(dst, &m_renderCommands[i].transform, sizeof(glm::mat4));
+void Renderer::uploadParticles() {
+    if (m_particleCount == 0) return;
+    // Fixed-size chunks of every emitter, written in parallel straight into the mapped stream
+    auto* stream = static_cast<ParticleInstance*>(m_particleBuffers[m_currentFrame]->getMappedData());
+    m_particleChunks.clear();
+    for (uint32_t d = 0; d < static_cast<uint32_t>(m_particleDraws.size()); ++d) {
+        for (uint32_t begin = 0; begin < m_particleDraws[d].count; begin += ParticlePool::CHUNK_SIZE) m_particleChunks.push_back({ d, begin });
+    }
+    auto write = [&](uint32_t c, uint32_t) {
+        const ParticleDraw& draw = m_particleDraws[m_particleChunks[c].x];
+        const uint32_t begin = m_particleChunks[c].y;
+        draw.pool->writeInstances(stream + draw.firstInstance + begin, begin, std::min(begin + ParticlePool::CHUNK_SIZE, draw.count));
+    };
+    if (m_particleChunks.size() > 1) {
+        m_jobSystem.dispatch(static_cast<uint32_t>(m_particleChunks.size()), 1, write);
+    } else {
+        write(0, 0);
     }
 }
 
-void Renderer::renderShadows(vk::CommandBuffer cb, Scene& scene, GlobalUBO& uboData) {
-    if (!m_shadowsEnabledRuntime || uboData.globalParams.x == 0) return;
+bool Renderer::prepareShadows(Scene& scene, GlobalUBO& uboData) {
+    if (!m_shadowsEnabledRuntime || uboData.globalParams.x == 0) return false;
 
-    if (uboData.lights[0].position.w >= 0.5f) return; // Not directional
+    if (uboData.lights[0].position.w >= 0.5f) return false; // Not directional
     glm::vec3 lightDir = glm::normalize(glm::vec3(uboData.lights[0].direction));
 
     Camera* activeCamera = nullptr;
     auto camView = scene.getRegistry().view<CameraComponent>();
     for (auto entity : camView) { if (camView.get<CameraComponent>(entity).active) { activeCamera = camView.get<CameraComponent>(entity).camera.get(); break; } }
-    if (!activeCamera) return;
+    if (!activeCamera) return false;
 
+    const uint32_t cascades = std::min(m_config.graphics.shadowCascades, MAX_SHADOW_CASCADES);
+    const uint32_t resolution = m_config.graphics.shadowMapResolution;
     float nearZ = activeCamera->getNearPlane();
     float farZ = activeCamera->getFarPlane();
-    auto splits = ShadowCascade::calculateSplitDistances(m_config.graphics.shadowCascades, nearZ, farZ, 0.5f);
+    auto splits = ShadowCascade::calculateSplitDistances(cascades, nearZ, farZ, 0.5f);
     
     glm::mat4 camProj = activeCamera->getProjectionMatrix();
     glm::mat4 camViewMat = activeCamera->getViewMatrix();
 
-    // Transition Depth Array to Attachment
+    std::array<glm::mat4, MAX_SHADOW_CASCADES> lightVPs;
+    for (uint32_t i = 0; i < cascades; ++i) {
+        float minZ = (i == 0) ? nearZ : splits[i-1];
+        float maxZ = splits[i];
+        uboData.shadowSplitDepths[i] = maxZ;
+        lightVPs[i] = ShadowCascade::calculateLightSpaceMatrix(camProj, camViewMat, lightDir, minZ, maxZ, resolution);
+    }
+
+    // Casters of each cascade (draw positions), culled against the cascade volume extruded toward the light
+    const uint32_t drawCount = m_instanceCount;
+    m_shadowCasters.resize(cascades);
+    std::array<uint32_t, MAX_SHADOW_CASCADES> culledPerCascade{};
+    auto collectCasters = [&](uint32_t c) {
+        auto& casters = m_shadowCasters[c];
+        casters.clear();
+        uint32_t culled = 0;
+        for (uint32_t i = 0; i < drawCount; ++i) {
+            const auto& cmd = m_renderCommands[m_drawKeys[i].index];
+            if (!cmd.castShadows) continue;
+            if (ShadowCascade::isCasterVisible(lightVPs[c], cmd.worldBounds)) casters.push_back(i);
+            else culled++;
+        }
+        culledPerCascade[c] = culled;
+    };
+    if (cascades > 1 && m_jobSystem.getThreadCount() > 0) {
+        m_jobSystem.dispatch(cascades, 1, [&](uint32_t c, uint32_t) { collectCasters(c); });
+    } else {
+        for (uint32_t c = 0; c < cascades; ++c) collectCasters(c);
+    }
+
+    // Far cascades are kept while their matrix (texel-snapped) and their casters are unchanged
+    const uint32_t cachedCascades = std::min(m_config.graphics.shadowCachedCascades, cascades);
+    m_shadowCascadeStates.resize(cascades);
+    std::array<bool, MAX_SHADOW_CASCADES> reuse{};
+    bool anyReused = false;
+    m_stats.shadowCasters = 0;
+    m_stats.shadowCastersCulled = 0;
+    m_stats.shadowCascadesCached = 0;
+    for (uint32_t i = 0; i < cascades; ++i) {
+        m_stats.shadowCastersCulled += culledPerCascade[i];
+        auto& state = m_shadowCascadeStates[i];
+        if (i < cascades - cachedCascades) {
+            state.valid = false;
+        } else {
+            // Summed per caster: the draw order changes with the camera, the layer content does not
+            uint64_t signature = m_shadowCasters[i].size();
+            for (uint32_t pos : m_shadowCasters[i]) {
+                const auto& cmd = m_renderCommands[m_drawKeys[pos].index];
+                uint64_t caster = mixSignature(reinterpret_cast<uintptr_t>(cmd.mesh), (uint64_t(cmd.lod) << 32) | uint32_t(cmd.mesh->getVertexOffset()));
+                signature += mixSignature(caster, cmd.transform);
+            }
+            reuse[i] = state.valid && state.signature == signature && ShadowCascade::canReuse(state.lightViewProj, lightVPs[i], resolution);
+            if (!reuse[i]) {
+                state.lightViewProj = lightVPs[i];
+                state.signature = signature;
+                state.valid = true;
+            }
+        }
+        if (reuse[i]) {
+            // Sampled with the matrix the layer was rendered with
+            uboData.shadowCascades[i] = state.lightViewProj;
+            anyReused = true;
+            m_stats.shadowCascadesCached++;
+        } else {
+            uboData.shadowCascades[i] = lightVPs[i];
+            m_stats.shadowCasters += static_cast<uint32_t>(m_shadowCasters[i].size());
+        }
+    }
+
+    // Cascades left to render: recorded by the workers or by renderShadows
+    m_shadowCascadeCount = cascades;
+    m_shadowAnyReused = anyReused;
+    m_shadowLightVPs.assign(lightVPs.begin(), lightVPs.begin() + cascades);
+    m_shadowPasses.clear();
+    for (uint32_t i = 0; i < cascades; ++i) {
+        if (!reuse[i]) m_shadowPasses.push_back(i);
+    }
+    return true;
+}
+
+void Renderer::renderShadows(vk::CommandBuffer cb) {
+    // Transition Depth Array to Attachment (contents kept when a cached layer is reused)
     vk::ImageMemoryBarrier depthBarrier = {};
-    depthBarrier.srcAccessMask = {};
-    depthBarrier.dstAccessMask = vk::AccessFlagBits::eDepthStencilAttachmentWrite;
-    depthBarrier.oldLayout = vk::ImageLayout::eUndefined;
+    depthBarrier.srcAccessMask = m_shadowAnyReused ? vk::AccessFlagBits::eShaderRead : vk::AccessFlags{};
+    depthBarrier.dstAccessMask = vk::AccessFlagBits::eDepthStencilAttachmentRead | vk::AccessFlagBits::eDepthStencilAttachmentWrite;
+    depthBarrier.oldLayout = m_shadowAnyReused ? vk::ImageLayout::eDepthStencilReadOnlyOptimal : vk::ImageLayout::eUndefined;
     depthBarrier.newLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal;
     depthBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
     depthBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
@@ -850,78 +1836,17 @@ void Renderer::renderShadows(vk::CommandBuffer cb, Scene& scene, GlobalUBO& uboD
     depthBarrier.subresourceRange.baseMipLevel = 0;
     depthBarrier.subresourceRange.levelCount = 1;
     depthBarrier.subresourceRange.baseArrayLayer = 0;
-    depthBarrier.subresourceRange.layerCount = m_config.graphics.shadowCascades;
-
-    cb.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eEarlyFragmentTests, {}, nullptr, nullptr, depthBarrier);
-
-    vk::Extent2D shadowExtent(m_config.graphics.shadowMapResolution, m_config.graphics.shadowMapResolution);
-    cb.setViewport(0, vk::Viewport(0, 0, (float)shadowExtent.width, (float)shadowExtent.height, 0, 1));
-    cb.setScissor(0, vk::Rect2D({0, 0}, shadowExtent));
-    
-    auto& shadowPipeline = m_pipelines[static_cast<MaterialType>(99)];
-    cb.bindPipeline(vk::PipelineBindPoint::eGraphics, shadowPipeline->getHandle());
-    cb.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, shadowPipeline->getLayout(), 0, 1, &m_globalDescriptorSets[m_currentFrame], 0, nullptr);
-
-    // Dynamic depth bias (increased for 32-bit float depth stability)
-    cb.setDepthBias(m_config.graphics.shadowDepthBiasConstant, 0.0f, m_config.graphics.shadowDepthBiasSlope);
-
-    for (uint32_t i = 0; i < m_config.graphics.shadowCascades; ++i) {
-        float minZ = (i == 0) ? nearZ : splits[i-1];
-        float maxZ = splits[i];
-
-        uboData.shadowSplitDepths[i] = maxZ; 
-        glm::mat4 lightVP = ShadowCascade::calculateLightSpaceMatrix(camProj, camViewMat, lightDir, minZ, maxZ, m_config.graphics.shadowMapResolution);
-        uboData.shadowCascades[i] = lightVP;
-
-        vk::RenderingAttachmentInfo depthAttr = {};
-        depthAttr.imageView = m_shadowCascadeViews[i];
-        depthAttr.imageLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal;
-        depthAttr.loadOp = vk::AttachmentLoadOp::eClear;
-        depthAttr.storeOp = vk::AttachmentStoreOp::eStore;
-        depthAttr.clearValue = vk::ClearValue(vk::ClearDepthStencilValue(1.0f, 0));
-
-        vk::RenderingInfo renderInfo = {};
-        renderInfo.renderArea = vk::Rect2D({0, 0}, shadowExtent);
-        renderInfo.layerCount = 1;
-        renderInfo.pDepthAttachment = &depthAttr;
-
-        cb.setViewport(0, vk::Viewport(0, 0, (float)shadowExtent.width, (float)shadowExtent.height, 0, 1));
-        cb.setScissor(0, vk::Rect2D({0, 0}, shadowExtent));
-
-        cb.beginRendering(renderInfo);
-        
-        cb.pushConstants(shadowPipeline->getLayout(), vk::ShaderStageFlagBits::eVertex, 0, sizeof(glm::mat4), &lightVP);
+    depthBarrier.subresourceRange.layerCount = m_shadowCascadeCount;
 
-        // OPTIMIZED: Use prepared commands with instancing!
-        Mesh* lastMesh = nullptr;
-        uint32_t batchStart = 0;
-        uint32_t batchCount = 0;
+    cb.pipelineBarrier(m_shadowAnyReused ? vk::PipelineStageFlagBits::eFragmentShader : vk::PipelineStageFlagBits::eTopOfPipe,
+                       vk::PipelineStageFlagBits::eEarlyFragmentTests | vk::PipelineStageFlagBits::eLateFragmentTests,
+                       {}, nullptr, nullptr, depthBarrier);
 
-        auto flushShadowBatch = [&]() {
-            if (batchCount == 0) return;
-            lastMesh->draw(cb, batchCount, batchStart);
-            batchCount = 0;
-        };
-
-        for (uint32_t cmdIdx = 0; cmdIdx < (uint32_t)m_renderCommands.size(); ++cmdIdx) {
-            const auto& cmd = m_renderCommands[cmdIdx];
-            if (cmdIdx >= MAX_INSTANCES) break;
-            
-            // Skip non-shadow casters
-            if (!cmd.castShadows) {
-                flushShadowBatch();
-                continue;
-            }
-
-            if (cmd.mesh != lastMesh) {
-                flushShadowBatch();
-                lastMesh = cmd.mesh;
-                batchStart = cmdIdx;
-            }
-            batchCount++;
-        }
-        flushShadowBatch();
-        cb.endRendering();
+    if (m_recordTasks.size() > m_sceneRecordTasks) {
+        // Cascades recorded by the workers: the first tasks of recordSecondaries
+        cb.executeCommands(static_cast<uint32_t>(m_recordTasks.size()) - m_sceneRecordTasks, m_recordBuffers[m_currentFrame].data());
+    } else {
+        for (uint32_t cascade : m_shadowPasses) recordShadowCascade(cb, cascade);
     }
 
     // Transition Depth Array to Shader Read
@@ -937,11 +1862,73 @@ void Renderer::renderShadows(vk::CommandBuffer cb, Scene& scene, GlobalUBO& uboD
     depthReadBarrier.subresourceRange.baseMipLevel = 0;
     depthReadBarrier.subresourceRange.levelCount = 1;
     depthReadBarrier.subresourceRange.baseArrayLayer = 0;
-    depthReadBarrier.subresourceRange.layerCount = m_config.graphics.shadowCascades;
+    depthReadBarrier.subresourceRange.layerCount = m_shadowCascadeCount;
 
     cb.pipelineBarrier(vk::PipelineStageFlagBits::eLateFragmentTests, vk::PipelineStageFlagBits::eFragmentShader, {}, nullptr, nullptr, depthReadBarrier);
 }
 
+void Renderer::recordShadowCascade(vk::CommandBuffer cb, uint32_t cascade) {
+    const uint32_t resolution = m_config.graphics.shadowMapResolution;
+    vk::Extent2D shadowExtent(resolution, resolution);
+    auto& shadowPipeline = m_pipelines.at(static_cast<MaterialType>(99));
+
+    vk::RenderingAttachmentInfo depthAttr = {};
+    depthAttr.imageView = m_shadowCascadeViews[cascade];
+    depthAttr.imageLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal;
+    depthAttr.loadOp = vk::AttachmentLoadOp::eClear;
+    depthAttr.storeOp = vk::AttachmentStoreOp::eStore;
+    depthAttr.clearValue = vk::ClearValue(vk::ClearDepthStencilValue(1.0f, 0));
+
+    vk::RenderingInfo renderInfo = {};
+    renderInfo.renderArea = vk::Rect2D({0, 0}, shadowExtent);
+    renderInfo.layerCount = 1;
+    renderInfo.pDepthAttachment = &depthAttr;
+
+    cb.setViewport(0, vk::Viewport(0, 0, (float)shadowExtent.width, (float)shadowExtent.height, 0, 1));
+    cb.setScissor(0, vk::Rect2D({0, 0}, shadowExtent));
+    // Dynamic depth bias (increased for 32-bit float depth stability)
+    cb.setDepthBias(m_config.graphics.shadowDepthBiasConstant, 0.0f, m_config.graphics.shadowDepthBiasSlope);
+
+    cb.beginRendering(renderInfo);
+
+    shadowPipeline->bind(cb);
+    cb.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, shadowPipeline->getLayout(), 0, 1, &m_globalDescriptorSets[m_currentFrame], 0, nullptr);
+    cb.pushConstants(shadowPipeline->getLayout(), vk::ShaderStageFlagBits::eVertex, 0, sizeof(glm::mat4), &m_shadowLightVPs[cascade]);
+
+    // Instanced from the prepared commands: consecutive draw positions of the same mesh and LOD form a batch
+    VertexFormat lastFormat = VertexFormat::Full;
+    Mesh* lastMesh = nullptr;
+    uint32_t lastLod = 0;
+    uint32_t batchStart = 0;
+    uint32_t batchCount = 0;
+    GeometryBinding geometry;
+
+    auto flushShadowBatch = [&]() {
+        if (batchCount == 0) return;
+        geometry.bind(cb, *lastMesh);
+        lastMesh->drawBound(cb, batchCount, batchStart, lastLod);
+        batchCount = 0;
+    };
+
+    for (uint32_t pos : m_shadowCasters[cascade]) {
+        const auto& cmd = m_renderCommands[m_drawKeys[pos].index];
+        const bool contiguous = batchCount > 0 && pos == batchStart + batchCount;
+        if (!contiguous || cmd.mesh != lastMesh || cmd.lod != lastLod) {
+            flushShadowBatch();
+            if (cmd.mesh->getVertexFormat() != lastFormat) {
+                lastFormat = cmd.mesh->getVertexFormat();
+                shadowPipeline->bind(cb, lastFormat);
+            }
+            lastMesh = cmd.mesh;
+            lastLod = cmd.lod;
+            batchStart = pos;
+        }
+        batchCount++;
+    }
+    flushShadowBatch();
+    cb.endRendering();
+}
+
 void Renderer::createPickingResources() {
     auto dev = m_context.getDevice();
     auto allocator = m_context.getAllocator();
@@ -1027,9 +2014,10 @@ void Renderer::createPickingResources() {
     // 5. Create picking instance buffers and descriptor sets (one per frame)
     m_pickingInstanceBuffers.clear();
     m_pickingDescriptorSets.clear();
+    m_pickingCapacities.assign(MAX_FRAMES_IN_FLIGHT, INITIAL_INSTANCE_CAPACITY);
     for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
         m_pickingInstanceBuffers.push_back(CreateScope<Buffer>(m_context, 
-            MAX_INSTANCES * sizeof(glm::mat4), 
+            INITIAL_INSTANCE_CAPACITY * sizeof(InstanceData), 
             vk::BufferUsageFlagBits::eStorageBuffer, VMA_MEMORY_USAGE_CPU_TO_GPU, VMA_ALLOCATION_CREATE_MAPPED_BIT));
         
         vk::DescriptorSetAllocateInfo allocInfo(m_descriptorPool, 1, &m_globalDescriptorLayout);
@@ -1112,6 +2100,28 @@ void Renderer::renderEntityIds(Scene& scene) {
     cb.setScissor(0, vk::Rect2D({0,0}, extent));
     // BB_CORE_INFO("Renderer: Picking rendering begun");
 
+    // One instance per visible mesh: grow this frame's buffer first (its fence has been waited on)
+    uint32_t required = 0;
+    for (auto entity : scene.getRegistry().view<MeshComponent, TransformComponent>()) {
+        const auto& meshComp = scene.getRegistry().get<MeshComponent>(entity);
+        if (meshComp.mesh && meshComp.visible) required++;
+    }
+    for (auto entity : scene.getRegistry().view<ModelComponent, TransformComponent>()) {
+        const auto& modelComp = scene.getRegistry().get<ModelComponent>(entity);
+        if (!modelComp.model || !modelComp.visible) continue;
+        for (const auto& mesh : modelComp.model->getMeshes()) if (mesh->isVisible()) required++;
+    }
+    const uint32_t pickingCapacity = m_pickingCapacities[m_currentFrame];
+    if (required > pickingCapacity) {
+        const uint32_t capacity = m_instanceBudget.grow(pickingCapacity, required);
+        m_pickingInstanceBuffers[m_currentFrame] = CreateScope<Buffer>(m_context, capacity * sizeof(InstanceData),
+            vk::BufferUsageFlagBits::eStorageBuffer, VMA_MEMORY_USAGE_CPU_TO_GPU, VMA_ALLOCATION_CREATE_MAPPED_BIT);
+        vk::DescriptorBufferInfo pickingInstanceInfo(m_pickingInstanceBuffers[m_currentFrame]->getHandle(), 0, VK_WHOLE_SIZE);
+        vk::WriteDescriptorSet write(m_pickingDescriptorSets[m_currentFrame], 1, 0, 1, vk::DescriptorType::eStorageBuffer, nullptr, &pickingInstanceInfo);
+        m_context.getDevice().updateDescriptorSets(write, nullptr);
+        m_pickingCapacities[m_currentFrame] = capacity;
+    }
+
     m_pickingPipeline->bind(cb);
     cb.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, m_pickingPipeline->getLayout(), 0, 1,
         &m_pickingDescriptorSets[m_currentFrame], 0, nullptr);
@@ -1119,7 +2129,8 @@ void Renderer::renderEntityIds(Scene& scene) {
 
     // Draw all mesh entities with their entityID as push constant
     uint32_t instanceOffset = 0;
-    void* mappedInstanceData = m_pickingInstanceBuffers[m_currentFrame]->getMappedData();
+    GeometryBinding geometry;
+    auto* mappedInstanceData = static_cast<InstanceData*>(m_pickingInstanceBuffers[m_currentFrame]->getMappedData());
     auto meshView = scene.getRegistry().view<MeshComponent, TransformComponent>();
     for (auto entity : meshView) {
         auto& meshComp = meshView.get<MeshComponent>(entity);
@@ -1127,14 +2138,15 @@ void Renderer::renderEntityIds(Scene& scene) {
         glm::mat4 transform = meshView.get<TransformComponent>(entity).getTransform();
         
         // Write transform to dedicated picking instance SSBO
-        if (instanceOffset >= MAX_INSTANCES) break;
-        void* data = static_cast<char*>(mappedInstanceData) + (instanceOffset * sizeof(glm::mat4));
-        memcpy(data, &transform, sizeof(glm::mat4));
+        if (instanceOffset >= m_pickingCapacities[m_currentFrame]) break;
+        mappedInstanceData[instanceOffset] = InstanceData::pack(transform);
 
         uint32_t entityId = static_cast<uint32_t>(entity);
         cb.pushConstants(m_pickingPipeline->getLayout(), 
             vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment, 0, sizeof(uint32_t), &entityId);
-        meshComp.mesh->draw(cb, 1, instanceOffset);
+        m_pickingPipeline->bind(cb, meshComp.mesh->getVertexFormat());
+        geometry.bind(cb, *meshComp.mesh);
+        meshComp.mesh->drawBound(cb, 1, instanceOffset);
         instanceOffset++;
     }
     // BB_CORE_INFO("Renderer: Picking Mesh drawing done");
@@ -1153,10 +2165,11 @@ void Renderer::renderEntityIds(Scene& scene) {
 
         for (const auto& mesh : modelComp.model->getMeshes()) {
             if (!mesh->isVisible()) continue;
-            if (instanceOffset >= MAX_INSTANCES) break;
-            void* data = static_cast<char*>(mappedInstanceData) + (instanceOffset * sizeof(glm::mat4));
-            memcpy(data, &transform, sizeof(glm::mat4));
-            mesh->draw(cb, 1, instanceOffset);
+            if (instanceOffset >= m_pickingCapacities[m_currentFrame]) break;
+            mappedInstanceData[instanceOffset] = InstanceData::pack(transform);
+            m_pickingPipeline->bind(cb, mesh->getVertexFormat());
+            geometry.bind(cb, *mesh);
+            mesh->drawBound(cb, 1, instanceOffset);
             instanceOffset++;
         }
     }
@@ -1203,8 +2216,11 @@ uint32_t Renderer::readEntityIdAt(uint32_t x, uint32_t y) {
     cmd.end();
 
     vk::SubmitInfo submitInfo({}, {}, cmd, {});
-    m_context.getGraphicsQueue().submit(submitInfo, {});
-    m_context.getGraphicsQueue().waitIdle();
+    {
+        std::lock_guard<std::mutex> queueLock(m_context.getQueueMutex());
+        m_context.getGraphicsQueue().submit(submitInfo, {});
+        m_context.getGraphicsQueue().waitIdle();
+    }
 
     dev.freeCommandBuffers(m_commandPool, cmdBufs);
 
@@ -0,0 +1,52 @@
+#include "bb3d/render/RingAllocator.hpp"
+
+namespace bb3d {
+
+static uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return alignment <= 1 ? value : (value + alignment - 1) & ~(alignment - 1);
+}
+
+RingAllocator::RingAllocator(uint64_t capacity) : m_capacity(capacity) {}
+
+std::optional<RingAllocator::Allocation> RingAllocator::allocate(uint64_t size, uint64_t alignment) {
+    if (size == 0 || size > m_capacity) return std::nullopt;
+    if (m_used == 0) m_head = m_tail = 0; // Empty: restart at the beginning, the whole range is contiguous
+
+    uint64_t offset;
+    if (m_head > m_tail || m_used == 0) {
+        // Free space: [head, capacity) then [0, tail)
+        offset = alignUp(m_head, alignment);
+        if (offset + size > m_capacity) {
+            // Wrap: the end of the range is lost as padding of this block
+            if (size > m_tail) return std::nullopt;
+            offset = 0;
+        }
+    } else {
+        // Wrapped (or full when head == tail): free space is [head, tail)
+        offset = alignUp(m_head, alignment);
+        if (m_head == m_tail || offset + size > m_tail) return std::nullopt;
+    }
+
+    const uint64_t end = offset + size;
+    const uint64_t consumed = end > m_head ? end - m_head : (m_capacity - m_head) + end;
+    m_blocks.push_back({ end, consumed });
+    m_used += consumed;
+    m_head = end == m_capacity ? 0 : end;
+    return Allocation{ offset, m_firstId + m_blocks.size() - 1 };
+}
+
+void RingAllocator::release(uint64_t id) {
+    if (id < m_firstId || id >= m_firstId + m_blocks.size()) return;
+    m_blocks[id - m_firstId].released = true;
+
+    // Reclaim from the tail, in allocation order
+    while (!m_blocks.empty() && m_blocks.front().released) {
+        const Block& block = m_blocks.front();
+        m_tail = block.end == m_capacity ? 0 : block.end;
+        m_used -= block.size;
+        m_blocks.pop_front();
+        m_firstId++;
+    }
+}
+
+} // namespace bb3d
@@ -1,5 +1,7 @@
 #include "bb3d/render/Shader.hpp"
 #include "bb3d/core/Log.hpp"
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 
 namespace bb3d {
@@ -10,6 +12,17 @@ Shader::Shader(VulkanContext& context, std::string_view filepath)
 
     vk::ShaderModuleCreateInfo createInfo({}, code.size(), reinterpret_cast<const uint32_t*>(code.data()));
     m_module = m_context.getDevice().createShaderModule(createInfo);
+
+    // OpDecorate <target> SpecId <id>: lets pipelines know which constants the module actually reads
+    constexpr uint32_t OpDecorate = 71, DecorationSpecId = 1, HeaderWords = 5;
+    std::vector<uint32_t> words(code.size() / sizeof(uint32_t));
+    std::memcpy(words.data(), code.data(), words.size() * sizeof(uint32_t));
+    for (size_t i = HeaderWords; i < words.size();) {
+        const uint32_t wordCount = words[i] >> 16;
+        if (wordCount == 0 || i + wordCount > words.size()) break;
+        if ((words[i] & 0xFFFFu) == OpDecorate && wordCount >= 4 && words[i + 2] == DecorationSpecId) m_specializationIds.push_back(words[i + 3]);
+        i += wordCount;
+    }
     
     BB_CORE_INFO("Shader: Module created from {}", filepath);
 }
@@ -21,6 +34,10 @@ Shader::~Shader() {
     }
 }
 
+bool Shader::hasSpecializationConstant(uint32_t id) const {
+    return std::find(m_specializationIds.begin(), m_specializationIds.end(), id) != m_specializationIds.end();
+}
+
 std::vector<char> Shader::readFile(std::string_view filename) {
     std::ifstream file(filename.data(), std::ios::ate | std::ios::binary);
 
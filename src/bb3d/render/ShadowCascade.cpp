@@ -95,4 +95,31 @@ glm::mat4 ShadowCascade::calculateLightSpaceMatrix(
     return lightProj * lightView;
 }
 
+bool ShadowCascade::isCasterVisible(const glm::mat4& lightViewProj, const AABB& worldBounds) {
+    // Orthographic projection: the transformed box is exact, no perspective divide
+    const AABB clip = worldBounds.transform(lightViewProj);
+    return clip.max.x >= -1.0f && clip.min.x <= 1.0f &&
+           clip.max.y >= -1.0f && clip.min.y <= 1.0f &&
+           clip.min.z <= 1.0f;
+}
+
+bool ShadowCascade::canReuse(const glm::mat4& cached, const glm::mat4& current, uint32_t shadowMapRes) {
+    constexpr float AxisTolerance = 1e-5f;
+    constexpr float DepthTolerance = 1e-3f;
+    // Orientation and scale: relative to the largest term (the ortho scale)
+    float scale = 0.0f;
+    for (int c = 0; c < 3; ++c) {
+        for (int r = 0; r < 3; ++r) scale = std::max(scale, std::abs(cached[c][r]));
+    }
+    for (int c = 0; c < 3; ++c) {
+        for (int r = 0; r < 3; ++r) {
+            if (std::abs(cached[c][r] - current[c][r]) > AxisTolerance * scale) return false;
+        }
+    }
+    const float halfTexel = 1.0f / static_cast<float>(shadowMapRes); // NDC spans 2 over the resolution
+    return std::abs(cached[3].x - current[3].x) < halfTexel &&
+           std::abs(cached[3].y - current[3].y) < halfTexel &&
+           std::abs(cached[3].z - current[3].z) < DepthTolerance;
+}
+
 } // namespace bb3d
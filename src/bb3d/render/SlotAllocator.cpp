@@ -0,0 +1,40 @@
+#include "bb3d/render/SlotAllocator.hpp"
+
+namespace bb3d {
+
+SlotAllocator::SlotAllocator(uint32_t capacity, uint32_t latency) : m_capacity(capacity), m_latency(latency) {}
+
+std::optional<uint32_t> SlotAllocator::allocate() {
+    uint32_t slot;
+    if (!m_free.empty()) {
+        slot = m_free.back();
+        m_free.pop_back();
+    } else if (m_next < m_capacity) {
+        slot = m_next++;
+    } else {
+        return std::nullopt;
+    }
+    m_used++;
+    return slot;
+}
+
+void SlotAllocator::release(uint32_t slot) {
+    if (slot >= m_next || m_used == 0) return;
+    m_used--;
+    if (m_latency == 0) {
+        m_free.push_back(slot);
+        return;
+    }
+    m_retired.push_back({ slot, m_frame + m_latency });
+}
+
+void SlotAllocator::nextFrame(std::vector<uint32_t>* recycled) {
+    m_frame++;
+    while (!m_retired.empty() && m_retired.front().frame <= m_frame) {
+        m_free.push_back(m_retired.front().slot);
+        if (recycled) recycled->push_back(m_retired.front().slot);
+        m_retired.pop_front();
+    }
+}
+
+} // namespace bb3d
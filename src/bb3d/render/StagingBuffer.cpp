@@ -1,18 +1,23 @@
 #include "bb3d/render/StagingBuffer.hpp"
 #include "bb3d/render/VulkanContext.hpp"
 #include "bb3d/core/Log.hpp"
+#include <algorithm>
 
 namespace bb3d {
 
 StagingBuffer::StagingBuffer(VulkanContext& context, vk::DeviceSize size)
-    : m_context(context), m_size(size) {
-    
-    m_buffer = CreateScope<Buffer>(m_context, size, 
-        vk::BufferUsageFlagBits::eTransferSrc, 
-        VMA_MEMORY_USAGE_CPU_ONLY, 
+    : m_context(context), m_size(size), m_ring(size) {
+
+    m_buffer = CreateScope<Buffer>(m_context, size,
+        vk::BufferUsageFlagBits::eTransferSrc,
+        VMA_MEMORY_USAGE_CPU_ONLY,
         VMA_ALLOCATION_CREATE_MAPPED_BIT);
-    
-    BB_CORE_INFO("StagingBuffer initialized with {0} MB.", size / (1024 * 1024));
+
+    // 16 octets couvrent les copies de buffers (4) et les blocs BC (8/16) ; les deux sont des puissances de 2
+    const auto limits = m_context.getPhysicalDevice().getProperties().limits;
+    m_alignment = std::max<vk::DeviceSize>(limits.optimalBufferCopyOffsetAlignment, 16);
+
+    BB_CORE_INFO("StagingBuffer initialized with {0} MB (alignment {1} bytes).", size / (1024 * 1024), m_alignment);
 }
 
 StagingBuffer::~StagingBuffer() {
@@ -20,41 +25,51 @@ StagingBuffer::~StagingBuffer() {
 }
 
 StagingBuffer::Allocation StagingBuffer::allocate(vk::DeviceSize size) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-
-    // Alignement simple sur 4 octets
-    vk::DeviceSize alignedSize = (size + 3) & ~3;
+    // Une grosse texture ne doit pas vider l'anneau pour tous les autres uploads
+    if (size > m_size / 2) return allocateDedicated(size);
 
-    if (m_offset + alignedSize > m_size) {
-        // Pour l'instant, on fait un reset brutal (synchrone) si on dépasse la taille
-        // Dans une version future, on utilisera des fences pour libérer par blocs.
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (auto block = m_ring.allocate(size, m_alignment)) {
+                Allocation alloc;
+                alloc.buffer = m_buffer->getHandle();
+                alloc.offset = block->offset;
+                alloc.mappedData = static_cast<uint8_t*>(m_buffer->getMappedData()) + block->offset;
+                alloc.ringId = block->id;
+                return alloc;
+            }
+        }
+        // Hors verrou : la récupération rappelle release()
+        if (attempt == 0) {
+            m_context.getUploadQueue().collect();
+        } else if (attempt == 1) {
 #if defined(BB3D_DEBUG)
-        BB_CORE_WARN("StagingBuffer: Buffer full, waiting for GPU idle and resetting offset.");
+            BB_CORE_WARN("StagingBuffer: Ring full, waiting for pending uploads.");
 #endif
-        m_context.getDevice().waitIdle();
-        m_offset = 0;
+            m_context.getUploadQueue().flush();
+        }
     }
 
-    if (alignedSize > m_size) {
-        throw std::runtime_error("StagingBuffer: Requested allocation size exceeds total buffer size!");
-    }
+    // Toujours plein : zones réservées par d'autres threads mais pas encore enregistrées
+    return allocateDedicated(size);
+}
 
+StagingBuffer::Allocation StagingBuffer::allocateDedicated(vk::DeviceSize size) {
+    BB_CORE_TRACE("StagingBuffer: Dedicated staging buffer of {0} KB.", size / 1024);
     Allocation alloc;
-    alloc.buffer = m_buffer->getHandle();
-    alloc.offset = m_offset;
-    alloc.mappedData = static_cast<uint8_t*>(m_buffer->getMappedData()) + m_offset;
-
-    m_offset += alignedSize;
+    alloc.dedicated = CreateScope<Buffer>(m_context, size, vk::BufferUsageFlagBits::eTransferSrc, VMA_MEMORY_USAGE_CPU_ONLY, VMA_ALLOCATION_CREATE_MAPPED_BIT);
+    alloc.buffer = alloc.dedicated->getHandle();
+    alloc.mappedData = alloc.dedicated->getMappedData();
     return alloc;
 }
 
-void StagingBuffer::submitCopy(const std::function<void(vk::CommandBuffer, vk::Buffer stagingBuffer, vk::DeviceSize offset)>& copyFunc) {
-    // Cette méthode centralise la soumission immédiate
-    // On suppose que l'utilisateur a fait son allocation juste avant
-    // Dans une version asynchrone, on passerait l'allocation en paramètre.
-    vk::CommandBuffer cb = m_context.beginSingleTimeCommands();
-    copyFunc(cb, m_buffer->getHandle(), m_offset); 
-    m_context.endSingleTimeCommands(cb);
+void StagingBuffer::release(Allocation& allocation) {
+    allocation.dedicated.reset();
+    if (allocation.ringId == 0) return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_ring.release(allocation.ringId);
+    allocation.ringId = 0;
 }
 
 } // namespace bb3d
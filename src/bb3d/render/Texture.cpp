@@ -1,19 +1,71 @@
 #include "bb3d/render/Texture.hpp"
 #include "bb3d/render/Buffer.hpp"
+#include "bb3d/render/MipGenerator.hpp"
+#include "bb3d/render/TextureCooker.hpp"
+#include "bb3d/render/TextureResidency.hpp"
 #include "bb3d/core/Log.hpp"
 #include "bb3d/core/Engine.hpp"
 #include <stdexcept>
-#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 
 namespace bb3d {
 
+static std::vector<std::byte> readBinaryFile(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) throw std::runtime_error("Failed to open texture file: " + path.string());
+    std::vector<std::byte> bytes(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return bytes;
+}
+
+/** @brief Mip filter space of a decoded image (same rules as the cooker). */
+static TextureUsage pixelUsage(std::string_view name, bool isColor) {
+    if (isColor) return TextureUsage::Albedo;
+    return TextureCooker::detectUsage(name) == TextureUsage::Normal ? TextureUsage::Normal : TextureUsage::Data;
+}
+
+// Load-time settings of the Engine (defaults when there is none, e.g. in tests)
+static bool mipmappingEnabled() {
+    try { return Engine::Get().GetConfig().graphics.enableMipmapping; } catch (...) { return false; }
+}
+
+static JobSystem* loaderJobs() {
+    try { return &Engine::Get().jobs(); } catch (...) { return nullptr; }
+}
+
+static void transitionImage(vk::CommandBuffer commandBuffer, vk::Image image, uint32_t levels, uint32_t layers, vk::ImageLayout oldLayout, vk::ImageLayout newLayout) {
+    vk::ImageMemoryBarrier barrier({}, {}, oldLayout, newLayout, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, image, { vk::ImageAspectFlagBits::eColor, 0, levels, 0, layers });
+
+    vk::PipelineStageFlags sourceStage;
+    vk::PipelineStageFlags destinationStage;
+
+    if (oldLayout == vk::ImageLayout::eUndefined && newLayout == vk::ImageLayout::eTransferDstOptimal) {
+        barrier.srcAccessMask = vk::AccessFlags();
+        barrier.dstAccessMask = vk::AccessFlagBits::eTransferWrite;
+        sourceStage = vk::PipelineStageFlagBits::eTopOfPipe;
+        destinationStage = vk::PipelineStageFlagBits::eTransfer;
+    } else if (oldLayout == vk::ImageLayout::eTransferDstOptimal && newLayout == vk::ImageLayout::eShaderReadOnlyOptimal) {
+        barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+        barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+        sourceStage = vk::PipelineStageFlagBits::eTransfer;
+        destinationStage = vk::PipelineStageFlagBits::eFragmentShader;
+    } else {
+        throw std::invalid_argument("unsupported layout transition!");
+    }
+
+    commandBuffer.pipelineBarrier(sourceStage, destinationStage, {}, nullptr, nullptr, barrier);
+}
+
 Texture::Texture(VulkanContext& context, std::string_view filepath, bool isColor)
     : m_context(context) {
     
-    m_format = isColor ? vk::Format::eR8G8B8A8Srgb : vk::Format::eR8G8B8A8Unorm;
+    if (tryLoadCooked(filepath)) return;
 
     stbi_uc* raw_pixels = stbi_load(filepath.data(), &m_width, &m_height, &m_channels, STBI_rgb_alpha);
     
@@ -24,7 +76,8 @@ Texture::Texture(VulkanContext& context, std::string_view filepath, bool isColor
         throw std::runtime_error("Failed to load texture image: " + std::string(filepath));
     }
 
-    initFromPixels(pixels.get());
+    const unsigned char* layer = pixels.get();
+    initFromPixels({ &layer, 1 }, pixelUsage(filepath, isColor));
     
     BB_CORE_INFO("Texture: Loaded file '{0}' ({1}x{2}, format: {3})", filepath, m_width, m_height, vk::to_string(m_format));
 }
@@ -32,7 +85,11 @@ Texture::Texture(VulkanContext& context, std::string_view filepath, bool isColor
 Texture::Texture(VulkanContext& context, std::span<const std::byte> data, bool isColor)
     : m_context(context) {
     
-    m_format = isColor ? vk::Format::eR8G8B8A8Srgb : vk::Format::eR8G8B8A8Unorm;
+    if (KTX2::isKTX2(data)) {
+        loadKTX2(KTX2::read(data));
+        BB_CORE_INFO("Texture: Loaded KTX2 from memory ({0}x{1}, format: {2}, mipLevels: {3})", m_width, m_height, vk::to_string(m_format), m_mipLevels);
+        return;
+    }
 
     stbi_uc* raw_pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(data.data()), static_cast<int>(data.size()), &m_width, &m_height, &m_channels, STBI_rgb_alpha);
     
@@ -43,7 +100,8 @@ Texture::Texture(VulkanContext& context, std::span<const std::byte> data, bool i
         throw std::runtime_error("Failed to load texture from memory");
     }
 
-    initFromPixels(pixels.get());
+    const unsigned char* layer = pixels.get();
+    initFromPixels({ &layer, 1 }, pixelUsage({}, isColor));
     
     BB_CORE_INFO("Texture: Loaded from memory ({0}x{1}, format: {2})", m_width, m_height, vk::to_string(m_format));
 }
@@ -51,70 +109,42 @@ Texture::Texture(VulkanContext& context, std::span<const std::byte> data, bool i
 Texture::Texture(VulkanContext& context, std::span<const std::byte> data, int width, int height, bool isColor)
     : m_context(context), m_width(width), m_height(height), m_channels(4) {
     
-    m_format = isColor ? vk::Format::eR8G8B8A8Srgb : vk::Format::eR8G8B8A8Unorm;
-
     if (data.size() != (size_t)width * height * 4) {
         throw std::runtime_error("Texture: Raw data size mismatch with dimensions");
     }
 
-    initFromPixels(reinterpret_cast<const unsigned char*>(data.data()));
+    const auto* layer = reinterpret_cast<const unsigned char*>(data.data());
+    initFromPixels({ &layer, 1 }, pixelUsage({}, isColor));
     BB_CORE_INFO("Texture: Loaded from raw pixels ({0}x{1}, format: {2})", m_width, m_height, vk::to_string(m_format));
 }
 
 Texture::Texture(VulkanContext& context, const std::array<std::string, 6>& filepaths, bool isColor)
     : m_context(context), m_isCubemap(true) {
     
-    m_format = isColor ? vk::Format::eR8G8B8A8Srgb : vk::Format::eR8G8B8A8Unorm;
-
-    std::array<stbi_uc*, 6> all_pixels;
-    int w, h, ch;
-
-    for (int i = 0; i < 6; ++i) {
-        all_pixels[i] = stbi_load(filepaths[i].c_str(), &w, &h, &ch, STBI_rgb_alpha);
-        if (!all_pixels[i]) {
-            for (int j = 0; j < i; ++j) stbi_image_free(all_pixels[j]);
-            throw std::runtime_error("Failed to load cubemap face: " + filepaths[i]);
-        }
-        if (i > 0 && (w != m_width || h != m_height)) {
-            for (int j = 0; j <= i; ++j) stbi_image_free(all_pixels[j]);
-            throw std::runtime_error("Cubemap faces must have same dimensions");
-        }
-        m_width = w; m_height = h;
+    // Faces decoded concurrently (stb_image keeps no shared state while decoding)
+    struct StbiDeleter { void operator()(stbi_uc* p) { stbi_image_free(p); } };
+    std::array<std::unique_ptr<stbi_uc, StbiDeleter>, 6> faces;
+    std::array<int, 6> widths{}, heights{};
+    auto decode = [&](uint32_t face, uint32_t) {
+        int channels = 0;
+        faces[face].reset(stbi_load(filepaths[face].c_str(), &widths[face], &heights[face], &channels, STBI_rgb_alpha));
+    };
+    if (JobSystem* jobs = loaderJobs(); jobs && jobs->getThreadCount() > 0) {
+        jobs->dispatch(6, 1, decode);
+    } else {
+        for (uint32_t face = 0; face < 6; ++face) decode(face, 1);
     }
 
-    vk::DeviceSize faceSize = (vk::DeviceSize)m_width * m_height * 4;
-    vk::DeviceSize totalSize = faceSize * 6;
-
-    m_mipLevels = 1;
-    try {
-        if (Engine::Get().GetConfig().graphics.enableMipmapping) {
-            m_mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(m_width, m_height)))) + 1;
-        }
-    } catch (...) {}
-
-    m_stagingBuffer = CreateScope<Buffer>(m_context, totalSize, vk::BufferUsageFlagBits::eTransferSrc, VMA_MEMORY_USAGE_CPU_ONLY, VMA_ALLOCATION_CREATE_MAPPED_BIT);
-    
+    std::array<const unsigned char*, 6> layers;
     for (int i = 0; i < 6; ++i) {
-        m_stagingBuffer->upload(all_pixels[i], faceSize, faceSize * i);
-        stbi_image_free(all_pixels[i]);
-    }
-
-    createImage(m_width, m_height, 6);
-    
-    vk::CommandBuffer cb = m_context.beginTransferCommands();
-    transitionLayout(cb, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, 6);
-    copyBufferToImage(cb, m_stagingBuffer->getHandle(), 6);
-    
-    if (m_mipLevels > 1) {
-        generateMipmaps(cb, 6);
-    } else {
-        transitionLayout(cb, vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal, 6);
+        if (!faces[i]) throw std::runtime_error("Failed to load cubemap face: " + filepaths[i]);
+        if (widths[i] != widths[0] || heights[i] != heights[0]) throw std::runtime_error("Cubemap faces must have same dimensions");
+        layers[i] = faces[i].get();
     }
+    m_width = widths[0];
+    m_height = heights[0];
 
-    m_uploadFence = m_context.endTransferCommandsAsync(cb);
-
-    createImageView(6);
-    createSampler();
+    initFromPixels(layers, isColor ? TextureUsage::Albedo : TextureUsage::Data);
 
     BB_CORE_INFO("Texture: Loaded cubemap ({0}x{1}, mipLevels: {2})", m_width, m_height, m_mipLevels);
 }
@@ -122,105 +152,237 @@ Texture::Texture(VulkanContext& context, const std::array<std::string, 6>& filep
 Texture::Texture(VulkanContext& context, std::span<const std::byte> data, int width, int height, int layers, bool isColor)
     : m_context(context), m_width(width), m_height(height), m_isCubemap(layers == 6) {
     
-    m_format = isColor ? vk::Format::eR8G8B8A8Srgb : vk::Format::eR8G8B8A8Unorm;
-
-    vk::DeviceSize totalSize = (vk::DeviceSize)width * height * 4 * layers;
-    if (data.size() != totalSize) {
+    const size_t layerSize = static_cast<size_t>(width) * height * 4;
+    if (data.size() != layerSize * layers) {
         throw std::runtime_error("Texture: Raw data size mismatch with dimensions and layers");
     }
 
-    m_mipLevels = 1;
-    try {
-        if (Engine::Get().GetConfig().graphics.enableMipmapping) {
-            m_mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(m_width, m_height)))) + 1;
+    std::vector<const unsigned char*> layerPixels(layers);
+    for (int i = 0; i < layers; ++i) layerPixels[i] = reinterpret_cast<const unsigned char*>(data.data()) + layerSize * i;
+    initFromPixels(layerPixels, isColor ? TextureUsage::Albedo : TextureUsage::Data);
+
+    BB_CORE_INFO("Texture: Loaded multi-layer ({0}x{1}, layers: {2}, mipLevels: {3})", width, height, layers, m_mipLevels);
+}
+
+Texture::Texture(VulkanContext& context, KTX2Texture&& texture)
+    : m_context(context) {
+    loadKTX2(std::move(texture));
+    BB_CORE_INFO("Texture: Created {0} ({1}x{2}, format: {3}, mipLevels: {4})", m_isCubemap ? "cubemap" : "image", m_width, m_height, vk::to_string(m_format), m_mipLevels);
+}
+
+void Texture::initFromPixels(std::span<const unsigned char* const> layers, TextureUsage usage) {
+    // Mips filtered on the CPU (linear-space colors, renormalized normals) and uploaded with
+    // level 0 in a single copy: no blit, so any sampled format works
+    const auto width = static_cast<uint32_t>(m_width), height = static_cast<uint32_t>(m_height);
+    const size_t layerSize = static_cast<size_t>(width) * height * 4;
+    const uint32_t levels = mipmappingEnabled() ? MipGenerator::levelCount(width, height) : 1;
+    JobSystem* jobs = loaderJobs();
+
+    KTX2Texture ktx;
+    ktx.format = usage == TextureUsage::Albedo ? KTX2Format::R8G8B8A8_SRGB : KTX2Format::R8G8B8A8_UNORM;
+    ktx.width = width;
+    ktx.height = height;
+    ktx.faceCount = static_cast<uint32_t>(layers.size());
+    ktx.levels.resize(levels);
+    for (const unsigned char* pixels : layers) {
+        auto chain = levels > 1 ? MipGenerator::buildMipChain(pixels, width, height, usage, MipFilter::Box, jobs)
+                                : std::vector<std::vector<uint8_t>>{ std::vector<uint8_t>(pixels, pixels + layerSize) };
+        // Levels hold every layer back to back, as in a KTX2 file
+        for (uint32_t level = 0; level < levels; ++level) {
+            if (layers.size() == 1) ktx.levels[level] = std::move(chain[level]);
+            else ktx.levels[level].insert(ktx.levels[level].end(), chain[level].begin(), chain[level].end());
+        }
+    }
+    loadKTX2(std::move(ktx));
+}
+
+bool Texture::tryLoadCooked(std::string_view filepath) {
+    std::filesystem::path source(filepath);
+    const bool isKTX2 = source.extension() == ".ktx2";
+    std::filesystem::path cooked = source;
+    cooked.replace_extension(".ktx2");
+    if (!isKTX2 && (!m_context.supportsBCTextures() || !std::filesystem::exists(cooked))) return false;
+
+    // A cooked file older than its source is stale: the edited image wins until it is cooked again
+    if (!isKTX2) {
+        std::error_code sourceError, cookedError;
+        const auto sourceTime = std::filesystem::last_write_time(source, sourceError);
+        const auto cookedTime = std::filesystem::last_write_time(cooked, cookedError);
+        if (!sourceError && (cookedError || cookedTime < sourceTime)) {
+            BB_CORE_WARN("Texture: Ignoring '{0}' (older than its source)", cooked.string());
+            return false;
         }
-    } catch (...) {}
+    }
 
-    m_stagingBuffer = CreateScope<Buffer>(m_context, totalSize, vk::BufferUsageFlagBits::eTransferSrc, VMA_MEMORY_USAGE_CPU_ONLY, VMA_ALLOCATION_CREATE_MAPPED_BIT);
-    m_stagingBuffer->upload(data.data(), totalSize);
+    try {
+        loadKTX2(KTX2::read(readBinaryFile(cooked)));
+    } catch (const std::exception& e) {
+        if (isKTX2) throw;
+        // Unusable cooked file: the source image is still there
+        BB_CORE_WARN("Texture: Ignoring '{0}' ({1})", cooked.string(), e.what());
+        return false;
+    }
+    BB_CORE_INFO("Texture: Loaded cooked '{0}' ({1}x{2}, format: {3}, mipLevels: {4})", cooked.string(), m_width, m_height, vk::to_string(m_format), m_mipLevels);
+    return true;
+}
 
-    createImage(width, height, layers);
-    
-    vk::CommandBuffer cb = m_context.beginTransferCommands();
-    transitionLayout(cb, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, layers);
-    copyBufferToImage(cb, m_stagingBuffer->getHandle(), layers);
-    
-    if (m_mipLevels > 1) {
-        generateMipmaps(cb, layers);
+void Texture::loadKTX2(KTX2Texture&& ktx) {
+    if (ktx.faceCount == 1 && ktx.levels.size() > 1 && canStream(ktx.width, ktx.height)) {
+        initStreamed(std::move(ktx));
     } else {
-        transitionLayout(cb, vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal, layers);
+        initFromKTX2(ktx);
+    }
+}
+
+void Texture::setupFromKTX2(const KTX2Texture& ktx) {
+    m_format = static_cast<vk::Format>(ktx.format);
+    const auto features = m_context.getPhysicalDevice().getFormatProperties(m_format).optimalTilingFeatures;
+    if (!(features & vk::FormatFeatureFlagBits::eSampledImage)) {
+        throw std::runtime_error("Texture: Format " + vk::to_string(m_format) + " cannot be sampled on this device");
     }
 
-    m_uploadFence = m_context.endTransferCommandsAsync(cb);
+    m_width = static_cast<int>(ktx.width);
+    m_height = static_cast<int>(ktx.height);
+    m_channels = 4;
+    m_isCubemap = ktx.faceCount == 6;
+    m_mipLevels = static_cast<uint32_t>(ktx.levels.size());
+    if (ktx.format == KTX2Format::BC4_UNORM) {
+        m_swizzle = vk::ComponentMapping(vk::ComponentSwizzle::eR, vk::ComponentSwizzle::eR, vk::ComponentSwizzle::eR, vk::ComponentSwizzle::eOne);
+    }
+}
 
-    createImageView(layers);
+void Texture::initFromKTX2(const KTX2Texture& ktx) {
+    setupFromKTX2(ktx);
+    createImage(ktx.width, ktx.height, ktx.faceCount);
+    m_uploadTicket = uploadLevels(ktx, m_image, 0);
+    createImageView(ktx.faceCount);
     createSampler();
+}
 
-    BB_CORE_INFO("Texture: Loaded multi-layer ({0}x{1}, layers: {2}, mipLevels: {3})", width, height, layers, m_mipLevels);
+UploadQueue::Ticket Texture::uploadLevels(const KTX2Texture& ktx, vk::Image image, uint32_t firstLevel) {
+    const uint32_t levels = static_cast<uint32_t>(ktx.levels.size()) - firstLevel;
+
+    // Each level starts on a 16-byte boundary (BC block size, multiple of 4)
+    std::vector<vk::DeviceSize> offsets(levels);
+    vk::DeviceSize totalSize = 0;
+    for (uint32_t i = 0; i < levels; ++i) {
+        offsets[i] = totalSize;
+        totalSize += (ktx.levels[firstLevel + i].size() + 15) & ~vk::DeviceSize(15);
+    }
+
+    auto staging = m_context.getStagingBuffer().allocate(totalSize);
+    std::vector<vk::BufferImageCopy> regions;
+    regions.reserve(levels);
+    for (uint32_t i = 0; i < levels; ++i) {
+        const auto& level = ktx.levels[firstLevel + i];
+        std::memcpy(static_cast<uint8_t*>(staging.mappedData) + offsets[i], level.data(), level.size());
+        regions.emplace_back(staging.offset + offsets[i], 0, 0,
+            vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, i, 0, ktx.faceCount),
+            vk::Offset3D(0, 0, 0), vk::Extent3D(ktx.getLevelWidth(firstLevel + i), ktx.getLevelHeight(firstLevel + i), 1));
+    }
+
+    const vk::Buffer src = staging.buffer;
+    const uint32_t layers = ktx.faceCount;
+    return m_context.getUploadQueue().record([&](vk::CommandBuffer cb) {
+        transitionImage(cb, image, levels, layers, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal);
+        cb.copyBufferToImage(src, image, vk::ImageLayout::eTransferDstOptimal, regions);
+        transitionImage(cb, image, levels, layers, vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal);
+    }, std::move(staging));
 }
 
-void Texture::initFromPixels(const unsigned char* pixels) {
-    vk::DeviceSize imageSize = static_cast<vk::DeviceSize>(m_width) * m_height * 4;
+bool Texture::canStream(uint32_t width, uint32_t height) const {
+    const auto& settings = m_context.getTextureStreamer().getSettings();
+    return settings.enabled && !m_isCubemap && std::max(width, height) > settings.tailSize;
+}
 
-    m_mipLevels = 1;
-    try {
-        if (Engine::Get().GetConfig().graphics.enableMipmapping) {
-            m_mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(m_width, m_height)))) + 1;
-        }
-    } catch (...) {}
+void Texture::initStreamed(KTX2Texture&& ktx) {
+    setupFromKTX2(ktx);
+    m_streamSource = CreateScope<KTX2Texture>(std::move(ktx));
+    const KTX2Texture& source = *m_streamSource;
 
-    // Keeping staging buffer until asynchronous upload is complete
-    m_stagingBuffer = CreateScope<Buffer>(m_context, imageSize, vk::BufferUsageFlagBits::eTransferSrc, VMA_MEMORY_USAGE_CPU_ONLY, VMA_ALLOCATION_CREATE_MAPPED_BIT);
-    m_stagingBuffer->upload(pixels, imageSize);
+    m_residentBytes.assign(m_mipLevels + 1, 0);
+    for (uint32_t level = m_mipLevels; level-- > 0;) {
+        m_residentBytes[level] = m_residentBytes[level + 1] + source.levels[level].size();
+    }
 
-    createImage(static_cast<uint32_t>(m_width), static_cast<uint32_t>(m_height), 1);
+    // Only the mip tail at load time: the cost does not depend on the texture size
+    m_tailMip = TextureResidency::tailMip(source.width, source.height, m_mipLevels, m_context.getTextureStreamer().getSettings().tailSize);
+    m_residentMip = m_tailMip;
+    const uint32_t levels = m_mipLevels - m_tailMip;
+    m_image = allocateImage(source.getLevelWidth(m_tailMip), source.getLevelHeight(m_tailMip), levels, 1, m_allocation);
+    m_uploadTicket = uploadLevels(source, m_image, m_tailMip);
+    m_imageView = createView(m_image, levels, 1);
+    createSampler();
 
-    // Starting asynchronous transfer commands
-    vk::CommandBuffer cb = m_context.beginTransferCommands();
+    m_context.getTextureStreamer().registerTexture(this);
+    BB_CORE_TRACE("Texture: Streamed {0}x{1}, {2} of {3} levels resident", m_width, m_height, levels, m_mipLevels);
+}
 
-    transitionLayout(cb, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, 1);
-    copyBufferToImage(cb, m_stagingBuffer->getHandle(), 1);
-    
-    if (m_mipLevels > 1) {
-        generateMipmaps(cb, 1);
-    } else {
-        transitionLayout(cb, vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal, 1);
+void Texture::requestResolution(float screenPixels) {
+    if (!m_streamSource) return;
+    const uint32_t size = static_cast<uint32_t>(std::max(m_width, m_height));
+    const uint32_t mip = TextureResidency::desiredMip(size, screenPixels, m_mipLevels, m_context.getTextureStreamer().getSettings().bias);
+    // Finest request of the frame wins
+    uint32_t current = m_requestedMip.load(std::memory_order_relaxed);
+    while (mip < current && !m_requestedMip.compare_exchange_weak(current, mip, std::memory_order_relaxed)) {}
+}
+
+void Texture::beginResidency(uint32_t firstMip) {
+    const KTX2Texture& source = *m_streamSource;
+    PendingResidency pending;
+    pending.firstMip = firstMip;
+    try {
+        pending.image = allocateImage(source.getLevelWidth(firstMip), source.getLevelHeight(firstMip), m_mipLevels - firstMip, 1, pending.allocation);
+    } catch (const std::exception& e) {
+        BB_CORE_WARN("Texture: Cannot make mip {0} resident ({1})", firstMip, e.what());
+        return;
     }
+    pending.ticket = uploadLevels(source, pending.image, firstMip);
+    m_pending = std::move(pending);
+}
 
-    m_uploadFence = m_context.endTransferCommandsAsync(cb);
+void Texture::pollResidency() {
+    if (!m_pending || !m_context.getUploadQueue().isComplete(m_pending->ticket)) return;
+
+    // Frames in flight may still sample the previous image
+    m_context.getTextureStreamer().retire(m_image, m_allocation, m_imageView);
+    m_image = m_pending->image;
+    m_allocation = m_pending->allocation;
+    m_imageView = createView(m_image, m_mipLevels - m_pending->firstMip, 1);
+    m_residentMip = m_pending->firstMip;
+    m_residencyVersion++;
+    m_pending.reset();
+}
 
-    createImageView(1);
-    createSampler();
-    
-    // Note: m_ready remains false until isReady() or an explicit wait is called.
+void Texture::destroyPending() {
+    if (!m_pending) return;
+    m_context.getUploadQueue().wait(m_pending->ticket);
+    vmaDestroyImage(m_context.getAllocator(), static_cast<VkImage>(m_pending->image), m_pending->allocation);
+    m_pending.reset();
 }
 
 bool Texture::isReady() {
     if (m_ready) return true;
-    if (!m_uploadFence) return true; 
-
-    // Protection against concurrent calls (multi-frames)
-    auto result = m_context.getDevice().getFenceStatus(m_uploadFence);
-    if (result == vk::Result::eSuccess) {
-        // Double check to avoid multiple destruction
-        if (m_uploadFence) {
-            m_context.getDevice().destroyFence(m_uploadFence);
-            m_uploadFence = nullptr;
-            m_stagingBuffer.reset();
-            m_ready = true;
-            BB_CORE_TRACE("Texture: Upload complete and resources released.");
-        }
-        return true;
-    }
-    return false;
+    if (!m_context.getUploadQueue().isComplete(m_uploadTicket)) return false;
+
+    m_uploadTicket.reset();
+    m_ready = true;
+    BB_CORE_TRACE("Texture: Upload complete.");
+    return true;
 }
 
 Texture::~Texture() {
     auto device = m_context.getDevice();
     BB_CORE_TRACE("Texture: Destroying texture image ({}x{})", m_width, m_height);
     
-    if (m_uploadFence) {
-        device.destroyFence(m_uploadFence);
+    if (m_streamSource) {
+        m_context.getTextureStreamer().unregisterTexture(this);
+        destroyPending();
+    }
+
+    // The image may still be the destination of a pending copy
+    if (m_uploadTicket) {
+        m_context.getUploadQueue().wait(m_uploadTicket);
     }
 
     if (m_sampler) {
@@ -235,110 +397,46 @@ Texture::~Texture() {
 }
 
 void Texture::createImage(uint32_t width, uint32_t height, uint32_t layers) {
+    m_image = allocateImage(width, height, m_mipLevels, layers, m_allocation);
+}
+
+vk::Image Texture::allocateImage(uint32_t width, uint32_t height, uint32_t levels, uint32_t layers, VmaAllocation& allocation) {
     vk::ImageCreateFlags flags = m_isCubemap ? vk::ImageCreateFlagBits::eCubeCompatible : vk::ImageCreateFlags();
     
-    vk::ImageUsageFlags usage = vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled;
-    if (m_mipLevels > 1) {
-        usage |= vk::ImageUsageFlagBits::eTransferSrc; // Needed for blit
-    }
+    // Every level comes from the CPU (no blit): transfer destination only
+    const vk::ImageUsageFlags usage = vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled;
 
-    vk::ImageCreateInfo imageInfo(flags, vk::ImageType::e2D, m_format, { width, height, 1 }, m_mipLevels, layers, vk::SampleCountFlagBits::e1, vk::ImageTiling::eOptimal, usage);
+    vk::ImageCreateInfo imageInfo(flags, vk::ImageType::e2D, m_format, { width, height, 1 }, levels, layers, vk::SampleCountFlagBits::e1, vk::ImageTiling::eOptimal, usage);
 
     VmaAllocationCreateInfo allocInfo{};
     allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
 
     VkImage img;
-    VkResult res = vmaCreateImage(m_context.getAllocator(), reinterpret_cast<VkImageCreateInfo*>(&imageInfo), &allocInfo, &img, &m_allocation, nullptr);
+    VkResult res = vmaCreateImage(m_context.getAllocator(), reinterpret_cast<VkImageCreateInfo*>(&imageInfo), &allocInfo, &img, &allocation, nullptr);
     if (res != VK_SUCCESS) throw std::runtime_error("VMA Allocation Failed for Texture Image: " + vk::to_string(static_cast<vk::Result>(res)));
-    m_image = vk::Image(img);
+    return vk::Image(img);
 }
 
 void Texture::createImageView(uint32_t layers) {
+    m_imageView = createView(m_image, m_mipLevels, layers);
+}
+
+vk::ImageView Texture::createView(vk::Image image, uint32_t levels, uint32_t layers) {
     vk::ImageViewType viewType = m_isCubemap ? vk::ImageViewType::eCube : vk::ImageViewType::e2D;
     
-    vk::ImageViewCreateInfo viewInfo({}, m_image, viewType, m_format, {}, { vk::ImageAspectFlagBits::eColor, 0, m_mipLevels, 0, layers });
-    m_imageView = m_context.getDevice().createImageView(viewInfo);
+    vk::ImageViewCreateInfo viewInfo({}, image, viewType, m_format, m_swizzle, { vk::ImageAspectFlagBits::eColor, 0, levels, 0, layers });
+    return m_context.getDevice().createImageView(viewInfo);
 }
 
 void Texture::createSampler() {
-    vk::Filter filter = (m_width <= 256 && m_height <= 256) ? vk::Filter::eNearest : vk::Filter::eLinear;
-    vk::SamplerAddressMode addrMode = (m_width <= 256 && m_height <= 256) ? vk::SamplerAddressMode::eClampToEdge : vk::SamplerAddressMode::eRepeat;
+    // Small color images are sampled as pixel art; float data (baked lighting, lookup tables) is always filtered and clamped
+    const bool isFloat = KTX2::isFloat(static_cast<KTX2Format>(m_format));
+    const bool small = m_width <= 256 && m_height <= 256;
+    vk::Filter filter = (small && !isFloat) ? vk::Filter::eNearest : vk::Filter::eLinear;
+    vk::SamplerAddressMode addrMode = (small || isFloat) ? vk::SamplerAddressMode::eClampToEdge : vk::SamplerAddressMode::eRepeat;
 
     vk::SamplerCreateInfo samplerInfo({}, filter, filter, vk::SamplerMipmapMode::eLinear, addrMode, addrMode, addrMode, 0.0f, VK_FALSE, 1.0f, VK_FALSE, vk::CompareOp::eAlways, 0.0f, static_cast<float>(m_mipLevels), vk::BorderColor::eIntOpaqueBlack, VK_FALSE);
     m_sampler = m_context.getDevice().createSampler(samplerInfo);
 }
 
-void Texture::generateMipmaps(vk::CommandBuffer commandBuffer, uint32_t layers) {
-    vk::ImageMemoryBarrier barrier({}, {}, vk::ImageLayout::eUndefined, vk::ImageLayout::eUndefined, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, m_image, { vk::ImageAspectFlagBits::eColor, 0, 1, 0, layers });
-
-    int32_t mipWidth = m_width;
-    int32_t mipHeight = m_height;
-
-    for (uint32_t i = 1; i < m_mipLevels; i++) {
-        barrier.subresourceRange.baseMipLevel = i - 1;
-        barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
-        barrier.newLayout = vk::ImageLayout::eTransferSrcOptimal;
-        barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
-        barrier.dstAccessMask = vk::AccessFlagBits::eTransferRead;
-
-        commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eTransfer, {}, nullptr, nullptr, barrier);
-
-        vk::ImageBlit blit;
-        blit.srcSubresource = vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, i - 1, 0, layers);
-        blit.srcOffsets[0] = vk::Offset3D(0, 0, 0);
-        blit.srcOffsets[1] = vk::Offset3D(mipWidth, mipHeight, 1);
-        blit.dstSubresource = vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, i, 0, layers);
-        blit.dstOffsets[0] = vk::Offset3D(0, 0, 0);
-        blit.dstOffsets[1] = vk::Offset3D(mipWidth > 1 ? mipWidth / 2 : 1, mipHeight > 1 ? mipHeight / 2 : 1, 1);
-
-        commandBuffer.blitImage(m_image, vk::ImageLayout::eTransferSrcOptimal, m_image, vk::ImageLayout::eTransferDstOptimal, blit, vk::Filter::eLinear);
-
-        barrier.oldLayout = vk::ImageLayout::eTransferSrcOptimal;
-        barrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
-        barrier.srcAccessMask = vk::AccessFlagBits::eTransferRead;
-        barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
-
-        commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader, {}, nullptr, nullptr, barrier);
-
-        if (mipWidth > 1) mipWidth /= 2;
-        if (mipHeight > 1) mipHeight /= 2;
-    }
-
-    barrier.subresourceRange.baseMipLevel = m_mipLevels - 1;
-    barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
-    barrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
-    barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
-    barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
-
-    commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader, {}, nullptr, nullptr, barrier);
-}
-
-void Texture::transitionLayout(vk::CommandBuffer commandBuffer, vk::ImageLayout oldLayout, vk::ImageLayout newLayout, uint32_t layers) {
-    vk::ImageMemoryBarrier barrier({}, {}, oldLayout, newLayout, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, m_image, { vk::ImageAspectFlagBits::eColor, 0, m_mipLevels, 0, layers });
-
-    vk::PipelineStageFlags sourceStage;
-    vk::PipelineStageFlags destinationStage;
-
-    if (oldLayout == vk::ImageLayout::eUndefined && newLayout == vk::ImageLayout::eTransferDstOptimal) {
-        barrier.srcAccessMask = vk::AccessFlags();
-        barrier.dstAccessMask = vk::AccessFlagBits::eTransferWrite;
-        sourceStage = vk::PipelineStageFlagBits::eTopOfPipe;
-        destinationStage = vk::PipelineStageFlagBits::eTransfer;
-    } else if (oldLayout == vk::ImageLayout::eTransferDstOptimal && newLayout == vk::ImageLayout::eShaderReadOnlyOptimal) {
-        barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
-        barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
-        sourceStage = vk::PipelineStageFlagBits::eTransfer;
-        destinationStage = vk::PipelineStageFlagBits::eFragmentShader;
-    } else {
-        throw std::invalid_argument("unsupported layout transition!");
-    }
-
-    commandBuffer.pipelineBarrier(sourceStage, destinationStage, {}, nullptr, nullptr, barrier);
-}
-
-void Texture::copyBufferToImage(vk::CommandBuffer commandBuffer, vk::Buffer buffer, uint32_t layers) {
-    vk::BufferImageCopy region(0, 0, 0, { vk::ImageAspectFlagBits::eColor, 0, 0, layers }, { 0, 0, 0 }, { static_cast<uint32_t>(m_width), static_cast<uint32_t>(m_height), 1 });
-    commandBuffer.copyBufferToImage(buffer, m_image, vk::ImageLayout::eTransferDstOptimal, region);
-}
-
 } // namespace bb3d
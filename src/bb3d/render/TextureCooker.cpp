@@ -0,0 +1,76 @@
+#include "bb3d/render/TextureCooker.hpp"
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+namespace bb3d {
+
+namespace {
+
+bool contains(const std::string& haystack, std::initializer_list<const char*> needles) {
+    for (const char* needle : needles) {
+        if (haystack.find(needle) != std::string::npos) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+namespace TextureCooker {
+
+TextureUsage detectUsage(std::string_view filename) {
+    std::string name(filename);
+    if (auto slash = name.find_last_of("/\\"); slash != std::string::npos) name = name.substr(slash + 1);
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    if (contains(name, { "normal", "_nrm", "_nor." })) return TextureUsage::Normal;
+    if (contains(name, { "_orm.", "_arm.", "occlusionroughnessmetal" })) return TextureUsage::Data;
+    if (contains(name, { "roughness", "_rough", "ambientocclusion", "_ao.", "metalness", "metallic", "displacement", "height", "opacity", "mask", "gloss" })) {
+        return TextureUsage::Single;
+    }
+    return TextureUsage::Albedo;
+}
+
+KTX2Format selectFormat(TextureUsage usage, bool hasAlpha, bool fast) {
+    switch (usage) {
+        case TextureUsage::Normal: return KTX2Format::BC5_UNORM;
+        case TextureUsage::Single: return KTX2Format::BC4_UNORM;
+        case TextureUsage::Data: return KTX2Format::BC7_UNORM;
+        case TextureUsage::Albedo:
+        default:
+            if (!fast) return KTX2Format::BC7_SRGB;
+            return hasAlpha ? KTX2Format::BC3_SRGB : KTX2Format::BC1_RGBA_SRGB;
+    }
+}
+
+std::vector<std::vector<uint8_t>> buildMipChain(const uint8_t* rgba, uint32_t width, uint32_t height, TextureUsage usage, MipFilter filter) {
+    return MipGenerator::buildMipChain(rgba, width, height, usage, filter);
+}
+
+KTX2Texture cook(const uint8_t* rgba, uint32_t width, uint32_t height, TextureUsage usage, const TextureCookSettings& settings) {
+    bool hasAlpha = false;
+    for (size_t i = 0; i < static_cast<size_t>(width) * height && !hasAlpha; ++i) hasAlpha = rgba[i * 4 + 3] != 255;
+
+    KTX2Texture texture;
+    texture.format = selectFormat(usage, hasAlpha, settings.fast);
+    texture.width = width;
+    texture.height = height;
+
+    auto mips = settings.generateMips ? buildMipChain(rgba, width, height, usage, settings.mipFilter)
+                                      : std::vector<std::vector<uint8_t>>{ std::vector<uint8_t>(rgba, rgba + static_cast<size_t>(width) * height * 4) };
+    const auto block = KTX2::getBlockFormat(texture.format);
+    texture.levels.reserve(mips.size());
+    for (uint32_t level = 0; level < mips.size(); ++level) {
+        if (!block) {
+            texture.levels.push_back(std::move(mips[level]));
+            continue;
+        }
+        texture.levels.push_back(BlockCompression::compress(*block, mips[level].data(), texture.getLevelWidth(level), texture.getLevelHeight(level)));
+        mips[level] = {}; // Keep the peak memory to one uncompressed chain
+    }
+    return texture;
+}
+
+} // namespace TextureCooker
+
+} // namespace bb3d
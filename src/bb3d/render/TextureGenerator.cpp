@@ -1,63 +1,82 @@
 #include "bb3d/render/TextureGenerator.hpp"
+#include "bb3d/render/ORMPacker.hpp"
+#include "bb3d/resource/ResourceManager.hpp"
+#include "bb3d/core/JobSystem.hpp"
 #include "bb3d/core/Log.hpp"
 #include <stb_image.h>
+#include <array>
+#include <memory>
+#include <string>
 #include <vector>
 #include <algorithm>
 
 namespace bb3d {
 
-Ref<Texture> TextureGenerator::combineORM(VulkanContext& context, std::string_view aoPath, std::string_view roughnessPath, std::string_view metallicPath) {
-    int w = 0, h = 0, c = 0;
-    stbi_uc *ao = nullptr, *rough = nullptr, *metal = nullptr;
-
-    // Helper pour charger et valider les dimensions
-    auto load = [&](std::string_view path, stbi_uc*& ptr) {
-        if (path.empty()) return;
-        int lw, lh, lc;
-        ptr = stbi_load(path.data(), &lw, &lh, &lc, 1); // On ne charge que le canal R (grayscale)
-        if (ptr) {
-            if (w == 0) { w = lw; h = lh; }
-            else if (lw != w || lh != h) {
-                BB_CORE_WARN("TextureGenerator: Dimension mismatch for '{}' ({}x{} vs {}x{}). Resizing not supported yet.", path, lw, lh, w, h);
-                stbi_image_free(ptr); ptr = nullptr;
-            }
-        } else {
-            BB_CORE_WARN("TextureGenerator: Failed to load '{}'", path);
-        }
+namespace {
+
+struct StbiDeleter {
+    void operator()(stbi_uc* pixels) const { stbi_image_free(pixels); }
+};
+
+struct DecodedMap {
+    std::unique_ptr<stbi_uc, StbiDeleter> pixels;
+    int width = 0, height = 0;
+};
+
+} // namespace
+
+Ref<Texture> TextureGenerator::combineORM(VulkanContext& context, std::string_view aoPath, std::string_view roughnessPath, std::string_view metallicPath, JobSystem* jobs) {
+    const std::array<std::string, 3> paths = { std::string(aoPath), std::string(roughnessPath), std::string(metallicPath) };
+    std::array<DecodedMap, 3> maps;
+
+    // Les trois décodages sont indépendants : un job chacun
+    auto decode = [&](uint32_t i, uint32_t) {
+        if (paths[i].empty()) return;
+        int lc;
+        maps[i].pixels.reset(stbi_load(paths[i].c_str(), &maps[i].width, &maps[i].height, &lc, 1)); // On ne charge que le canal R (grayscale)
+        if (!maps[i].pixels) BB_CORE_WARN("TextureGenerator: Failed to load '{}'", paths[i]);
     };
+    const auto requested = std::ranges::count_if(paths, [](const std::string& path) { return !path.empty(); });
+    if (jobs && requested > 1 && jobs->getThreadCount() > 0) {
+        jobs->dispatch(3, 1, decode);
+    } else {
+        for (uint32_t i = 0; i < 3; ++i) decode(i, 1);
+    }
 
-    load(aoPath, ao);
-    load(roughnessPath, rough);
-    load(metallicPath, metal);
+    // La plus grande map donne la taille ; les autres sont rééchantillonnées
+    uint32_t w = 0, h = 0;
+    std::array<GrayImageView, 3> views;
+    for (size_t i = 0; i < maps.size(); ++i) {
+        if (!maps[i].pixels) continue;
+        views[i] = { maps[i].pixels.get(), static_cast<uint32_t>(maps[i].width), static_cast<uint32_t>(maps[i].height) };
+        if (w != 0 && (views[i].width != w || views[i].height != h)) {
+            BB_CORE_TRACE("TextureGenerator: Resampling mismatched map '{}' ({}x{})", paths[i], views[i].width, views[i].height);
+        }
+        if (static_cast<uint64_t>(views[i].width) * views[i].height > static_cast<uint64_t>(w) * h) { w = views[i].width; h = views[i].height; }
+    }
 
     if (w == 0) {
         BB_CORE_ERROR("TextureGenerator: No valid input textures found.");
         return nullptr;
     }
 
-    // Buffer final RGBA (4 canaux)
-    std::vector<unsigned char> ormPixels(w * h * 4);
-
-    for (int i = 0; i < w * h; ++i) {
-        // R = Occlusion (défaut 255/blanc)
-        ormPixels[i * 4 + 0] = ao ? ao[i] : 255;
-        // G = Roughness (défaut 255/blanc -> très rugueux)
-        ormPixels[i * 4 + 1] = rough ? rough[i] : 255;
-        // B = Metallic (défaut 0/noir -> diélectrique)
-        ormPixels[i * 4 + 2] = metal ? metal[i] : 0;
-        // A = Unused (255)
-        ormPixels[i * 4 + 3] = 255;
-    }
-
-    // Cleanup
-    if (ao) stbi_image_free(ao);
-    if (rough) stbi_image_free(rough);
-    if (metal) stbi_image_free(metal);
+    // RGBA final : R = Occlusion (défaut blanc), G = Roughness (défaut blanc -> très rugueux), B = Metallic (défaut noir -> diélectrique), A = 255
+    std::vector<uint8_t> ormPixels = ORMPacker::pack(views[0], views[1], views[2], w, h, jobs);
+    for (auto& map : maps) map.pixels.reset();
 
     BB_CORE_INFO("TextureGenerator: Generated ORM texture ({}x{})", w, h);
-    
+
     // Création de la texture via le constructeur existant qui prend un std::span de bytes
     return CreateRef<Texture>(context, std::as_bytes(std::span(ormPixels)), w, h, false); // false = format linéaire (UNORM) pour les data maps
 }
 
+Ref<Texture> TextureGenerator::combineORM(ResourceManager& resources, std::string_view aoPath, std::string_view roughnessPath, std::string_view metallicPath) {
+    // Clé distincte des chemins de fichiers du cache de textures
+    std::string key = "orm:";
+    key.append(aoPath).append("|").append(roughnessPath).append("|").append(metallicPath);
+    return resources.getOrCreate<Texture>(key, [&]() {
+        return combineORM(resources.getContext(), aoPath, roughnessPath, metallicPath, &resources.getJobSystem());
+    });
+}
+
 } // namespace bb3d
@@ -0,0 +1,65 @@
+#include "bb3d/render/TextureResidency.hpp"
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <vector>
+
+namespace bb3d {
+
+namespace TextureResidency {
+
+uint32_t desiredMip(uint32_t textureSize, float screenPixels, uint32_t mipCount, float bias) {
+    if (mipCount <= 1) return 0;
+    const float pixels = std::max(screenPixels, 1.0f);
+    const float level = std::floor(std::log2(static_cast<float>(textureSize) / pixels) + bias);
+    return static_cast<uint32_t>(std::clamp(level, 0.0f, static_cast<float>(mipCount - 1)));
+}
+
+uint32_t tailMip(uint32_t width, uint32_t height, uint32_t mipCount, uint32_t tailSize) {
+    uint32_t level = 0;
+    while (level + 1 < mipCount && std::max(width >> level, height >> level) > tailSize) level++;
+    return level;
+}
+
+uint64_t plan(std::span<ResidencyEntry> entries, uint64_t budget) {
+    uint64_t total = 0;
+    for (auto& entry : entries) {
+        entry.targetMip = std::min(entry.desiredMip, entry.tailMip);
+        total += entry.residentBytes[entry.targetMip];
+    }
+    if (total <= budget) return total;
+
+    // Candidate = the finest level of one texture; the least degraded texture goes first
+    struct Candidate {
+        uint32_t dropped;
+        uint64_t saving;
+        size_t index;
+        bool operator<(const Candidate& other) const {
+            if (dropped != other.dropped) return dropped > other.dropped;
+            return saving < other.saving;
+        }
+    };
+    auto candidate = [&](size_t index) {
+        const auto& entry = entries[index];
+        return Candidate{ entry.targetMip - std::min(entry.desiredMip, entry.tailMip),
+                          entry.residentBytes[entry.targetMip] - entry.residentBytes[entry.targetMip + 1], index };
+    };
+
+    std::priority_queue<Candidate> queue;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (entries[i].targetMip < entries[i].tailMip) queue.push(candidate(i));
+    }
+    while (total > budget && !queue.empty()) {
+        const Candidate next = queue.top();
+        queue.pop();
+        auto& entry = entries[next.index];
+        total -= next.saving;
+        entry.targetMip++;
+        if (entry.targetMip < entry.tailMip) queue.push(candidate(next.index));
+    }
+    return total;
+}
+
+} // namespace TextureResidency
+
+} // namespace bb3d
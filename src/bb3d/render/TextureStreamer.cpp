@@ -0,0 +1,118 @@
+#include "bb3d/render/TextureStreamer.hpp"
+#include "bb3d/render/Texture.hpp"
+#include "bb3d/render/VulkanContext.hpp"
+#include "bb3d/render/Renderer.hpp"
+#include "bb3d/core/Log.hpp"
+#include <algorithm>
+
+namespace bb3d {
+
+TextureStreamer::TextureStreamer(VulkanContext& context)
+    : m_context(context) {}
+
+TextureStreamer::~TextureStreamer() {
+    if (!m_textures.empty()) {
+        BB_CORE_WARN("TextureStreamer: {0} streamed texture(s) still alive at shutdown.", m_textures.size());
+    }
+    destroyRetired(true);
+}
+
+void TextureStreamer::configure(const Settings& settings) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_settings = settings;
+    m_settings.tailSize = std::max(m_settings.tailSize, 1u);
+    BB_CORE_INFO("TextureStreamer: {0} (budget {1} MB, tail {2}px)", m_settings.enabled ? "enabled" : "disabled",
+        m_settings.budgetBytes / (1024 * 1024), m_settings.tailSize);
+}
+
+void TextureStreamer::registerTexture(Texture* texture) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_textures.push_back({ texture, texture->getTailMip(), m_frame });
+}
+
+void TextureStreamer::unregisterTexture(Texture* texture) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::erase_if(m_textures, [&](const Streamed& streamed) { return streamed.texture == texture; });
+}
+
+void TextureStreamer::update() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_frame++;
+    destroyRetired(false);
+
+    m_stats = {};
+    m_stats.textures = static_cast<uint32_t>(m_textures.size());
+    if (m_textures.empty()) return;
+
+    // 1. Completed transitions and requests of the frame
+    m_entries.resize(m_textures.size());
+    for (size_t i = 0; i < m_textures.size(); ++i) {
+        auto& streamed = m_textures[i];
+        Texture& texture = *streamed.texture;
+        texture.pollResidency();
+
+        const uint32_t requested = texture.consumeRequest();
+        if (requested != Texture::NoMipRequest) {
+            streamed.desiredMip = requested;
+            streamed.lastRequest = m_frame;
+        } else if (m_frame - streamed.lastRequest > m_settings.graceFrames) {
+            streamed.desiredMip = texture.getTailMip();
+        }
+        m_entries[i] = { texture.getResidentBytes(), texture.getTailMip(), streamed.desiredMip, 0 };
+    }
+    m_stats.plannedBytes = TextureResidency::plan(m_entries, m_settings.budgetBytes);
+
+    // 2. Evictions right away (the new image is smaller), stream-ins by decreasing blur
+    m_streamIns.clear();
+    for (size_t i = 0; i < m_textures.size(); ++i) {
+        Texture& texture = *m_textures[i].texture;
+        const auto bytes = texture.getResidentBytes();
+        m_stats.residentBytes += bytes[texture.getResidentMip()];
+        m_stats.fullBytes += bytes[0];
+        if (texture.hasPendingResidency()) {
+            m_stats.pending++;
+            continue;
+        }
+
+        const uint32_t target = m_entries[i].targetMip;
+        if (target > texture.getResidentMip()) {
+            texture.beginResidency(target);
+            m_stats.evicted++;
+        } else if (target < texture.getResidentMip()) {
+            m_streamIns.push_back(i);
+        }
+    }
+
+    std::ranges::sort(m_streamIns, [&](size_t a, size_t b) {
+        return m_textures[a].texture->getResidentMip() - m_entries[a].targetMip > m_textures[b].texture->getResidentMip() - m_entries[b].targetMip;
+    });
+    uint64_t uploaded = 0;
+    for (size_t i : m_streamIns) {
+        const uint64_t bytes = m_entries[i].residentBytes[m_entries[i].targetMip];
+        if (uploaded > 0 && uploaded + bytes > m_settings.uploadBytesPerFrame) break;
+        m_textures[i].texture->beginResidency(m_entries[i].targetMip);
+        uploaded += bytes;
+        m_stats.streamedIn++;
+    }
+    m_stats.pending += m_stats.evicted + m_stats.streamedIn;
+}
+
+TextureStreamer::Stats TextureStreamer::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void TextureStreamer::retire(vk::Image image, VmaAllocation allocation, vk::ImageView view) {
+    m_retired.push_back({ image, allocation, view, m_frame });
+}
+
+void TextureStreamer::destroyRetired(bool all) {
+    while (!m_retired.empty() && (all || m_frame - m_retired.front().frame >= Renderer::MAX_FRAMES_IN_FLIGHT)) {
+        const Retired& retired = m_retired.front();
+        if (retired.view) m_context.getDevice().destroyImageView(retired.view);
+        if (retired.image) vmaDestroyImage(m_context.getAllocator(), static_cast<VkImage>(retired.image), retired.allocation);
+        m_retired.pop_front();
+    }
+}
+
+} // namespace bb3d
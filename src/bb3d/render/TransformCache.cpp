@@ -0,0 +1,50 @@
+#define GLM_ENABLE_EXPERIMENTAL
+#include "bb3d/render/TransformCache.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtx/quaternion.hpp>
+
+namespace bb3d {
+
+namespace {
+bool sameBounds(const AABB& a, const AABB& b) { return a.min == b.min && a.max == b.max; }
+} // namespace
+
+bool TransformCache::refresh(const glm::vec3& newTranslation, const glm::vec3& newRotation, const glm::vec3& newScale,
+                             const glm::vec3& newOffset, const void* newSource, const AABB& newLocalBounds) {
+    if (source && source == newSource && translation == newTranslation && rotation == newRotation && scale == newScale && offset == newOffset &&
+        sameBounds(localBounds, newLocalBounds)) {
+        return false;
+    }
+    translation = newTranslation;
+    rotation = newRotation;
+    scale = newScale;
+    offset = newOffset;
+    source = newSource;
+    localBounds = newLocalBounds;
+    world = composeWorld(translation, rotation, scale, offset);
+    worldBounds = localBounds.transform(world);
+    return true;
+}
+
+glm::mat4 TransformCache::composeWorld(const glm::vec3& translation, const glm::vec3& rotation, const glm::vec3& scale, const glm::vec3& offset) {
+    glm::mat4 world = glm::translate(glm::mat4(1.0f), translation) *
+                      glm::toMat4(glm::quat(rotation)) *
+                      glm::scale(glm::mat4(1.0f), scale);
+    return offset == glm::vec3(0.0f) ? world : glm::translate(world, offset);
+}
+
+bool ModelTransformCache::resizeParts(size_t count) {
+    if (partBounds.size() == count) return false;
+    partLocalBounds.assign(count, AABB{});
+    partBounds.assign(count, AABB{});
+    return true;
+}
+
+bool ModelTransformCache::refreshPart(size_t index, const AABB& newLocalBounds, bool worldChanged) {
+    if (!worldChanged && sameBounds(partLocalBounds[index], newLocalBounds)) return false;
+    partLocalBounds[index] = newLocalBounds;
+    partBounds[index] = newLocalBounds.transform(world);
+    return true;
+}
+
+} // namespace bb3d
@@ -0,0 +1,169 @@
+#include "bb3d/render/UploadQueue.hpp"
+#include "bb3d/render/VulkanContext.hpp"
+#include "bb3d/core/Log.hpp"
+
+namespace bb3d {
+
+UploadQueue::UploadQueue(VulkanContext& context) : m_context(context) {
+    vk::SemaphoreTypeCreateInfo typeInfo(vk::SemaphoreType::eTimeline, 0);
+    vk::SemaphoreCreateInfo semaphoreInfo({}, &typeInfo);
+    m_timeline = m_context.getDevice().createSemaphore(semaphoreInfo);
+}
+
+UploadQueue::~UploadQueue() {
+    flush();
+    auto device = m_context.getDevice();
+    for (auto& [id, batch] : m_threads) {
+        // Destroying the pool frees its command buffers
+        device.destroyCommandPool(batch->pool);
+    }
+    m_threads.clear();
+    device.destroySemaphore(m_timeline);
+}
+
+UploadQueue::ThreadBatch& UploadQueue::currentThreadBatch() {
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    auto& batch = m_threads[std::this_thread::get_id()];
+    if (!batch) {
+        batch = CreateScope<ThreadBatch>();
+        batch->pool = m_context.getDevice().createCommandPool({ vk::CommandPoolCreateFlagBits::eTransient | vk::CommandPoolCreateFlagBits::eResetCommandBuffer, m_context.getTransferQueueFamily() });
+    }
+    return *batch;
+}
+
+UploadQueue::Ticket UploadQueue::record(const std::function<void(vk::CommandBuffer)>& commands, Scope<Buffer> keepAlive) {
+    ThreadBatch& batch = currentThreadBatch();
+    std::lock_guard<std::mutex> lock(batch.mutex);
+    Ticket ticket = recordLocked(batch, commands);
+    if (keepAlive) batch.keepAlive.push_back(std::move(keepAlive));
+    return ticket;
+}
+
+UploadQueue::Ticket UploadQueue::record(const std::function<void(vk::CommandBuffer)>& commands, StagingBuffer::Allocation staging) {
+    ThreadBatch& batch = currentThreadBatch();
+    std::lock_guard<std::mutex> lock(batch.mutex);
+    Ticket ticket = recordLocked(batch, commands);
+    batch.staging.push_back(std::move(staging));
+    return ticket;
+}
+
+UploadQueue::Ticket UploadQueue::recordLocked(ThreadBatch& batch, const std::function<void(vk::CommandBuffer)>& commands) {
+    if (!batch.recording) {
+        recycleLocked(batch);
+        if (!batch.freeCommandBuffers.empty()) {
+            batch.recording = batch.freeCommandBuffers.back();
+            batch.freeCommandBuffers.pop_back();
+        } else {
+            vk::CommandBufferAllocateInfo allocInfo(batch.pool, vk::CommandBufferLevel::ePrimary, 1);
+            batch.recording = m_context.getDevice().allocateCommandBuffers(allocInfo)[0];
+        }
+        batch.recording.begin({ vk::CommandBufferUsageFlagBits::eOneTimeSubmit });
+        batch.submission = CreateRef<Submission>();
+    }
+
+    commands(batch.recording);
+    return batch.submission;
+}
+
+void UploadQueue::submit() {
+    ThreadBatch& batch = currentThreadBatch();
+    std::lock_guard<std::mutex> lock(batch.mutex);
+    submitLocked(batch);
+}
+
+void UploadQueue::submitAll() {
+    std::vector<ThreadBatch*> batches;
+    {
+        std::lock_guard<std::mutex> lock(m_threadsMutex);
+        batches.reserve(m_threads.size());
+        for (auto& [id, batch] : m_threads) batches.push_back(batch.get());
+    }
+    for (ThreadBatch* batch : batches) {
+        std::lock_guard<std::mutex> lock(batch->mutex);
+        submitLocked(*batch);
+    }
+}
+
+void UploadQueue::submitLocked(ThreadBatch& batch) {
+    if (!batch.recording) return;
+
+    // Transfer writes become visible to every later consumer on the queue
+    vk::MemoryBarrier barrier(vk::AccessFlagBits::eTransferWrite,
+        vk::AccessFlagBits::eVertexAttributeRead | vk::AccessFlagBits::eIndexRead | vk::AccessFlagBits::eShaderRead |
+        vk::AccessFlagBits::eUniformRead | vk::AccessFlagBits::eIndirectCommandRead | vk::AccessFlagBits::eTransferRead);
+    batch.recording.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eAllCommands, {}, barrier, nullptr, nullptr);
+    batch.recording.end();
+
+    uint64_t value;
+    {
+        std::lock_guard<std::mutex> queueLock(m_context.getQueueMutex());
+        // Signal values must increase in submission order: allocated under the queue lock
+        value = m_lastSubmitted.load() + 1;
+        vk::TimelineSemaphoreSubmitInfo timelineInfo(0, nullptr, 1, &value);
+        vk::SubmitInfo submitInfo(0, nullptr, nullptr, 1, &batch.recording, 1, &m_timeline, &timelineInfo);
+        m_context.getTransferQueue().submit(submitInfo, nullptr);
+        m_lastSubmitted.store(value);
+    }
+
+    batch.submission->value.store(value);
+    batch.inFlight.push_back({ batch.recording, value, std::move(batch.keepAlive), std::move(batch.staging) });
+    batch.keepAlive.clear();
+    batch.staging.clear();
+    batch.recording = nullptr;
+    batch.submission.reset();
+}
+
+void UploadQueue::recycleLocked(ThreadBatch& batch) {
+    const uint64_t completed = getCompletedValue();
+    while (!batch.inFlight.empty() && batch.inFlight.front().value <= completed) {
+        // The pool allows individual resets: begin() resets the buffer implicitly
+        batch.freeCommandBuffers.push_back(batch.inFlight.front().commandBuffer);
+        retire(batch.inFlight.front());
+        batch.inFlight.pop_front();
+    }
+}
+
+void UploadQueue::retire(InFlightBatch& batch) {
+    auto& stagingBuffer = m_context.getStagingBuffer();
+    for (auto& allocation : batch.staging) stagingBuffer.release(allocation);
+    batch.staging.clear();
+    batch.keepAlive.clear();
+}
+
+void UploadQueue::collect() {
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    for (auto& [id, batch] : m_threads) {
+        std::lock_guard<std::mutex> batchLock(batch->mutex);
+        recycleLocked(*batch);
+    }
+}
+
+void UploadQueue::flush() {
+    submitAll();
+    waitValue(m_lastSubmitted.load());
+    collect();
+}
+
+bool UploadQueue::isComplete(const Ticket& ticket) const {
+    if (!ticket) return true;
+    const uint64_t value = ticket->value.load();
+    return value != 0 && getCompletedValue() >= value;
+}
+
+void UploadQueue::wait(const Ticket& ticket) {
+    if (!ticket) return;
+    if (ticket->value.load() == 0) submitAll();
+    waitValue(ticket->value.load());
+}
+
+uint64_t UploadQueue::getCompletedValue() const {
+    return m_context.getDevice().getSemaphoreCounterValue(m_timeline);
+}
+
+void UploadQueue::waitValue(uint64_t value) const {
+    if (value == 0) return;
+    vk::SemaphoreWaitInfo waitInfo({}, 1, &m_timeline, &value);
+    (void)m_context.getDevice().waitSemaphores(waitInfo, UINT64_MAX);
+}
+
+} // namespace bb3d
@@ -0,0 +1,146 @@
+#include "bb3d/render/Vertex.hpp"
+
+namespace bb3d {
+
+namespace {
+
+// Half floats keep ~1/1024 precision up to 2.0: beyond that, tiled UVs start to swim.
+constexpr float MaxHalfUV = 2.0f;
+
+vk::VertexInputAttributeDescription attribute(uint32_t location, vk::Format format, uint32_t offset) {
+    vk::VertexInputAttributeDescription a{};
+    a.binding = 0;
+    a.location = location;
+    a.format = format;
+    a.offset = offset;
+    return a;
+}
+
+template <typename T>
+void encodeCommon(const Vertex& v, T& out) {
+    out.position = v.position;
+    VertexPacking::encodeNormal(v.normal, out.normal);
+    VertexPacking::encodeTangent(v.tangent, out.tangent);
+    out.uv[0] = VertexPacking::toHalf(v.uv.x);
+    out.uv[1] = VertexPacking::toHalf(v.uv.y);
+}
+
+template <typename T>
+std::array<vk::VertexInputAttributeDescription, 7> quantizedAttributes() {
+    // Unused locations alias the normal bytes (always present) and are ignored by the shaders
+    const uint32_t alias = offsetof(T, normal);
+    return {
+        attribute(VertexLayout::Position, vk::Format::eR32G32B32Sfloat, offsetof(T, position)),
+        attribute(VertexLayout::Normal, vk::Format::eR16G16Snorm, offsetof(T, normal)),
+        attribute(VertexLayout::Color, vk::Format::eR8G8B8A8Unorm, alias),
+        attribute(VertexLayout::UV, vk::Format::eR16G16Sfloat, offsetof(T, uv)),
+        attribute(VertexLayout::Tangent, vk::Format::eR16G16Snorm, offsetof(T, tangent)),
+        attribute(VertexLayout::Joints, vk::Format::eR8G8B8A8Uint, alias),
+        attribute(VertexLayout::Weights, vk::Format::eR8G8B8A8Unorm, alias)
+    };
+}
+
+} // namespace
+
+vk::VertexInputBindingDescription Vertex::getBindingDescription(VertexFormat format) {
+    vk::VertexInputBindingDescription bindingDescription = getBindingDescription();
+    bindingDescription.stride = getStride(format);
+    return bindingDescription;
+}
+
+std::array<vk::VertexInputAttributeDescription, 7> Vertex::getAttributeDescriptions(VertexFormat format) {
+    switch (format) {
+        case VertexFormat::StaticLit:
+            return quantizedAttributes<VertexStaticLit>();
+        case VertexFormat::Colored: {
+            auto attributes = quantizedAttributes<VertexColored>();
+            attributes[VertexLayout::Color].offset = offsetof(VertexColored, color);
+            return attributes;
+        }
+        case VertexFormat::Skinned: {
+            auto attributes = quantizedAttributes<VertexSkinned>();
+            attributes[VertexLayout::Joints].offset = offsetof(VertexSkinned, joints);
+            attributes[VertexLayout::Weights].offset = offsetof(VertexSkinned, weights);
+            return attributes;
+        }
+        default:
+            return getAttributeDescriptions();
+    }
+}
+
+uint32_t Vertex::getStride(VertexFormat format) {
+    switch (format) {
+        case VertexFormat::StaticLit: return sizeof(VertexStaticLit);
+        case VertexFormat::Colored:   return sizeof(VertexColored);
+        case VertexFormat::Skinned:   return sizeof(VertexSkinned);
+        default:                      return sizeof(Vertex);
+    }
+}
+
+VertexFormat Vertex::chooseFormat(std::span<const Vertex> vertices) {
+    bool skinned = false, colored = false;
+    for (const auto& v : vertices) {
+        if (std::abs(v.uv.x) > MaxHalfUV || std::abs(v.uv.y) > MaxHalfUV) return VertexFormat::Full;
+        if (v.weights != glm::vec4(0.0f)) {
+            for (int k = 0; k < 4; ++k) {
+                if (v.joints[k] < 0 || v.joints[k] > 255) return VertexFormat::Full;
+            }
+            skinned = true;
+        }
+        if (v.color != glm::vec3(1.0f)) {
+            if (glm::any(glm::lessThan(v.color, glm::vec3(0.0f))) || glm::any(glm::greaterThan(v.color, glm::vec3(1.0f)))) return VertexFormat::Full;
+            colored = true;
+        }
+    }
+    // A skinned vertex has no room for a color: keep everything rather than dropping data
+    if (skinned && colored) return VertexFormat::Full;
+    if (skinned) return VertexFormat::Skinned;
+    return colored ? VertexFormat::Colored : VertexFormat::StaticLit;
+}
+
+std::vector<std::byte> Vertex::encode(std::span<const Vertex> vertices, VertexFormat format) {
+    if (format == VertexFormat::Auto) format = chooseFormat(vertices);
+
+    std::vector<std::byte> out(vertices.size() * getStride(format));
+    switch (format) {
+        case VertexFormat::StaticLit: {
+            auto* dst = reinterpret_cast<VertexStaticLit*>(out.data());
+            for (size_t i = 0; i < vertices.size(); ++i) encodeCommon(vertices[i], dst[i]);
+            break;
+        }
+        case VertexFormat::Colored: {
+            auto* dst = reinterpret_cast<VertexColored*>(out.data());
+            for (size_t i = 0; i < vertices.size(); ++i) {
+                encodeCommon(vertices[i], dst[i]);
+                for (int k = 0; k < 3; ++k) dst[i].color[k] = VertexPacking::toUnorm8(vertices[i].color[k]);
+                dst[i].color[3] = 255;
+            }
+            break;
+        }
+        case VertexFormat::Skinned: {
+            auto* dst = reinterpret_cast<VertexSkinned*>(out.data());
+            for (size_t i = 0; i < vertices.size(); ++i) {
+                encodeCommon(vertices[i], dst[i]);
+                const glm::vec4& w = vertices[i].weights;
+                float sum = w.x + w.y + w.z + w.w;
+                glm::vec4 nw = sum > 0.0f ? w / sum : w;
+                int total = 0, heaviest = 0;
+                for (int k = 0; k < 4; ++k) {
+                    dst[i].joints[k] = static_cast<uint8_t>(vertices[i].joints[k]);
+                    dst[i].weights[k] = VertexPacking::toUnorm8(nw[k]);
+                    total += dst[i].weights[k];
+                    if (dst[i].weights[k] > dst[i].weights[heaviest]) heaviest = k;
+                }
+                // Keep the quantized weights summing to exactly 1
+                if (sum > 0.0f) dst[i].weights[heaviest] = static_cast<uint8_t>(dst[i].weights[heaviest] + (255 - total));
+            }
+            break;
+        }
+        default:
+            std::memcpy(out.data(), vertices.data(), out.size());
+            break;
+    }
+    return out;
+}
+
+} // namespace bb3d
@@ -16,7 +16,9 @@ VULKAN_HPP_DEFAULT_DISPATCH_LOADER_DYNAMIC_STORAGE
 
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_vulkan.h>
+#include <algorithm>
 #include <set>
+#include <span>
 
 namespace bb3d {
 
@@ -117,8 +119,33 @@ void VulkanContext::init(SDL_Window* window, std::string_view appName, bool enab
     for (uint32_t family : uniqueQueueFamilies) queueCreateInfos.push_back({ {}, family, 1, &queuePriority });
 
     std::vector<const char*> deviceExtensions = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
-    vk::PhysicalDeviceDynamicRenderingFeatures dynamicRenderingFeatures(VK_TRUE);
+    // Timeline semaphores (core 1.2): completion tracking of the upload batches
+    vk::PhysicalDeviceTimelineSemaphoreFeatures timelineFeatures(VK_TRUE);
+    // Descriptor indexing (core 1.2): bindless materials, one texture array indexed per instance (optional, fallback = one set per material)
+    auto supported = m_physicalDevice.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceDescriptorIndexingFeatures>();
+    const auto& indexing = supported.get<vk::PhysicalDeviceDescriptorIndexingFeatures>();
+    m_descriptorIndexing = indexing.shaderSampledImageArrayNonUniformIndexing && indexing.runtimeDescriptorArray &&
+                           indexing.descriptorBindingPartiallyBound && indexing.descriptorBindingSampledImageUpdateAfterBind;
+    vk::PhysicalDeviceDescriptorIndexingFeatures indexingFeatures;
+    indexingFeatures.shaderSampledImageArrayNonUniformIndexing = m_descriptorIndexing ? VK_TRUE : VK_FALSE;
+    indexingFeatures.runtimeDescriptorArray = m_descriptorIndexing ? VK_TRUE : VK_FALSE;
+    indexingFeatures.descriptorBindingPartiallyBound = m_descriptorIndexing ? VK_TRUE : VK_FALSE;
+    indexingFeatures.descriptorBindingSampledImageUpdateAfterBind = m_descriptorIndexing ? VK_TRUE : VK_FALSE;
+    timelineFeatures.pNext = &indexingFeatures;
+    vk::PhysicalDeviceDynamicRenderingFeatures dynamicRenderingFeatures(VK_TRUE, &timelineFeatures);
     vk::PhysicalDeviceFeatures deviceFeatures{};
+    // Multi-draw indirect: one call for all visible clusters of a mesh (optional, fallback = one call per draw)
+    m_multiDrawIndirect = m_physicalDevice.getFeatures().multiDrawIndirect == VK_TRUE;
+    deviceFeatures.multiDrawIndirect = m_multiDrawIndirect ? VK_TRUE : VK_FALSE;
+    // Draw count read from a GPU buffer (GPU-driven culling); the extension form needs no feature struct in the chain
+    const auto extensions = m_physicalDevice.enumerateDeviceExtensionProperties();
+    m_drawIndirectCount = m_multiDrawIndirect && std::any_of(extensions.begin(), extensions.end(), [](const vk::ExtensionProperties& e) {
+        return std::string_view(e.extensionName.data()) == VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME;
+    });
+    if (m_drawIndirectCount) deviceExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+    // BCn textures (KTX2 produced by the cooker); without it the loaders fall back to the source images
+    m_textureCompressionBC = m_physicalDevice.getFeatures().textureCompressionBC == VK_TRUE;
+    deviceFeatures.textureCompressionBC = m_textureCompressionBC ? VK_TRUE : VK_FALSE;
     vk::DeviceCreateInfo deviceCreateInfo({}, static_cast<uint32_t>(queueCreateInfos.size()), queueCreateInfos.data(), 0, nullptr, static_cast<uint32_t>(deviceExtensions.size()), deviceExtensions.data(), &deviceFeatures);
     deviceCreateInfo.pNext = &dynamicRenderingFeatures;
 
@@ -142,22 +169,62 @@ void VulkanContext::init(SDL_Window* window, std::string_view appName, bool enab
     allocatorInfo.vulkanApiVersion = VK_API_VERSION_1_3;
     vmaCreateAllocator(&allocatorInfo, &m_allocator);
 
-    m_shortLivedCommandPool = m_device.createCommandPool({ vk::CommandPoolCreateFlagBits::eTransient, m_graphicsQueueFamily });
-    m_transferCommandPool = m_device.createCommandPool({ vk::CommandPoolCreateFlagBits::eTransient, m_transferQueueFamily });
     m_stagingBuffer = CreateScope<StagingBuffer>(*this);
+    m_uploadQueue = CreateScope<UploadQueue>(*this);
+    m_geometryPool = CreateScope<GeometryPool>(*this);
+    m_textureStreamer = CreateScope<TextureStreamer>(*this);
     BB_CORE_INFO("VulkanContext initialized (VMA with dynamic dispatch).");
 }
 
+void VulkanContext::loadPipelineCache(const std::filesystem::path& directory) {
+    const auto props = m_physicalDevice.getProperties();
+    m_pipelineCacheIdentity = { props.vendorID, props.deviceID, props.driverVersion, {} };
+    std::copy(props.pipelineCacheUUID.begin(), props.pipelineCacheUUID.end(), m_pipelineCacheIdentity.cacheUUID.begin());
+    m_pipelineCachePath = directory / PipelineCacheData::fileName(m_pipelineCacheIdentity);
+
+    // Data from another GPU or driver is never handed to Vulkan
+    auto data = PipelineCacheData::read(m_pipelineCachePath);
+    if (data && !PipelineCacheData::isCompatible(*data, m_pipelineCacheIdentity)) {
+        BB_CORE_WARN("VulkanContext: Ignoring incompatible pipeline cache '{0}'", m_pipelineCachePath.string());
+        data.reset();
+    }
+    try {
+        m_pipelineCache = m_device.createPipelineCache({ {}, data ? data->size() : 0, data ? data->data() : nullptr });
+    } catch (const vk::SystemError& e) {
+        BB_CORE_WARN("VulkanContext: Pipeline cache rejected by the driver ({0}), starting empty", e.what());
+        data.reset();
+        m_pipelineCache = m_device.createPipelineCache({});
+    }
+    if (data) BB_CORE_INFO("VulkanContext: Pipeline cache loaded ({0} KB).", data->size() / 1024);
+    else BB_CORE_INFO("VulkanContext: Empty pipeline cache, pipelines are compiled from SPIR-V.");
+}
+
+void VulkanContext::savePipelineCache() {
+    if (!m_pipelineCache || m_pipelineCachePath.empty()) return;
+    const auto data = m_device.getPipelineCacheData(m_pipelineCache);
+    const auto bytes = std::as_bytes(std::span(data));
+    if (!PipelineCacheData::isCompatible(bytes, m_pipelineCacheIdentity)) return;
+    if (!PipelineCacheData::write(m_pipelineCachePath, bytes)) {
+        BB_CORE_WARN("VulkanContext: Failed to write pipeline cache '{0}'", m_pipelineCachePath.string());
+    }
+}
+
 void VulkanContext::cleanup() {
     if (m_device) {
         m_device.waitIdle();
-        m_stagingBuffer.reset();
-        if (m_shortLivedCommandPool) {
-            m_device.destroyCommandPool(m_shortLivedCommandPool);
+        if (m_pipelineCache) {
+            savePipelineCache();
+            m_device.destroyPipelineCache(m_pipelineCache);
+            m_pipelineCache = nullptr;
         }
-        if (m_transferCommandPool) {
-            m_device.destroyCommandPool(m_transferCommandPool);
+        m_uploadQueue.reset(); // Submits and waits for the pending uploads first
+        m_textureStreamer.reset();
+        m_geometryPool.reset();
+        m_stagingBuffer.reset();
+        for (auto& [thread, pool] : m_threadCommandPools) {
+            m_device.destroyCommandPool(pool);
         }
+        m_threadCommandPools.clear();
         if (m_allocator) {
             vmaDestroyAllocator(m_allocator);
             m_allocator = nullptr;
@@ -170,8 +237,16 @@ void VulkanContext::cleanup() {
     if (m_instance) { m_instance.destroy(); m_instance = nullptr; }
 }
 
+vk::CommandPool VulkanContext::getThreadCommandPool() {
+    std::lock_guard<std::mutex> lock(m_commandPoolMutex);
+    auto& pool = m_threadCommandPools[std::this_thread::get_id()];
+    // The transfer family is the graphics family: a single pool per thread serves both
+    if (!pool) pool = m_device.createCommandPool({ vk::CommandPoolCreateFlagBits::eTransient, m_graphicsQueueFamily });
+    return pool;
+}
+
 vk::CommandBuffer VulkanContext::beginSingleTimeCommands() {
-    vk::CommandBufferAllocateInfo allocInfo(m_shortLivedCommandPool, vk::CommandBufferLevel::ePrimary, 1);
+    vk::CommandBufferAllocateInfo allocInfo(getThreadCommandPool(), vk::CommandBufferLevel::ePrimary, 1);
     vk::CommandBuffer commandBuffer = m_device.allocateCommandBuffers(allocInfo)[0];
     commandBuffer.begin({ vk::CommandBufferUsageFlagBits::eOneTimeSubmit });
     return commandBuffer;
@@ -181,13 +256,21 @@ void VulkanContext::endSingleTimeCommands(vk::CommandBuffer commandBuffer) {
 
     commandBuffer.end();
 
-    vk::SubmitInfo submitInfo(0, nullptr, nullptr, 1, &commandBuffer);
+    // Uploads recorded before these commands may be read by them
+    if (m_uploadQueue) m_uploadQueue->submitAll();
 
-    m_graphicsQueue.submit(submitInfo, nullptr);
+    vk::SubmitInfo submitInfo(0, nullptr, nullptr, 1, &commandBuffer);
+    vk::Fence fence = m_device.createFence({});
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_graphicsQueue.submit(submitInfo, fence);
+    }
 
-    m_graphicsQueue.waitIdle();
+    // Only this command buffer is waited for: frames in flight keep running
+    (void)m_device.waitForFences(1, &fence, VK_TRUE, UINT64_MAX);
+    m_device.destroyFence(fence);
 
-    m_device.freeCommandBuffers(m_shortLivedCommandPool, commandBuffer);
+    m_device.freeCommandBuffers(getThreadCommandPool(), commandBuffer);
 
 }
 
@@ -195,7 +278,7 @@ void VulkanContext::endSingleTimeCommands(vk::CommandBuffer commandBuffer) {
 
 vk::CommandBuffer VulkanContext::beginTransferCommands() {
 
-    vk::CommandBufferAllocateInfo allocInfo(m_transferCommandPool, vk::CommandBufferLevel::ePrimary, 1);
+    vk::CommandBufferAllocateInfo allocInfo(getThreadCommandPool(), vk::CommandBufferLevel::ePrimary, 1);
 
     vk::CommandBuffer commandBuffer = m_device.allocateCommandBuffers(allocInfo)[0];
 
@@ -217,6 +300,7 @@ vk::Fence VulkanContext::endTransferCommandsAsync(vk::CommandBuffer commandBuffe
 
     vk::SubmitInfo submitInfo(0, nullptr, nullptr, 1, &commandBuffer);
 
+    std::lock_guard<std::mutex> lock(m_queueMutex);
     m_transferQueue.submit(submitInfo, fence);
 
     
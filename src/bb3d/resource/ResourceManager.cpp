@@ -8,6 +8,10 @@ ResourceManager::ResourceManager(VulkanContext& context, JobSystem& jobSystem)
     : m_context(context), m_jobSystem(jobSystem) {
 }
 
+void ResourceManager::submitUploads() {
+    m_context.getUploadQueue().submit();
+}
+
 void ResourceManager::clearCache() {
     std::unique_lock<std::shared_mutex> lock(m_registryMutex);
     BB_CORE_TRACE("ResourceManager: Clearing {} resource caches...", m_caches.size());
@@ -0,0 +1,147 @@
+#include "bb3d/scene/ParticlePool.hpp"
+#include "bb3d/render/InstanceData.hpp"
+#include "bb3d/core/Float4.hpp"
+#include <algorithm>
+#include <atomic>
+
+namespace bb3d {
+
+namespace {
+
+std::atomic<uint32_t> s_nextSeed{ 0x2545F491u };
+
+/** @brief Lerp of two RGBA8 colors, weight in [0, 256]: two channels per multiply, 16 bits each. */
+uint32_t lerpColor(uint32_t a, uint32_t b, uint32_t weight) {
+    const uint32_t rb = ((a & 0x00FF00FFu) * (256 - weight) + (b & 0x00FF00FFu) * weight) >> 8;
+    const uint32_t ga = (((a >> 8) & 0x00FF00FFu) * (256 - weight) + ((b >> 8) & 0x00FF00FFu) * weight) >> 8;
+    return (rb & 0x00FF00FFu) | ((ga & 0x00FF00FFu) << 8);
+}
+
+} // namespace
+
+ParticlePool::ParticlePool(uint32_t capacity, uint32_t seed)
+    : m_random(seed != 0 ? seed : s_nextSeed.fetch_add(0x9E3779B9u, std::memory_order_relaxed)) {
+    resize(capacity);
+}
+
+void ParticlePool::resize(uint32_t capacity) {
+    m_capacity = capacity;
+    m_alive = 0;
+    m_recycle = 0;
+    m_bounds = AABB();
+    for (auto* array : { &m_positionX, &m_positionY, &m_positionZ, &m_velocityX, &m_velocityY, &m_velocityZ,
+                         &m_lifeRemaining, &m_inverseLifeTime, &m_sizeBegin, &m_sizeEnd }) {
+        array->assign(capacity, 0.0f);
+    }
+    m_colorBegin.assign(capacity, 0);
+    m_colorEnd.assign(capacity, 0);
+}
+
+void ParticlePool::emit(const ParticleProps& props) {
+    if (m_capacity == 0) return;
+    uint32_t i;
+    if (m_alive < m_capacity) {
+        i = m_alive++;
+    } else {
+        i = m_recycle;
+        m_recycle = (m_recycle + 1) % m_capacity;
+    }
+
+    const glm::vec3 variation(m_random.signedUnit(), m_random.signedUnit(), m_random.signedUnit());
+    const glm::vec3 velocity = props.velocity + props.velocityVariation * variation;
+    m_positionX[i] = props.position.x;
+    m_positionY[i] = props.position.y;
+    m_positionZ[i] = props.position.z;
+    m_velocityX[i] = velocity.x;
+    m_velocityY[i] = velocity.y;
+    m_velocityZ[i] = velocity.z;
+    m_lifeRemaining[i] = props.lifeTime;
+    m_inverseLifeTime[i] = props.lifeTime > 0.0f ? 1.0f / props.lifeTime : 0.0f;
+    m_sizeBegin[i] = props.sizeBegin + props.sizeVariation * variation.x;
+    m_sizeEnd[i] = props.sizeEnd;
+    m_colorBegin[i] = InstanceData::packColor(props.colorBegin);
+    m_colorEnd[i] = InstanceData::packColor(props.colorEnd);
+
+    // Emitted after removeDead(): culled with this frame's bounds, which must already include the new particle
+    const glm::vec3 extent(std::max(m_sizeBegin[i], m_sizeEnd[i]));
+    m_bounds.extend(props.position - extent);
+    m_bounds.extend(props.position + extent);
+}
+
+void ParticlePool::update(float deltaTime, uint32_t begin, uint32_t end) {
+    end = std::min(end, m_alive);
+    float* px = m_positionX.data();
+    float* py = m_positionY.data();
+    float* pz = m_positionZ.data();
+    const float* vx = m_velocityX.data();
+    const float* vy = m_velocityY.data();
+    const float* vz = m_velocityZ.data();
+    float* life = m_lifeRemaining.data();
+
+    uint32_t i = begin;
+    const Float4 step = Float4::splat(deltaTime);
+    const Float4 age = Float4::splat(-deltaTime);
+    for (; i + 4 <= end; i += 4) {
+        (Float4::load(px + i) + Float4::load(vx + i) * step).store(px + i);
+        (Float4::load(py + i) + Float4::load(vy + i) * step).store(py + i);
+        (Float4::load(pz + i) + Float4::load(vz + i) * step).store(pz + i);
+        (Float4::load(life + i) + age).store(life + i);
+    }
+    for (; i < end; ++i) {
+        px[i] += vx[i] * deltaTime;
+        py[i] += vy[i] * deltaTime;
+        pz[i] += vz[i] * deltaTime;
+        life[i] -= deltaTime;
+    }
+}
+
+void ParticlePool::move(uint32_t from, uint32_t to) {
+    m_positionX[to] = m_positionX[from];
+    m_positionY[to] = m_positionY[from];
+    m_positionZ[to] = m_positionZ[from];
+    m_velocityX[to] = m_velocityX[from];
+    m_velocityY[to] = m_velocityY[from];
+    m_velocityZ[to] = m_velocityZ[from];
+    m_lifeRemaining[to] = m_lifeRemaining[from];
+    m_inverseLifeTime[to] = m_inverseLifeTime[from];
+    m_sizeBegin[to] = m_sizeBegin[from];
+    m_sizeEnd[to] = m_sizeEnd[from];
+    m_colorBegin[to] = m_colorBegin[from];
+    m_colorEnd[to] = m_colorEnd[from];
+}
+
+void ParticlePool::removeDead() {
+    m_bounds = AABB();
+    float largest = 0.0f;
+    uint32_t i = 0;
+    while (i < m_alive) {
+        if (m_lifeRemaining[i] <= 0.0f) {
+            // The last live particle takes the slot and is tested in turn
+            move(--m_alive, i);
+            continue;
+        }
+        m_bounds.extend(glm::vec3(m_positionX[i], m_positionY[i], m_positionZ[i]));
+        largest = std::max(largest, std::max(m_sizeBegin[i], m_sizeEnd[i]));
+        ++i;
+    }
+    if (m_alive > 0) {
+        m_bounds.min -= glm::vec3(largest);
+        m_bounds.max += glm::vec3(largest);
+    }
+    if (m_recycle >= m_alive) m_recycle = 0;
+}
+
+void ParticlePool::writeInstances(ParticleInstance* out, uint32_t begin, uint32_t end) const {
+    end = std::min(end, m_alive);
+    for (uint32_t i = begin; i < end; ++i) {
+        const float t = std::clamp(1.0f - m_lifeRemaining[i] * m_inverseLifeTime[i], 0.0f, 1.0f);
+        ParticleInstance& instance = out[i - begin];
+        instance.position[0] = m_positionX[i];
+        instance.position[1] = m_positionY[i];
+        instance.position[2] = m_positionZ[i];
+        instance.size = m_sizeBegin[i] + (m_sizeEnd[i] - m_sizeBegin[i]) * t;
+        instance.color = lerpColor(m_colorBegin[i], m_colorEnd[i], static_cast<uint32_t>(t * 256.0f));
+    }
+}
+
+} // namespace bb3d
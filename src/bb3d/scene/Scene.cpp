@@ -400,19 +400,27 @@ void Scene::onUpdate(float deltaTime) {
     }
 
     // --- SYSTEM: Particles ---
+    // Chunks of every emitter are updated in parallel, then each emitter packs its live particles
+    // Note: Jolt Physics integration for particles could go here (if particleSys.injectIntoPhysics).
+    struct ParticleChunk { ParticlePool* pool; uint32_t begin; };
+    std::vector<ParticlePool*> particlePools;
+    std::vector<ParticleChunk> particleChunks;
     auto particleView = m_registry.view<ParticleSystemComponent>();
     for (auto entityHandle : particleView) {
-        auto& particleSys = particleView.get<ParticleSystemComponent>(entityHandle);
-        for (auto& p : particleSys.particlePool) {
-            if (p.lifeRemaining <= 0.0f) continue;
-            
-            p.lifeRemaining -= deltaTime;
-            if (p.lifeRemaining > 0.0f) {
-                p.position += p.velocity * deltaTime;
-                
-                // Note: Jolt Physics integration for particles could go here (if particleSys.injectIntoPhysics).
-            }
-        }
+        auto& pool = particleView.get<ParticleSystemComponent>(entityHandle).pool;
+        if (pool.getAliveCount() == 0) continue;
+        particlePools.push_back(&pool);
+        for (uint32_t begin = 0; begin < pool.getAliveCount(); begin += ParticlePool::CHUNK_SIZE) particleChunks.push_back({ &pool, begin });
+    }
+    JobSystem* jobs = m_EngineContext ? m_EngineContext->GetJobSystem() : nullptr;
+    auto updateChunk = [&](uint32_t c, uint32_t) { particleChunks[c].pool->update(deltaTime, particleChunks[c].begin, particleChunks[c].begin + ParticlePool::CHUNK_SIZE); };
+    auto removeDead = [&](uint32_t p, uint32_t) { particlePools[p]->removeDead(); };
+    if (jobs && particleChunks.size() > 1) {
+        jobs->dispatch(static_cast<uint32_t>(particleChunks.size()), 1, updateChunk);
+        jobs->dispatch(static_cast<uint32_t>(particlePools.size()), 1, removeDead);
+    } else {
+        for (uint32_t c = 0; c < particleChunks.size(); ++c) updateChunk(c, 0);
+        for (uint32_t p = 0; p < particlePools.size(); ++p) removeDead(p, 0);
     }
 
     // --- SYSTEM: Native Scripts ---
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "bb3d/core/Log.hpp"
+#include <string_view>
+
+namespace bb3d::test {
+
+/**
+ * @brief Result of the checks of a CPU-only unit test, reported through the core logger.
+ *
+ * `Log::Init()` must have been called. Each check logs one `[OK]`/`[FAIL]` line;
+ * `finish()` logs the summary and returns the exit code of the test.
+ */
+class CheckCounter {
+public:
+    void operator()(bool condition, std::string_view what) {
+        if (condition) {
+            BB_CORE_INFO("[OK]   {}", what);
+        } else {
+            BB_CORE_ERROR("[FAIL] {}", what);
+            m_failures++;
+        }
+    }
+
+    [[nodiscard]] int failures() const { return m_failures; }
+
+    int finish(std::string_view suite) const {
+        if (m_failures == 0) {
+            BB_CORE_INFO("All {} tests passed!", suite);
+        } else {
+            BB_CORE_ERROR("{} {} check(s) failed.", m_failures, suite);
+        }
+        Log::Flush();
+        return m_failures == 0 ? 0 : 1;
+    }
+
+private:
+    int m_failures = 0;
+};
+
+} // namespace bb3d::test
@@ -73,6 +73,7 @@ int main() {
         bb3d::Buffer vB(context, vS, vk::BufferUsageFlagBits::eVertexBuffer, VMA_MEMORY_USAGE_CPU_TO_GPU, VMA_ALLOCATION_CREATE_MAPPED_BIT);
         vB.upload(vertices.data(), vS);
         bb3d::Texture tex(context, "assets/textures/Bricks092_1K-JPG_Color.jpg");
+        context.getUploadQueue().flush(); // Ce test soumet ses propres frames
         bb3d::UniformBuffer ubo(context, sizeof(UniformBufferObject));
 
         vk::Device dev = context.getDevice();
@@ -68,6 +68,7 @@ int main() {
 
             auto model = resources.load<bb3d::Model>("assets/models/house.obj");
             auto texture = resources.load<bb3d::Texture>("assets/textures/Bricks092_1K-JPG_Color.jpg");
+            context.getUploadQueue().flush(); // Ce test soumet ses propres frames
 
             auto bounds = model->getBounds();
             glm::vec3 center = bounds.center(), size = bounds.size();
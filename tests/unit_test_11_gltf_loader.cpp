@@ -73,6 +73,7 @@ int main() {
                 BB_CORE_WARN("Texture manquante dans le modèle GLTF, chargement d'une texture par défaut...");
                 texture = resources.load<bb3d::Texture>("assets/textures/Bricks092_1K-JPG_Color.jpg");
             }
+            context.getUploadQueue().flush(); // Ce test soumet ses propres frames
 
             auto bounds = model->getBounds();
             glm::vec3 center = bounds.center(), size = bounds.size();
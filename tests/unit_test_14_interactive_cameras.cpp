@@ -65,6 +65,7 @@ int main() {
             auto cube = bb3d::MeshGenerator::createCube(context, 1.0f, {1, 0, 0});
             auto sphere = bb3d::MeshGenerator::createSphere(context, 0.5f, 32, {0, 0, 1});
             auto centerSphere = bb3d::MeshGenerator::createSphere(context, 0.1f, 16, {0, 1, 0}); // Petite sphère verte au centre
+            context.getUploadQueue().flush(); // Ce test soumet ses propres frames
 
             bb3d::Shader vert(context, "assets/shaders/simple_3d.vert.spv");
             bb3d::Shader frag(context, "assets/shaders/simple_3d.frag.spv");
@@ -4,11 +4,11 @@
 #include "bb3d/scene/OrbitCamera.hpp"
 #include "bb3d/render/Material.hpp"
 #include "bb3d/core/Log.hpp"
-#include <random>
+#include <algorithm>
 
 int main() {
     auto engine = bb3d::Engine::Create(bb3d::EngineConfig()
-        .title("BB3D - Particle System Test")
+        .title("BB3D - Particle System Test (1M)")
         .resolution(1280, 720)
         .vsync(true)
         .enableOffscreenRendering(true) // Required for Editor Viewport
@@ -49,37 +49,30 @@ int main() {
     auto emitter = scene->createEntity("FireEmitter");
     emitter.at({0, 0, 0});
     
-    emitter.add<bb3d::ParticleSystemComponent>(2000);
+    // Up to one million live particles (SoA pool, updated and streamed by the job system)
+    emitter.add<bb3d::ParticleSystemComponent>(1000000);
     auto& pSys = emitter.get<bb3d::ParticleSystemComponent>();
     pSys.material = particleMat;
 
-    // 4. Emission Script
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> dis(-1.0f, 1.0f);
+    // 4. Emission Script: ~700k particles/s, 1.5s mean lifetime: the pool stays at its 1M capacity
+    emitter.add<bb3d::NativeScriptComponent>([](bb3d::Entity entity, float dt) {
+        auto& pSysComp = entity.get<bb3d::ParticleSystemComponent>();
+        auto& rnd = pSysComp.pool.random();
+        const glm::vec3 origin = entity.get<bb3d::TransformComponent>().translation;
+        const int count = static_cast<int>(std::min(dt, 0.1f) * 700000.0f);
+        for (int i = 0; i < count; ++i) {
+            bb3d::ParticleProps props;
+            props.position = origin;
+            props.velocity = { rnd.signedUnit() * 1.5f, 2.0f + rnd.signedUnit() * 0.5f, rnd.signedUnit() * 1.5f };
+            props.velocityVariation = { 0.2f, 0.2f, 0.2f };
+            props.colorBegin = { 1.0f, 0.8f, 0.3f, 1.0f };
+            props.colorEnd = { 1.0f, 0.1f, 0.0f, 0.0f }; // Fade to transparent red
+            props.sizeBegin = 0.05f + rnd.signedUnit() * 0.01f;
+            props.sizeEnd = 0.0f;
+            props.sizeVariation = 0.01f;
+            props.lifeTime = 1.5f + rnd.signedUnit() * 0.5f;
 
-    emitter.add<bb3d::NativeScriptComponent>([dis, gen](bb3d::Entity entity, float dt) mutable {
-        static float timer = 0.0f;
-        timer += dt;
-        
-        // Emit 5 particles every 0.01s (approx 500/s)
-        if (timer > 0.01f) {
-            timer = 0.0f;
-            auto& pSysComp = entity.get<bb3d::ParticleSystemComponent>();
-            for(int i=0; i<5; ++i) {
-                bb3d::ParticleProps props;
-                props.position = entity.get<bb3d::TransformComponent>().translation;
-                props.velocity = { dis(gen) * 0.5f, 2.0f + dis(gen) * 0.5f, dis(gen) * 0.5f };
-                props.velocityVariation = { 0.2f, 0.2f, 0.2f };
-                props.colorBegin = { 1.0f, 0.8f, 0.3f, 1.0f };
-                props.colorEnd = { 1.0f, 0.1f, 0.0f, 0.0f }; // Fade to transparent red
-                props.sizeBegin = 0.5f + dis(gen) * 0.1f;
-                props.sizeEnd = 0.0f;
-                props.sizeVariation = 0.1f;
-                props.lifeTime = 1.5f + dis(gen) * 0.5f;
-                
-                pSysComp.emit(props);
-            }
+            pSysComp.emit(props);
         }
     });
 
@@ -0,0 +1,93 @@
+#include "bb3d/render/MeshSimplifier.hpp"
+#include "TestCheck.hpp"
+#include <glm/glm.hpp>
+#include <vector>
+#include <cmath>
+
+using namespace bb3d;
+
+// Welded grid sphere (no seams except the poles' fans) to exercise the simplifier.
+static void buildSphere(uint32_t rings, uint32_t segments, std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices) {
+    for (uint32_t r = 0; r <= rings; ++r) {
+        float phi = 3.14159265f * (float)r / (float)rings;
+        for (uint32_t s = 0; s < segments; ++s) {
+            float theta = 2.0f * 3.14159265f * (float)s / (float)segments;
+            positions.push_back({ std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta) });
+        }
+    }
+    for (uint32_t r = 0; r < rings; ++r) {
+        for (uint32_t s = 0; s < segments; ++s) {
+            uint32_t a = r * segments + s;
+            uint32_t b = r * segments + (s + 1) % segments;
+            uint32_t c = (r + 1) * segments + s;
+            uint32_t d = (r + 1) * segments + (s + 1) % segments;
+            indices.insert(indices.end(), { a, c, b, b, c, d });
+        }
+    }
+}
+
+int main() {
+    Log::Init();
+    BB_CORE_INFO("--- Unit Test: Mesh LOD (QEM Simplifier & Selection) ---");
+    test::CheckCounter check;
+
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    buildSphere(64, 64, positions, indices);
+
+    // 1. Simplification reaches the target with a bounded error
+    float error = 0.0f;
+    auto half = MeshSimplifier::simplify(&positions[0].x, positions.size(), sizeof(glm::vec3), indices, indices.size() / 2, 0.05f, &error);
+    check(half.size() % 3 == 0, "Result is a triangle list");
+    check(half.size() <= indices.size() / 2 + 6, "Half target reached");
+    check(error <= 0.05f, "Error stays below the bound");
+
+    bool inRange = true;
+    for (uint32_t i : half) inRange &= (i < positions.size());
+    check(inRange, "Indices reference the original vertex buffer");
+
+    // Simplified vertices must stay on the unit sphere (within the error bound)
+    float maxDeviation = 0.0f;
+    for (size_t i = 0; i < half.size(); i += 3) {
+        glm::vec3 c = (positions[half[i]] + positions[half[i + 1]] + positions[half[i + 2]]) / 3.0f;
+        maxDeviation = std::max(maxDeviation, 1.0f - glm::length(c));
+    }
+    check(maxDeviation < 0.1f, "Shape is preserved");
+
+    // Scale-invariant: the error bound is relative to the extent, so a 100x larger sphere stops at the same point
+    // (up to float rounding of the scaled positions)
+    std::vector<glm::vec3> scaled = positions;
+    for (auto& p : scaled) p *= 100.0f;
+    float unitError = 0.0f, scaledError = 0.0f;
+    auto unitLod = MeshSimplifier::simplify(&positions[0].x, positions.size(), sizeof(glm::vec3), indices, 0, 0.002f, &unitError);
+    auto scaledLod = MeshSimplifier::simplify(&scaled[0].x, scaled.size(), sizeof(glm::vec3), indices, 0, 0.002f, &scaledError);
+    check(unitLod.size() < indices.size() / 2 && unitLod.size() > 0, "Error bound stops the reduction");
+    check(std::abs(static_cast<float>(scaledLod.size()) - static_cast<float>(unitLod.size())) <= unitLod.size() * 0.05f, "Same reduction at 100x scale");
+    check(scaledError <= 0.002f && std::abs(scaledError - unitError) <= 0.0002f, "Same relative error at 100x scale");
+
+    // 2. Full chain
+    LODSettings settings;
+    settings.levels = 4;
+    auto chain = MeshSimplifier::buildLODChain(&positions[0].x, positions.size(), sizeof(glm::vec3), indices, settings);
+    check(chain.levels.size() >= 3, "At least 3 levels generated");
+    check(chain.levels[0].indexCount == indices.size(), "LOD 0 is the source mesh");
+    bool decreasing = true;
+    for (size_t i = 1; i < chain.levels.size(); ++i) {
+        decreasing &= chain.levels[i].indexCount < chain.levels[i - 1].indexCount;
+        decreasing &= chain.levels[i].screenSize < chain.levels[i - 1].screenSize;
+        decreasing &= chain.levels[i].firstIndex + chain.levels[i].indexCount <= chain.indices.size();
+    }
+    check(decreasing, "Levels are ordered and fit in the concatenated buffer");
+
+    // 3. Selection with hysteresis
+    std::vector<MeshLOD> levels = { {0, 300, 1.0f}, {300, 150, 0.25f}, {450, 75, 0.125f} };
+    check(LOD::selectLevel(levels, 0.5f, 0, 0.1f) == 0, "Large object uses LOD 0");
+    check(LOD::selectLevel(levels, 0.2f, 0, 0.1f) == 1, "Smaller object uses LOD 1");
+    check(LOD::selectLevel(levels, 0.05f, 0, 0.1f) == 2, "Tiny object uses LOD 2");
+    check(LOD::selectLevel(levels, 0.26f, 1, 0.1f) == 1, "Hysteresis keeps LOD 1 just above the threshold");
+    check(LOD::selectLevel(levels, 0.24f, 0, 0.1f) == 0, "Hysteresis keeps LOD 0 just below the threshold");
+    check(LOD::selectLevel(levels, 0.3f, 1, 0.1f) == 0, "Back to LOD 0 outside the dead band");
+    check(LOD::screenSize(1.0f, 0.5f, 1.0f) == 1.0f, "Camera inside the bounds gives full size");
+
+    return check.finish("LOD");
+}
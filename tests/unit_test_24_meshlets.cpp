@@ -0,0 +1,127 @@
+#include "bb3d/render/Meshlet.hpp"
+#include "bb3d/render/ClusterCuller.hpp"
+#include "bb3d/scene/Frustum.hpp"
+#include "TestCheck.hpp"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <vector>
+#include <chrono>
+#include <cmath>
+
+using namespace bb3d;
+
+// CPU only: meshlet building and cluster culling need no GPU (the culler is benchmarked here).
+
+static void buildSphere(uint32_t rings, uint32_t segments, std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices) {
+    for (uint32_t r = 0; r <= rings; ++r) {
+        float phi = 3.14159265f * (float)r / (float)rings;
+        for (uint32_t s = 0; s < segments; ++s) {
+            float theta = 2.0f * 3.14159265f * (float)s / (float)segments;
+            positions.push_back({ std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta) });
+        }
+    }
+    // Outward facing (counter-clockwise seen from outside)
+    for (uint32_t r = 0; r < rings; ++r) {
+        for (uint32_t s = 0; s < segments; ++s) {
+            uint32_t a = r * segments + s;
+            uint32_t b = r * segments + (s + 1) % segments;
+            uint32_t c = (r + 1) * segments + s;
+            uint32_t d = (r + 1) * segments + (s + 1) % segments;
+            indices.insert(indices.end(), { a, b, c, b, d, c });
+        }
+    }
+}
+
+int main() {
+    Log::Init();
+    BB_CORE_INFO("--- Unit Test: Meshlets & CPU Cluster Culling ---");
+    test::CheckCounter check;
+
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    buildSphere(256, 512, positions, indices);
+    const size_t triCount = indices.size() / 3;
+
+    // 1. Decomposition
+    auto t0 = std::chrono::high_resolution_clock::now();
+    MeshletData data = MeshletBuilder::build(&positions[0].x, positions.size(), sizeof(glm::vec3), indices, 64, 124);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    BB_CORE_INFO("Built {} meshlets from {} triangles in {:.2f} ms", data.meshlets.size(), triCount,
+                 std::chrono::duration<double, std::milli>(t1 - t0).count());
+
+    check(data.indices.size() == indices.size(), "Every triangle belongs to exactly one meshlet");
+    bool bounded = true, boundsOk = true, conesOk = true;
+    for (const auto& m : data.meshlets) {
+        bounded &= m.vertexCount <= 64 && m.indexCount / 3 <= 124 && m.indexCount > 0;
+        for (uint32_t i = m.firstIndex; i < m.firstIndex + m.indexCount; ++i) {
+            boundsOk &= glm::distance(positions[data.indices[i]], m.center) <= m.radius + 1e-4f;
+        }
+        if (m.coneCutoff < 1.0f) {
+            float minDot = std::sqrt(1.0f - m.coneCutoff * m.coneCutoff);
+            for (uint32_t i = m.firstIndex; i < m.firstIndex + m.indexCount; i += 3) {
+                glm::vec3 p0 = positions[data.indices[i]], p1 = positions[data.indices[i + 1]], p2 = positions[data.indices[i + 2]];
+                glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+                if (glm::length(n) <= 0.0f) continue;
+                conesOk &= glm::dot(glm::normalize(n), m.coneAxis) >= minDot - 1e-3f;
+            }
+        }
+    }
+    check(bounded, "Vertex/triangle limits respected");
+    check(boundsOk, "Bounding spheres contain their triangles");
+    check(conesOk, "Normal cones contain their triangle normals");
+
+    // 2. Culling: camera on +Z looking at the sphere
+    glm::vec3 camPos(0.0f, 0.0f, 3.0f);
+    glm::mat4 proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+    glm::mat4 view = glm::lookAt(camPos, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    Frustum frustum;
+    frustum.update(proj * view);
+
+    std::vector<IndexedDrawCommand> draws;
+    ClusterCullStats stats;
+    glm::mat4 model(1.0f);
+    auto objView = ClusterCuller::toObjectSpace(frustum.getPlanes(), camPos, model);
+    ClusterCuller::cull(data, objView, 0, draws, &stats);
+    BB_CORE_INFO("Visible {}/{} (frustum {}, backface {}), {} draws", stats.visible, stats.tested, stats.frustumCulled,
+                 stats.backfaceCulled, draws.size());
+    check(stats.tested == data.meshlets.size(), "All clusters tested");
+    check(stats.backfaceCulled > data.meshlets.size() / 4, "Back half of the sphere is cone-culled");
+    check(stats.visible > 0 && stats.visible + stats.backfaceCulled + stats.frustumCulled == stats.tested, "Counters are consistent");
+    check(draws.size() <= stats.visible, "Contiguous clusters are merged");
+
+    // Clusters facing the camera must never be culled
+    bool frontKept = true;
+    for (const auto& m : data.meshlets) {
+        if (glm::dot(m.coneAxis, glm::normalize(camPos - m.center)) > 0.5f && m.center.z > 0.5f) {
+            bool found = false;
+            for (const auto& d : draws) found |= (m.firstIndex >= d.firstIndex && m.firstIndex < d.firstIndex + d.indexCount);
+            frontKept &= found;
+        }
+    }
+    check(frontKept, "Front-facing clusters survive");
+
+    // Same result through a translated instance (object-space transform of the view)
+    glm::mat4 moved = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -50.0f));
+    std::vector<IndexedDrawCommand> farDraws;
+    ClusterCullStats farStats;
+    ClusterCuller::cull(data, ClusterCuller::toObjectSpace(frustum.getPlanes(), camPos, moved), 7, farDraws, &farStats);
+    check(farStats.visible > 0 && farDraws[0].firstInstance == 7, "Instance index is propagated");
+
+    glm::mat4 behind = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, 50.0f));
+    std::vector<IndexedDrawCommand> none;
+    ClusterCuller::cull(data, ClusterCuller::toObjectSpace(frustum.getPlanes(), camPos, behind), 0, none);
+    check(none.empty(), "Instance behind the camera is fully culled");
+
+    // 3. Benchmark
+    const int iterations = 200;
+    auto b0 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        draws.clear();
+        ClusterCuller::cull(data, objView, 0, draws);
+    }
+    auto b1 = std::chrono::high_resolution_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(b1 - b0).count() / (double)(iterations * data.meshlets.size());
+    BB_CORE_INFO("Cluster culling: {:.1f} ns/cluster", ns);
+
+    return check.finish("meshlet");
+}
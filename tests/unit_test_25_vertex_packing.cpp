@@ -0,0 +1,82 @@
+#include "bb3d/render/VertexPacking.hpp"
+#include "TestCheck.hpp"
+#include <glm/glm.hpp>
+#include <cmath>
+#include <random>
+
+using namespace bb3d;
+
+// CPU only: checks the precision of the quantized vertex encodings.
+
+int main() {
+    Log::Init();
+    BB_CORE_INFO("--- Unit Test: Quantized Vertex Formats ---");
+    test::CheckCounter check;
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    // Angle from the chord length: acos(dot) has no precision left near 1 in float
+    auto angleDeg = [](const glm::vec3& a, const glm::vec3& b) {
+        return 2.0f * std::asin(std::min(glm::length(a - b) * 0.5f, 1.0f)) * 57.2957795f;
+    };
+    auto randomUnit = [&]() {
+        glm::vec3 v;
+        do { v = glm::vec3(dist(rng), dist(rng), dist(rng)); } while (glm::length(v) < 0.1f || glm::length(v) > 1.0f);
+        return glm::normalize(v);
+    };
+
+    // 1. Octahedral snorm16 normals
+    float worstNormalDeg = 0.0f;
+    for (int i = 0; i < 100000; ++i) {
+        glm::vec3 n = randomUnit();
+        int16_t packed[2];
+        VertexPacking::encodeNormal(n, packed);
+        glm::vec3 d = VertexPacking::octDecode(glm::vec2(VertexPacking::fromSnorm16(packed[0]), VertexPacking::fromSnorm16(packed[1])));
+        worstNormalDeg = std::max(worstNormalDeg, angleDeg(n, d));
+    }
+    BB_CORE_INFO("Worst normal error: {} deg", worstNormalDeg);
+    check(worstNormalDeg < 0.01f, "Octahedral normal error below 0.01 degree");
+
+    // Axis-aligned and lower hemisphere edge cases
+    const glm::vec3 axes[] = { {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1} };
+    bool axesOk = true;
+    for (const auto& a : axes) {
+        int16_t packed[2];
+        VertexPacking::encodeNormal(a, packed);
+        glm::vec3 d = VertexPacking::octDecode(glm::vec2(VertexPacking::fromSnorm16(packed[0]), VertexPacking::fromSnorm16(packed[1])));
+        axesOk &= glm::dot(a, d) > 0.99999f;
+    }
+    check(axesOk, "Axis-aligned normals are exact");
+
+    // 2. Tangents keep their bitangent sign
+    float worstTangentDeg = 0.0f;
+    bool signsOk = true;
+    for (int i = 0; i < 100000; ++i) {
+        glm::vec4 t(randomUnit(), (i & 1) ? 1.0f : -1.0f);
+        int16_t packed[2];
+        VertexPacking::encodeTangent(t, packed);
+        glm::vec4 d = VertexPacking::decodeTangent(packed);
+        worstTangentDeg = std::max(worstTangentDeg, angleDeg(glm::vec3(t), glm::vec3(d)));
+        signsOk &= d.w == t.w;
+    }
+    BB_CORE_INFO("Worst tangent error: {} deg", worstTangentDeg);
+    check(signsOk, "Bitangent sign preserved");
+    check(worstTangentDeg < 0.02f, "Tangent error below 0.02 degree");
+
+    // 3. Half-float UVs
+    bool halfOk = true;
+    for (int i = 0; i <= 4096; ++i) {
+        float u = (float)i / 2048.0f; // [0, 2]
+        halfOk &= std::abs(VertexPacking::fromHalf(VertexPacking::toHalf(u)) - u) <= 1.0f / 2048.0f;
+    }
+    check(halfOk, "Half UVs in [0, 2] within 1/2048");
+    check(VertexPacking::fromHalf(VertexPacking::toHalf(1.0f)) == 1.0f && VertexPacking::fromHalf(VertexPacking::toHalf(-0.5f)) == -0.5f, "Exact halves round-trip");
+    check(VertexPacking::toHalf(1e6f) == 0x7C00u, "Overflow saturates to infinity");
+    check(VertexPacking::fromHalf(VertexPacking::toHalf(1e-6f)) > 0.0f, "Subnormals are kept");
+
+    // 4. Memory footprint
+    BB_CORE_INFO("Full: 92 B, StaticLit: {} B, Colored: {} B, Skinned: {} B", sizeof(VertexStaticLit), sizeof(VertexColored), sizeof(VertexSkinned));
+    check(92.0f / sizeof(VertexStaticLit) > 3.5f, "StaticLit is ~4x smaller than the full vertex");
+
+    return check.finish("vertex packing");
+}
@@ -0,0 +1,104 @@
+#include "bb3d/render/RangeAllocator.hpp"
+#include "TestCheck.hpp"
+#include <random>
+#include <map>
+
+using namespace bb3d;
+
+// CPU only: the GeometryPool suballocator (alignment, coalescing, growth, compaction).
+
+int main() {
+    Log::Init();
+    BB_CORE_INFO("--- Unit Test: Range Allocator ---");
+    test::CheckCounter check;
+
+    // 1. Non power of two alignment (vertex strides)
+    {
+        RangeAllocator ranges(1024);
+        auto a = ranges.allocate(10, 1);
+        auto b = ranges.allocate(92 * 3, 92);
+        auto c = ranges.allocate(24 * 2, 24);
+        check(a && *a == 0, "First allocation at offset 0");
+        check(b && *b % 92 == 0, "Full vertex range aligned on 92 bytes");
+        check(c && *c % 24 == 0, "Quantized vertex range aligned on 24 bytes");
+        check(ranges.getUsed() == 10 + 92 * 3 + 24 * 2, "Used bytes exclude alignment padding");
+        check(!ranges.allocate(4096), "Oversized request fails");
+        check(!ranges.allocate(0), "Empty request fails");
+    }
+
+    // 2. Coalescing: freeing everything gives back a single block
+    {
+        RangeAllocator ranges(1000);
+        auto a = ranges.allocate(100);
+        auto b = ranges.allocate(200);
+        auto c = ranges.allocate(300);
+        ranges.free(*b);
+        check(ranges.getLargestFreeBlock() == 400, "Freed middle block does not merge with used neighbours");
+        check(ranges.allocate(150).value_or(~0ull) == 100, "Best fit reuses the hole");
+        ranges.free(100);
+        ranges.free(*a);
+        ranges.free(*c);
+        check(ranges.getAllocationCount() == 0 && ranges.getLargestFreeBlock() == 1000, "Everything coalesces back");
+        check(ranges.getFragmentation() == 0.0f, "No fragmentation when empty");
+    }
+
+    // 3. Growth appends free space (merged with the free tail)
+    {
+        RangeAllocator ranges(256);
+        auto a = ranges.allocate(200);
+        check(!ranges.allocate(100), "Full range refuses the request");
+        ranges.grow(512);
+        auto b = ranges.allocate(300);
+        check(a && b && *b >= 200 && ranges.getCapacity() == 512, "Grown range serves the request");
+    }
+
+    // 4. Random churn then compaction
+    {
+        RangeAllocator ranges(1 << 20);
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<uint64_t> sizeDist(1, 4096);
+        const uint64_t strides[] = { 2, 4, 24, 28, 32, 92 };
+        std::map<uint64_t, std::pair<uint64_t, uint64_t>> live; // offset -> size, alignment
+
+        bool overlapFree = true;
+        for (int i = 0; i < 20000; ++i) {
+            if (!live.empty() && rng() % 3 == 0) {
+                auto it = live.begin();
+                std::advance(it, rng() % live.size());
+                ranges.free(it->first);
+                live.erase(it);
+                continue;
+            }
+            uint64_t align = strides[rng() % 6];
+            uint64_t size = sizeDist(rng) * align;
+            auto offset = ranges.allocate(size, align);
+            if (!offset) continue;
+            overlapFree &= *offset % align == 0;
+            auto next = live.lower_bound(*offset);
+            if (next != live.end()) overlapFree &= *offset + size <= next->first;
+            if (next != live.begin()) {
+                auto prev = std::prev(next);
+                overlapFree &= prev->first + prev->second.first <= *offset;
+            }
+            live[*offset] = { size, align };
+        }
+        check(overlapFree, "20000 random operations: aligned, no overlap");
+
+        uint64_t used = ranges.getUsed();
+        float before = ranges.getFragmentation();
+        auto moves = ranges.compact();
+        bool movesOk = moves.size() == live.size();
+        uint64_t end = 0;
+        for (const auto& m : moves) {
+            auto it = live.find(m.from);
+            movesOk &= it != live.end() && it->second.first == m.size && m.to % it->second.second == 0 && m.to >= end && m.to <= m.from;
+            end = m.to + m.size;
+        }
+        BB_CORE_INFO("Fragmentation before: {}, after: {}", before, ranges.getFragmentation());
+        check(movesOk, "Compaction keeps order, sizes and alignment");
+        check(ranges.getUsed() == used && ranges.getAllocationCount() == live.size(), "Compaction keeps every allocation");
+        check(ranges.getLargestFreeBlock() == ranges.getCapacity() - end, "Free space is contiguous after compaction");
+    }
+
+    return check.finish("range allocator");
+}
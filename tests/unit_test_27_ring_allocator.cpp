@@ -0,0 +1,87 @@
+#include "bb3d/render/RingAllocator.hpp"
+#include "TestCheck.hpp"
+#include <random>
+#include <deque>
+#include <vector>
+
+using namespace bb3d;
+
+// CPU only: the StagingBuffer ring (alignment, wrap-around, out-of-order release).
+
+int main() {
+    Log::Init();
+    BB_CORE_INFO("--- Unit Test: Ring Allocator ---");
+    test::CheckCounter check;
+
+    // 1. Alignment and exhaustion
+    {
+        RingAllocator ring(1024);
+        auto a = ring.allocate(10, 256);
+        auto b = ring.allocate(10, 256);
+        check(a && b && a->offset == 0 && b->offset == 256, "Offsets aligned on the copy alignment");
+        check(!ring.allocate(1024, 1), "Request larger than the free space fails");
+        check(!ring.allocate(2048, 1), "Request larger than the ring fails");
+    }
+
+    // 2. Wrap-around once the tail has moved
+    {
+        RingAllocator ring(1000);
+        auto a = ring.allocate(400);
+        auto b = ring.allocate(400);
+        check(!ring.allocate(300), "Tail space too small before any release");
+        ring.release(a->id);
+        auto c = ring.allocate(300);
+        check(c && c->offset == 0, "Wraps to the beginning once the oldest block is released");
+        check(!ring.allocate(150), "Wrapped head stops at the tail");
+        ring.release(b->id);
+        ring.release(c->id);
+        check(ring.getUsed() == 0 && ring.getBlockCount() == 0, "Everything reclaimed");
+        auto d = ring.allocate(1000);
+        check(d && d->offset == 0, "Empty ring restarts at offset 0 with its whole capacity");
+    }
+
+    // 3. Out-of-order releases only reclaim in allocation order
+    {
+        RingAllocator ring(300);
+        auto a = ring.allocate(100);
+        auto b = ring.allocate(100);
+        auto c = ring.allocate(100);
+        ring.release(c->id);
+        ring.release(b->id);
+        check(ring.getUsed() == 300 && !ring.allocate(50), "Younger blocks wait for the oldest one");
+        ring.release(a->id);
+        check(ring.getUsed() == 0, "Oldest release frees the whole chain");
+    }
+
+    // 4. Random streaming: live allocations never overlap
+    {
+        RingAllocator ring(1 << 16);
+        std::mt19937 rng(7);
+        struct Live { uint64_t offset, size, id; };
+        std::deque<Live> live;
+        bool ok = true;
+        uint64_t served = 0;
+        for (int i = 0; i < 50000; ++i) {
+            if (!live.empty() && (rng() % 2 == 0)) {
+                // Mostly in order, sometimes a younger batch completes first
+                size_t idx = (rng() % 4 == 0) ? rng() % live.size() : 0;
+                ring.release(live[idx].id);
+                live.erase(live.begin() + idx);
+                continue;
+            }
+            uint64_t size = 1 + rng() % 8000;
+            auto a = ring.allocate(size, 16);
+            if (!a) continue;
+            served++;
+            ok &= a->offset % 16 == 0 && a->offset + size <= ring.getCapacity();
+            for (const auto& l : live) ok &= a->offset + size <= l.offset || l.offset + l.size <= a->offset;
+            live.push_back({ a->offset, size, a->id });
+        }
+        for (const auto& l : live) ring.release(l.id);
+        BB_CORE_INFO("Served {} allocations", served);
+        check(ok, "50000 random operations: aligned, in range, no overlap");
+        check(ring.getUsed() == 0, "Ring empty after releasing everything");
+    }
+
+    return check.finish("ring allocator");
+}
@@ -0,0 +1,132 @@
+#include "bb3d/render/BlockCompression.hpp"
+#include "bb3d/render/KTX2.hpp"
+#include "bb3d/render/TextureCooker.hpp"
+#include "TestCheck.hpp"
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace bb3d;
+
+// CPU only: BCn encoders, KTX2 container and cooker mip chains.
+
+int main() {
+    Log::Init();
+    BB_CORE_INFO("--- Unit Test: Texture Compression ---");
+    test::CheckCounter check;
+
+    // Smooth test image (what albedo/normal maps mostly look like), with a noisy corner
+    const uint32_t width = 64, height = 48;
+    std::vector<uint8_t> image(width * height * 4);
+    std::mt19937 rng(42);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            uint8_t* p = &image[(y * width + x) * 4];
+            p[0] = static_cast<uint8_t>(x * 4);
+            p[1] = static_cast<uint8_t>(y * 5);
+            p[2] = static_cast<uint8_t>(128 + 60 * std::sin(x * 0.2f));
+            p[3] = 255;
+            if (x < 8 && y < 8) for (int c = 0; c < 3; ++c) p[c] = static_cast<uint8_t>(rng() & 0xFF);
+        }
+    }
+
+    // Root mean square error of the decoded image over the channels of interest
+    auto rmse = [&](BlockFormat format, int channels) {
+        auto blocks = BlockCompression::compress(format, image.data(), width, height);
+        const uint32_t stride = BlockCompression::blockBytes(format);
+        double sum = 0.0;
+        size_t count = 0;
+        uint8_t decoded[64];
+        for (uint32_t by = 0; by < height / 4; ++by) {
+            for (uint32_t bx = 0; bx < width / 4; ++bx) {
+                if (!BlockCompression::decodeBlock(format, blocks.data() + (by * (width / 4) + bx) * stride, decoded)) return 1e9;
+                for (int i = 0; i < 16; ++i) {
+                    const uint8_t* src = &image[((by * 4 + i / 4) * width + bx * 4 + i % 4) * 4];
+                    for (int c = 0; c < channels; ++c) {
+                        const double d = double(src[c]) - decoded[i * 4 + c];
+                        sum += d * d;
+                        count++;
+                    }
+                }
+            }
+        }
+        return std::sqrt(sum / count);
+    };
+
+    // 1. Block sizes
+    check(BlockCompression::compressedSize(BlockFormat::BC1, 64, 48) == 16 * 12 * 8, "BC1: 8 bytes per 4x4 block");
+    check(BlockCompression::compressedSize(BlockFormat::BC7, 5, 5) == 4 * 16, "Partial blocks are padded");
+
+    // 2. Encoder quality on the test image
+    const double bc1 = rmse(BlockFormat::BC1, 3), bc7 = rmse(BlockFormat::BC7, 4);
+    const double bc4 = rmse(BlockFormat::BC4, 1), bc5 = rmse(BlockFormat::BC5, 2), bc3 = rmse(BlockFormat::BC3, 4);
+    BB_CORE_INFO("RMSE BC1 {:.2f}, BC3 {:.2f}, BC4 {:.2f}, BC5 {:.2f}, BC7 {:.2f}", bc1, bc3, bc4, bc5, bc7);
+    check(bc1 < 12.0, "BC1 error is bounded");
+    check(bc3 < 12.0, "BC3 error is bounded");
+    check(bc4 < 6.0 && bc5 < 6.0, "BC4/BC5 error is bounded");
+    check(bc7 < bc1, "BC7 beats BC1");
+
+    // 3. Exact cases
+    {
+        uint8_t flat[64], decoded[64], block[16];
+        for (int i = 0; i < 16; ++i) { flat[i * 4] = 200; flat[i * 4 + 1] = 100; flat[i * 4 + 2] = 50; flat[i * 4 + 3] = 255; }
+        BlockCompression::encodeBlock(BlockFormat::BC4, flat, block);
+        BlockCompression::decodeBlock(BlockFormat::BC4, block, decoded);
+        check(decoded[0] == 200 && decoded[60] == 200, "BC4 flat block is lossless");
+
+        flat[5 * 4 + 3] = 0; // One transparent texel
+        BlockCompression::encodeBlock(BlockFormat::BC1, flat, block);
+        BlockCompression::decodeBlock(BlockFormat::BC1, block, decoded);
+        check(decoded[5 * 4 + 3] == 0 && decoded[3] == 255, "BC1 keeps punch-through alpha");
+
+        for (int i = 0; i < 16; ++i) flat[i * 4 + 3] = static_cast<uint8_t>(i * 17);
+        BlockCompression::encodeBlock(BlockFormat::BC7, flat, block);
+        bool ok = BlockCompression::decodeBlock(BlockFormat::BC7, block, decoded);
+        int maxError = 0;
+        for (int i = 0; i < 64; ++i) maxError = std::max(maxError, std::abs(int(decoded[i]) - int(flat[i])));
+        check(ok && maxError <= 6, "BC7 mode 6 handles an alpha ramp");
+    }
+
+    // 4. KTX2 round trip
+    {
+        KTX2Texture cooked = TextureCooker::cook(image.data(), width, height, TextureUsage::Albedo);
+        check(cooked.format == KTX2Format::BC7_SRGB, "Albedo cooks to BC7 sRGB");
+        check(cooked.levels.size() == 7, "Full mip chain down to 1x1 (64x48 -> 7 levels)");
+        auto bytes = KTX2::write(cooked);
+        check(KTX2::isKTX2(bytes), "Identifier written");
+        KTX2Texture loaded = KTX2::read(bytes);
+        bool same = loaded.format == cooked.format && loaded.width == width && loaded.height == height && loaded.levels == cooked.levels;
+        check(same, "Read back identical levels");
+
+        bool rejected = false;
+        bytes[44] = std::byte{ 2 }; // Zstandard supercompression
+        try { KTX2::read(bytes); } catch (const std::exception&) { rejected = true; }
+        check(rejected, "Supercompressed files are rejected");
+
+        bool truncated = false;
+        try { KTX2::read(std::span<const std::byte>(bytes.data(), 100)); } catch (const std::exception&) { truncated = true; }
+        check(truncated, "Truncated files are rejected");
+    }
+
+    // 5. Cooker usage detection and mip filters
+    {
+        check(TextureCooker::detectUsage("assets/PBR/Bricks092_1K-JPG/Bricks092_1K-JPG_NormalGL.jpg") == TextureUsage::Normal, "NormalGL -> Normal");
+        check(TextureCooker::detectUsage("Bricks092_1K-JPG_Roughness.jpg") == TextureUsage::Single, "Roughness -> Single");
+        check(TextureCooker::detectUsage("Bricks092_1K-JPG_Color.jpg") == TextureUsage::Albedo, "Color -> Albedo");
+        check(TextureCooker::selectFormat(TextureUsage::Normal, false, false) == KTX2Format::BC5_UNORM, "Normal maps use BC5");
+
+        // Black/white checker: the sRGB-correct average is 188, not 128
+        std::vector<uint8_t> checker(4 * 4 * 4);
+        for (int i = 0; i < 16; ++i) { uint8_t v = ((i % 4 + i / 4) % 2) ? 255 : 0; checker[i * 4] = checker[i * 4 + 1] = checker[i * 4 + 2] = v; checker[i * 4 + 3] = 255; }
+        auto mips = TextureCooker::buildMipChain(checker.data(), 4, 4, TextureUsage::Albedo);
+        check(mips.size() == 3 && mips[2][0] >= 186 && mips[2][0] <= 190, "Albedo mips are averaged in linear space");
+
+        // Two opposite tilted normals: the average must stay unit length
+        std::vector<uint8_t> normals(2 * 2 * 4);
+        for (int i = 0; i < 4; ++i) { normals[i * 4] = (i % 2) ? 218 : 37; normals[i * 4 + 1] = 128; normals[i * 4 + 2] = 218; normals[i * 4 + 3] = 255; }
+        auto nmips = TextureCooker::buildMipChain(normals.data(), 2, 2, TextureUsage::Normal);
+        check(nmips.size() == 2 && nmips[1][2] >= 253, "Normal mips are renormalized");
+    }
+
+    return check.finish("texture compression");
+}
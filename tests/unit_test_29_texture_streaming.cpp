@@ -0,0 +1,74 @@
+#include "bb3d/render/TextureResidency.hpp"
+#include "TestCheck.hpp"
+#include <vector>
+
+using namespace bb3d;
+
+// CPU only: mip selection and budgeted residency plan of the texture streamer.
+
+// residentBytes[m] for a square RGBA8 texture of `size` texels (levels m..last resident)
+static std::vector<uint64_t> suffixBytes(uint32_t size) {
+    std::vector<uint64_t> levels;
+    for (uint32_t s = size; s > 0; s /= 2) levels.push_back(static_cast<uint64_t>(s) * s * 4);
+    std::vector<uint64_t> bytes(levels.size() + 1, 0);
+    for (size_t m = levels.size(); m-- > 0;) bytes[m] = bytes[m + 1] + levels[m];
+    return bytes;
+}
+
+int main() {
+    Log::Init();
+    BB_CORE_INFO("--- Unit Test: Texture Streaming ---");
+    test::CheckCounter check;
+
+    // 1. Mip selection
+    check(TextureResidency::desiredMip(2048, 2048.0f, 12) == 0, "Texel per pixel -> level 0");
+    check(TextureResidency::desiredMip(2048, 4096.0f, 12) == 0, "Magnified -> level 0");
+    check(TextureResidency::desiredMip(2048, 256.0f, 12) == 3, "2048 on 256 px -> level 3");
+    check(TextureResidency::desiredMip(2048, 0.0f, 12) == 11, "Invisible -> last level");
+    check(TextureResidency::desiredMip(2048, 256.0f, 12, 1.0f) == 4, "Positive bias is blurrier");
+    check(TextureResidency::desiredMip(2048, 256.0f, 12, -1.0f) == 2, "Negative bias is sharper");
+    check(TextureResidency::tailMip(2048, 2048, 12, 128) == 4, "Tail of a 2048 texture starts at 128");
+    check(TextureResidency::tailMip(2048, 512, 12, 128) == 4, "Tail uses the largest side");
+    check(TextureResidency::tailMip(64, 64, 7, 128) == 0, "Small texture is all tail");
+
+    // 2. Plan within budget: everything gets its desired level
+    const auto big = suffixBytes(2048);   // 12 levels, tail at 4
+    const auto small = suffixBytes(512);  // 10 levels, tail at 2
+    {
+        std::vector<ResidencyEntry> entries = { { big, 4, 0, 0 }, { small, 2, 1, 0 } };
+        uint64_t total = TextureResidency::plan(entries, 1ull << 30);
+        check(entries[0].targetMip == 0 && entries[1].targetMip == 1, "Within budget: desired levels");
+        check(total == big[0] + small[1], "Planned bytes match the resident levels");
+    }
+
+    // 3. Desired levels coarser than the tail are clamped to the tail
+    {
+        std::vector<ResidencyEntry> entries = { { big, 4, 9, 0 } };
+        TextureResidency::plan(entries, 1ull << 30);
+        check(entries[0].targetMip == 4, "Tail is always resident");
+    }
+
+    // 4. Over budget: degradation is spread before any texture loses two levels
+    {
+        std::vector<ResidencyEntry> entries = { { big, 4, 0, 0 }, { big, 4, 0, 0 } };
+        uint64_t budget = big[1] * 2;
+        uint64_t total = TextureResidency::plan(entries, budget);
+        check(total <= budget, "Over budget: plan fits");
+        check(entries[0].targetMip == 1 && entries[1].targetMip == 1, "Both textures lose one level");
+
+        entries = { { big, 4, 0, 0 }, { big, 4, 0, 0 } };
+        budget = big[1] + big[2];
+        TextureResidency::plan(entries, budget);
+        check(entries[0].targetMip + entries[1].targetMip == 3, "Then the next level of one of them");
+    }
+
+    // 5. Budget smaller than the tails: tails stay, nothing else
+    {
+        std::vector<ResidencyEntry> entries = { { big, 4, 0, 0 }, { small, 2, 0, 0 } };
+        uint64_t total = TextureResidency::plan(entries, 1);
+        check(entries[0].targetMip == 4 && entries[1].targetMip == 2, "Tiny budget: only tails");
+        check(total == big[4] + small[2], "Tiny budget: tails may exceed the budget");
+    }
+
+    return check.finish("texture streaming");
+}
@@ -0,0 +1,93 @@
+#include "bb3d/core/JobSystem.hpp"
+#include "bb3d/core/Log.hpp"
+#include "bb3d/render/MipGenerator.hpp"
+#include "TestCheck.hpp"
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace bb3d;
+
+// CPU only: box/Kaiser mip filters, sRGB handling, normal renormalization and parallel bands.
+
+int main() {
+    Log::Init();
+    BB_CORE_INFO("--- Unit Test: Mip Generation ---");
+    test::CheckCounter check;
+
+    check(MipGenerator::levelCount(1, 1) == 1, "1x1 has one level");
+    check(MipGenerator::levelCount(256, 64) == 9, "256x64 has 9 levels");
+    check(MipGenerator::levelCount(5, 3) == 3, "5x3 has 3 levels");
+
+    // 1. Constant images stay constant with both filters (weights sum to 1, edges clamped)
+    for (MipFilter filter : { MipFilter::Box, MipFilter::Kaiser }) {
+        std::vector<uint8_t> flat(37 * 19 * 4);
+        for (size_t i = 0; i < flat.size(); i += 4) { flat[i] = 200; flat[i + 1] = 90; flat[i + 2] = 17; flat[i + 3] = 128; }
+        auto chain = MipGenerator::buildMipChain(flat.data(), 37, 19, TextureUsage::Albedo, filter);
+        bool constant = chain.size() == 6 && chain.back().size() == 4;
+        for (const auto& level : chain) {
+            for (size_t i = 0; i < level.size() && constant; i += 4) {
+                constant = level[i] == 200 && level[i + 1] == 90 && level[i + 2] == 17 && level[i + 3] == 128;
+            }
+        }
+        check(constant, filter == MipFilter::Box ? "Box keeps a constant image" : "Kaiser keeps a constant image");
+    }
+
+    // 2. sRGB: black/white checker averages to linear 0.5 (188), not to 128
+    {
+        std::vector<uint8_t> checker(8 * 8 * 4);
+        for (int i = 0; i < 64; ++i) { uint8_t v = ((i % 8 + i / 8) % 2) ? 255 : 0; checker[i * 4] = checker[i * 4 + 1] = checker[i * 4 + 2] = v; checker[i * 4 + 3] = 255; }
+        auto box = MipGenerator::downsample(checker.data(), 8, 8, TextureUsage::Albedo, MipFilter::Box);
+        check(box[0] >= 187 && box[0] <= 189, "Box averages albedo in linear space");
+        auto data = MipGenerator::downsample(checker.data(), 8, 8, TextureUsage::Data, MipFilter::Box);
+        check(data[0] == 128, "Data maps are averaged as stored");
+        auto kaiser = MipGenerator::downsample(checker.data(), 8, 8, TextureUsage::Albedo, MipFilter::Kaiser);
+        check(kaiser[4 * 5] >= 180 && kaiser[4 * 5] <= 196, "Kaiser removes the checker (no aliasing)");
+    }
+
+    // 3. Normals stay unit length at every level
+    {
+        const uint32_t size = 16;
+        std::vector<uint8_t> normals(size * size * 4);
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> tilt(-0.8f, 0.8f);
+        for (size_t i = 0; i < normals.size(); i += 4) {
+            float x = tilt(rng), y = tilt(rng), z = std::sqrt(std::max(0.0f, 1.0f - x * x - y * y));
+            normals[i] = static_cast<uint8_t>(std::lround((x * 0.5f + 0.5f) * 255.0f));
+            normals[i + 1] = static_cast<uint8_t>(std::lround((y * 0.5f + 0.5f) * 255.0f));
+            normals[i + 2] = static_cast<uint8_t>(std::lround((z * 0.5f + 0.5f) * 255.0f));
+            normals[i + 3] = 255;
+        }
+        for (MipFilter filter : { MipFilter::Box, MipFilter::Kaiser }) {
+            auto chain = MipGenerator::buildMipChain(normals.data(), size, size, TextureUsage::Normal, filter);
+            bool unit = true;
+            for (size_t level = 1; level < chain.size(); ++level) {
+                for (size_t i = 0; i < chain[level].size(); i += 4) {
+                    float n[3];
+                    for (int c = 0; c < 3; ++c) n[c] = chain[level][i + c] / 127.5f - 1.0f;
+                    unit = unit && std::abs(std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]) - 1.0f) < 0.02f;
+                }
+            }
+            check(unit, filter == MipFilter::Box ? "Box mips keep unit normals" : "Kaiser mips keep unit normals");
+        }
+    }
+
+    // 4. Parallel bands produce exactly the serial result
+    {
+        const uint32_t width = 1024, height = 300;
+        std::vector<uint8_t> image(static_cast<size_t>(width) * height * 4);
+        std::mt19937 rng(42);
+        for (auto& v : image) v = static_cast<uint8_t>(rng());
+
+        JobSystem jobs;
+        jobs.init(4);
+        for (MipFilter filter : { MipFilter::Box, MipFilter::Kaiser }) {
+            auto serial = MipGenerator::buildMipChain(image.data(), width, height, TextureUsage::Albedo, filter);
+            auto parallel = MipGenerator::buildMipChain(image.data(), width, height, TextureUsage::Albedo, filter, &jobs);
+            check(serial == parallel, filter == MipFilter::Box ? "Parallel box matches serial" : "Parallel Kaiser matches serial");
+        }
+        jobs.shutdown();
+    }
+
+    return check.finish("mip generation");
+}
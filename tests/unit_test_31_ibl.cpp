@@ -0,0 +1,112 @@
+#include "bb3d/core/JobSystem.hpp"
+#include "bb3d/core/Log.hpp"
+#include "bb3d/render/IBLBaker.hpp"
+#include "TestCheck.hpp"
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace bb3d;
+
+// CPU only: half floats, SH irradiance, prefiltered cubemap, BRDF table and the cache format.
+
+static HDRImage makeImage(uint32_t width, uint32_t height, float r, float g, float b) {
+    HDRImage image{ width, height, std::vector<float>(static_cast<size_t>(width) * height * 4) };
+    for (size_t i = 0; i < image.texels.size(); i += 4) {
+        image.texels[i] = r; image.texels[i + 1] = g; image.texels[i + 2] = b; image.texels[i + 3] = 1.0f;
+    }
+    return image;
+}
+
+static bool near(float a, float b, float tolerance) { return std::abs(a - b) <= tolerance; }
+
+int main() {
+    Log::Init();
+    BB_CORE_INFO("--- Unit Test: Image-Based Lighting Bake ---");
+    test::CheckCounter check;
+
+    // 1. Half floats
+    check(IBLBaker::toHalf(1.0f) == 0x3C00 && IBLBaker::toHalf(-2.0f) == 0xC000, "Half encodes 1 and -2");
+    check(IBLBaker::fromHalf(IBLBaker::toHalf(0.333333f)) == IBLBaker::fromHalf(0x3555), "Half rounds to nearest");
+    check(IBLBaker::toHalf(1e6f) == 0x7BFF, "Half clamps to 65504 instead of infinity");
+    check(IBLBaker::fromHalf(IBLBaker::toHalf(3e-6f)) > 0.0f, "Half keeps subnormals");
+
+    // 2. Direction conventions: +Y up, cube faces in Vulkan order
+    const glm::vec3 top = IBLBaker::equirectDirection(0.5f, 0.0f);
+    check(near(top.y, 1.0f, 1e-5f), "Equirect top row is +Y");
+    const glm::vec3 posZ = IBLBaker::cubeDirection(4, 8, 8, 16);
+    check(posZ.z > 0.99f, "Cube face 4 is +Z");
+
+    // 3. Constant environment: irradiance / pi equals the radiance in every direction
+    const HDRImage constant = makeImage(128, 64, 2.0f, 1.0f, 0.5f);
+    const SHCoefficients sh = IBLBaker::projectIrradiance(constant);
+    bool flat = true;
+    for (const glm::vec3 n : { glm::vec3(0, 1, 0), glm::vec3(0, -1, 0), glm::vec3(1, 0, 0), glm::vec3(0.577f, 0.577f, -0.577f) }) {
+        const glm::vec3 e = IBLBaker::evaluateIrradiance(sh, n);
+        flat = flat && near(e.x, 2.0f, 0.02f) && near(e.y, 1.0f, 0.01f) && near(e.z, 0.5f, 0.005f);
+    }
+    check(flat, "Constant sky gives constant irradiance");
+
+    // 4. Bright upper hemisphere: up-facing normals receive more than down-facing ones
+    HDRImage sky = makeImage(128, 64, 0.0f, 0.0f, 0.0f);
+    for (size_t i = 0; i < sky.texels.size() / 2; ++i) sky.texels[i] = 1.0f;
+    const SHCoefficients skySH = IBLBaker::projectIrradiance(sky);
+    const float up = IBLBaker::evaluateIrradiance(skySH, glm::vec3(0, 1, 0)).x;
+    const float down = IBLBaker::evaluateIrradiance(skySH, glm::vec3(0, -1, 0)).x;
+    check(up > 0.85f && down < 0.15f, "Upper hemisphere lights up-facing normals");
+
+    // 5. Prefiltered cubemap: layout, and a constant environment stays constant at every roughness
+    IBLBakeSettings settings;
+    settings.specularSize = 16;
+    settings.specularLevels = 4;
+    settings.specularSamples = 32;
+    const KTX2Texture cube = IBLBaker::prefilterSpecular(constant, settings);
+    check(cube.format == KTX2Format::R16G16B16A16_SFLOAT && cube.faceCount == 6 && cube.levels.size() == 4, "Cubemap is RGBA16F with 4 levels");
+    bool uniform = cube.levels[3].size() == 2u * 2u * 6u * 8u;
+    for (const auto& level : cube.levels) {
+        const auto* texels = reinterpret_cast<const uint16_t*>(level.data());
+        for (size_t i = 0; i < level.size() / 2 && uniform; i += 4) {
+            uniform = near(IBLBaker::fromHalf(texels[i]), 2.0f, 0.01f) && near(IBLBaker::fromHalf(texels[i + 1]), 1.0f, 0.01f);
+        }
+    }
+    check(uniform, "Constant sky prefilters to itself");
+
+    // 6. BRDF table: scale + bias <= 1, close to 1 for smooth surfaces seen head-on
+    const KTX2Texture lut = IBLBaker::integrateBRDF(32, 128);
+    const auto* brdf = reinterpret_cast<const uint16_t*>(lut.levels[0].data());
+    bool bounded = lut.format == KTX2Format::R16G16_SFLOAT && lut.levels[0].size() == 32u * 32u * 4u;
+    for (size_t i = 0; i < 32 * 32 && bounded; ++i) {
+        const float scale = IBLBaker::fromHalf(brdf[i * 2]), bias = IBLBaker::fromHalf(brdf[i * 2 + 1]);
+        bounded = scale >= 0.0f && bias >= 0.0f && scale + bias <= 1.01f;
+    }
+    check(bounded, "BRDF table stays in [0, 1]");
+    const float smooth = IBLBaker::fromHalf(brdf[31 * 2]) + IBLBaker::fromHalf(brdf[31 * 2 + 1]);
+    check(smooth > 0.9f, "Smooth head-on BRDF integrates to about 1");
+
+    // 7. Cache round trip; stale versions are rejected
+    BakedEnvironment baked{ sh, cube };
+    const auto bytes = IBLBaker::serialize(baked);
+    const BakedEnvironment loaded = IBLBaker::deserialize(bytes);
+    check(loaded.irradiance[0] == sh[0] && loaded.irradiance[8] == sh[8] && loaded.specular.levels == cube.levels, "Cache round trip");
+    auto stale = bytes;
+    const uint32_t oldVersion = IBLBaker::Version + 1;
+    std::memcpy(stale.data() + 4, &oldVersion, sizeof(oldVersion));
+    bool rejected = false;
+    try { (void)IBLBaker::deserialize(stale); } catch (const std::exception&) { rejected = true; }
+    check(rejected, "Cache of another version is rejected");
+    check(IBLBaker::hash(bytes) != IBLBaker::hash(stale), "Content hash changes with the data");
+
+    // 8. Parallel bake matches the serial one
+    {
+        HDRImage noisy = makeImage(256, 128, 0.0f, 0.0f, 0.0f);
+        for (size_t i = 0; i < noisy.texels.size(); ++i) noisy.texels[i] = static_cast<float>((i * 2654435761u) % 1000) / 100.0f;
+        JobSystem jobs;
+        jobs.init(4);
+        const BakedEnvironment serial = IBLBaker::bake(noisy, settings);
+        const BakedEnvironment parallel = IBLBaker::bake(noisy, settings, &jobs);
+        check(serial.irradiance == parallel.irradiance && serial.specular.levels == parallel.specular.levels, "Parallel bake matches serial");
+        jobs.shutdown();
+    }
+
+    return check.finish("IBL");
+}
@@ -0,0 +1,58 @@
+#include "bb3d/render/SlotAllocator.hpp"
+#include "TestCheck.hpp"
+#include <algorithm>
+#include <vector>
+
+using namespace bb3d;
+
+// CPU only: slot allocation of the bindless texture array and material records (deferred reuse).
+
+int main() {
+    Log::Init();
+    BB_CORE_INFO("--- Unit Test: Slot Allocator ---");
+    test::CheckCounter check;
+
+    // 1. Dense allocation up to the capacity
+    SlotAllocator slots(4, 3);
+    std::vector<uint32_t> taken;
+    for (int i = 0; i < 4; ++i) taken.push_back(slots.allocate().value_or(99));
+    check(taken == std::vector<uint32_t>{ 0, 1, 2, 3 }, "Slots are handed out in order");
+    check(!slots.allocate().has_value(), "Full allocator refuses");
+    check(slots.getUsed() == 4 && slots.getHighWater() == 4, "Used and high water");
+
+    // 2. A released slot stays retired for `latency` frames (frames in flight may still read it)
+    slots.release(2);
+    check(slots.getUsed() == 3, "Released slot is no longer used");
+    check(!slots.allocate().has_value(), "Retired slot is not reused immediately");
+    std::vector<uint32_t> recycled;
+    slots.nextFrame(&recycled);
+    slots.nextFrame(&recycled);
+    check(recycled.empty() && !slots.allocate().has_value(), "Still retired after 2 frames");
+    slots.nextFrame(&recycled);
+    check(recycled == std::vector<uint32_t>{ 2 }, "Recycled after 3 frames");
+    check(slots.allocate() == 2u, "Recycled slot is reused");
+
+    // 3. Releases of different frames come back in order
+    slots.release(0);
+    slots.nextFrame();
+    slots.release(3);
+    recycled.clear();
+    slots.nextFrame(&recycled);
+    slots.nextFrame(&recycled);
+    check(recycled == std::vector<uint32_t>{ 0 }, "First release recycled first");
+    slots.nextFrame(&recycled);
+    check(recycled == std::vector<uint32_t>{ 0, 3 }, "Second release one frame later");
+
+    // 4. Recycled slots are reused before the array grows
+    SlotAllocator immediate(8);
+    (void)immediate.allocate();
+    (void)immediate.allocate();
+    immediate.release(0);
+    check(immediate.allocate() == 0u && immediate.getHighWater() == 2, "Holes are filled before growing");
+
+    // 5. Unknown slots are ignored
+    immediate.release(7);
+    check(immediate.getUsed() == 2, "Releasing a slot never handed out is a no-op");
+
+    return check.finish("slot allocator");
+}
@@ -0,0 +1,68 @@
+#include "bb3d/core/JobSystem.hpp"
+#include "bb3d/core/Log.hpp"
+#include "bb3d/render/ORMPacker.hpp"
+#include "TestCheck.hpp"
+#include <algorithm>
+#include <vector>
+
+using namespace bb3d;
+
+// CPU only: ORM channel interleaving, bilinear resampling of mismatched maps and parallel packing.
+
+static std::vector<uint8_t> pattern(uint32_t width, uint32_t height, uint32_t seed) {
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * height);
+    for (size_t i = 0; i < pixels.size(); ++i) pixels[i] = static_cast<uint8_t>((i * 2654435761u + seed) >> 7);
+    return pixels;
+}
+
+int main() {
+    Log::Init();
+    BB_CORE_INFO("--- Unit Test: ORM Packing ---");
+    test::CheckCounter check;
+
+    // 1. Interleave: vector body and scalar tail agree (37 = 2 x 16 + 5)
+    const auto r = pattern(37, 1, 1), g = pattern(37, 1, 2), b = pattern(37, 1, 3);
+    std::vector<uint8_t> row(37 * 4);
+    ORMPacker::packRow(r.data(), g.data(), b.data(), row.data(), 37);
+    bool interleaved = true;
+    for (size_t x = 0; x < 37; ++x) {
+        interleaved = interleaved && row[x * 4] == r[x] && row[x * 4 + 1] == g[x] && row[x * 4 + 2] == b[x] && row[x * 4 + 3] == 255;
+    }
+    check(interleaved, "Rows interleave into RGBA with opaque alpha");
+
+    // 2. Absent maps take their defaults
+    const auto ao = pattern(8, 8, 4);
+    const auto packed = ORMPacker::pack({ ao.data(), 8, 8 }, {}, {}, 8, 8);
+    check(packed.size() == 8 * 8 * 4 && packed[4 * 9] == ao[9] && packed[4 * 9 + 1] == 255 && packed[4 * 9 + 2] == 0, "Missing roughness is white, missing metallic is black");
+
+    // 3. Resampling: identity at the same size, constant stays constant
+    std::vector<uint8_t> out(16);
+    ORMPacker::resampleRow({ ao.data(), 8, 8 }, 8, 8, 3, out.data());
+    check(std::equal(out.begin(), out.begin() + 8, ao.begin() + 24), "Same size resample is exact");
+    const uint8_t gray = 77;
+    ORMPacker::resampleRow({ &gray, 1, 1 }, 16, 16, 5, out.data());
+    check(std::all_of(out.begin(), out.end(), [](uint8_t v) { return v == 77; }), "1x1 map upsamples to a constant");
+
+    // 4. 2x upsample of a ramp: edges clamp, the inside interpolates
+    const uint8_t ramp[2] = { 0, 200 };
+    ORMPacker::resampleRow({ ramp, 2, 1 }, 4, 1, 0, out.data());
+    check(out[0] == 0 && out[3] == 200 && out[1] == 50 && out[2] == 150, "Bilinear taps at texel centers");
+
+    // 5. Mismatched sizes pack at the requested size
+    const auto roughness = pattern(4, 4, 5);
+    const auto mixed = ORMPacker::pack({ ao.data(), 8, 8 }, { roughness.data(), 4, 4 }, {}, 8, 8);
+    check(mixed[1] == roughness[0] && mixed[(7 * 8 + 7) * 4 + 1] == roughness[15], "Smaller map is resampled to the output size");
+
+    // 6. Parallel bands match the serial result
+    {
+        JobSystem jobs;
+        jobs.init(4);
+        const auto big = pattern(1024, 512, 6), small = pattern(300, 200, 7), metal = pattern(1024, 512, 8);
+        const auto serial = ORMPacker::pack({ big.data(), 1024, 512 }, { small.data(), 300, 200 }, { metal.data(), 1024, 512 }, 1024, 512);
+        const auto parallel = ORMPacker::pack({ big.data(), 1024, 512 }, { small.data(), 300, 200 }, { metal.data(), 1024, 512 }, 1024, 512, &jobs);
+        check(serial == parallel, "Parallel packing matches serial");
+        jobs.shutdown();
+    }
+
+    return check.finish("ORM packing");
+}
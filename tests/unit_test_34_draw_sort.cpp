@@ -0,0 +1,57 @@
+#include "bb3d/render/DrawSort.hpp"
+#include "TestCheck.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace bb3d;
+
+// CPU only: packed draw sort keys (state grouping, depth order) and their radix sort.
+
+int main() {
+    Log::Init();
+    BB_CORE_INFO("--- Unit Test: Draw Sort ---");
+    test::CheckCounter check;
+
+    // 1. Opaque keys: state first, depth last (front to back inside a batch)
+    DrawSort::KeyFields near{ 1, 0, 5, 7, 0, false, false, 0.1f };
+    DrawSort::KeyFields far = near;
+    far.depth = 0.9f;
+    check(DrawSort::makeKey(near) < DrawSort::makeKey(far), "Opaque: near before far");
+    DrawSort::KeyFields otherMesh = far;
+    otherMesh.mesh = 6;
+    check(DrawSort::makeKey(otherMesh) < DrawSort::makeKey(near), "Opaque: mesh outranks depth");
+    DrawSort::KeyFields hidden = near;
+    hidden.hidden = true;
+    hidden.depth = 0.0f;
+    check(DrawSort::makeKey(near) < DrawSort::makeKey(hidden), "Hidden instances close their batch");
+
+    // 2. Translucent keys: after every opaque draw, back to front before state
+    DrawSort::KeyFields blendNear = near, blendFar = far;
+    blendNear.translucent = blendFar.translucent = true;
+    blendNear.mesh = 1;
+    check(DrawSort::makeKey(blendFar) < DrawSort::makeKey(blendNear), "Translucent: far before near, whatever the mesh");
+    DrawSort::KeyFields lastOpaque{ 15, 7, 0xFFFF, 0xFFFF, 7, true, false, 1.0f };
+    check(DrawSort::makeKey(lastOpaque) < DrawSort::makeKey(blendNear), "Translucent after every opaque type");
+
+    // 3. Quantization
+    check(DrawSort::quantizeDepth(-1.0f) == 0 && DrawSort::quantizeDepth(2.0f) == 0xFFFF && DrawSort::quantizeDepth(0.5f) == 32768, "Depth clamps to 16 bits");
+
+    // 4. Radix sort matches a stable sort, sparse keys (skipped passes) included
+    std::mt19937_64 rng(42);
+    std::vector<DrawKey> keys(5000);
+    for (uint32_t i = 0; i < keys.size(); ++i) keys[i] = { rng() & 0xFF0000FFFF00ull, i };
+    auto expected = keys;
+    std::ranges::stable_sort(expected, {}, &DrawKey::key);
+    std::vector<DrawKey> scratch;
+    DrawSort::radixSort(keys, scratch);
+    const bool same = std::ranges::equal(keys, expected, [](const DrawKey& a, const DrawKey& b) { return a.key == b.key && a.index == b.index; });
+    check(same, "Radix sort is ordered and stable");
+
+    std::vector<DrawKey> full(3000);
+    for (uint32_t i = 0; i < full.size(); ++i) full[i] = { rng(), i };
+    DrawSort::radixSort(full, scratch);
+    check(std::ranges::is_sorted(full, {}, &DrawKey::key), "Full 64-bit keys sort");
+
+    return check.finish("draw sort");
+}
@@ -0,0 +1,65 @@
+#define GLM_ENABLE_EXPERIMENTAL
+#include "bb3d/render/TransformCache.hpp"
+#include "TestCheck.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtx/quaternion.hpp>
+#include <cmath>
+
+using namespace bb3d;
+
+// CPU only: transform cache (world matrix and bounds recomputed only when the inputs change).
+
+static bool nearlyEqual(const glm::mat4& a, const glm::mat4& b) {
+    for (int c = 0; c < 4; ++c) {
+        for (int r = 0; r < 4; ++r) {
+            if (std::abs(a[c][r] - b[c][r]) > 1e-5f) return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    Log::Init();
+    BB_CORE_INFO("--- Unit Test: Transform Cache ---");
+    test::CheckCounter check;
+
+    AABB unit;
+    unit.extend(glm::vec3(-1.0f));
+    unit.extend(glm::vec3(1.0f));
+    const int meshA = 0, meshB = 1;
+
+    // 1. First refresh builds the same matrix as TransformComponent::getTransform()
+    const glm::vec3 t(1.0f, 2.0f, 3.0f), r(0.3f, 1.1f, -0.4f), s(2.0f, 1.0f, 0.5f);
+    const glm::mat4 expected = glm::translate(glm::mat4(1.0f), t) * glm::toMat4(glm::quat(r)) * glm::scale(glm::mat4(1.0f), s);
+    TransformCache cache;
+    check(cache.refresh(t, r, s, glm::vec3(0.0f), &meshA, unit), "New cache is computed");
+    check(nearlyEqual(cache.world, expected), "World matrix matches the transform component");
+    const AABB bounds = unit.transform(expected);
+    check(glm::distance(cache.worldBounds.min, bounds.min) < 1e-5f && glm::distance(cache.worldBounds.max, bounds.max) < 1e-5f, "World bounds follow the matrix");
+
+    // 2. Unchanged inputs are skipped, any change recomputes
+    check(!cache.refresh(t, r, s, glm::vec3(0.0f), &meshA, unit), "Static entity is not recomputed");
+    check(cache.refresh(t + glm::vec3(0.0f, 1.0f, 0.0f), r, s, glm::vec3(0.0f), &meshA, unit) && cache.world[3].y > expected[3].y, "Moved entity is recomputed");
+    cache.refresh(t, r, s, glm::vec3(0.0f), &meshA, unit);
+    check(cache.refresh(t, r, s, glm::vec3(0.0f), &meshB, unit), "New mesh is recomputed");
+    AABB grown = unit;
+    grown.extend(glm::vec3(0.0f, 5.0f, 0.0f));
+    check(cache.refresh(t, r, s, glm::vec3(0.0f), &meshB, grown) && cache.worldBounds.max.y > bounds.max.y, "Rebuilt mesh with new bounds is recomputed");
+
+    // 3. Model offset is applied in local space
+    ModelTransformCache model;
+    model.refresh(t, r, s, glm::vec3(0.0f, 0.0f, 4.0f), &meshA, unit);
+    check(nearlyEqual(model.world, glm::translate(expected, glm::vec3(0.0f, 0.0f, 4.0f))), "Offset follows the transform");
+
+    // 4. Model parts: a mesh rebuilt in place is recomputed even if the model bounds do not change
+    check(model.resizeParts(2) && model.refreshPart(0, unit, true) && model.refreshPart(1, unit, true), "New parts are computed");
+    check(!model.resizeParts(2) && !model.refreshPart(0, unit, false) && !model.refreshPart(1, unit, false), "Unchanged parts are skipped");
+    AABB shrunk;
+    shrunk.extend(glm::vec3(-0.5f));
+    shrunk.extend(glm::vec3(0.5f));
+    check(model.refreshPart(1, shrunk, false) && !model.refreshPart(0, unit, false), "Only the rebuilt part is recomputed");
+    const AABB part = shrunk.transform(model.world);
+    check(glm::distance(model.partBounds[1].min, part.min) < 1e-5f && glm::distance(model.partBounds[1].max, part.max) < 1e-5f, "Part bounds follow the new local bounds");
+
+    return check.finish("transform cache");
+}
@@ -0,0 +1,48 @@
+#include "bb3d/render/ShadowCascade.hpp"
+#include "TestCheck.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace bb3d;
+
+// CPU only: shadow casters culled per cascade (extruded toward the light) and reuse of cached cascades.
+
+static AABB box(const glm::vec3& center, float halfSize) {
+    AABB bounds;
+    bounds.extend(center - glm::vec3(halfSize));
+    bounds.extend(center + glm::vec3(halfSize));
+    return bounds;
+}
+
+int main() {
+    Log::Init();
+    BB_CORE_INFO("--- Unit Test: Shadow Caster Culling ---");
+    test::CheckCounter check;
+
+    // Camera at the origin looking down -Z, sun straight down
+    const glm::mat4 proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::vec3 sun(0.0f, -1.0f, 0.0f);
+    const uint32_t resolution = 2048;
+    const glm::mat4 nearCascade = ShadowCascade::calculateLightSpaceMatrix(proj, view, sun, 0.1f, 20.0f, resolution);
+
+    // 1. Casters inside the first cascade, beside it, behind the camera
+    check(ShadowCascade::isCasterVisible(nearCascade, box(glm::vec3(0.0f, 0.0f, -10.0f), 1.0f)), "Caster in the cascade is kept");
+    check(!ShadowCascade::isCasterVisible(nearCascade, box(glm::vec3(200.0f, 0.0f, -10.0f), 1.0f)), "Caster beside the cascade is culled");
+    check(!ShadowCascade::isCasterVisible(nearCascade, box(glm::vec3(0.0f, 0.0f, -300.0f), 1.0f)), "Caster of a farther cascade is culled");
+
+    // 2. Extrusion: far above the cascade (toward the sun) still casts, below the receivers does not matter
+    check(ShadowCascade::isCasterVisible(nearCascade, box(glm::vec3(0.0f, 800.0f, -10.0f), 1.0f)), "Caster between the sun and the cascade is kept");
+    check(!ShadowCascade::isCasterVisible(nearCascade, box(glm::vec3(0.0f, -5000.0f, -10.0f), 1.0f)), "Caster beyond the far plane is culled");
+
+    // 3. Reuse: same view, sub-texel motion and real motion
+    const glm::mat4 again = ShadowCascade::calculateLightSpaceMatrix(proj, view, sun, 0.1f, 20.0f, resolution);
+    check(ShadowCascade::canReuse(nearCascade, again, resolution), "Unchanged cascade is reused");
+    const glm::mat4 nudged = ShadowCascade::calculateLightSpaceMatrix(proj, glm::translate(view, glm::vec3(-0.001f, 0.0f, 0.0f)), sun, 0.1f, 20.0f, resolution);
+    check(ShadowCascade::canReuse(nearCascade, nudged, resolution), "Sub-texel camera motion keeps the cache");
+    const glm::mat4 moved = ShadowCascade::calculateLightSpaceMatrix(proj, glm::translate(view, glm::vec3(-5.0f, 0.0f, 0.0f)), sun, 0.1f, 20.0f, resolution);
+    check(!ShadowCascade::canReuse(nearCascade, moved, resolution), "Cascade moved by several texels is re-rendered");
+    const glm::mat4 turned = ShadowCascade::calculateLightSpaceMatrix(proj, view, glm::normalize(glm::vec3(0.3f, -1.0f, 0.0f)), 0.1f, 20.0f, resolution);
+    check(!ShadowCascade::canReuse(nearCascade, turned, resolution), "New light direction is re-rendered");
+
+    return check.finish("shadow caster culling");
+}
@@ -0,0 +1,78 @@
+#include "bb3d/render/InstanceCuller.hpp"
+#include "bb3d/scene/Frustum.hpp"
+#include "TestCheck.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace bb3d;
+
+// CPU only: reference of the GPU culling passes (frustum test, instance compaction, indirect commands per group).
+
+int main() {
+    Log::Init();
+    BB_CORE_INFO("--- Unit Test: Instance Culling ---");
+    test::CheckCounter check;
+
+    // Camera at the origin looking down -Z
+    Frustum frustum;
+    frustum.update(glm::perspective(glm::radians(60.0f), 1.0f, 0.1f, 100.0f) *
+                   glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+
+    // Group 0: two batches (slots 0-2 and 3-4); group 1: one batch (slots 5-7)
+    std::vector<GpuDrawTemplate> templates(3);
+    templates[0] = { 36, 0, 0, 0, 0, 0 };
+    templates[1] = { 60, 36, 24, 3, 0, 0 };
+    templates[2] = { 6, 96, 50, 5, 1, 2 };
+    auto instance = [](const glm::vec3& center, uint32_t draw, uint32_t slot) {
+        return GpuCullInstance{ center - glm::vec3(0.5f), draw, center + glm::vec3(0.5f), slot };
+    };
+    std::vector<GpuCullInstance> instances = {
+        instance({ 0.0f, 0.0f, -5.0f }, 0, 0),   // visible
+        instance({ 0.0f, 0.0f, 5.0f }, 0, 1),    // behind
+        instance({ 1.0f, 0.0f, -8.0f }, 0, 2),   // visible
+        instance({ 50.0f, 0.0f, -5.0f }, 1, 3),  // beside
+        instance({ 0.0f, 0.0f, -500.0f }, 1, 4), // beyond far
+        instance({ 0.0f, 1.0f, -3.0f }, 2, 5),   // visible
+        instance({ 0.0f, -1.0f, -3.0f }, 2, 6),  // visible
+        instance({ 0.0f, 0.0f, -99.8f }, 2, 7),  // straddles the far plane
+    };
+
+    GpuCullPushConstants constants;
+    constants.planes = frustum.getPlanes();
+    constants.instanceCount = static_cast<uint32_t>(instances.size());
+    constants.drawCount = static_cast<uint32_t>(templates.size());
+    constants.outputBase = 1000;
+
+    // 1. Same answer as the CPU frustum test
+    bool agrees = true;
+    for (const auto& inst : instances) {
+        AABB bounds;
+        bounds.extend(inst.boundsMin);
+        bounds.extend(inst.boundsMax);
+        agrees &= InstanceCuller::isVisible(constants.planes, inst.boundsMin, inst.boundsMax) == frustum.intersects(bounds);
+    }
+    check(agrees, "Visibility matches Frustum::intersects");
+
+    InstanceCuller::Result result;
+    InstanceCuller::cull(constants, instances, templates, 2, result);
+
+    // 2. Per-batch counts and compaction into the batch ranges
+    check(result.counters[0] == 5, "Five instances are visible");
+    check(result.drawCounts[0] == 2 && result.drawCounts[1] == 0 && result.drawCounts[2] == 3, "Visible instances counted per batch");
+    check(result.compacted[0] == 0 && result.compacted[1] == 2 && result.compacted[2] == UINT32_MAX, "Visible instances packed at the start of their batch");
+    check(result.compacted[5] == 5 && result.compacted[6] == 6 && result.compacted[7] == 7, "Every slot of a fully visible batch is used");
+
+    // 3. Empty batches emit no command, groups count their own commands
+    check(result.counters[1] == 1 && result.counters[2] == 1, "One command per group with visible instances");
+    const IndexedDrawCommand& first = result.commands[0];
+    check(first.indexCount == 36 && first.instanceCount == 2 && first.firstInstance == 1000, "Command of group 0 targets the compacted range");
+    const IndexedDrawCommand& second = result.commands[2];
+    check(second.firstIndex == 96 && second.vertexOffset == 50 && second.instanceCount == 3 && second.firstInstance == 1005, "Command of group 1 starts at its first draw");
+
+    // 4. Planes (0, 0, 0, 1) disable the test
+    GpuCullPushConstants all = constants;
+    all.planes.fill(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    InstanceCuller::cull(all, instances, templates, 2, result);
+    check(result.counters[0] == constants.instanceCount && result.counters[1] == 2, "Culling off keeps every instance");
+
+    return check.finish("instance culling");
+}
@@ -0,0 +1,32 @@
+#include "bb3d/render/InstanceBudget.hpp"
+#include "TestCheck.hpp"
+
+using namespace bb3d;
+
+// CPU only: geometric growth of the instance buffers and hard instance budget.
+
+int main() {
+    Log::Init();
+    BB_CORE_INFO("--- Unit Test: Instance Budget ---");
+    test::CheckCounter check;
+
+    // 1. Growth without budget
+    InstanceBudget unlimited;
+    check(unlimited.grow(10000, 8000) == 10000, "Enough capacity is kept");
+    check(unlimited.grow(10000, 10001) == 20000, "Capacity doubles");
+    check(unlimited.grow(10000, 75000) == 75000, "Large jumps allocate what is needed");
+    check(unlimited.grow(0, 1) == 1, "Empty buffer grows");
+    bool overflow = true;
+    check(unlimited.admit(1000000, overflow) == 1000000 && !overflow, "No budget admits everything");
+
+    // 2. Hard budget: growth capped, excess reported once per overflow episode
+    InstanceBudget budget(25000);
+    check(budget.grow(20000, 30000) == 25000, "Growth stops at the budget");
+    check(budget.grow(25000, 30000) == 25000, "Full budget does not grow");
+    check(budget.admit(30000, overflow) == 25000 && overflow, "First overflow is reported");
+    check(budget.admit(31000, overflow) == 25000 && !overflow, "Ongoing overflow is not reported again");
+    check(budget.admit(20000, overflow) == 20000 && !overflow, "Back under the budget");
+    check(budget.admit(26000, overflow) == 25000 && overflow, "New overflow is reported again");
+
+    return check.finish("instance budget");
+}
@@ -0,0 +1,46 @@
+#include "bb3d/render/InstanceData.hpp"
+#include "TestCheck.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+
+using namespace bb3d;
+
+// CPU only: 64-byte instance record (3x4 affine transform, material index, packed tint).
+
+static bool nearlyEqual(const glm::mat4& a, const glm::mat4& b) {
+    for (int c = 0; c < 4; ++c)
+        for (int r = 0; r < 4; ++r)
+            if (std::abs(a[c][r] - b[c][r]) > 1e-5f) return false;
+    return true;
+}
+
+int main() {
+    Log::Init();
+    BB_CORE_INFO("--- Unit Test: Instance Data ---");
+    test::CheckCounter check;
+
+    // 1. Same size as the mat4 it replaces
+    check(sizeof(InstanceData) == sizeof(glm::mat4), "Record is as large as a mat4");
+
+    // 2. Affine transforms survive the 3x4 packing
+    glm::mat4 world = glm::translate(glm::mat4(1.0f), glm::vec3(3.0f, -2.0f, 7.5f));
+    world = glm::scale(world, glm::vec3(2.0f, 0.5f, -1.0f));
+    world[0][1] = 0.25f; // shear, still affine
+    const InstanceData data = InstanceData::pack(world, 42);
+    check(nearlyEqual(InstanceData::unpackTransform(data), world), "Affine transform round-trips");
+    check(data.rows[0].w == 3.0f && data.rows[1].w == -2.0f && data.rows[2].w == 7.5f, "Translation stored in w of each row");
+    const glm::vec4 point(1.0f, 2.0f, 3.0f, 1.0f);
+    const glm::vec4 expected = world * point;
+    check(std::abs(glm::dot(data.rows[0], point) - expected.x) < 1e-5f && std::abs(glm::dot(data.rows[2], point) - expected.z) < 1e-5f,
+          "Rows transform a point like the matrix");
+    check(data.materialIndex == 42 && data.color == 0xFFFFFFFFu && data.flags == 0, "Attributes stored, white tint by default");
+    check(nearlyEqual(InstanceData::unpackTransform(InstanceData{}), glm::mat4(1.0f)), "Default record is the identity");
+
+    // 3. Tint packing (packUnorm4x8 order and rounding)
+    check(InstanceData::packColor(glm::vec4(1.0f, 0.0f, 0.0f, 1.0f)) == 0xFF0000FFu, "Red in the low byte");
+    check(InstanceData::packColor(glm::vec4(2.0f, -1.0f, 0.5f, 1.0f)) == 0xFF8000FFu, "Components clamped and rounded");
+    const glm::vec4 color = InstanceData::unpackColor(InstanceData::packColor(glm::vec4(0.2f, 0.4f, 0.6f, 0.8f)));
+    check(std::abs(color.x - 0.2f) < 0.5f / 255.0f && std::abs(color.w - 0.8f) < 0.5f / 255.0f, "Tint round-trips within half a step");
+
+    return check.finish("instance data");
+}
@@ -0,0 +1,101 @@
+#include "bb3d/scene/ParticlePool.hpp"
+#include "TestCheck.hpp"
+#include <chrono>
+#include <cmath>
+
+using namespace bb3d;
+
+// CPU only: SoA particle pool (emission, SIMD update, packing of live particles, GPU stream).
+
+static ParticleProps props(const glm::vec3& velocity, float lifeTime) {
+    ParticleProps p;
+    p.position = glm::vec3(1.0f, 2.0f, 3.0f);
+    p.velocity = velocity;
+    p.velocityVariation = glm::vec3(0.0f);
+    p.colorBegin = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
+    p.colorEnd = glm::vec4(0.0f, 0.0f, 1.0f, 0.0f);
+    p.sizeBegin = 1.0f;
+    p.sizeEnd = 3.0f;
+    p.sizeVariation = 0.0f;
+    p.lifeTime = lifeTime;
+    return p;
+}
+
+int main() {
+    Log::Init();
+    BB_CORE_INFO("--- Unit Test: Particle Pool ---");
+    test::CheckCounter check;
+
+    // 1. Random generator: reproducible, in range
+    ParticleRandom a(7), b(7);
+    bool same = true, inRange = true;
+    for (int i = 0; i < 1000; ++i) {
+        same &= a.next() == b.next();
+        const float s = a.signedUnit();
+        b.signedUnit();
+        inRange &= s >= -1.0f && s < 1.0f;
+    }
+    check(same && inRange, "Seeded generator is reproducible and in [-1, 1)");
+
+    // 2. Emission and recycling of a full pool
+    ParticlePool pool(8, 1);
+    for (int i = 0; i < 7; ++i) pool.emit(props(glm::vec3(1.0f, 0.0f, -2.0f), 2.0f));
+    check(pool.getAliveCount() == 7, "Emitted particles are live");
+    for (int i = 0; i < 5; ++i) pool.emit(props(glm::vec3(1.0f, 0.0f, -2.0f), 2.0f));
+    check(pool.getAliveCount() == 8 && pool.getCapacity() == 8, "Full pool recycles instead of growing");
+    const AABB& fresh = pool.getBounds();
+    check(fresh.min.x <= -2.0f && fresh.max.x >= 4.0f && fresh.min.z <= 0.0f && fresh.max.z >= 6.0f, "Bounds cover particles emitted before any update");
+
+    // 3. Update kernel (SIMD body and scalar tail) and stream at mid-life
+    pool.update(1.0f);
+    std::vector<ParticleInstance> stream(pool.getAliveCount());
+    pool.writeInstances(stream.data(), 0, pool.getAliveCount());
+    bool moved = true;
+    for (const auto& p : stream) moved &= p.position[0] == 2.0f && p.position[1] == 2.0f && p.position[2] == 1.0f;
+    check(moved, "Every particle moved by velocity x dt");
+    check(std::abs(stream[7].size - 2.0f) < 1e-5f, "Size interpolated at the particle's age");
+    check(stream[7].color == 0x7F7F007Fu, "Color interpolated per channel");
+
+    // 4. Dead particles removed, survivors packed, bounds follow them
+    ParticlePool mixed(16, 2);
+    for (int i = 0; i < 10; ++i) mixed.emit(props(glm::vec3(0.0f, static_cast<float>(i), 0.0f), (i % 2 == 0) ? 0.5f : 4.0f));
+    mixed.update(1.0f);
+    check(mixed.getAliveCount() == 5, "Expired particles removed");
+    std::vector<ParticleInstance> survivors(mixed.getAliveCount());
+    mixed.writeInstances(survivors.data(), 0, mixed.getAliveCount());
+    bool odd = true;
+    for (const auto& p : survivors) odd &= static_cast<int>(p.position[1] - 2.0f) % 2 == 1;
+    check(odd, "Only the long-lived particles remain, packed at the front");
+    check(mixed.getBounds().min.y <= 3.0f && mixed.getBounds().max.y >= 11.0f, "Bounds cover the live particles");
+
+    // 5. Chunked update matches the whole-pool update
+    ParticlePool whole(1000, 3), chunked(1000, 3);
+    for (int i = 0; i < 999; ++i) {
+        ParticleProps p = props(glm::vec3(0.5f, 1.0f, -1.0f), 1.0f + (i % 7) * 0.1f);
+        p.velocityVariation = glm::vec3(1.0f);
+        whole.emit(p);
+        chunked.emit(p);
+    }
+    whole.update(0.3f);
+    for (uint32_t begin = 0; begin < chunked.getAliveCount(); begin += 100) chunked.update(0.3f, begin, begin + 100);
+    chunked.removeDead();
+    std::vector<ParticleInstance> s0(whole.getAliveCount()), s1(chunked.getAliveCount());
+    whole.writeInstances(s0.data(), 0, whole.getAliveCount());
+    chunked.writeInstances(s1.data(), 0, chunked.getAliveCount());
+    bool equal = s0.size() == s1.size();
+    for (size_t i = 0; equal && i < s0.size(); ++i) equal = s0[i].position[0] == s1[i].position[0] && s0[i].color == s1[i].color;
+    check(equal, "Chunked update matches the single-threaded update");
+
+    // 6. One million particles
+    ParticlePool large(1000000, 4);
+    for (uint32_t i = 0; i < 1000000; ++i) large.emit(props(glm::vec3(0.0f, 1.0f, 0.0f), 2.0f));
+    std::vector<ParticleInstance> largeStream(large.getAliveCount());
+    const auto start = std::chrono::steady_clock::now();
+    large.update(0.016f);
+    large.writeInstances(largeStream.data(), 0, large.getAliveCount());
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    BB_CORE_INFO("1M particles: update + stream in {:.2f} ms (single thread)", ms);
+    check(large.getAliveCount() == 1000000, "One million particles simulated");
+
+    return check.finish("particle pool");
+}
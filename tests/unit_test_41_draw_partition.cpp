@@ -0,0 +1,50 @@
+#include "bb3d/render/DrawPartition.hpp"
+#include "TestCheck.hpp"
+
+using namespace bb3d;
+
+// CPU only: split of the draw list among the secondary command buffers.
+
+int main() {
+    Log::Init();
+    BB_CORE_INFO("--- Unit Test: Draw Partition ---");
+    test::CheckCounter check;
+    auto covers = [](const std::vector<DrawRange>& ranges, uint32_t drawCount) {
+        uint32_t next = 0;
+        for (const auto& range : ranges) {
+            if (range.begin != next || range.end <= range.begin) return false;
+            next = range.end;
+        }
+        return next == drawCount;
+    };
+    std::vector<DrawRange> ranges;
+
+    // 1. Small lists stay in one range
+    DrawPartition::split(300, 512, 16, {}, ranges);
+    check(ranges.size() == 1 && ranges[0].begin == 0 && ranges[0].end == 300, "Fewer draws than minDraws: one range");
+    DrawPartition::split(0, 512, 16, {}, ranges);
+    check(ranges.size() == 1 && ranges[0].begin == 0 && ranges[0].end == 0, "Empty list: one empty range");
+
+    // 2. Even split, bounded by maxRanges
+    DrawPartition::split(4096, 512, 16, {}, ranges);
+    check(ranges.size() == 8 && covers(ranges, 4096), "4096 draws: eight contiguous ranges");
+    check(ranges[0].end == 512 && ranges[7].begin == 3584, "Ranges are the same size");
+    DrawPartition::split(100000, 512, 12, {}, ranges);
+    check(ranges.size() == 12 && covers(ranges, 100000), "Range count capped by maxRanges");
+
+    // 3. Spans are never cut
+    const std::vector<DrawRange> spans = { { 400, 700 }, { 1000, 1100 }, { 1500, 2048 } };
+    DrawPartition::split(2048, 512, 16, spans, ranges);
+    bool intact = covers(ranges, 2048);
+    for (const auto& range : ranges) {
+        for (const auto& span : spans) intact &= !(range.begin > span.begin && range.begin < span.end);
+    }
+    check(intact, "Cuts move to the end of the spans");
+    check(ranges.size() == 3 && ranges[0].end == 700, "First cut pushed past the span [400, 700)");
+
+    // 4. A span over the whole list leaves a single range
+    DrawPartition::split(4096, 512, 16, { { 0, 4096 } }, ranges);
+    check(ranges.size() == 1 && ranges[0].end == 4096, "One span over every draw: one range");
+
+    return check.finish("draw partition");
+}
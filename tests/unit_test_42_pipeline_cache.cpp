@@ -0,0 +1,61 @@
+#include "bb3d/render/PipelineCacheData.hpp"
+#include "TestCheck.hpp"
+
+using namespace bb3d;
+
+// CPU only: header validation, naming and storage of the on-disk pipeline cache.
+
+int main() {
+    Log::Init();
+    BB_CORE_INFO("--- Unit Test: Pipeline Cache ---");
+    test::CheckCounter check;
+
+    PipelineCacheIdentity device;
+    device.vendorID = 0x10DE;
+    device.deviceID = 0x2206;
+    device.driverVersion = 2252734464u;
+    for (uint8_t i = 0; i < 16; ++i) device.cacheUUID[i] = static_cast<uint8_t>(0xA0 + i);
+
+    // Header as written by a driver (least significant byte first), followed by opaque data
+    auto makeBlob = [](const PipelineCacheIdentity& id, uint32_t headerSize = PipelineCacheData::HeaderSize, uint32_t version = PipelineCacheData::HeaderVersionOne) {
+        std::vector<std::byte> blob;
+        auto put = [&](uint32_t value) { for (int b = 0; b < 4; ++b) blob.push_back(static_cast<std::byte>((value >> (8 * b)) & 0xFF)); };
+        put(headerSize);
+        put(version);
+        put(id.vendorID);
+        put(id.deviceID);
+        for (uint8_t byte : id.cacheUUID) blob.push_back(static_cast<std::byte>(byte));
+        for (int i = 0; i < 64; ++i) blob.push_back(static_cast<std::byte>(i));
+        return blob;
+    };
+
+    // 1. Header validation
+    const auto blob = makeBlob(device);
+    check(PipelineCacheData::isCompatible(blob, device), "Blob of the same device is accepted");
+    PipelineCacheIdentity other = device;
+    other.deviceID = 0x2484;
+    check(!PipelineCacheData::isCompatible(blob, other), "Other device is rejected");
+    other = device;
+    other.cacheUUID[7] ^= 0xFF;
+    check(!PipelineCacheData::isCompatible(blob, other), "Other cache UUID is rejected");
+    check(!PipelineCacheData::isCompatible(makeBlob(device, PipelineCacheData::HeaderSize, 2), device), "Unknown header version is rejected");
+    check(!PipelineCacheData::isCompatible(makeBlob(device, 4096), device), "Header larger than the blob is rejected");
+    check(!PipelineCacheData::isCompatible(std::span(blob).first(20), device), "Truncated header is rejected");
+
+    // 2. One file per cache UUID and driver version
+    const std::string name = PipelineCacheData::fileName(device);
+    check(name == "pipelines_a0a1a2a3a4a5a6a7a8a9aaabacadaeaf_2252734464.bin", "File name holds the UUID and the driver version");
+    other = device;
+    other.driverVersion++;
+    check(PipelineCacheData::fileName(other) != name, "Driver update starts a new file");
+
+    // 3. Round trip on disk
+    const auto path = std::filesystem::temp_directory_path() / "bb3d_test_pipeline_cache" / name;
+    check(PipelineCacheData::write(path, blob), "Cache written");
+    const auto loaded = PipelineCacheData::read(path);
+    check(loaded && *loaded == blob && PipelineCacheData::isCompatible(*loaded, device), "Cache read back unchanged");
+    std::filesystem::remove_all(path.parent_path());
+    check(!PipelineCacheData::read(path), "Missing file reads as nullopt");
+
+    return check.finish("pipeline cache");
+}